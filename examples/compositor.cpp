@@ -0,0 +1,241 @@
+/***********************************************************************
+* compositor.cpp - Benchmark of the window composition                 *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <final/final.h>
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+using finalcut::FPoint;
+using finalcut::FSize;
+using finalcut::FColor;
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The benchmark composes overlapping windows with shadows into
+// a 320x100 virtual terminal with 1, 2, 4 and 8 compositor
+// threads. It runs in a headless terminal, so the result does
+// not depend on the size or the speed of the real terminal.
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//----------------------------------------------------------------------
+// class PatternWindow
+//----------------------------------------------------------------------
+
+class PatternWindow final : public finalcut::FDialog
+{
+  public:
+    // Constructor
+    explicit PatternWindow (finalcut::FWidget* = nullptr, int = 0);
+
+    // Method
+    void nextFrame();
+
+  private:
+    // Method
+    void draw() override;
+
+    // Data members
+    int number{0};
+    int frame{0};
+};
+
+//----------------------------------------------------------------------
+PatternWindow::PatternWindow (finalcut::FWidget* parent, int n)
+  : finalcut::FDialog{parent}
+  , number{n}
+{
+  finalcut::FString title{};
+  FDialog::setText (title.sprintf("Window %d", number));
+
+  // Every second window has a solid shadow
+  if ( number % 2 == 1 )
+    setShadow();
+}
+
+//----------------------------------------------------------------------
+void PatternWindow::nextFrame()
+{
+  frame++;
+  redraw();
+}
+
+//----------------------------------------------------------------------
+void PatternWindow::draw()
+{
+  finalcut::FDialog::draw();
+  const auto width = int(getClientWidth());
+  const auto height = int(getClientHeight());
+  const auto color = FColor(1 + number % 6);
+
+  for (auto y{0}; y < height; y++)
+  {
+    print() << FPoint{2, 2 + y};
+
+    for (auto x{0}; x < width; x++)
+    {
+      const auto ch = wchar_t(L'0' + (x + y + frame + number) % 10);
+
+      if ( ch == L'0' )
+        print() << finalcut::FColorPair{FColor::White, color};
+      else
+        print() << finalcut::FColorPair{FColor::Black, FColor::LightGray};
+
+      print() << ch;
+    }
+  }
+}
+
+
+//----------------------------------------------------------------------
+// class Benchmark
+//----------------------------------------------------------------------
+
+class Benchmark final : public finalcut::FWidget
+{
+  public:
+    // Constructor
+    explicit Benchmark (finalcut::FWidget* = nullptr);
+
+    // Accessor
+    finalcut::FString getReport() const;
+
+    // Method
+    void run();
+
+  private:
+    // Constants
+    static constexpr int window_count = 24;
+    static constexpr int frames = 100;
+
+    // Method
+    double composeFrames (std::size_t);
+
+    // Data members
+    std::vector<std::unique_ptr<PatternWindow>> windows{};
+    std::vector<std::size_t>    thread_counts{1, 2, 4, 8};
+    std::vector<double>         compose_ms{};
+};
+
+//----------------------------------------------------------------------
+Benchmark::Benchmark (finalcut::FWidget* parent)
+  : finalcut::FWidget{parent}
+{
+  for (int i{0}; i < window_count; i++)
+  {
+    // Overlapping windows in four rows
+    windows.emplace_back (new PatternWindow{this, i});
+    const int x = 1 + (i % 6) * 50 + (i / 6) * 4;
+    const int y = 1 + (i / 6) * 22;
+    windows.back()->setGeometry (FPoint{x, y}, FSize{64, 30});
+  }
+}
+
+//----------------------------------------------------------------------
+finalcut::FString Benchmark::getReport() const
+{
+  finalcut::FStringStream rep;
+  rep << "Compositor benchmark (" << window_count << " windows, "
+      << frames << " frames, 320x100)\n"
+      << finalcut::FString{41, '-'} << "\n"
+      << "Threads  Time        Per frame   Speedup\n"
+      << finalcut::FString{41, '-'} << "\n";
+
+  for (std::size_t i{0}; i < compose_ms.size(); i++)
+  {
+    finalcut::FString time_str{};
+    finalcut::FString frame_str{};
+    time_str << compose_ms[i] << "ms";
+    frame_str << compose_ms[i] / frames << "ms";
+    rep << std::left << std::setw(9) << thread_counts[i]
+        << std::setw(12) << time_str
+        << std::setw(12) << frame_str
+        << compose_ms[0] / compose_ms[i] << "\n";
+  }
+
+  return rep.str();
+}
+
+//----------------------------------------------------------------------
+void Benchmark::run()
+{
+  // Keep only the composition into the virtual terminal
+  setTerminalUpdates (finalcut::FVTerm::TerminalUpdate::Stop);
+
+  for (auto&& threads : thread_counts)
+    compose_ms.push_back (composeFrames(threads));
+
+  finalcut::FVTerm::setCompositorThreads (1);
+  setTerminalUpdates (finalcut::FVTerm::TerminalUpdate::Continue);
+}
+
+//----------------------------------------------------------------------
+double Benchmark::composeFrames (std::size_t threads)
+{
+  finalcut::FVTerm::setCompositorThreads (threads);
+  steady_clock::duration compose_time{};
+
+  for (int frame{0}; frame < frames; frame++)
+  {
+    for (auto&& window : windows)
+      window->nextFrame();
+
+    // Composes the changed windows into the virtual terminal
+    const auto start = steady_clock::now();
+    forceTerminalUpdate();
+    compose_time += steady_clock::now() - start;
+  }
+
+  return double(duration_cast<microseconds>(compose_time).count()) / 1000.0;
+}
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+  using Profile = finalcut::FHeadlessTerminal::Profile;
+  finalcut::FString report{};
+  finalcut::FHeadlessTerminal::install (Profile::Xterm256color, FSize{320, 100});
+
+  {  // Create the application object in this scope
+    finalcut::FApplication app{argc, argv};
+    Benchmark benchmark{&app};
+    finalcut::FWidget::setMainWidget (&benchmark);
+    benchmark.show();
+    benchmark.run();
+    report = benchmark.getReport();
+  }  // Hide and destroy the application object
+
+  // Restores the standard output of the headless terminal
+  std::unique_ptr<finalcut::FSystem> fsys{new finalcut::FSystemImpl};
+  finalcut::FTerm::setFSystem(fsys);
+  fsys.reset();  // Destroys the headless terminal
+  std::cout << report;
+  return 0;
+}
@@ -20,7 +20,9 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -36,6 +38,7 @@
 #include "final/fmenubar.h"
 #include "final/fmessagebox.h"
 #include "final/fmouse.h"
+#include "final/fsessionrecorder.h"
 #include "final/fstartoptions.h"
 #include "final/fstatusbar.h"
 #include "final/ftermdata.h"
@@ -401,14 +404,17 @@ void FApplication::init()
   auto cmd2 = std::bind(&FApplication::keyReleased, this);
   auto cmd3 = std::bind(&FApplication::escapeKeyPressed, this);
   auto cmd4 = std::bind(&FApplication::mouseTracking, this);
+  auto cmd5 = std::bind(&FApplication::textPasted, this);
   FKeyboardCommand key_cmd1 (cmd1);
   FKeyboardCommand key_cmd2 (cmd2);
   FKeyboardCommand key_cmd3 (cmd3);
   FKeyboardCommand key_cmd4 (cmd4);
+  FKeyboardCommand key_cmd5 (cmd5);
   keyboard->setPressCommand (key_cmd1);
   keyboard->setReleaseCommand (key_cmd2);
   keyboard->setEscPressedCommand (key_cmd3);
   keyboard->setMouseTrackingCommand (key_cmd4);
+  keyboard->setPasteCommand (key_cmd5);
   // Set the keyboard keypress timeout
   keyboard->setKeypressTimeout (key_timeout);
 
@@ -426,6 +432,14 @@ void FApplication::init()
   // Initialize logging
   if ( ! getStartOptions().logfile_stream.is_open() )
     getLog()->setLineEnding(FLog::LineEnding::CRLF);
+
+  // Start the session recording
+  if ( ! getStartOptions().record_file.isEmpty() )
+    startRecording();
+
+  // Start the compositor threads
+  if ( getStartOptions().compositor_threads != 1 )
+    setCompositorThreads (getStartOptions().compositor_threads);
 }
 
 //----------------------------------------------------------------------
@@ -453,6 +467,33 @@ void FApplication::setTerminalEncoding (const FString& enc_str)
   }
 }
 
+//----------------------------------------------------------------------
+void FApplication::setCompositorThreadCount (const FString& count_str)
+{
+  static constexpr std::size_t max_threads = 256;
+  const std::string count{count_str.toString()};
+  const bool is_number = ! count.empty() && count.length() <= 3
+                      && std::all_of ( count.begin(), count.end()
+                                     , [] (char ch)
+                                       {
+                                         return ch >= '0' && ch <= '9';
+                                       } );
+  const std::size_t thread_count = is_number
+                                 ? std::strtoul(count.c_str(), nullptr, 10)
+                                 : 0;
+
+  if ( ! is_number || thread_count > max_threads )
+  {
+    const auto& fterm_data = FTerm::getFTermData();
+    fterm_data->setExitMessage ( "Invalid compositor thread count \""
+                               + count_str + "\"\n(Valid values are "
+                               + "0 = auto and 1 to 256)" );
+    exit(EXIT_FAILURE);
+  }
+
+  getStartOptions().compositor_threads = thread_count;
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::setLongOptions (std::vector<CmdOption>& long_options)
 {
@@ -460,12 +501,16 @@ inline void FApplication::setLongOptions (std::vector<CmdOption>& long_options)
   {
     {"encoding",                 required_argument, nullptr,  'e' },
     {"log-file",                 required_argument, nullptr,  'l' },
+    {"record",                   required_argument, nullptr,  'R' },
+    {"compositor-threads",       required_argument, nullptr,  'T' },
     {"no-mouse",                 no_argument,       nullptr,  'm' },
     {"no-optimized-cursor",      no_argument,       nullptr,  'o' },
     {"no-terminal-detection",    no_argument,       nullptr,  'd' },
     {"no-terminal-data-request", no_argument,       nullptr,  'r' },
     {"no-color-change",          no_argument,       nullptr,  'c' },
     {"no-sgr-optimizer",         no_argument,       nullptr,  's' },
+    {"no-termcap-cache",         no_argument,       nullptr,  'k' },
+    {"refresh-termcap-cache",    no_argument,       nullptr,  'K' },
     {"vgafont",                  no_argument,       nullptr,  'v' },
     {"newfont",                  no_argument,       nullptr,  'n' },
     {"dark-theme",               no_argument,       nullptr,  't' },
@@ -487,12 +532,17 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
   using std::placeholders::_1;
   auto enc = std::bind(&FApplication::setTerminalEncoding, _1);
   auto log = std::bind(&FApplication::setLogFile, _1);
+  auto thr = std::bind(&FApplication::setCompositorThreadCount, _1);
   auto opt = &FApplication::getStartOptions;
 
   // --encoding
   cmd_map['e'] = [enc] (const char* arg) { enc(FString(arg)); };
   // --log-file
   cmd_map['l'] = [log] (const char* arg) { log(FString(arg)); };
+  // --record
+  cmd_map['R'] = [opt] (const char* arg) { opt().record_file = arg; };
+  // --compositor-threads
+  cmd_map['T'] = [thr] (const char* arg) { thr(FString(arg)); };
   // --no-mouse
   cmd_map['m'] = [opt] (const char*) { opt().mouse_support = false; };
   // --no-optimized-cursor
@@ -505,6 +555,10 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
   cmd_map['c'] = [opt] (const char*) { opt().color_change = false; };
   // --no-sgr-optimizer
   cmd_map['s'] = [opt] (const char*) { opt().sgr_optimizer = false; };
+  // --no-termcap-cache
+  cmd_map['k'] = [opt] (const char*) { opt().termcap_cache = false; };
+  // --refresh-termcap-cache
+  cmd_map['K'] = [opt] (const char*) { opt().termcap_refresh = true; };
   // --vgafont
   cmd_map['v'] = [opt] (const char*) { opt().vgafont = true; };
   // --newfont
@@ -581,6 +635,10 @@ void FApplication::showParameterUsage()
     << "    {utf8, vt100, pc, ascii}\n"
     << "  --log-file=<FILE>         "
     << "    Writes log output to FILE\n"
+    << "  --record=<FILE>           "
+    << "    Records the session as asciicast v2 to FILE\n"
+    << "  --compositor-threads=<N>  "
+    << "    Composes the windows with N threads (0 = auto)\n"
     << "  --no-mouse                "
     << "    Disable mouse support\n"
     << "  --no-optimized-cursor     "
@@ -593,6 +651,10 @@ void FApplication::showParameterUsage()
     << "    Do not redefine the color palette\n"
     << "  --no-sgr-optimizer        "
     << "    Do not optimize SGR sequences\n"
+    << "  --no-termcap-cache        "
+    << "    Do not use the terminal capability cache\n"
+    << "  --refresh-termcap-cache   "
+    << "    Rebuild the terminal capability cache\n"
     << "  --vgafont                 "
     << "    Set the standard vga 8x16 font\n"
     << "  --newfont                 "
@@ -617,6 +679,22 @@ void FApplication::showParameterUsage()
     << std::endl;  // newline character + flushes the output stream
 }
 
+//----------------------------------------------------------------------
+void FApplication::startRecording() const
+{
+  const auto& recorder = FTerm::getFSessionRecorder();
+  const auto& filename = getStartOptions().record_file;
+  const FSize term_size{FTerm::getColumnNumber(), FTerm::getLineNumber()};
+
+  if ( ! recorder->start(filename, term_size) )
+  {
+    const auto& fterm_data = FTerm::getFTermData();
+    fterm_data->setExitMessage ( "Could not open record file \""
+                               + filename + "\"" );
+    exit(EXIT_FAILURE);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::destroyLog()
 {
@@ -664,7 +742,14 @@ inline bool FApplication::isKeyPressed() const
   if ( mouse->isGpmMouseEnabled() )
     return mouse->getGpmKeyPressed(keyboard->hasUnprocessedInput());
 
-  return (keyboard->isKeyPressed() || keyboard->hasPendingInput());
+  // Waits only briefly for input while a terminal resize is pending
+  auto blocking_time = FKeyboard::getReadBlockingTime();
+
+  if ( FTerm::hasChangedTermSize() )
+    blocking_time = std::min(blocking_time, next_event_wait);
+
+  return ( keyboard->isKeyPressed(blocking_time)
+        || keyboard->hasPendingInput() );
 }
 
 //----------------------------------------------------------------------
@@ -691,6 +776,12 @@ void FApplication::mouseTracking() const
   performMouseAction();
 }
 
+//----------------------------------------------------------------------
+void FApplication::textPasted()
+{
+  performPasteAction();
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::performKeyboardAction()
 {
@@ -735,6 +826,36 @@ inline void FApplication::performMouseAction() const
   queuingMouseInput();
 }
 
+//----------------------------------------------------------------------
+inline void FApplication::performPasteAction()
+{
+  const auto& keyboard = FTerm::getFKeyboard();
+  const auto& text = keyboard->getPasteText();
+  FPasteEvent paste_ev (Event::Paste, text);
+  sendEvent (keyboard_widget, &paste_ev);
+
+  if ( paste_ev.isAccepted() )
+    return;
+
+  // The widget does not process pasted text, therefore each
+  // character is handled like a typed key. A pasted tab can move
+  // the focus, so the keyboard widget is determined for each key.
+  for (const auto& ch : text)
+  {
+    findKeyboardWidget();
+    keyboard->setKey (FKey(ch));
+    keyPressed();
+
+    if ( quit_now || internal::var::exit_loop )
+      return;
+
+    keyReleased();
+
+    if ( quit_now || internal::var::exit_loop )
+      return;
+  }
+}
+
 //----------------------------------------------------------------------
 void FApplication::mouseEvent (const FMouseData& md)
 {
@@ -917,29 +1038,23 @@ bool FApplication::processAccelerator (const FWidget& widget) const
   if ( widget.getAcceleratorList().empty() )
     return false;
 
-  for (auto&& item : widget.getAcceleratorList())
-  {
-    if ( item.key == FTerm::getFKeyboard()->getKey() )
-    {
-      // unset the move/size mode
-      auto move_size = getMoveSizeWidget();
+  auto target = widget.getAcceleratorTarget(FTerm::getFKeyboard()->getKey());
 
-      if ( move_size )
-      {
-        setMoveSizeWidget(nullptr);
-        move_size->redraw();
-      }
+  if ( ! target )
+    return false;
 
-      FAccelEvent a_ev (Event::Accelerator, getFocusWidget());
-      sendEvent (item.object, &a_ev);
-      return a_ev.isAccepted();
-    }
+  // unset the move/size mode
+  auto move_size = getMoveSizeWidget();
 
-    if ( quit_now || internal::var::exit_loop )
-      break;
+  if ( move_size )
+  {
+    setMoveSizeWidget(nullptr);
+    move_size->redraw();
   }
 
-  return false;
+  FAccelEvent a_ev (Event::Accelerator, getFocusWidget());
+  sendEvent (target, &a_ev);
+  return a_ev.isAccepted();
 }
 
 //----------------------------------------------------------------------
@@ -1245,17 +1360,20 @@ FWidget* FApplication::processParameters (const Args& args)
 //----------------------------------------------------------------------
 void FApplication::processResizeEvent() const
 {
-  if ( ! FTerm::hasChangedTermSize() )
+  // Several size changes within a frame lead to one relayout
+  if ( ! FTerm::hasChangedTermSize() || ! isFlushTimeout() )
     return;
 
+  // A size change during the relayout starts a new one
+  FTerm::changeTermSizeFinished();
   const auto& mouse = FTerm::getFMouseControl();
   mouse->setMaxWidth (uInt16(getDesktopWidth()));
   mouse->setMaxHeight (uInt16(getDesktopHeight()));
   FResizeEvent r_ev(Event::Resize);
   sendEvent(internal::var::app_object, &r_ev);
 
-  if ( r_ev.isAccepted() )
-    FTerm::changeTermSizeFinished();
+  if ( ! r_ev.isAccepted() )
+    FTerm::getFTermData()->setTermResized(true);  // Try again
 }
 
 //----------------------------------------------------------------------
@@ -1305,6 +1423,7 @@ bool FApplication::processNextEvent()
     processMouseEvent();
     processResizeEvent();
     processCloseWidget();
+    processDamage();
     processTerminalUpdate();  // after terminal changes
     flush();
     processLogger();
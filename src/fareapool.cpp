@@ -0,0 +1,181 @@
+/***********************************************************************
+* fareapool.cpp - Recycles the character buffers of terminal areas  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+#endif
+
+#include <cstdlib>
+#include <new>
+
+#include "final/fareapool.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+constexpr std::size_t MIN_BLOCK_SIZE = 256;
+constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+constexpr std::size_t MAX_FREE_BLOCKS = 4;  // Per size class
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FAreaPool
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FAreaPool::~FAreaPool()  // destructor
+{
+  clear();
+}
+
+
+// public methods of FAreaPool
+//----------------------------------------------------------------------
+std::size_t FAreaPool::getFreeBlockCount() const
+{
+  std::size_t count{0};
+
+  for (const auto& blocks : free_blocks)
+    count += blocks.size();
+
+  return count;
+}
+
+//----------------------------------------------------------------------
+std::size_t FAreaPool::getFreeBytes() const
+{
+  std::size_t bytes{0};
+
+  for (std::size_t index{0}; index < CLASS_COUNT; index++)
+    bytes += free_blocks[index].size() * (MIN_BLOCK_SIZE << index);
+
+  return bytes;
+}
+
+//----------------------------------------------------------------------
+std::size_t FAreaPool::getBlockSize (std::size_t size)
+{
+  // Rounds the size up to the next size class
+
+  std::size_t block_size{MIN_BLOCK_SIZE};
+
+  while ( block_size < size )
+    block_size <<= 1;
+
+  return block_size;
+}
+
+//----------------------------------------------------------------------
+void* FAreaPool::allocate (std::size_t size, std::size_t& block_size)
+{
+  // Returns a block of at least size bytes
+  // and stores the usable size in block_size
+
+  block_size = getBlockSize(size);
+  const auto index = getClassIndex(block_size);
+
+  if ( index < CLASS_COUNT && ! free_blocks[index].empty() )
+  {
+    void* block = free_blocks[index].back();
+    free_blocks[index].pop_back();
+    return block;
+  }
+
+  return allocateBlock(block_size);
+}
+
+//----------------------------------------------------------------------
+void FAreaPool::deallocate (void* block, std::size_t block_size)
+{
+  if ( ! block )
+    return;
+
+  const auto index = getClassIndex(block_size);
+
+  if ( index < CLASS_COUNT && free_blocks[index].size() < MAX_FREE_BLOCKS )
+    free_blocks[index].push_back(block);
+  else
+    freeBlock (block, block_size);
+}
+
+//----------------------------------------------------------------------
+void FAreaPool::clear()
+{
+  for (std::size_t index{0}; index < CLASS_COUNT; index++)
+  {
+    for (auto&& block : free_blocks[index])
+      freeBlock (block, MIN_BLOCK_SIZE << index);
+
+    free_blocks[index].clear();
+  }
+}
+
+
+// private methods of FAreaPool
+//----------------------------------------------------------------------
+std::size_t FAreaPool::getClassIndex (std::size_t block_size)
+{
+  std::size_t index{0};
+
+  while ( (MIN_BLOCK_SIZE << index) < block_size )
+    index++;
+
+  return index;
+}
+
+//----------------------------------------------------------------------
+void* FAreaPool::allocateBlock (std::size_t block_size)
+{
+  if ( block_size >= HUGE_PAGE_SIZE )
+  {
+    // Huge page aligned memory for large terminal areas
+    void* block{nullptr};
+
+    if ( posix_memalign(&block, HUGE_PAGE_SIZE, block_size) != 0 )
+      throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    madvise (block, block_size, MADV_HUGEPAGE);
+#endif
+
+    return block;
+  }
+
+  return ::operator new(block_size);
+}
+
+//----------------------------------------------------------------------
+void FAreaPool::freeBlock (void* block, std::size_t block_size)
+{
+  if ( block_size >= HUGE_PAGE_SIZE )
+    std::free (block);
+  else
+    ::operator delete(block);
+}
+
+}  // namespace finalcut
@@ -200,7 +200,7 @@ bool FButton::setDown (bool enable)
   if ( button_down != enable )
   {
     button_down = enable;
-    redraw();
+    invalidate();
   }
 
   return enable;
@@ -290,7 +290,7 @@ void FButton::onMouseDown (FMouseEvent* ev)
     setFocus();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
     if ( getStatusBar() )
       getStatusBar()->drawMessage();
@@ -354,12 +354,12 @@ void FButton::onAccel (FAccelEvent* ev)
     if ( focused_widget && focused_widget->isWidget() )
     {
       setFocus();
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
       if ( click_animation )
         setDown();
       else
-        redraw();
+        invalidate();
 
       if ( getStatusBar() )
         getStatusBar()->drawMessage();
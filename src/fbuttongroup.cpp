@@ -322,10 +322,10 @@ void FButtonGroup::onFocusIn (FFocusEvent* in_ev)
       focusLastChild();
 
     if ( prev_element )
-      prev_element->redraw();
+      prev_element->invalidate();
 
     if ( getFocusWidget() )
-      getFocusWidget()->redraw();
+      getFocusWidget()->invalidate();
   }
 
   if ( getStatusBar() )
@@ -458,12 +458,12 @@ bool FButtonGroup::directFocusCheckedRadioButton (FToggleButton* item) const
   item->setFocus();
 
   if ( focused_widget )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
   focused_widget = getFocusWidget();
 
   if ( focused_widget )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
   return true;
 }
@@ -494,12 +494,12 @@ void FButtonGroup::directFocus()
     focusFirstChild();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
     focused_widget = getFocusWidget();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
   }
 
   if ( getStatusBar() )
@@ -526,9 +526,9 @@ void FButtonGroup::focusCheckedRadioButton ( FToggleButton* toggle_button
     in_ev->accept();
 
   if ( prev_element )
-    prev_element->redraw();
+    prev_element->invalidate();
 
-  toggle_button->redraw();
+  toggle_button->invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -569,7 +569,7 @@ void FButtonGroup::cb_buttonToggled (const FToggleButton* button) const
       toggle_button->unsetChecked();
 
       if ( toggle_button->isShown() )
-        toggle_button->redraw();
+        toggle_button->invalidate();
     }
   }
 }
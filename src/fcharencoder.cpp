@@ -0,0 +1,204 @@
+/***********************************************************************
+* fcharencoder.cpp - Table-driven terminal character encoding          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <vector>
+
+#include "final/fc.h"
+#include "final/fcharencoder.h"
+#include "final/fcharmap.h"
+#include "final/fterm.h"
+#include "final/ftermdata.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FCharEncoder
+//----------------------------------------------------------------------
+
+// public methods of FCharEncoder
+//----------------------------------------------------------------------
+void FCharEncoder::invalidate()
+{
+  for (auto&& table : charset_table)
+    table.clear();
+
+  for (auto&& map : charset_map)
+    map.clear();
+
+  output_table.clear();
+  output_map.clear();
+}
+
+//----------------------------------------------------------------------
+wchar_t FCharEncoder::encode (wchar_t c, Encoding enc)
+{
+  const auto index = std::size_t(enc);
+
+  if ( index >= NUM_OF_ENCODINGS )
+    return c;
+
+  if ( charset_table[index].empty() )
+    buildCharsetTable(enc);
+
+  if ( std::size_t(c) < TABLE_SIZE )
+    return charset_table[index][std::size_t(c)];
+
+  const auto& map = charset_map[index];
+  const auto iter = map.find(c);
+
+  if ( iter != map.end() )
+    return iter->second;
+
+  // Not a cp437 character
+  return ( enc == Encoding::PC ) ? L'?' : c;
+}
+
+
+// private methods of FCharEncoder
+//----------------------------------------------------------------------
+void FCharEncoder::buildCharsetTable (Encoding enc)
+{
+  constexpr std::size_t CP437 = 0;
+  constexpr std::size_t UNICODE = 1;
+  const auto index = std::size_t(enc);
+  auto& table = charset_table[index];
+  auto& map = charset_map[index];
+  map.clear();
+
+  if ( enc == Encoding::PC )
+  {
+    // Unknown characters are replaced by '?'. A reverse pass
+    // keeps the first match of fc::cp437_ucs.
+    table.assign(TABLE_SIZE, L'?');
+
+    for (auto iter = fc::cp437_ucs.crbegin(); iter != fc::cp437_ucs.crend(); ++iter)
+    {
+      const auto ucs = std::size_t((*iter)[UNICODE]);
+
+      if ( ucs < TABLE_SIZE )
+        table[ucs] = (*iter)[CP437];
+    }
+  }
+  else
+  {
+    table.resize(TABLE_SIZE);
+
+    for (std::size_t ch{0}; ch < TABLE_SIZE; ch++)
+      table[ch] = wchar_t(ch);
+  }
+
+  // The first entry of fc::character wins
+  std::vector<bool> found(TABLE_SIZE, false);
+
+  for (auto&& entry : fc::character)
+  {
+    const auto ucs = entry.unicode;
+    wchar_t ch_enc = getCharacter(entry, enc);
+
+    if ( std::size_t(ucs) >= TABLE_SIZE )
+    {
+      if ( enc == Encoding::PC && ch_enc == ucs )
+        ch_enc = L'?';  // Not a cp437 character
+
+      map.emplace(ucs, ch_enc);
+      continue;
+    }
+
+    if ( found[std::size_t(ucs)] )
+      continue;
+
+    found[std::size_t(ucs)] = true;
+
+    // An unchanged PC character keeps its cp437 value
+    if ( enc != Encoding::PC || ch_enc != ucs )
+      table[std::size_t(ucs)] = ch_enc;
+  }
+}
+
+//----------------------------------------------------------------------
+void FCharEncoder::buildOutputTable (Encoding enc)
+{
+  output_table.resize(TABLE_SIZE);
+  output_map.clear();
+
+  for (std::size_t ch{0}; ch < TABLE_SIZE; ch++)
+    output_table[ch] = createOutputChar(wchar_t(ch), enc);
+
+  output_encoding = enc;
+}
+
+//----------------------------------------------------------------------
+const FCharEncoder::FOutputChar&
+    FCharEncoder::getOutputMapChar (wchar_t c, Encoding enc)
+{
+  const auto iter = output_map.find(c);
+
+  if ( iter != output_map.end() )
+    return iter->second;
+
+  return output_map.emplace(c, createOutputChar(c, enc)).first->second;
+}
+
+//----------------------------------------------------------------------
+FCharEncoder::FOutputChar FCharEncoder::createOutputChar ( wchar_t c
+                                                         , Encoding enc )
+{
+  FOutputChar out{c, c, false, false};
+  const wchar_t ch_enc = ( enc == Encoding::UTF8 ) ? c : encode(c, enc);
+
+  if ( ch_enc == 0 && c != 0 )
+  {
+    out.encoded = encode(c, Encoding::ASCII);
+  }
+  else if ( ch_enc != c )
+  {
+    out.encoded = ch_enc;
+
+    if ( enc == Encoding::VT100 )
+      out.alt_charset = true;
+    else if ( enc == Encoding::PC )
+    {
+      out.pc_charset = true;
+
+      if ( ! FTerm::isPuttyTerminal()
+        && FTerm::isXTerminal() && ch_enc < 0x20 )  // Character 0x00..0x1f
+      {
+        if ( FTerm::hasUTF8() )
+          out.encoded = encode(c, Encoding::ASCII);
+        else
+        {
+          out.encoded += 0x5f;
+          out.alt_charset = true;
+        }
+      }
+    }
+  }
+
+  // Character substitution
+  const auto& sub_map = FTerm::getFTermData()->getCharSubstitutionMap();
+  const auto iter = sub_map.find(out.encoded);
+  out.output = ( iter != sub_map.end() ) ? iter->second : out.encoded;
+  return out;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,278 @@
+/***********************************************************************
+* fcolorquantizer.cpp - Maps 24-bit colors to terminal palette colors  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "final/fcolorquantizer.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+constexpr std::size_t CUBE_SIZE = 32 * 32 * 32;  // 5 bits per channel
+constexpr uInt16 UNKNOWN = 0xffff;
+
+// Default RGB values of the 16 base colors in FColor order
+constexpr std::array<uInt32, 16> base_rgb =
+{{
+  0x000000, 0x0000aa, 0x00aa00, 0x00aaaa,
+  0xaa0000, 0xaa00aa, 0xaa5500, 0xaaaaaa,
+  0x555555, 0x5555ff, 0x55ff55, 0x55ffff,
+  0xff5555, 0xff55ff, 0xffff55, 0xffffff
+}};
+
+// Channel intensities of the xterm 6x6x6 color cube
+constexpr std::array<int, 6> cube_level = {{ 0, 95, 135, 175, 215, 255 }};
+
+//----------------------------------------------------------------------
+constexpr int red (uInt32 rgb)
+{
+  return int((rgb >> 16) & 0xff);
+}
+
+//----------------------------------------------------------------------
+constexpr int green (uInt32 rgb)
+{
+  return int((rgb >> 8) & 0xff);
+}
+
+//----------------------------------------------------------------------
+constexpr int blue (uInt32 rgb)
+{
+  return int(rgb & 0xff);
+}
+
+//----------------------------------------------------------------------
+inline int colorDistance (int r, int g, int b, uInt32 rgb)
+{
+  // Weighted Euclidean distance (the eye is most sensitive to green)
+  const int dr = r - red(rgb);
+  const int dg = g - green(rgb);
+  const int db = b - blue(rgb);
+  return 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+}
+
+//----------------------------------------------------------------------
+inline int findCubeLevel (int value)
+{
+  for (std::size_t i{0}; i < cube_level.size(); i++)
+    if ( cube_level[i] == value )
+      return int(i);
+
+  return -1;
+}
+
+//----------------------------------------------------------------------
+inline uInt8 clampChannel (int value)
+{
+  return uInt8(std::max(0, std::min(value, 255)));
+}
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FColorQuantizer
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FColorQuantizer::FColorQuantizer (uInt16 colors)
+  : color_count{colors}
+{ }
+
+
+// public methods of FColorQuantizer
+//----------------------------------------------------------------------
+uInt32 FColorQuantizer::getPaletteRGB (FColor color)
+{
+  const auto index = uInt16(color);
+
+  if ( index < 16 )
+    return base_rgb[index];
+
+  if ( index < 232 )  // 6x6x6 color cube
+  {
+    const auto n = std::size_t(index - 16);
+    return (uInt32(cube_level[n / 36]) << 16)
+         | (uInt32(cube_level[(n / 6) % 6]) << 8)
+         | uInt32(cube_level[n % 6]);
+  }
+
+  if ( index < 256 )  // Grayscale ramp
+  {
+    const auto level = uInt32(8 + (index - 232) * 10);
+    return (level << 16) | (level << 8) | level;
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizer::setColorCount (uInt16 colors)
+{
+  if ( colors == color_count )
+    return;
+
+  color_count = colors;
+  cube.clear();  // Cached values are no longer valid
+}
+
+//----------------------------------------------------------------------
+FColor FColorQuantizer::quantize (uInt32 rgb)
+{
+  const auto r = uInt32(red(rgb)) >> 3;
+  const auto g = uInt32(green(rgb)) >> 3;
+  const auto b = uInt32(blue(rgb)) >> 3;
+
+  if ( cube.empty() )
+    cube.assign(CUBE_SIZE, UNKNOWN);
+
+  auto& entry = cube[(r << 10) | (g << 5) | b];
+
+  if ( entry == UNKNOWN )  // Searches the center of the cube cell
+  {
+    entry = uInt16(findNearestColor ( int(r << 3) | 4
+                                    , int(g << 3) | 4
+                                    , int(b << 3) | 4 ));
+  }
+
+  return FColor(entry);
+}
+
+//----------------------------------------------------------------------
+std::vector<FColor> FColorQuantizer::dither ( const std::vector<uInt32>& block
+                                            , std::size_t width )
+{
+  // Floyd-Steinberg error diffusion of a block with the given width
+
+  std::vector<FColor> result{};
+
+  if ( width == 0 )
+    return result;
+
+  result.reserve(block.size());
+  // Accumulated errors (r, g, b) of the current and the next row
+  // with one cell of padding on each side
+  std::vector<int> error(3 * (width + 2), 0);
+  std::vector<int> next_error(3 * (width + 2), 0);
+
+  for (std::size_t pos{0}; pos < block.size(); pos++)
+  {
+    const std::size_t x = pos % width;
+
+    if ( x == 0 && pos > 0 )
+    {
+      error.swap(next_error);
+      std::fill (next_error.begin(), next_error.end(), 0);
+    }
+
+    const std::size_t e = 3 * (x + 1);
+    // The error values are scaled by 16
+    const int r = clampChannel(red(block[pos]) + error[e] / 16);
+    const int g = clampChannel(green(block[pos]) + error[e + 1] / 16);
+    const int b = clampChannel(blue(block[pos]) + error[e + 2] / 16);
+    const FColor color = quantize(uInt8(r), uInt8(g), uInt8(b));
+    result.push_back(color);
+    const uInt32 palette_rgb = getPaletteRGB(color);
+    const std::array<int, 3> diff = {{ r - red(palette_rgb)
+                                     , g - green(palette_rgb)
+                                     , b - blue(palette_rgb) }};
+
+    for (std::size_t c{0}; c < 3; c++)
+    {
+      error[e + 3 + c] += diff[c] * 7;       // Right
+      next_error[e - 3 + c] += diff[c] * 3;  // Bottom left
+      next_error[e + c] += diff[c] * 5;      // Bottom
+      next_error[e + 3 + c] += diff[c];      // Bottom right
+    }
+  }
+
+  return result;
+}
+
+//----------------------------------------------------------------------
+bool FColorQuantizer::findPaletteColor (uInt32 rgb, FColor& color)
+{
+  // Finds an exact match in the 256-color palette (16...255)
+
+  const int r = red(rgb);
+  const int g = green(rgb);
+  const int b = blue(rgb);
+  const int ri = findCubeLevel(r);
+  const int gi = findCubeLevel(g);
+  const int bi = findCubeLevel(b);
+
+  if ( ri >= 0 && gi >= 0 && bi >= 0 )
+  {
+    color = FColor(16 + ri * 36 + gi * 6 + bi);
+    return true;
+  }
+
+  if ( r == g && g == b && r >= 8 && r <= 238 && (r - 8) % 10 == 0 )
+  {
+    color = FColor(232 + (r - 8) / 10);
+    return true;
+  }
+
+  return false;
+}
+
+
+// private methods of FColorQuantizer
+//----------------------------------------------------------------------
+FColor FColorQuantizer::findNearestColor (int r, int g, int b) const
+{
+  uInt16 first{0};
+  uInt16 last{7};
+
+  if ( color_count >= 256 )
+  {
+    first = 16;
+    last = 255;
+  }
+  else if ( color_count >= 16 )
+    last = 15;
+
+  uInt16 nearest{first};
+  int min_distance{std::numeric_limits<int>::max()};
+
+  for (uInt16 index{first}; index <= last; index++)
+  {
+    const int distance = colorDistance(r, g, b, getPaletteRGB(FColor(index)));
+
+    if ( distance < min_distance )
+    {
+      min_distance = distance;
+      nearest = index;
+    }
+  }
+
+  return FColor(nearest);
+}
+
+}  // namespace finalcut
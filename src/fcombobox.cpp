@@ -157,7 +157,7 @@ bool FDropDownListBox::containsWidget (const FPoint& p)
 
   if ( getTermGeometry().contains(p) )
     return true;
-  else if ( parent && parent->isInstanceOf("FComboBox") )
+  else if ( parent && parent->isA<FComboBox>() )
     return static_cast<FComboBox*>(parent)->getTermGeometry().contains(p);
   else
     return false;
@@ -262,7 +262,7 @@ void FComboBox::setCurrentItem (std::size_t index)
 
   list_window.list.setCurrentItem(index);
   input_field = list_window.list.getItem(index).getText();
-  input_field.redraw();
+  input_field.invalidate();
   processChanged();
 }
 
@@ -295,7 +295,7 @@ void FComboBox::remove (std::size_t item)
   {
     const std::size_t index = list_window.list.currentItem();
     input_field = list_window.list.getItem(index).getText();
-    input_field.redraw();
+    input_field.invalidate();
   }
 
   if ( list_window.isShown() )
@@ -314,7 +314,7 @@ void FComboBox::clear()
 
   list_window.list.clear();
   input_field.clear();
-  redraw();
+  invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -344,7 +344,7 @@ void FComboBox::hideDropDown()
 
   list_window.hide();
   input_field.setFocus();
-  input_field.redraw();
+  input_field.invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -402,9 +402,9 @@ void FComboBox::onMouseDown (FMouseEvent* ev)
     setFocus();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
-    redraw();
+    invalidate();
 
     if ( getStatusBar() )
       getStatusBar()->drawMessage();
@@ -555,7 +555,7 @@ void FComboBox::onePosUp()
 
   list_window.list.setCurrentItem(index);
   input_field = list_window.list.getItem(index).getText();
-  input_field.redraw();
+  input_field.invalidate();
   processChanged();
 }
 
@@ -571,7 +571,7 @@ void FComboBox::onePosDown()
 
   list_window.list.setCurrentItem(index);
   input_field = list_window.list.getItem(index).getText();
-  input_field.redraw();
+  input_field.invalidate();
   processChanged();
 }
 
@@ -608,7 +608,7 @@ void FComboBox::cb_setInputField()
   auto& list = list_window.list;
   const std::size_t index = list.currentItem();
   input_field = list.getItem(index).getText();
-  input_field.redraw();
+  input_field.invalidate();
   processChanged();
 }
 
@@ -639,9 +639,9 @@ void FComboBox::cb_inputFieldSwitch()
       setFocus();
 
       if ( focused_widget )
-        focused_widget->redraw();
+        focused_widget->invalidate();
 
-      redraw();
+      invalidate();
 
       if ( getStatusBar() )
         getStatusBar()->drawMessage();
@@ -679,7 +679,7 @@ void closeOpenComboBox()
   if ( ! openmenu )
     return;
 
-  if ( openmenu->isInstanceOf("FDropDownListBox") )
+  if ( openmenu->isA<FDropDownListBox>() )
   {
     auto drop_down = static_cast<FDropDownListBox*>(openmenu);
     drop_down->hide();
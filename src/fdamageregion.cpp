@@ -0,0 +1,104 @@
+/***********************************************************************
+* fdamageregion.cpp - Collects and merges damaged screen rectangles *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include "final/fdamageregion.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+//----------------------------------------------------------------------
+inline std::size_t getArea (const FRect& r)
+{
+  return r.getWidth() * r.getHeight();
+}
+
+//----------------------------------------------------------------------
+inline bool isMergeable (const FRect& r1, const FRect& r2)
+{
+  if ( r1.overlap(r2) )
+    return true;
+
+  // Neighboring rectangles are merged if the bounding box
+  // does not contain more cells than both rectangles together
+  return getArea(r1.combined(r2)) <= getArea(r1) + getArea(r2);
+}
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FDamageRegion
+//----------------------------------------------------------------------
+
+// public methods of FDamageRegion
+//----------------------------------------------------------------------
+void FDamageRegion::add (const FRect& box)
+{
+  if ( getArea(box) == 0 )  // Also an empty intersection
+    return;
+
+  for (const auto& r : rects)
+    if ( r.contains(box) )  // Already damaged
+      return;
+
+  // Drops the rectangles covered by the new one
+  rects.erase ( std::remove_if ( rects.begin(), rects.end()
+                               , [&box] (const FRect& r)
+                                 {
+                                   return box.contains(r);
+                                 } )
+              , rects.end() );
+  rects.push_back(box);
+}
+
+//----------------------------------------------------------------------
+void FDamageRegion::merge()
+{
+  bool merged{true};
+
+  while ( merged )  // Repeat until nothing can be combined
+  {
+    merged = false;
+
+    for (std::size_t i{0}; i < rects.size(); i++)
+    {
+      for (std::size_t j{i + 1}; j < rects.size(); )
+      {
+        if ( isMergeable(rects[i], rects[j]) )
+        {
+          rects[i] = rects[i].combined(rects[j]);
+          rects.erase(rects.begin() + std::ptrdiff_t(j));
+          merged = true;
+        }
+        else
+          j++;
+      }
+    }
+  }
+}
+
+}  // namespace finalcut
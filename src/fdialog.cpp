@@ -437,10 +437,10 @@ void FDialog::activateDialog()
   if ( win_focus )
   {
     win_focus->setFocus();
-    win_focus->redraw();
+    win_focus->invalidate();
 
     if ( old_focus )
-      old_focus->redraw();
+      old_focus->invalidate();
   }
   else if ( old_focus )
   {
@@ -448,7 +448,7 @@ void FDialog::activateDialog()
       old_focus->unsetFocus();
 
     if ( ! old_focus->isWindowWidget() )
-      old_focus->redraw();
+      old_focus->invalidate();
   }
 
   if ( getStatusBar() )
@@ -718,7 +718,7 @@ void FDialog::onWindowActive (FEvent*)
       && win_focus->isShown() )
     {
       win_focus->setFocus();
-      win_focus->redraw();
+      win_focus->invalidate();
     }
     else
       focusFirstChild();
@@ -846,7 +846,7 @@ void FDialog::init()
   if ( old_focus )
   {
     setFocus();
-    old_focus->redraw();
+    old_focus->invalidate();
   }
 
   // Add the dialog menu
@@ -73,6 +73,32 @@ void FKeyEvent::ignore()
 { accpt = false; }
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+FPasteEvent::FPasteEvent (Event ev_type, const FString& txt)  // constructor
+  : FEvent{ev_type}
+  , text{txt}
+{ }
+
+//----------------------------------------------------------------------
+const FString& FPasteEvent::getText() const
+{ return text; }
+
+//----------------------------------------------------------------------
+bool FPasteEvent::isAccepted() const
+{ return accpt; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::accept()
+{ accpt = true; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::ignore()
+{ accpt = false; }
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
@@ -25,7 +25,12 @@
   #include <strings.h>    // need for strcasecmp
 #endif
 
+#include <fcntl.h>
+
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <iterator>
 #include <vector>
 
 #include "final/fevent.h"
@@ -35,6 +40,11 @@
 namespace finalcut
 {
 
+// Directory reader settings
+constexpr std::size_t DIR_READ_BATCH_SIZE = 1024;  // Entries per batch
+constexpr int DIR_READ_WAIT_TIME = 100;  // ms before a partial list is shown
+constexpr int DIR_READ_INTERVAL = 100;   // ms between the list updates
+
 // non-member functions
 //----------------------------------------------------------------------
 bool sortByName ( const FFileDialog::FDirEntry& lhs
@@ -120,6 +130,7 @@ FFileDialog::FFileDialog ( const FString& dirname
 //----------------------------------------------------------------------
 FFileDialog::~FFileDialog()  // destructor
 {
+  stopDirReader();
   clear();
 }
 
@@ -128,12 +139,12 @@ FFileDialog::~FFileDialog()  // destructor
 //----------------------------------------------------------------------
 FString FFileDialog::getSelectedFile() const
 {
-  const auto n = uLong(filebrowser.currentItem() - 1);
+  const std::size_t n = filebrowser.currentItem();
 
-  if ( dir_entries[n].directory )
+  if ( n == 0 || n > dir_entries.size() || dir_entries[n - 1].directory )
     return {""};
   else
-    return {dir_entries[n].name};
+    return {dir_entries[n - 1].name};
 }
 
 //----------------------------------------------------------------------
@@ -189,7 +200,7 @@ bool FFileDialog::setShowHiddenFiles (bool enable)
 
   show_hidden = enable;
   readDir();
-  filebrowser.redraw();
+  filebrowser.invalidate();
   return show_hidden;
 }
 
@@ -213,6 +224,53 @@ void FFileDialog::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FFileDialog::onTimer (FTimerEvent* ev)
+{
+  if ( ev->getTimerId() != read_timer )
+    return;
+
+  // Remember the selected entry
+  const std::size_t current = filebrowser.currentItem();
+  const std::size_t count = dir_entries.size();
+  std::string current_name{};
+
+  if ( current > 0 && current <= count )
+    current_name = dir_entries[current - 1].name;
+
+  if ( fetchDirEntries() )
+    finishReadDir();  // Replaces the list with the sorted entries
+  else if ( dir_entries.size() != count )
+    appendToList(count);  // Only the new entries
+  else
+    return;  // No new entries
+
+  if ( ! select_entry.empty() && current <= 1
+    && selectDirectoryEntry(select_entry.c_str()) )
+  {
+    select_entry.clear();
+    filename.invalidate();
+  }
+  else if ( read_timer == 0 && ! current_name.empty() )
+  {
+    // Select the same entry in the sorted list
+    const auto iter = std::find_if ( dir_entries.begin()
+                                   , dir_entries.end()
+                                   , [&current_name] (const FDirEntry& entry)
+                                     {
+                                       return entry.name == current_name;
+                                     }
+                                   );
+    const auto index = std::size_t(std::distance(dir_entries.begin(), iter));
+    filebrowser.setCurrentItem(index + 1);
+  }
+
+  if ( read_timer == 0 )
+    select_entry.clear();  // Reading completed
+
+  filebrowser.invalidate();
+}
+
 //----------------------------------------------------------------------
 FString FFileDialog::fileOpenChooser ( FWidget* parent
                                      , const FString& dirname
@@ -370,7 +428,8 @@ void FFileDialog::initCallbacks()
 
 //----------------------------------------------------------------------
 inline bool FFileDialog::patternMatch ( const char* const pattern
-                                      , const char fname[] ) const
+                                      , const char fname[]
+                                      , bool show_hidden )
 {
   std::array<char, 128> search{};
 
@@ -402,50 +461,31 @@ void FFileDialog::clear()
 }
 
 //----------------------------------------------------------------------
-sInt64 FFileDialog::numOfDirs()
+bool FFileDialog::sortDirEntries (const FDirEntry& lhs, const FDirEntry& rhs)
 {
-  if ( dir_entries.empty() )
-    return 0;
+  // ".." first, then the directories and the files sorted by name
 
-  const sInt64 n = std::count_if ( std::begin(dir_entries)
-                                 , std::end(dir_entries)
-                                 , [] (const FDirEntry& entry)
-                                   {
-                                     return entry.directory
-                                         && std::strcmp(entry.name.c_str(), ".") != 0;
-                                   }
-                                 );
-  return n;
-}
+  const bool lhs_parent = ( lhs.name == ".." );
+  const bool rhs_parent = ( rhs.name == ".." );
 
-//----------------------------------------------------------------------
-void FFileDialog::sortDir()
-{
-  sInt64 start{0};
+  if ( lhs_parent || rhs_parent )
+    return lhs_parent && ! rhs_parent;
 
-  if ( std::strcmp((*dir_entries.begin()).name.c_str(), "..") == 0 )
-    start = 1;
+  if ( sortDirFirst(lhs, rhs) )
+    return true;
+
+  if ( sortDirFirst(rhs, lhs) )
+    return false;
 
-  const sInt64 dir_num = numOfDirs();
-  // directories first
-  std::sort ( dir_entries.begin() + start
-            , dir_entries.end()
-            , sortDirFirst );
-  // sort directories by name
-  std::sort ( dir_entries.begin() + start
-            , dir_entries.begin() + dir_num
-            , sortByName );
-  // sort files by name
-  std::sort ( dir_entries.begin() + dir_num
-            , dir_entries.end()
-            , sortByName );
+  return sortByName(lhs, rhs);
 }
 
 //----------------------------------------------------------------------
 int FFileDialog::readDir()
 {
+  stopDirReader();
   const auto& dir = directory.c_str();
-  directory_stream = opendir(dir);
+  DIR* directory_stream = opendir(dir);
 
   if ( ! directory_stream )
   {
@@ -454,63 +494,139 @@ int FFileDialog::readDir()
   }
 
   clear();
-
-  while ( true )
+  const bool is_root = ( dir[0] == '/' && dir[1] == '\0' );
+  dir_reader.cancel = false;
+  dir_reader.done = false;
+  dir_reader.read_error = false;
+  dir_reader.close_error = false;
+  dir_reader.thread = std::thread ( readDirEntries
+                                  , std::ref(dir_reader)
+                                  , directory_stream
+                                  , filter_pattern.toString()
+                                  , show_hidden
+                                  , is_root );
+
+  // Wait a moment so that small directories appear completely
   {
-    errno = 0;
-    const struct dirent* next = readdir(directory_stream);
+    std::unique_lock<std::mutex> lock(dir_reader.mut);
+    dir_reader.cond.wait_for ( lock
+                             , std::chrono::milliseconds(DIR_READ_WAIT_TIME)
+                             , [this] { return dir_reader.done; } );
+  }
+
+  if ( fetchDirEntries() )
+    return finishReadDir();
+
+  // Show the entries read so far with a placeholder row
+  dirEntriesToList();
+  read_timer = addTimer(DIR_READ_INTERVAL);
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FFileDialog::readDirEntries ( FDirReader& reader
+                                 , DIR* directory_stream
+                                 , const std::string& filter
+                                 , bool show_hidden
+                                 , bool is_root )
+{
+  // Runs in the reader thread and passes the entries
+  // to the dialog in batches
+
+  const int dir_fd = dirfd(directory_stream);
+  DirEntries entries{};
+  bool read_error{false};
 
-    if ( next )
+  auto flush = [&reader, &entries] (bool last)
+  {
     {
-      // Continue if name = "." (current directory)
-      if ( next->d_name[0] == '.' && next->d_name[1] == '\0' )
-        continue;
-
-      // Skip hidden entries
-      if ( ! show_hidden
-        && next->d_name[0] == '.'
-        && next->d_name[1] != '\0'
-        && next->d_name[1] != '.' )
-        continue;
-
-      // Skip ".." for the root directory
-      if ( dir[0] == '/' && dir[1] == '\0'
-        && std::strcmp(next->d_name, "..") == 0  )
-        continue;
-
-      getEntry(dir, next);
+      std::lock_guard<std::mutex> lock_guard(reader.mut);
+
+      if ( ! reader.entries.empty() && ! last )
+        return;  // Keep on reading until the dialog has taken the entries
     }
-    else if ( errno != 0 )
-    {
-      FMessageBox::error (this, "Reading directory\n" + directory);
 
-      if ( errno == EOVERFLOW )  // Value too large to be stored in data type
-        break;
+    // The dialog appends the sorted batch to its list
+    std::sort (entries.begin(), entries.end(), sortDirEntries);
+    std::lock_guard<std::mutex> lock_guard(reader.mut);
+
+    if ( reader.entries.empty() )
+    {
+      reader.entries.swap(entries);
     }
     else
-      break;
-  }  // end while
+    {
+      DirEntries merged{};
+      merged.reserve(reader.entries.size() + entries.size());
+      std::merge ( std::make_move_iterator(reader.entries.begin())
+                 , std::make_move_iterator(reader.entries.end())
+                 , std::make_move_iterator(entries.begin())
+                 , std::make_move_iterator(entries.end())
+                 , std::back_inserter(merged)
+                 , sortDirEntries );
+      reader.entries.swap(merged);
+    }
+
+    entries.clear();
+  };
 
-  if ( closedir(directory_stream) != 0 )
+  while ( ! reader.cancel )
   {
-    FMessageBox::error (this, "Closing directory\n" + directory);
-    return -2;
+    errno = 0;
+    const struct dirent* next = readdir(directory_stream);
+
+    if ( ! next )
+    {
+      read_error = ( errno != 0 );
+      break;
+    }
+
+    // Continue if name = "." (current directory)
+    if ( next->d_name[0] == '.' && next->d_name[1] == '\0' )
+      continue;
+
+    // Skip hidden entries
+    if ( ! show_hidden
+      && next->d_name[0] == '.'
+      && next->d_name[1] != '\0'
+      && next->d_name[1] != '.' )
+      continue;
+
+    // Skip ".." for the root directory
+    if ( is_root && std::strcmp(next->d_name, "..") == 0  )
+      continue;
+
+    FDirEntry entry{};
+
+    if ( getEntry(dir_fd, next, filter, show_hidden, entry) )
+      entries.push_back (entry);
+
+    if ( entries.size() >= DIR_READ_BATCH_SIZE )
+      flush(false);
   }
 
-  sortDir();
+  if ( ! reader.cancel )
+    flush(true);
 
-  // Insert directory entries into the list
-  dirEntriesToList();
+  const bool close_error = ( closedir(directory_stream) != 0 );
 
-  return 0;
+  {
+    std::lock_guard<std::mutex> lock_guard(reader.mut);
+    reader.read_error = read_error;
+    reader.close_error = close_error;
+    reader.done = true;
+  }
+
+  reader.cond.notify_all();
 }
 
 //----------------------------------------------------------------------
-void FFileDialog::getEntry (const char* const dir, const struct dirent* d_entry)
+bool FFileDialog::getEntry ( int dir_fd
+                           , const struct dirent* d_entry
+                           , const std::string& filter
+                           , bool show_hidden
+                           , FDirEntry& entry )
 {
-  const auto& filter = filter_pattern.c_str();
-  FDirEntry entry{};
-
   entry.name = d_entry->d_name;
 
 #if defined _DIRENT_HAVE_D_TYPE || defined HAVE_STRUCT_DIRENT_D_TYPE
@@ -523,7 +639,7 @@ void FFileDialog::getEntry (const char* const dir, const struct dirent* d_entry)
   entry.socket           = (d_entry->d_type & DT_SOCK) == DT_SOCK;
 #else
   struct stat s{};
-  stat (entry.name.c_str(), &s);
+  fstatat (dir_fd, d_entry->d_name, &s, AT_SYMLINK_NOFOLLOW);
   entry.fifo             = S_ISFIFO (s.st_mode);
   entry.character_device = S_ISCHR (s.st_mode);
   entry.directory        = S_ISDIR (s.st_mode);
@@ -533,44 +649,107 @@ void FFileDialog::getEntry (const char* const dir, const struct dirent* d_entry)
   entry.socket           = S_ISSOCK (s.st_mode);
 #endif
 
-  followSymLink (dir, entry);
+  followSymLink (dir_fd, entry);
 
-  if ( entry.directory )
-    dir_entries.push_back (entry);
-  else if ( patternMatch(filter, entry.name.c_str()) )
-    dir_entries.push_back (entry);
-  else
-    entry.name.clear();
+  return entry.directory
+      || patternMatch(filter.c_str(), entry.name.c_str(), show_hidden);
 }
 
 //----------------------------------------------------------------------
-void FFileDialog::followSymLink (const char* const dir, FDirEntry& entry) const
+void FFileDialog::followSymLink (int dir_fd, FDirEntry& entry)
 {
   if ( ! entry.symbolic_link )
     return;  // No symbolic link
 
-  std::array<char, MAXPATHLEN> resolved_path{};
-  std::array<char, MAXPATHLEN> symLink{};
   struct stat sb{};
 
-  const auto& fsystem = FTerm::getFSystem();
-  std::strncpy (symLink.data(), dir, symLink.size() - 1);
-  symLink[symLink.size() - 1] = '\0';
-  std::strncat ( symLink.data()
-               , entry.name.c_str()
-               , symLink.size() - std::strlen(symLink.data()) - 1);
-  symLink[symLink.size() - 1] = '\0';
-
-  if ( fsystem->realpath(symLink.data(), resolved_path.data()) == nullptr )
+  // fstatat() without AT_SYMLINK_NOFOLLOW gets the link target status
+  if ( fstatat(dir_fd, entry.name.c_str(), &sb, 0) == -1 )
     return;  // Cannot follow the symlink
 
-  if ( lstat(resolved_path.data(), &sb) == -1 )
-    return;  // Cannot get file status
-
   if ( S_ISDIR(sb.st_mode) )
     entry.directory = true;
 }
 
+//----------------------------------------------------------------------
+void FFileDialog::stopDirReader()
+{
+  // Cancels a running directory reader
+
+  if ( read_timer )
+  {
+    delTimer(read_timer);
+    read_timer = 0;
+  }
+
+  if ( dir_reader.thread.joinable() )
+  {
+    dir_reader.cancel = true;
+    dir_reader.thread.join();
+  }
+
+  dir_reader.entries.clear();
+  select_entry.clear();
+}
+
+//----------------------------------------------------------------------
+bool FFileDialog::fetchDirEntries()
+{
+  // Appends the sorted batch of the reader thread to the entries
+  // and returns true when the directory has been read completely.
+  // All entries are sorted at the end, so that the list only grows
+  // at the bottom while the directory is read.
+
+  DirEntries entries{};
+  bool done{};
+
+  {
+    std::lock_guard<std::mutex> lock_guard(dir_reader.mut);
+    entries.swap(dir_reader.entries);
+    done = dir_reader.done;
+  }
+
+  dir_entries.insert ( dir_entries.end()
+                     , std::make_move_iterator(entries.begin())
+                     , std::make_move_iterator(entries.end()) );
+
+  if ( done && ! std::is_sorted ( dir_entries.begin()
+                                , dir_entries.end()
+                                , sortDirEntries ) )
+  {
+    std::sort (dir_entries.begin(), dir_entries.end(), sortDirEntries);
+  }
+
+  return done;
+}
+
+//----------------------------------------------------------------------
+int FFileDialog::finishReadDir()
+{
+  if ( dir_reader.thread.joinable() )
+    dir_reader.thread.join();
+
+  if ( read_timer )
+  {
+    delTimer(read_timer);
+    read_timer = 0;
+  }
+
+  // Insert directory entries into the list
+  dirEntriesToList();
+
+  if ( dir_reader.read_error )
+    FMessageBox::error (this, "Reading directory\n" + directory);
+
+  if ( dir_reader.close_error )
+  {
+    FMessageBox::error (this, "Closing directory\n" + directory);
+    return -2;
+  }
+
+  return 0;
+}
+
 //----------------------------------------------------------------------
 void FFileDialog::dirEntriesToList()
 {
@@ -578,23 +757,43 @@ void FFileDialog::dirEntriesToList()
 
   filebrowser.clear();
 
-  if ( dir_entries.empty() )
-    return;
-
   for (auto&& entry : dir_entries)
-  {
-    if ( entry.directory )
-      filebrowser.insert(FString{entry.name}, BracketType::Brackets);
-    else
-      filebrowser.insert(FString{entry.name});
-  }
+    insertListEntry(entry);
+
+  if ( dir_reader.thread.joinable() )
+    filebrowser.insert(FString{"Reading directory..."});  // Placeholder
+}
+
+//----------------------------------------------------------------------
+void FFileDialog::appendToList (std::size_t first)
+{
+  // Appends the entries from index first to the list while the
+  // directory is read. The selection and the scroll position
+  // remain unchanged.
+
+  for (auto i{first}; i < dir_entries.size(); i++)
+    insertListEntry(dir_entries[i]);
+
+  // Move the placeholder row behind the new entries
+  auto& items = filebrowser.getData();
+  const auto placeholder = items.begin() + std::ptrdiff_t(first);
+  std::rotate (placeholder, placeholder + 1, items.end());
+}
+
+//----------------------------------------------------------------------
+inline void FFileDialog::insertListEntry (const FDirEntry& entry)
+{
+  if ( entry.directory )
+    filebrowser.insert(FString{entry.name}, BracketType::Brackets);
+  else
+    filebrowser.insert(FString{entry.name});
 }
 
 //----------------------------------------------------------------------
-void FFileDialog::selectDirectoryEntry (const char* const name)
+bool FFileDialog::selectDirectoryEntry (const char* const name)
 {
   if ( dir_entries.empty() )
-    return;
+    return false;
 
   std::size_t i{1};
 
@@ -604,11 +803,13 @@ void FFileDialog::selectDirectoryEntry (const char* const name)
     {
       filebrowser.setCurrentItem(i);
       filename.setText(FString{name} + '/');
-      break;
+      return true;
     }
 
     i++;
   }
+
+  return false;
 }
 
 //----------------------------------------------------------------------
@@ -644,10 +845,13 @@ int FFileDialog::changeDir (const FString& dirname)
         else
         {
           auto baseName = basename(lastdir.c_str());
-          selectDirectoryEntry (baseName);
+
+          // Select the entry later if it has not been read yet
+          if ( ! selectDirectoryEntry(baseName) && read_timer )
+            select_entry = baseName;
         }
       }
-      else
+      else if ( ! dir_entries.empty() )
       {
         FString firstname{dir_entries[0].name};
 
@@ -658,8 +862,8 @@ int FFileDialog::changeDir (const FString& dirname)
       }
 
       printPath(directory);
-      filename.redraw();
-      filebrowser.redraw();
+      filename.invalidate();
+      filebrowser.invalidate();
       // fall through
     default:
       return 0;
@@ -708,13 +912,13 @@ void FFileDialog::cb_processActivate()
   {
     setFilter(filename.getText());
     readDir();
-    filebrowser.redraw();
+    filebrowser.invalidate();
   }
   else if ( filename.getText().getLength() == 0 )
   {
     setFilter("*");
     readDir();
-    filebrowser.redraw();
+    filebrowser.invalidate();
   }
   else if ( filename.getText().trim() == FString{".."}
          || filename.getText().includes('/')
@@ -754,8 +958,8 @@ void FFileDialog::cb_processRowChanged()
 {
   const std::size_t n = filebrowser.currentItem();
 
-  if ( n == 0 )
-    return;
+  if ( n == 0 || n > dir_entries.size() )
+    return;  // No entry or placeholder row
 
   const auto& name = FString{dir_entries[n - 1].name};
 
@@ -764,16 +968,19 @@ void FFileDialog::cb_processRowChanged()
   else
     filename.setText(name);
 
-  filename.redraw();
+  filename.invalidate();
 }
 
 //----------------------------------------------------------------------
 void FFileDialog::cb_processClicked()
 {
-  const auto n = uLong(filebrowser.currentItem() - 1);
+  const std::size_t n = filebrowser.currentItem();
 
-  if ( dir_entries[n].directory )
-    changeDir(dir_entries[n].name);
+  if ( n == 0 || n > dir_entries.size() )
+    return;  // No entry or placeholder row
+
+  if ( dir_entries[n - 1].directory )
+    changeDir(dir_entries[n - 1].name);
   else
     done (ResultCode::Accept);
 }
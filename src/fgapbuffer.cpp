@@ -0,0 +1,382 @@
+/***********************************************************************
+* fgapbuffer.cpp - Editable text with a movable gap                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cwctype>
+#include <string>
+
+#include "final/fgapbuffer.h"
+#include "final/fterm.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+//----------------------------------------------------------------------
+inline bool isWhitespace (const wchar_t ch) noexcept
+{
+  return std::iswspace(static_cast<wint_t>(ch));
+}
+
+//----------------------------------------------------------------------
+inline uInt8 getCharColumnWidth (const wchar_t ch)
+{
+  return uInt8(finalcut::getColumnWidth(ch));
+}
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FGapBuffer
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FGapBuffer::FGapBuffer (const FString& str)
+{
+  insert (0, str);
+}
+
+
+// public methods of FGapBuffer
+//----------------------------------------------------------------------
+std::size_t FGapBuffer::getColumnWidth (std::size_t end_pos) const
+{
+  // Returns the column width of the characters in front of end_pos
+
+  end_pos = std::min(end_pos, getLength());
+  std::size_t column_width{front_columns};
+
+  if ( end_pos <= gap_start )
+  {
+    for (std::size_t i{end_pos}; i < gap_start; i++)
+      column_width -= widths[i];
+  }
+  else
+  {
+    const auto end_index = getIndex(end_pos);
+
+    for (std::size_t i{gap_end}; i < end_index; i++)
+      column_width += widths[i];
+  }
+
+  return column_width;
+}
+
+//----------------------------------------------------------------------
+FString FGapBuffer::getString() const
+{
+  return getSubString (0, getLength());
+}
+
+//----------------------------------------------------------------------
+FString FGapBuffer::getSubString (std::size_t pos, std::size_t len) const
+{
+  const auto length = getLength();
+
+  if ( pos >= length || len == 0 )
+    return {L""};
+
+  const auto end_pos = pos + std::min(len, length - pos);
+  std::wstring str{};
+  str.reserve(end_pos - pos);
+
+  if ( pos < gap_start )
+  {
+    const auto front_end = std::min(end_pos, gap_start);
+    str.append (chars.data() + pos, front_end - pos);
+  }
+
+  if ( end_pos > gap_start )
+  {
+    const auto start_index = getIndex(std::max(pos, gap_start));
+    str.append (chars.data() + start_index, getIndex(end_pos) - start_index);
+  }
+
+  return {str};
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::setString (const FString& str)
+{
+  clear();
+  insert (0, str);
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::moveGap (std::size_t pos)
+{
+  // Moves the characters between the gap and pos to the other side
+
+  pos = std::min(pos, getLength());
+
+  if ( pos < gap_start )
+  {
+    const auto count = gap_start - pos;
+
+    for (std::size_t i{pos}; i < gap_start; i++)
+      front_columns -= widths[i];
+
+    std::move_backward ( chars.begin() + std::ptrdiff_t(pos)
+                       , chars.begin() + std::ptrdiff_t(gap_start)
+                       , chars.begin() + std::ptrdiff_t(gap_end) );
+    std::move_backward ( widths.begin() + std::ptrdiff_t(pos)
+                       , widths.begin() + std::ptrdiff_t(gap_start)
+                       , widths.begin() + std::ptrdiff_t(gap_end) );
+    gap_start -= count;
+    gap_end -= count;
+  }
+  else if ( pos > gap_start )
+  {
+    const auto count = pos - gap_start;
+
+    for (std::size_t i{gap_end}; i < gap_end + count; i++)
+      front_columns += widths[i];
+
+    std::move ( chars.begin() + std::ptrdiff_t(gap_end)
+              , chars.begin() + std::ptrdiff_t(gap_end + count)
+              , chars.begin() + std::ptrdiff_t(gap_start) );
+    std::move ( widths.begin() + std::ptrdiff_t(gap_end)
+              , widths.begin() + std::ptrdiff_t(gap_end + count)
+              , widths.begin() + std::ptrdiff_t(gap_start) );
+    gap_start += count;
+    gap_end += count;
+  }
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::insert (std::size_t pos, wchar_t ch)
+{
+  moveGap(pos);
+  reserveGap(1);
+  const auto width = getCharColumnWidth(ch);
+  chars[gap_start] = ch;
+  widths[gap_start] = width;
+  front_columns += width;
+  total_columns += width;
+  gap_start++;
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::insert (std::size_t pos, const FString& str)
+{
+  const auto len = str.getLength();
+
+  if ( len == 0 )
+    return;
+
+  moveGap(pos);
+  reserveGap(len);
+
+  for (const auto& ch : str)
+    insert (gap_start, ch);
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::overwrite (std::size_t pos, const FString& str)
+{
+  const auto length = getLength();
+  pos = std::min(pos, length);
+  remove (pos, std::min(str.getLength(), length - pos));
+  insert (pos, str);
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::remove (std::size_t pos, std::size_t len)
+{
+  const auto length = getLength();
+
+  if ( pos >= length || len == 0 )
+    return;
+
+  moveGap(pos);
+  len = std::min(len, length - pos);
+
+  for (std::size_t i{gap_end}; i < gap_end + len; i++)
+    total_columns -= widths[i];
+
+  gap_end += len;  // The gap swallows the removed characters
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::clear()
+{
+  // The allocated memory is kept for the next text
+  gap_start = 0;
+  gap_end = chars.size();
+  front_columns = 0;
+  total_columns = 0;
+}
+
+//----------------------------------------------------------------------
+void FGapBuffer::updateColumnWidths()
+{
+  // Recalculates all column widths (e.g. after a change of encoding)
+
+  front_columns = 0;
+  total_columns = 0;
+
+  for (std::size_t i{0}; i < chars.size(); i++)
+  {
+    if ( i >= gap_start && i < gap_end )
+      continue;
+
+    widths[i] = getCharColumnWidth(chars[i]);
+    total_columns += widths[i];
+
+    if ( i < gap_start )
+      front_columns += widths[i];
+  }
+}
+
+//----------------------------------------------------------------------
+int FGapBuffer::getCharLength (std::size_t pos) const
+{
+  // Gets the number of characters of the combined character
+  // at position pos
+
+  const std::size_t len = getLength();
+  std::size_t n = pos;
+
+  if ( isWhitespace((*this)[n]) )
+    return 1;
+
+  if ( getCharWidth(n) == 0 || n >= len )
+    return -1;
+
+  do
+  {
+    n++;
+  }
+  while ( n < len && getCharWidth(n) == 0 && ! isWhitespace((*this)[n]) );
+
+  return static_cast<int>(n - pos);
+}
+
+//----------------------------------------------------------------------
+int FGapBuffer::getPrevCharLength (std::size_t pos) const
+{
+  // Gets the number of characters of the previous combined character
+  // at position pos
+
+  const std::size_t len = getLength();
+  std::size_t n = pos;
+  const auto ch = (*this)[n];
+
+  if ( n == 0
+    || ((getCharWidth(n) == 0 || n >= len) && ! isWhitespace(ch)) )
+    return -1;
+
+  std::size_t char_width{0};
+
+  do
+  {
+    n--;
+    char_width = getCharWidth(n);
+  }
+  while ( n > 0 && char_width == 0 && ! isWhitespace((*this)[n]) );
+
+  if ( char_width == 0 )
+    return -1;
+
+  return int(pos - n);
+}
+
+//----------------------------------------------------------------------
+std::size_t FGapBuffer::searchLeftCharBegin (std::size_t pos) const
+{
+  // Search for the next character position to the left of position pos
+
+  std::size_t n = pos;
+
+  if ( n == 0 )
+    return NOT_FOUND;
+
+  std::size_t char_width{0};
+
+  do
+  {
+    n--;
+    char_width = getCharWidth(n);
+  }
+  while ( n > 0 && char_width == 0 && ! isWhitespace((*this)[n]) );
+
+  if ( n == 0 && char_width == 0 )
+    return NOT_FOUND;
+
+  return n;
+}
+
+//----------------------------------------------------------------------
+std::size_t FGapBuffer::searchRightCharBegin (std::size_t pos) const
+{
+  // Search for the next character position to the right of position pos
+
+  const std::size_t len = getLength();
+  std::size_t n = pos;
+
+  if ( n >= len )
+    return NOT_FOUND;
+
+  std::size_t char_width{0};
+
+  do
+  {
+    n++;
+    char_width = getCharWidth(n);
+  }
+  while ( n < len && char_width == 0 && ! isWhitespace((*this)[n]) );
+
+  if ( n == len && char_width == 0 )
+    return NOT_FOUND;
+
+  return n;
+}
+
+
+// private methods of FGapBuffer
+//----------------------------------------------------------------------
+void FGapBuffer::reserveGap (std::size_t len)
+{
+  // Enlarges the gap to at least len characters
+
+  if ( gap_end - gap_start >= len )
+    return;
+
+  const auto tail = chars.size() - gap_end;
+  const auto new_size = std::max ( 2 * chars.size()
+                                 , getLength() + len + MIN_GAP_SIZE );
+  chars.resize(new_size);
+  widths.resize(new_size);
+  std::move_backward ( chars.begin() + std::ptrdiff_t(gap_end)
+                     , chars.begin() + std::ptrdiff_t(gap_end + tail)
+                     , chars.end() );
+  std::move_backward ( widths.begin() + std::ptrdiff_t(gap_end)
+                     , widths.begin() + std::ptrdiff_t(gap_end + tail)
+                     , widths.end() );
+  gap_end = new_size - tail;
+}
+
+}  // namespace finalcut
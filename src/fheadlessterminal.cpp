@@ -0,0 +1,295 @@
+/***********************************************************************
+* fheadlessterminal.cpp - Terminal without a real tty                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <array>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "final/fheadlessterminal.h"
+#include "final/fkeyboard.h"
+#include "final/fobject.h"
+#include "final/fstartoptions.h"
+#include "final/fterm.h"
+#include "final/fvterm.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FHeadlessTerminal
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FHeadlessTerminal::FHeadlessTerminal (Profile term_profile, const FSize& size)
+  : screen{size}
+  , profile{term_profile}
+{
+  const char* term_env = std::getenv("TERM");
+
+  if ( term_env )
+  {
+    saved_term = term_env;
+    had_term = true;
+  }
+
+  setenv ("TERM", getTermType(profile), 1);
+  // Nobody answers the terminal queries
+  auto& start_options = FStartOptions::getFStartOptions();
+  saved_detection = start_options.terminal_detection;
+  start_options.terminal_detection = false;
+  openPseudoTerminal();
+  setWindowSize (size);
+}
+
+//----------------------------------------------------------------------
+FHeadlessTerminal::~FHeadlessTerminal() noexcept  // destructor
+{
+  closePseudoTerminal();
+  FStartOptions::getFStartOptions().terminal_detection = saved_detection;
+
+  if ( had_term )
+    setenv ("TERM", saved_term.c_str(), 1);
+  else
+    unsetenv ("TERM");
+}
+
+
+// public methods of FHeadlessTerminal
+//----------------------------------------------------------------------
+const char* FHeadlessTerminal::getTermType (Profile term_profile)
+{
+  switch ( term_profile )
+  {
+    case Profile::Linux:
+      return "linux";
+
+    case Profile::Vt100:
+      return "vt100";
+
+    default:
+      return "xterm-256color";
+  }
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminal::setSize (const FSize& size)
+{
+  // Resizes the terminal like a window manager
+
+  setWindowSize (size);
+  screen.setSize (size);
+  std::raise (SIGWINCH);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminal::setClock (const timeval& time)
+{
+  FObject::setFixedTime (time);
+  // Waiting for input in real time is pointless with a fixed time
+  FKeyboard::setReadBlockingTime (0);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminal::advanceClock (uInt64 usec)
+{
+  // Moves the fixed time forward (starts from the real time)
+
+  timeval time{};
+  FObject::getCurrentTime (&time);
+  const timeval step{ time_t(usec / 1000000), suseconds_t(usec % 1000000) };
+  FObject::setFixedTime (time + step);
+}
+
+//----------------------------------------------------------------------
+int FHeadlessTerminal::putchar (int c)
+{
+  screen.write (c);
+  return int(uChar(c));
+}
+
+//----------------------------------------------------------------------
+bool FHeadlessTerminal::sendInput (const std::string& input)
+{
+  // Writes keyboard or mouse input to the master side of the pty
+
+  if ( master_fd < 0 )
+    return false;
+
+  drainOutput();
+  std::size_t pos{0};
+
+  while ( pos < input.length() )
+  {
+    const auto bytes = ::write (master_fd, input.data() + pos, input.length() - pos);
+
+    if ( bytes < 0 )
+      return false;
+
+    pos += std::size_t(bytes);
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+FHeadlessTerminal& FHeadlessTerminal::install ( Profile term_profile
+                                              , const FSize& size )
+{
+  // Replaces the system interface of FTerm with a headless terminal.
+  // Must be called before the FApplication object is created.
+
+  std::unique_ptr<FSystem> fsys = make_unique<FHeadlessTerminal>(term_profile, size);
+  auto& terminal = static_cast<FHeadlessTerminal&>(*fsys);
+  FTerm::setFSystem(fsys);
+  return terminal;
+}
+
+//----------------------------------------------------------------------
+FPoint FHeadlessTerminal::findVTermDifference() const
+{
+  // Returns the first position (1-based) at which the character or
+  // the colors on the screen differ from the virtual terminal,
+  // or (0, 0) if both are equal. The colors match only with a
+  // profile that can display all colors of the application.
+
+  const auto* vterm = FVTerm::vterm;
+
+  if ( ! vterm )
+    return {};
+
+  if ( std::size_t(vterm->width) != screen.getWidth()
+    || std::size_t(vterm->height) != screen.getHeight() )
+    return {1, 1};
+
+  for (auto y{0}; y < vterm->height; y++)
+  {
+    for (auto x{0}; x < vterm->width; x++)
+    {
+      const auto& vch = vterm->data[y * vterm->width + x];
+
+      if ( vch.attr.bit.fullwidth_padding )
+        continue;
+
+      const FPoint pos{x + 1, y + 1};
+      const auto& sch = screen.getCharacter(pos);
+
+      if ( vch.ch[0] != sch.ch[0]
+        || vch.fg_color != sch.fg_color
+        || vch.bg_color != sch.bg_color )
+        return pos;
+    }
+  }
+
+  return {};
+}
+
+
+// private methods of FHeadlessTerminal
+//----------------------------------------------------------------------
+void FHeadlessTerminal::openPseudoTerminal()
+{
+  master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if ( master_fd < 0 )
+    return;
+
+  const char* slave_name{nullptr};
+  int slave_fd{-1};
+
+  if ( grantpt(master_fd) == 0 && unlockpt(master_fd) == 0 )
+    slave_name = ptsname(master_fd);
+
+  if ( slave_name )
+    slave_fd = ::open(slave_name, O_RDWR | O_NOCTTY);
+
+  if ( slave_fd < 0 )
+  {
+    ::close(master_fd);
+    master_fd = -1;
+    return;
+  }
+
+  // Output that bypasses FSystem is read and discarded
+  ::fcntl (master_fd, F_SETFL, ::fcntl(master_fd, F_GETFL) | O_NONBLOCK);
+  std::fflush(stdout);
+  saved_stdin = ::dup(STDIN_FILENO);
+  saved_stdout = ::dup(STDOUT_FILENO);
+  ::dup2 (slave_fd, STDIN_FILENO);
+  ::dup2 (slave_fd, STDOUT_FILENO);
+  ::close(slave_fd);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminal::closePseudoTerminal()
+{
+  if ( master_fd < 0 )
+    return;
+
+  std::fflush(stdout);
+  drainOutput();
+
+  if ( saved_stdin >= 0 )
+  {
+    ::dup2 (saved_stdin, STDIN_FILENO);
+    ::close(saved_stdin);
+  }
+
+  if ( saved_stdout >= 0 )
+  {
+    ::dup2 (saved_stdout, STDOUT_FILENO);
+    ::close(saved_stdout);
+  }
+
+  ::close(master_fd);
+  master_fd = -1;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminal::setWindowSize (const FSize& size) const
+{
+  if ( master_fd < 0 )
+    return;
+
+  struct winsize win_size{};
+  win_size.ws_col = uShort(size.getWidth());
+  win_size.ws_row = uShort(size.getHeight());
+  ::ioctl (master_fd, TIOCSWINSZ, &win_size);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminal::drainOutput() const
+{
+  std::array<char, 512> buffer{};
+
+  while ( ::read(master_fd, buffer.data(), buffer.size()) > 0 )
+    ;  // Discard the data
+}
+
+}  // namespace finalcut
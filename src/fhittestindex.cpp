@@ -0,0 +1,203 @@
+/***********************************************************************
+* fhittestindex.cpp - Spatial index for widget hit-testing             *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "final/fhittestindex.h"
+
+namespace finalcut
+{
+
+// static class attribute
+uInt64 FHitTestIndex::current_generation{1};
+
+//----------------------------------------------------------------------
+// class FHitTestIndex
+//----------------------------------------------------------------------
+
+// public methods of FHitTestIndex
+//----------------------------------------------------------------------
+void FHitTestIndex::clear()
+{
+  entries.clear();
+  spans.clear();
+  generation = 0;
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndex::insert (const FRect& geometry, FWidget* widget)
+{
+  if ( geometry.getX2() < geometry.getX1()
+    || geometry.getY2() < geometry.getY1() )
+    return;  // Nothing can be hit
+
+  entries.push_back({geometry, widget});
+}
+
+//----------------------------------------------------------------------
+bool FHitTestIndex::update (const FRect& geometry, const FWidget* widget)
+{
+  // Replaces the rectangle of widget and keeps its priority.
+  // Returns false if the index has to be built from scratch.
+
+  if ( generation != current_generation
+    || geometry.getX2() < geometry.getX1()
+    || geometry.getY2() < geometry.getY1() )
+    return false;
+
+  auto iter = std::find_if ( entries.begin(), entries.end()
+                           , [&widget] (const Entry& entry)
+                             {
+                               return entry.widget == widget;
+                             }
+                           );
+
+  if ( iter == entries.end() )
+    return false;
+
+  if ( iter->geometry != geometry )
+  {
+    iter->geometry = geometry;
+    buildSpans();
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndex::build (uInt64 local)
+{
+  buildSpans();
+  generation = current_generation;
+  local_generation = local;
+}
+
+//----------------------------------------------------------------------
+FWidget* FHitTestIndex::find (const FPoint& pos) const
+{
+  auto iter = std::upper_bound ( spans.begin(), spans.end(), pos.getY()
+                               , [] (int value, const Span& span)
+                                 {
+                                   return value < span.y1;
+                                 }
+                               );
+
+  if ( iter == spans.begin() )
+    return nullptr;  // Above all rectangles
+
+  --iter;
+  return findInRow (iter->row, pos.getX());
+}
+
+
+// private methods of FHitTestIndex
+//----------------------------------------------------------------------
+void FHitTestIndex::buildSpans()
+{
+  // A new span starts at every top border and below every bottom
+  // border, so that all rows of a span are hit by the same entries
+
+  std::vector<int> borders{};
+  borders.reserve(entries.size() * 2);
+
+  for (auto&& entry : entries)
+  {
+    borders.push_back(entry.geometry.getY1());
+    borders.push_back(entry.geometry.getY2() + 1);
+  }
+
+  std::sort (borders.begin(), borders.end());
+  borders.erase (std::unique(borders.begin(), borders.end()), borders.end());
+  spans.clear();
+  spans.reserve(borders.size());
+
+  for (const auto y : borders)
+    spans.push_back({y, {}});
+
+  for (std::size_t index{0}; index < entries.size(); index++)
+  {
+    const auto& geometry = entries[index].geometry;
+    auto iter = std::lower_bound ( spans.begin(), spans.end()
+                                 , geometry.getY1()
+                                 , [] (const Span& span, int value)
+                                   {
+                                     return span.y1 < value;
+                                   }
+                                 );
+
+    while ( iter != spans.end() && iter->y1 <= geometry.getY2() )
+    {
+      iter->row.push_back({geometry.getX1(), geometry.getX2(), index});
+      ++iter;
+    }
+  }
+
+  for (auto&& span : spans)
+  {
+    auto& row = span.row;
+    std::stable_sort ( row.begin(), row.end()
+                     , [] (const RowEntry& lhs, const RowEntry& rhs)
+                       {
+                         return lhs.x1 < rhs.x1;
+                       }
+                     );
+    int max_x2{std::numeric_limits<int>::min()};
+
+    for (auto&& entry : row)
+    {
+      max_x2 = std::max(max_x2, entry.max_x2);
+      entry.max_x2 = max_x2;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+FWidget* FHitTestIndex::findInRow (const RowList& row, int x) const
+{
+  // All candidates start at or before x. Walking backwards, the
+  // search ends as soon as no earlier entry reaches up to x.
+
+  auto iter = std::upper_bound ( row.begin(), row.end(), x
+                               , [] (int value, const RowEntry& entry)
+                                 {
+                                   return value < entry.x1;
+                                 }
+                               );
+  std::size_t found = entries.size();
+
+  while ( iter != row.begin() )
+  {
+    --iter;
+
+    if ( iter->max_x2 < x )
+      break;
+
+    if ( iter->index < found
+      && entries[iter->index].geometry.getX2() >= x )
+      found = iter->index;
+  }
+
+  return ( found < entries.size() ) ? entries[found].widget : nullptr;
+}
+
+}  // namespace finalcut
@@ -35,6 +35,7 @@
 #include "final/fkeyboard.h"
 #include "final/fkey_map.h"
 #include "final/fobject.h"
+#include "final/fsessionrecorder.h"
 #include "final/fterm.h"
 #include "final/ftermdetection.h"
 #include "final/ftermios.h"
@@ -46,6 +47,69 @@
 namespace finalcut
 {
 
+namespace
+{
+
+// End marker of a bracketed paste
+constexpr char paste_end[] = CSI "201~";
+constexpr std::size_t paste_end_length = sizeof(paste_end) - 1;
+
+//----------------------------------------------------------------------
+FKey decodeProtocolKey (uInt32 code, uInt32 modifiers)
+{
+  // Converts a key of the kitty keyboard protocol or of xterm's
+  // modifyOtherKeys into a key code (the lock modifiers are ignored)
+
+  const uInt32 mod_bits = ( modifiers > 0 ) ? modifiers - 1 : 0;
+  const bool shift = mod_bits & 0x01;
+  const bool alt   = mod_bits & 0x02;
+  const bool ctrl  = mod_bits & 0x04;
+
+  if ( code == 27 )
+    return FKey::Escape;
+
+  if ( code == 13 )
+    return alt ? FKey::Meta_enter : FKey::Return;
+
+  if ( code == 9 )
+  {
+    if ( shift )
+      return FKey::Back_tab;
+
+    return alt ? FKey::Meta_tab : FKey::Tab;
+  }
+
+  if ( code == 127 || code == 8 )
+    return FKey::Backspace;
+
+  if ( code >= 0xe000 && code <= 0xf8ff )
+    return FKey::None;  // Functional keys without a legacy encoding
+
+  if ( code < 0x20 || code > 0x7e )
+    return FKey(code);
+
+  if ( shift && code >= 'a' && code <= 'z' )
+    code -= 0x20;
+
+  if ( ctrl )
+  {
+    if ( code == ' ' || code == '@' || code == '2' )
+      return FKey::Ctrl_space;
+
+    const uInt32 upper = ( code >= 'a' && code <= 'z' ) ? code - 0x20 : code;
+
+    if ( upper >= '@' && upper <= '_' )
+      return FKey(upper & 0x1f);
+  }
+
+  if ( alt )
+    return FKey::Meta_offset + code;
+
+  return FKey(code);
+}
+
+}  // anonymous namespace
+
 // static class attributes
 uInt64 FKeyboard::key_timeout{100000};             // 100 ms  (10 Hz)
 uInt64 FKeyboard::read_blocking_time{100000};      // 100 ms  (10 Hz)
@@ -140,33 +204,17 @@ bool FKeyboard::isKeyPressed (uInt64 blocking_time)
   if ( has_pending_input )
     return false;
 
-  fd_set ifds{};
-  struct timeval tv{};
-  const int stdin_no = FTermios::getStdIn();
-
-  FD_ZERO(&ifds);
-  FD_SET(stdin_no, &ifds);
-  tv.tv_sec = tv.tv_usec = 0;  // Non-blocking input
-
   if ( blocking_time > 0
     && non_blocking_input_support
-    && select(stdin_no + 1, &ifds, nullptr, nullptr, &tv) > 0
-    && FD_ISSET(stdin_no, &ifds) )
+    && waitForInput(0) )  // Non-blocking input
   {
     return (has_pending_input = true);
   }
 
   if ( isKeypressTimeout() || ! non_blocking_input_support )
-    tv.tv_usec = suseconds_t(blocking_time);
+    has_pending_input = waitForInput(blocking_time);
   else
-    tv.tv_usec = suseconds_t(read_blocking_time_short);
-
-  if ( ! has_pending_input
-    && select(stdin_no + 1, &ifds, nullptr, nullptr, &tv) > 0
-    && FD_ISSET(stdin_no, &ifds) )
-  {
-    has_pending_input = true;
-  }
+    has_pending_input = waitForInput(read_blocking_time_short);
 
   return has_pending_input;
 }
@@ -190,6 +238,10 @@ void FKeyboard::clearKeyBufferOnTimeout()
 
   if ( fifo_in_use && isKeypressTimeout() )
     clearKeyBuffer();
+
+  // A paste without end marker is terminated after one second
+  if ( paste_mode && FObject::isTimeout(&time_keypressed, PASTE_TIMEOUT) )
+    finishPaste (paste_data.size());
 }
 
 //----------------------------------------------------------------------
@@ -223,7 +275,18 @@ void FKeyboard::processQueuedInput()
     key = fkey_queue.front();
     fkey_queue.pop();
 
-    if ( key > FKey::None )
+    if ( key == FKey::Bracketed_paste && ! paste_queue.empty() )
+    {
+      paste_text = std::move(paste_queue.front());
+      paste_queue.pop();
+      textPasted();
+      paste_text.clear();
+      key = FKey::None;
+
+      if ( FApplication::isQuit() )
+        return;
+    }
+    else if ( key > FKey::None )
     {
       keyPressed();
 
@@ -269,6 +332,77 @@ inline FKey FKeyboard::getMouseProtocolKey() const
   return NOT_SET;
 }
 
+//----------------------------------------------------------------------
+inline FKey FKeyboard::getKeyboardProtocolKey()
+{
+  // Looking for a key of the kitty keyboard protocol (CSI code;mods u)
+  // or of xterm's modifyOtherKeys (CSI 27;mods;code ~) in the buffer
+
+  assert ( FIFO_BUF_SIZE > 0 );
+
+  if ( fifo_buf[1] != '[' )
+    return NOT_SET;
+
+  std::array<uInt32, 3> param{{0, 0, 0}};
+  std::size_t count{1};
+  std::size_t len{2};
+
+  while ( len < FIFO_BUF_SIZE )
+  {
+    const auto ch = uChar(fifo_buf[len]);
+
+    if ( ch >= '0' && ch <= '9' )
+    {
+      if ( param[count - 1] < 0x110000 )
+        param[count - 1] = 10 * param[count - 1] + uInt32(ch - '0');
+    }
+    else if ( ch == ';' )
+    {
+      if ( count == param.size() )
+        return NOT_SET;
+
+      count++;
+    }
+    else if ( ch == ':' )  // Skip the sub-parameters
+    {
+      while ( len + 1 < FIFO_BUF_SIZE
+           && ( std::isdigit(uChar(fifo_buf[len + 1]))
+             || fifo_buf[len + 1] == ':' ) )
+        len++;
+    }
+    else
+      break;
+
+    len++;
+  }
+
+  if ( len == 2 || len >= FIFO_BUF_SIZE )
+    return NOT_SET;
+
+  FKey keycode{NOT_SET};
+  const auto final_byte = fifo_buf[len];
+
+  if ( final_byte == 'u' )
+    keycode = decodeProtocolKey (param[0], ( count > 1 ) ? param[1] : 1);
+  else if ( final_byte == '~' && count == 3 && param[0] == 27 )
+    keycode = decodeProtocolKey (param[2], param[1]);
+
+  if ( keycode == NOT_SET )
+    return NOT_SET;
+
+  len++;
+  std::size_t n{};
+
+  for (n = len; n < FIFO_BUF_SIZE; n++)  // Remove founded entry
+    fifo_buf[n - len] = fifo_buf[n];
+
+  for (n = n - len; n < FIFO_BUF_SIZE; n++)  // Fill rest with '\0'
+    fifo_buf[n] = '\0';
+
+  unprocessed_buffer_data = bool(fifo_buf[0] != '\0');
+  return keycode;
+}
+
 //----------------------------------------------------------------------
 inline FKey FKeyboard::getTermcapKey()
 {
@@ -444,6 +578,40 @@ FKey FKeyboard::UTF8decode (const char utf8[]) const
   return ucs;
 }
 
+//----------------------------------------------------------------------
+bool FKeyboard::waitForInput (uInt64 timeout)
+{
+  // Waits up to timeout microseconds for data on stdin.
+  // Data on the wakeup descriptor ends the waiting early.
+
+  fd_set ifds{};
+  struct timeval tv{};
+  const int stdin_no = FTermios::getStdIn();
+  FD_ZERO(&ifds);
+  FD_SET(stdin_no, &ifds);
+
+  if ( wakeup_fd >= 0 )
+    FD_SET(wakeup_fd, &ifds);
+
+  tv.tv_sec = time_t(timeout / 1000000);
+  tv.tv_usec = suseconds_t(timeout % 1000000);
+  const int max_fd = std::max(stdin_no, wakeup_fd);
+
+  if ( select(max_fd + 1, &ifds, nullptr, nullptr, &tv) < 1 )
+    return false;
+
+  if ( wakeup_fd >= 0 && FD_ISSET(wakeup_fd, &ifds) )
+  {
+    // Empty the pipe, the notifier keeps its own state
+    std::array<char, 64> buf{};
+
+    while ( read(wakeup_fd, buf.data(), buf.size()) > 0 )
+      continue;
+  }
+
+  return FD_ISSET(stdin_no, &ifds);
+}
+
 //----------------------------------------------------------------------
 inline ssize_t FKeyboard::readKey()
 {
@@ -458,12 +626,26 @@ void FKeyboard::parseKeyBuffer()
 {
   ssize_t bytesread{};
   FObject::getCurrentTime (&time_keypressed);
+  const auto& recorder = FTerm::getFSessionRecorder();
+  const bool recording = recorder->isRecording();
+  std::string recorded_input{};
 
   while ( (bytesread = readKey()) > 0 )
   {
     has_pending_input = false;
 
-    if ( bytesread + fifo_offset <= int(FIFO_BUF_SIZE) )
+    if ( recording )
+      recorded_input += read_character;
+
+    if ( paste_mode )
+    {
+      // Pasted text bypasses the key parser
+      readPasteData (recording ? &recorded_input : nullptr);
+
+      if ( paste_mode )
+        continue;
+    }
+    else if ( bytesread + fifo_offset <= int(FIFO_BUF_SIZE) )
     {
       fifo_buf[fifo_offset] = read_character;
       fifo_offset++;
@@ -475,6 +657,12 @@ void FKeyboard::parseKeyBuffer()
          && fifo_offset > 0
          && fkey != FKey::Incomplete )
     {
+      if ( isPasteStart() )
+      {
+        startPaste();
+        break;
+      }
+
       fkey = parseKeyString();
       fkey = keyCorrection(fkey);
 
@@ -500,6 +688,9 @@ void FKeyboard::parseKeyBuffer()
     if ( fkey_queue.size() >= MAX_QUEUE_SIZE )
       break;
   }
+
+  if ( recording )
+    recorder->recordInput (recorded_input);
 }
 
 //----------------------------------------------------------------------
@@ -511,6 +702,11 @@ FKey FKeyboard::parseKeyString()
   {
     FKey keycode = getMouseProtocolKey();
 
+    if ( keycode != NOT_SET )
+      return keycode;
+
+    keycode = getKeyboardProtocolKey();
+
     if ( keycode != NOT_SET )
       return keycode;
 
@@ -580,6 +776,127 @@ void FKeyboard::substringKeyHandling()
   }
 }
 
+//----------------------------------------------------------------------
+inline bool FKeyboard::isPasteStart() const
+{
+  // Bracketed paste mode encloses pasted text in ESC [ 200 ~ ... ESC [ 201 ~
+
+  return fifo_buf[0] == ESC[0] && std::strcmp(fifo_buf, CSI "200~") == 0;
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::startPaste()
+{
+  clearKeyBuffer();
+  paste_data.clear();
+  paste_mode = true;
+  unprocessed_buffer_data = false;
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::readPasteData (std::string* recorded_input)
+{
+  // Collects all immediately readable bytes of the pasted text
+  // until the end marker arrives
+
+  std::array<char, 4096> buffer{};
+  buffer[0] = read_character;
+  ssize_t bytes{1};
+  setNonBlockingInput();
+
+  while ( bytes > 0 )
+  {
+    const auto old_size = paste_data.size();
+    paste_data.append (buffer.data(), std::size_t(bytes));
+    const auto start = ( old_size > paste_end_length )
+                     ? old_size - paste_end_length
+                     : 0;
+    const auto pos = paste_data.find(paste_end, start);
+
+    if ( pos != std::string::npos )
+    {
+      finishPaste(pos);
+      break;
+    }
+
+    bytes = read(FTermios::getStdIn(), buffer.data(), buffer.size());
+
+    if ( bytes > 0 && recorded_input )
+      recorded_input->append (buffer.data(), std::size_t(bytes));
+  }
+
+  unsetNonBlockingInput();
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::finishPaste (std::size_t end)
+{
+  // The bytes after the end marker are keyboard input again
+
+  const auto rest = ( end + paste_end_length < paste_data.size() )
+                  ? paste_data.substr(end + paste_end_length)
+                  : std::string{};
+  paste_data.resize(end);
+  paste_mode = false;
+
+  if ( ! paste_data.empty() )
+  {
+    paste_queue.push(decodePasteData());
+    fkey_queue.push(FKey::Bracketed_paste);
+  }
+
+  paste_data.clear();
+  paste_data.shrink_to_fit();
+  const auto length = std::min(rest.size(), FIFO_BUF_SIZE - 1);
+  std::copy_n (rest.begin(), length, fifo_buf);
+  fifo_offset = int(length);
+  fifo_in_use = length > 0;
+  FObject::getCurrentTime (&time_keypressed);
+}
+
+//----------------------------------------------------------------------
+FString FKeyboard::decodePasteData() const
+{
+  std::wstring text{};
+  text.reserve(paste_data.size());
+  std::size_t pos{0};
+
+  while ( pos < paste_data.size() )
+  {
+    const auto ch = uChar(paste_data[pos]);
+    std::size_t len{1};
+
+    if ( utf8_input && (ch & 0xc0) == 0xc0 )
+    {
+      if ( (ch & 0xe0) == 0xc0 )
+        len = 2;
+      else if ( (ch & 0xf0) == 0xe0 )
+        len = 3;
+      else if ( (ch & 0xf8) == 0xf0 )
+        len = 4;
+    }
+
+    if ( len > 1 && pos + len <= paste_data.size() )
+    {
+      std::array<char, 5> utf8char{};  // Init array with '\0'
+      std::copy_n (paste_data.begin() + std::ptrdiff_t(pos), len, utf8char.begin());
+      const FKey ucs = UTF8decode(utf8char.data());
+
+      if ( ucs != NOT_SET )
+        text += wchar_t(ucs);
+    }
+    else
+    {
+      len = 1;
+      text += wchar_t(ch);
+    }
+
+    pos += len;
+  }
+
+  return FString{text};
+}
+
 //----------------------------------------------------------------------
 void FKeyboard::keyPressed() const
 {
@@ -604,4 +921,10 @@ void FKeyboard::mouseTracking() const
   mouse_tracking_cmd.execute();
 }
 
+//----------------------------------------------------------------------
+void FKeyboard::textPasted() const
+{
+  paste_cmd.execute();
+}
+
 }  // namespace finalcut
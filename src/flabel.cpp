@@ -191,9 +191,9 @@ void FLabel::onMouseDown (FMouseEvent* ev)
     accel_widget->setFocus();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
-    accel_widget->redraw();
+    accel_widget->invalidate();
 
     if ( getStatusBar() )
       accel_widget->getStatusBar()->drawMessage();
@@ -213,8 +213,8 @@ void FLabel::onAccel (FAccelEvent* ev)
     if ( focused_widget && focused_widget->isWidget() )
     {
       accel_widget->setFocus();
-      focused_widget->redraw();
-      accel_widget->redraw();
+      focused_widget->invalidate();
+      accel_widget->invalidate();
       FFocusEvent in (Event::FocusIn);
       FApplication::sendEvent(accel_widget, &in);
 
@@ -0,0 +1,283 @@
+/***********************************************************************
+* flineanalyzer.cpp - Finds the character runs of a terminal line      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "final/flineanalyzer.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+using ByteMask = std::array<uInt8, sizeof(FChar)>;
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+constexpr std::size_t BLOCK_SIZE = 16;
+#else
+constexpr std::size_t BLOCK_SIZE = 8;
+#endif
+
+constexpr std::size_t BLOCK_COUNT = (sizeof(FChar) + BLOCK_SIZE - 1) / BLOCK_SIZE;
+static_assert ( sizeof(FChar) >= BLOCK_SIZE
+              , "FChar is smaller than a mask block" );
+
+using MaskBlock = std::array<uInt8, BLOCK_SIZE>;
+using MaskBlocks = std::array<MaskBlock, BLOCK_COUNT>;
+
+//----------------------------------------------------------------------
+constexpr std::size_t getBlockOffset (std::size_t index)
+{
+  // The last block ends with the character,
+  // so that no load reads past the end of a character
+  return ( index * BLOCK_SIZE < sizeof(FChar) - BLOCK_SIZE )
+         ? index * BLOCK_SIZE
+         : sizeof(FChar) - BLOCK_SIZE;
+}
+
+//----------------------------------------------------------------------
+ByteMask getByteMask()
+{
+  // Marks the bits that operator == (const FChar&, const FChar&)
+  // compares. The encoded character, the print state and the
+  // padding bytes are not part of the comparison.
+
+  ByteMask byte_mask{};
+
+  const auto set = [&byte_mask] (std::size_t offset, std::size_t size)
+  {
+    std::fill_n (byte_mask.begin() + std::ptrdiff_t(offset), size, 0xff);
+  };
+
+  set (offsetof(FChar, ch), sizeof(FUnicode));
+  set (offsetof(FChar, fg_color), sizeof(FColor));
+  set (offsetof(FChar, bg_color), sizeof(FColor));
+  set (offsetof(FChar, fg_rgb), sizeof(uInt32));
+  set (offsetof(FChar, bg_rgb), sizeof(uInt32));
+  set (offsetof(FChar, attr), 2);  // Attribute byte #0 and #1
+  FChar padding_char{};
+  padding_char.attr.bit.fullwidth_padding = true;
+  byte_mask[offsetof(FChar, attr) + 2] = padding_char.attr.byte[2];
+  return byte_mask;
+}
+
+//----------------------------------------------------------------------
+MaskBlocks getMaskBlocks()
+{
+  // Splits the byte mask into blocks
+
+  const auto byte_mask = getByteMask();
+  MaskBlocks blocks{};
+  std::size_t pos{0};
+
+  for (std::size_t index{0}; index < BLOCK_COUNT; index++)
+  {
+    const auto offset = getBlockOffset(index);
+
+    // Bytes in front of pos belong to the previous block
+    for (auto i{pos}; i < offset + BLOCK_SIZE; i++)
+      blocks[index][i - offset] = byte_mask[i];
+
+    pos = offset + BLOCK_SIZE;
+  }
+
+  return blocks;
+}
+
+//----------------------------------------------------------------------
+const MaskBlocks& getMasks()
+{
+  static const auto mask_blocks = getMaskBlocks();
+  return mask_blocks;
+}
+
+//----------------------------------------------------------------------
+// class CharCompare
+//----------------------------------------------------------------------
+
+class CharCompare
+{
+  // Keeps the masks in registers while a line is compared
+
+  public:
+    CharCompare();
+    bool operator () (const FChar&, const FChar&) const;
+
+  private:
+#if defined(__SSE2__)
+    __m128i     mask[BLOCK_COUNT]{};
+#elif defined(__ARM_NEON)
+    uint8x16_t  mask[BLOCK_COUNT]{};
+#else
+    uInt64      mask[BLOCK_COUNT]{};
+#endif
+};
+
+//----------------------------------------------------------------------
+inline CharCompare::CharCompare()
+{
+  const auto& blocks = getMasks();
+
+  for (std::size_t i{0}; i < BLOCK_COUNT; i++)
+  {
+#if defined(__SSE2__)
+    mask[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[i].data()));
+#elif defined(__ARM_NEON)
+    mask[i] = vld1q_u8(blocks[i].data());
+#else
+    std::memcpy (&mask[i], blocks[i].data(), sizeof(mask[i]));
+#endif
+  }
+}
+
+//----------------------------------------------------------------------
+inline bool CharCompare::operator () ( const FChar& lhs
+                                     , const FChar& rhs ) const
+{
+  const auto l = reinterpret_cast<const uInt8*>(&lhs);
+  const auto r = reinterpret_cast<const uInt8*>(&rhs);
+
+#if defined(__SSE2__)
+  __m128i diff = _mm_setzero_si128();
+
+  for (std::size_t i{0}; i < BLOCK_COUNT; i++)
+  {
+    const auto offset = getBlockOffset(i);
+    const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + offset));
+    const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + offset));
+    diff = _mm_or_si128(diff, _mm_and_si128(_mm_xor_si128(a, b), mask[i]));
+  }
+
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xffff;
+#elif defined(__ARM_NEON)
+  uint8x16_t diff = vdupq_n_u8(0);
+
+  for (std::size_t i{0}; i < BLOCK_COUNT; i++)
+  {
+    const auto offset = getBlockOffset(i);
+    diff = vorrq_u8(diff, vandq_u8(veorq_u8(vld1q_u8(l + offset), vld1q_u8(r + offset)), mask[i]));
+  }
+
+  const auto words = vreinterpretq_u64_u8(diff);
+  return ( vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1) ) == 0;
+#else
+  uInt64 diff{0};
+
+  for (std::size_t i{0}; i < BLOCK_COUNT; i++)
+  {
+    const auto offset = getBlockOffset(i);
+    uInt64 a{};
+    uInt64 b{};
+    std::memcpy (&a, l + offset, sizeof(a));
+    std::memcpy (&b, r + offset, sizeof(b));
+    diff |= (a ^ b) & mask[i];
+  }
+
+  return diff == 0;
+#endif
+}
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FLineAnalyzer
+//----------------------------------------------------------------------
+
+// public methods of FLineAnalyzer
+//----------------------------------------------------------------------
+void FLineAnalyzer::analyze ( const FChar* line, uInt line_width
+                            , uInt first_column, uInt last_column )
+{
+  // Determines the runs of the columns from last_column
+  // to first_column
+
+  width = line_width;
+  first = std::min(first_column, line_width);
+  last = std::min(last_column, line_width - 1);
+  trailing_run = 0;
+
+  if ( ! line || width == 0 || first > last )
+  {
+    first = width;
+    return;
+  }
+
+  if ( equal_run.size() < width )
+  {
+    equal_run.resize(width);
+    unchanged_run.resize(width);
+  }
+
+  const CharCompare is_equal{};
+  uInt x = last;
+  uInt run{1};
+  uInt unchanged = line[x].attr.bit.no_changes ? 1 : 0;
+  equal_run[x] = run;
+  unchanged_run[x] = unchanged;
+
+  while ( x > first )
+  {
+    x--;
+    run = is_equal(line[x], line[x + 1]) ? run + 1 : 1;
+    unchanged = line[x].attr.bit.no_changes ? unchanged + 1 : 0;
+    equal_run[x] = run;
+    unchanged_run[x] = unchanged;
+  }
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzer::analyzeTrailingRun (const FChar* line, uInt line_width)
+{
+  // Determines the run of equal characters at the end of the line
+
+  trailing_run = 0;
+
+  if ( ! line || line_width == 0 )
+    return;
+
+  const CharCompare is_equal{};
+  uInt x = line_width - 1;
+
+  while ( x > 0 && is_equal(line[x - 1], line[x]) )
+    x--;
+
+  trailing_run = line_width - x;
+}
+
+//----------------------------------------------------------------------
+bool FLineAnalyzer::isEqual (const FChar& lhs, const FChar& rhs)
+{
+  return CharCompare{}(lhs, rhs);
+}
+
+}  // namespace finalcut
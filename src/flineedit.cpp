@@ -52,7 +52,6 @@ FLineEdit::FLineEdit (FWidget* parent)
 //----------------------------------------------------------------------
 FLineEdit::FLineEdit (const FString& txt, FWidget* parent)
   : FWidget{parent}
-  , text{txt}
   , label{new FLabel("", parent)}
 {
   init();
@@ -77,21 +76,21 @@ FLineEdit& FLineEdit::operator = (const FString& s)
 //----------------------------------------------------------------------
 FLineEdit& FLineEdit::operator << (UniChar c)
 {
-  setText(text + static_cast<wchar_t>(c));
+  appendText(FString{1, static_cast<wchar_t>(c)});
   return *this;
 }
 
 //----------------------------------------------------------------------
 FLineEdit& FLineEdit::operator << (const wchar_t c)
 {
-  setText(text + c);
+  appendText(FString{1, c});
   return *this;
 }
 
 //----------------------------------------------------------------------
 const FLineEdit& FLineEdit::operator >> (FString& s) const
 {
-  s += text;
+  s += text.getString();
   return *this;
 }
 
@@ -146,17 +145,10 @@ bool FLineEdit::setReadOnly (bool enable)
 //----------------------------------------------------------------------
 void FLineEdit::setText (const FString& txt)
 {
-  if ( txt )
-  {
-    if ( txt.getLength() > max_length )
-      text.setString(txt.left(max_length));
-    else
-      text.setString(txt);
-  }
+  if ( txt.getLength() > max_length )
+    text.setString(txt.left(max_length));
   else
-    text.setString("");
-
-  print_text = ( isPasswordField() ) ? getPasswordText() : text;
+    text.setString(txt);
 
   if ( isShown() )
   {
@@ -173,10 +165,7 @@ void FLineEdit::setMaxLength (std::size_t max)
   max_length = max;
 
   if ( text.getLength() > max_length )
-  {
-    text.setString(text.left(max_length));
-    print_text = ( isPasswordField() ) ? getPasswordText() : text;
-  }
+    text.remove(max_length, text.getLength() - max_length);
 
   if ( isShown() )
   {
@@ -287,7 +276,6 @@ void FLineEdit::clear()
   text_offset = 0;
   char_width_offset = 0;
   text.clear();
-  print_text.clear();
 }
 
 //----------------------------------------------------------------------
@@ -321,6 +309,22 @@ void FLineEdit::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FLineEdit::onPaste (FPasteEvent* ev)
+{
+  if ( isReadOnly() )
+    return;
+
+  // The whole text is inserted at once with only one redraw
+  if ( pasteInput(ev->getText()) )
+  {
+    drawInputField();
+    forceTerminalUpdate();
+  }
+
+  ev->accept();
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::onMouseDown (FMouseEvent* ev)
 {
@@ -333,9 +337,9 @@ void FLineEdit::onMouseDown (FMouseEvent* ev)
     setFocus();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
-    redraw();
+    invalidate();
 
     if ( getStatusBar() )
       getStatusBar()->drawMessage();
@@ -347,7 +351,7 @@ void FLineEdit::onMouseDown (FMouseEvent* ev)
 
   if ( mouse_x >= xmin && mouse_x <= int(getWidth()) && mouse_y == 1 )
   {
-    const std::size_t len = print_text.getLength();
+    const std::size_t len = text.getLength();
     cursor_pos = clickPosToCursorPos (std::size_t(mouse_x) - 2);
 
     if ( cursor_pos >= len )
@@ -378,7 +382,7 @@ void FLineEdit::onMouseMove (FMouseEvent* ev)
   if ( ev->getButton() != MouseButton::Left || isReadOnly() )
     return;
 
-  const std::size_t len = print_text.getLength();
+  const std::size_t len = text.getLength();
   const int mouse_x = ev->getX();
   const int mouse_y = ev->getY();
 
@@ -452,7 +456,7 @@ void FLineEdit::onWheel (FWheelEvent* ev)
 //----------------------------------------------------------------------
 void FLineEdit::onTimer (FTimerEvent*)
 {
-  const auto len = print_text.getLength();
+  const auto len = text.getLength();
 
   if ( drag_scroll == DragScrollMode::Leftward )
   {
@@ -500,8 +504,8 @@ void FLineEdit::onAccel (FAccelEvent* ev)
     if ( focused_widget && focused_widget->isWidget() )
     {
       setFocus();
-      focused_widget->redraw();
-      redraw();
+      focused_widget->invalidate();
+      invalidate();
 
       if ( getStatusBar() )
         getStatusBar()->drawMessage();
@@ -628,6 +632,8 @@ bool FLineEdit::hasHotkey() const
 //----------------------------------------------------------------------
 void FLineEdit::draw()
 {
+  text.updateColumnWidths();  // The encoding may have changed
+
   if ( cursor_pos == NOT_SET && ! isReadOnly() )
     cursorEnd();
 
@@ -720,10 +726,28 @@ void FLineEdit::drawInputField()
 //----------------------------------------------------------------------
 inline std::size_t FLineEdit::printTextField()
 {
-  const std::size_t text_offset_column = getColumnWidth (print_text, text_offset);
+  const std::size_t text_offset_column = text.getColumnWidth(text_offset);
   const std::size_t start_column = text_offset_column - char_width_offset + 1;
+  const std::size_t input_width = getWidth() - 2;
+  // Only the visible part of the text is copied. It starts one
+  // character earlier for a cut full-width character on the left.
+  const std::size_t first = ( text_offset > 0 ) ? text_offset - 1 : 0;
+  const std::size_t first_column = text.getColumnWidth(first);
+  const std::size_t column_pos = start_column - first_column;
+  const std::size_t end_column = column_pos + input_width;
+  const std::size_t len = text.getLength();
+  std::size_t last{first};
+  std::size_t column{0};
+
+  while ( last < len && column < end_column )
+  {
+    column += text.getCharWidth(last);
+    last++;
+  }
+
   const FString& show_text = \
-      getColumnSubString(print_text, start_column, getWidth() - 2);
+      getColumnSubString ( text.getSubString(first, last - first)
+                         , column_pos, input_width );
 
   if ( ! show_text.isEmpty() )
     print (show_text);
@@ -736,12 +760,15 @@ inline std::size_t FLineEdit::printTextField()
 inline std::size_t FLineEdit::printPassword()
 {
   const std::size_t text_offset_column = text_offset;
-  const FString show_text{print_text.mid(1 + text_offset, getWidth() - 2)};
+  const std::size_t len = text.getLength();
+  const std::size_t show_length = ( len > text_offset )
+                                ? std::min(len - text_offset, getWidth() - 2)
+                                : 0;
 
-  if ( ! show_text.isEmpty() )
-    print() << FString{show_text.getLength(), UniChar::Bullet};  // •
+  if ( show_length > 0 )
+    print() << FString{show_length, UniChar::Bullet};  // •
 
-  x_pos = show_text.getLength();
+  x_pos = show_length;
   return text_offset_column;
 }
 
@@ -750,7 +777,7 @@ inline std::size_t FLineEdit::getCursorColumnPos() const
 {
   if ( input_type == InputType::Textfield )
   {
-    return getColumnWidth (print_text, cursor_pos);
+    return text.getColumnWidth(cursor_pos);
   }
   else if ( input_type == InputType::Password )
   {
@@ -761,9 +788,23 @@ inline std::size_t FLineEdit::getCursorColumnPos() const
 }
 
 //----------------------------------------------------------------------
-inline FString FLineEdit::getPasswordText() const
+inline std::size_t FLineEdit::getColumnPos (std::size_t pos) const
 {
-  return {text.getLength(), UniChar::Bullet};  // •
+  // Password characters are displayed as bullets with a width of one
+
+  if ( isPasswordField() )
+    return std::min(pos, text.getLength());
+
+  return text.getColumnWidth(pos);
+}
+
+//----------------------------------------------------------------------
+inline std::size_t FLineEdit::getCharWidth (std::size_t pos) const
+{
+  if ( isPasswordField() )
+    return ( pos < text.getLength() ) ? 1 : 0;
+
+  return text.getCharWidth(pos);
 }
 
 //----------------------------------------------------------------------
@@ -777,24 +818,14 @@ inline FLineEdit::offsetPair FLineEdit::endPosToOffset (std::size_t pos)
 {
   std::size_t input_width = getWidth() - 2;
   std::size_t fullwidth_char_offset{0};
-  const std::size_t len = print_text.getLength();
+  const std::size_t len = text.getLength();
 
   if ( pos >= len )
     pos = len - 1;
 
   while ( pos > 0 && input_width > 0 )
   {
-    std::size_t char_width{};
-
-    try
-    {
-      char_width = getColumnWidth(print_text[pos]);
-    }
-    catch (const std::out_of_range& ex)
-    {
-      std::clog << FLog::LogLevel::Error
-                << "Out of Range error: " << ex.what() << std::endl;
-    }
+    const std::size_t char_width = getCharWidth(pos);
 
     if ( input_width >= char_width )
       input_width -= char_width;
@@ -804,21 +835,10 @@ inline FLineEdit::offsetPair FLineEdit::endPosToOffset (std::size_t pos)
 
     if ( input_width == 1)
     {
-      if ( char_width == 1 )
+      if ( char_width == 1 && getCharWidth(pos - 1) == 2 )  // pos is always > 0
       {
-        try
-        {
-          if ( getColumnWidth(print_text[pos - 1]) == 2 )  // pos is always > 0
-          {
-            fullwidth_char_offset = 1;
-            break;
-          }
-        }
-        catch (const std::out_of_range& ex)
-        {
-          std::clog << FLog::LogLevel::Error
-                    << "Out of Range error: " << ex.what() << std::endl;
-        }
+        fullwidth_char_offset = 1;
+        break;
       }
 
       if ( char_width == 2 )
@@ -839,23 +859,12 @@ std::size_t FLineEdit::clickPosToCursorPos (std::size_t pos)
 {
   std::size_t click_width{0};
   std::size_t idx = text_offset;
-  const std::size_t len = print_text.getLength();
+  const std::size_t len = text.getLength();
   pos -= char_width_offset;
 
   while ( click_width < pos && idx < len )
   {
-    std::size_t char_width{};
-
-    try
-    {
-      char_width = getColumnWidth(print_text[idx]);
-    }
-    catch (const std::out_of_range& ex)
-    {
-      std::clog << FLog::LogLevel::Error
-                << "Out of Range error: " << ex.what() << std::endl;
-    }
-
+    const std::size_t char_width = getCharWidth(idx);
     idx++;
     click_width += char_width;
 
@@ -869,46 +878,29 @@ std::size_t FLineEdit::clickPosToCursorPos (std::size_t pos)
 //----------------------------------------------------------------------
 void FLineEdit::adjustTextOffset()
 {
+  // The gap follows the cursor, so that the column calculations
+  // only have to walk over the characters around the cursor
+  text.moveGap(cursor_pos);
   const std::size_t input_width = getWidth() - 2;
-  const std::size_t len = print_text.getLength();
-  const std::size_t len_column = getColumnWidth (print_text);
-  std::size_t text_offset_column = getColumnWidth (print_text, text_offset);
-  const std::size_t cursor_pos_column = getColumnWidth (print_text, cursor_pos);
+  const std::size_t len = text.getLength();
+  const std::size_t len_column = getColumnPos(len);
+  std::size_t text_offset_column = getColumnPos(text_offset);
+  const std::size_t cursor_pos_column = getColumnPos(cursor_pos);
   std::size_t first_char_width{0};
   std::size_t cursor_char_width{1};
   char_width_offset = 0;
 
   if ( cursor_pos < len )
-  {
-    try
-    {
-      cursor_char_width = getColumnWidth(print_text[cursor_pos]);
-    }
-    catch (const std::out_of_range& ex)
-    {
-      std::clog << FLog::LogLevel::Error
-                << "Out of Range error: " << ex.what() << std::endl;
-    }
-  }
+    cursor_char_width = getCharWidth(cursor_pos);
 
   if ( len > 0 )
-  {
-    try
-    {
-      first_char_width = getColumnWidth(print_text[0]);
-    }
-    catch (const std::out_of_range& ex)
-    {
-      std::clog << FLog::LogLevel::Error
-                << "Out of Range error: " << ex.what() << std::endl;
-    }
-  }
+    first_char_width = getCharWidth(0);
 
   // Text alignment right for long lines
   while ( text_offset > 0 && len_column - text_offset_column < input_width )
   {
     text_offset--;
-    text_offset_column = getColumnWidth (print_text, text_offset);
+    text_offset_column -= getCharWidth(text_offset);
   }
 
   // Right cursor overflow
@@ -917,7 +909,7 @@ void FLineEdit::adjustTextOffset()
     const offsetPair offset_pair = endPosToOffset(cursor_pos);
     text_offset = offset_pair.first;
     char_width_offset = offset_pair.second;
-    text_offset_column = getColumnWidth (print_text, text_offset);
+    text_offset_column = getColumnPos(text_offset);
   }
 
   // Right full-width cursor overflow
@@ -935,14 +927,33 @@ void FLineEdit::adjustTextOffset()
     text_offset = cursor_pos;
 }
 
+//----------------------------------------------------------------------
+void FLineEdit::appendText (const FString& str)
+{
+  // Appends str to the end without copying the existing text
+
+  const auto len = text.getLength();
+
+  if ( len < max_length )
+    text.insert (len, str.left(max_length - len));
+
+  if ( isShown() )
+  {
+    if ( ! isReadOnly() )
+      cursorEnd();
+
+    adjustTextOffset();
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FLineEdit::cursorLeft()
 {
-  auto prev_char_len = getPrevCharLength(text, cursor_pos);
+  auto prev_char_len = text.getPrevCharLength(cursor_pos);
 
   if ( prev_char_len < 0 )
   {
-    const auto pos = searchLeftCharBegin(text, cursor_pos);
+    const auto pos = text.searchLeftCharBegin(cursor_pos);
 
     if ( pos != NOT_FOUND )
     {
@@ -964,11 +975,11 @@ inline void FLineEdit::cursorLeft()
 inline void FLineEdit::cursorRight()
 {
   const auto len = text.getLength();
-  const auto char_len = getCharLength(text, cursor_pos);
+  const auto char_len = text.getCharLength(cursor_pos);
 
   if ( char_len < 0 )
   {
-    const auto pos = searchRightCharBegin(text, cursor_pos);
+    const auto pos = text.searchRightCharBegin(cursor_pos);
 
     if ( pos != NOT_FOUND )
     {
@@ -1011,8 +1022,8 @@ inline void FLineEdit::deleteCurrentCharacter()
 {
   // Delete key functionality
 
-  const auto& len = text.getLength();
-  const auto char_len = getCharLength(text, cursor_pos);
+  const auto len = text.getLength();
+  const auto char_len = text.getCharLength(cursor_pos);
 
   if ( char_len < 0 )
     return;
@@ -1021,7 +1032,6 @@ inline void FLineEdit::deleteCurrentCharacter()
     && cursor_pos <= len - std::size_t(char_len) )
   {
     text.remove(cursor_pos, std::size_t(char_len));
-    print_text = ( isPasswordField() ) ? getPasswordText() : text;
     processChanged();
   }
 
@@ -1071,25 +1081,16 @@ inline bool FLineEdit::keyInput (FKey key)
 
   if ( key >= 0x20 && key <= 0x10fff )
   {
-    auto len = text.getLength();
     const auto ch = characterFilter(wchar_t(key));
 
     if ( ch == L'\0' )
       return false;
-    else if ( cursor_pos == len )
-      text += ch;
-    else if ( len > 0 )
-    {
-      if ( insert_mode )
-        text.insert(ch, cursor_pos);
-      else
-        text.overwrite(ch, cursor_pos);
-    }
-    else
-      text.setString(ch);
 
+    if ( ! insert_mode )
+      text.remove(cursor_pos, 1);  // Overwrites the current character
+
+    text.insert(cursor_pos, ch);
     cursor_pos++;
-    print_text = ( isPasswordField() ) ? getPasswordText() : text;
     adjustTextOffset();
     processChanged();
     return true;
@@ -1098,6 +1099,72 @@ inline bool FLineEdit::keyInput (FKey key)
     return false;
 }
 
+//----------------------------------------------------------------------
+bool FLineEdit::pasteInput (const FString& pasted_text)
+{
+  const auto len = text.getLength();
+
+  if ( len >= max_length )
+  {
+    FTerm::beep();
+    return false;
+  }
+
+  // Overwriting the existing text does not change the length
+  const auto max_input = ( insert_mode ) ? max_length - len
+                                         : max_length - cursor_pos;
+  const bool has_filter = ! input_filter.empty();
+  std::wregex filter{};  // Compiled only once for the whole text
+  std::wstring input{};
+
+  if ( has_filter )
+    filter.assign(input_filter);
+
+  const auto end = pasted_text.end();
+
+  for (auto iter = pasted_text.begin(); iter != end; ++iter)
+  {
+    auto ch = *iter;
+
+    if ( ch == L'\r' && iter + 1 != end && *(iter + 1) == L'\n' )
+      continue;  // CR LF becomes a single space
+
+    if ( ch == L'\t' || ch == L'\n' || ch == L'\r' )
+      ch = L' ';  // The input field has only one line
+    else if ( ch < L' ' || ch == L'\x7f' )
+      continue;
+
+    if ( has_filter )
+    {
+      const std::array<const wchar_t, 2> character{{ch, L'\0'}};
+
+      if ( ! regex_match(character.data(), filter) )
+        continue;
+    }
+
+    if ( input.length() == max_input )
+    {
+      FTerm::beep();
+      break;
+    }
+
+    input += ch;
+  }
+
+  if ( input.empty() )
+    return false;
+
+  if ( insert_mode )
+    text.insert(cursor_pos, input);
+  else
+    text.overwrite(cursor_pos, input);
+
+  cursor_pos += input.length();
+  adjustTextOffset();
+  processChanged();
+  return true;
+}
+
 //----------------------------------------------------------------------
 inline wchar_t FLineEdit::characterFilter (const wchar_t c) const
 {
@@ -1118,7 +1185,7 @@ void FLineEdit::processActivate()
   if ( ! hasFocus() )
   {
     setFocus();
-    redraw();
+    invalidate();
   }
 
   emitCallback("activate");
@@ -112,7 +112,7 @@ void FListBox::setCurrentItem (std::size_t index)
   yoffset = 0;
   adjustSize();
   vbar->setValue(yoffset);
-  redraw();
+  invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -794,9 +794,16 @@ void FListBox::drawList()
   }
 
   auto iter = index2iterator(start + std::size_t(yoffset));
+  const auto visible = getVisibleRect();
 
   for (std::size_t y = start; y < num && iter != itemlist.end() ; y++)
   {
+    if ( ! isVisibleLine(visible, 2 + int(y)) )  // Skip covered lines
+    {
+      ++iter;
+      continue;
+    }
+
     bool serach_mark{false};
     const bool lineHasBrackets = hasBrackets(iter);
 
@@ -1111,7 +1118,7 @@ inline void FListBox::getWidgetFocus()
   setFocus();
 
   if ( focused_widget )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
   if ( getStatusBar() )
     getStatusBar()->drawMessage();
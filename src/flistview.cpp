@@ -181,11 +181,11 @@ FListViewItem::FListViewItem (const FListViewItem& item)
   if ( ! parent )
     return;
 
-  if ( parent->isInstanceOf("FListView") )
+  if ( parent->isA<FListView>() )
   {
     static_cast<FListView*>(parent)->insert (this);
   }
-  else if ( parent->isInstanceOf("FListViewItem") )
+  else if ( parent->isA<FListViewItem>() )
   {
     static_cast<FListViewItem*>(parent)->insert (this);
   }
@@ -208,11 +208,11 @@ FListViewItem::~FListViewItem()  // destructor
   if ( ! parent )
     return;
 
-  if ( parent->isInstanceOf("FListView") )
+  if ( parent->isA<FListView>() )
   {
     static_cast<FListView*>(parent)->remove (this);
   }
-  else if ( parent->isInstanceOf("FListViewItem") )
+  else if ( parent->isA<FListViewItem>() )
   {
     static_cast<FListViewItem*>(parent)->remove (this);
   }
@@ -246,13 +246,10 @@ FString FListViewItem::getText (int column) const
 //----------------------------------------------------------------------
 uInt FListViewItem::getDepth() const
 {
-  const auto& parent = getParent();
+  const auto parent_item = dyn_cast<FListViewItem>(getParent());
 
-  if ( parent && parent->isInstanceOf("FListViewItem") )
-  {
-    const auto& parent_item = static_cast<FListViewItem*>(parent);
+  if ( parent_item )
     return parent_item->getDepth() + 1;
-  }
 
   return 0;
 }
@@ -269,7 +266,7 @@ void FListViewItem::setText (int column, const FString& text)
   const auto index = std::size_t(column - 1);
   auto parent = getParent();
 
-  if ( parent && parent->isInstanceOf("FListView") )
+  if ( parent && parent->isA<FListView>() )
   {
     auto listview = static_cast<FListView*>(parent);
 
@@ -304,13 +301,13 @@ FObject::iterator FListViewItem::insert ( FListViewItem* child
 
   if ( *parent_iter )
   {
-    if ( (*parent_iter)->isInstanceOf("FListView") )
+    if ( (*parent_iter)->isA<FListView>() )
     {
       // Add FListViewItem to a FListView parent
       auto parent = static_cast<FListView*>(*parent_iter);
       return parent->insert (child);
     }
-    else if ( (*parent_iter)->isInstanceOf("FListViewItem") )
+    else if ( (*parent_iter)->isA<FListViewItem>() )
     {
       // Add FListViewItem to a FListViewItem parent
       auto parent = static_cast<FListViewItem*>(*parent_iter);
@@ -330,7 +327,7 @@ void FListViewItem::remove (FListViewItem* item) const
   auto parent = item->getParent();
 
   // Search for a FListView parent in my object tree
-  while ( parent && ! parent->isInstanceOf("FListView") )
+  while ( parent && ! parent->isA<FListView>() )
   {
     parent = parent->getParent();
   }
@@ -338,7 +335,7 @@ void FListViewItem::remove (FListViewItem* item) const
   if ( parent == nullptr )
     return;
 
-  if ( parent->isInstanceOf("FListView") )
+  if ( parent->isA<FListView>() )
   {
     auto listview = static_cast<FListView*>(parent);
     listview->remove(item);
@@ -462,13 +459,10 @@ void FListViewItem::setCheckable (bool enable)
 void FListViewItem::resetVisibleLineCounter()
 {
   visible_lines = 0;
-  auto parent = getParent();
+  auto parent_item = dyn_cast<FListViewItem>(getParent());
 
-  if ( parent && parent->isInstanceOf("FListViewItem") )
-  {
-    auto parent_item = static_cast<FListViewItem*>(parent);
+  if ( parent_item )
     return parent_item->resetVisibleLineCounter();
-  }
 }
 
 
@@ -617,6 +611,15 @@ void FListViewIterator::parentElement()
 }
 
 
+//----------------------------------------------------------------------
+// class FListViewModel
+//----------------------------------------------------------------------
+
+// destructor
+//----------------------------------------------------------------------
+FListViewModel::~FListViewModel() noexcept = default;  // destructor
+
+
 //----------------------------------------------------------------------
 // class FListView
 //----------------------------------------------------------------------
@@ -639,6 +642,9 @@ FListView::~FListView()  // destructor
 //----------------------------------------------------------------------
 std::size_t FListView::getCount() const
 {
+  if ( model )
+    return model->getRowCount();
+
   int n{0};
 
   for (auto&& item : itemlist)
@@ -709,6 +715,19 @@ void FListView::setGeometry ( const FPoint& pos, const FSize& size
   changeOnResize();
 }
 
+//----------------------------------------------------------------------
+void FListView::setModel (FListViewModel* data_model)
+{
+  // Replaces the items with the rows of a data model.
+  // The model is not owned by the list view.
+
+  clear();
+  model = data_model;
+
+  if ( model )
+    reloadModel();
+}
+
 //----------------------------------------------------------------------
 void FListView::setColumnAlignment (int column, Align align)
 {
@@ -812,13 +831,13 @@ FObject::iterator FListView::insert ( FListViewItem* item
   }
   else if ( *parent_iter )
   {
-    if ( (*parent_iter)->isInstanceOf("FListView") )
+    if ( (*parent_iter)->isA<FListView>() )
     {
       // Add FListViewItem to a FListView parent
       auto parent = static_cast<FListView*>(*parent_iter);
       item_iter = parent->appendItem (item);
     }
-    else if ( (*parent_iter)->isInstanceOf("FListViewItem") )
+    else if ( (*parent_iter)->isA<FListViewItem>() )
     {
       // Add FListViewItem to a FListViewItem parent
       auto parent = static_cast<FListViewItem*>(*parent_iter);
@@ -908,6 +927,11 @@ void FListView::remove (FListViewItem* item)
 //----------------------------------------------------------------------
 void FListView::clear()
 {
+  // Removes all items and detaches the data model
+
+  model = nullptr;
+  current_row = 0;
+  first_row = 0;
   itemlist.clear();
   current_iter = getNullIterator();
   first_visible_line = getNullIterator();
@@ -918,7 +942,24 @@ void FListView::clear()
   vbar->setMinimum(0);
   vbar->setValue(0);
   vbar->hide();
-  clearList();
+
+  if ( isShown() )
+    clearList();
+}
+
+//----------------------------------------------------------------------
+void FListView::reloadModel()
+{
+  // Call this method after the rows of the model have changed
+
+  if ( ! model )
+    return;
+
+  adjustModelColumns();
+  adjustModelViewport();
+  const std::size_t element_count = getCount();
+  recalculateVerticalBar (element_count);
+  vbar->setValue (first_row);
 }
 
 //----------------------------------------------------------------------
@@ -929,6 +970,12 @@ void FListView::sort()
   if ( sort_column < 1 && sort_column > int(header.size()) )
     return;
 
+  if ( model )
+  {
+    sortModel();
+    return;
+  }
+
   SortType column_sort_type = getColumnSortType(sort_column);
   assert ( column_sort_type == SortType::Name
         || column_sort_type == SortType::Number
@@ -979,19 +1026,19 @@ void FListView::sort()
 //----------------------------------------------------------------------
 void FListView::onKeyPress (FKeyEvent* ev)
 {
-  const int position_before = current_iter.getPosition();
+  const int position_before = getCurrentPosition();
   const int xoffset_before = xoffset;
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
   clicked_expander_pos.setPoint(-1, -1);
   processKeyAction(ev);  // Process the keystrokes
 
-  if ( position_before != current_iter.getPosition() )
+  if ( position_before != getCurrentPosition() )
     processChanged();
 
   if ( ev->isAccepted() )
   {
     const bool draw_vbar( first_line_position_before
-                       != first_visible_line.getPosition() );
+                       != getFirstVisiblePosition() );
     const bool draw_hbar(xoffset_before != xoffset);
     updateDrawing (draw_vbar, draw_hbar);
   }
@@ -1012,7 +1059,7 @@ void FListView::onMouseDown (FMouseEvent* ev)
     setFocus();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
     if ( getStatusBar() )
       getStatusBar()->drawMessage();
@@ -1020,7 +1067,7 @@ void FListView::onMouseDown (FMouseEvent* ev)
 
   const int mouse_x = ev->getX();
   const int mouse_y = ev->getY();
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( mouse_x > 1 && mouse_x < int(getWidth()) )
   {
@@ -1030,18 +1077,18 @@ void FListView::onMouseDown (FMouseEvent* ev)
     }
     else if ( mouse_y > 1 && mouse_y < int(getHeight()) )  // List
     {
-      if ( itemlist.empty() )
+      if ( isEmpty() )
         return;
 
       int indent = 0;
-      const int new_pos = first_visible_line.getPosition() + mouse_y - 2;
+      const int new_pos = getFirstVisiblePosition() + mouse_y - 2;
 
       if ( new_pos < int(getCount()) )
         setRelativePosition (mouse_y - 2);
 
       const auto& item = getCurrentItem();
 
-      if ( tree_view )
+      if ( tree_view && item )
       {
         indent = int(item->getDepth() << 1);  // indent = 2 * depth
 
@@ -1049,7 +1096,7 @@ void FListView::onMouseDown (FMouseEvent* ev)
           clicked_expander_pos = ev->getPos();
       }
 
-      if ( hasCheckableItems() )
+      if ( hasCheckableItems() && item )
       {
         if ( tree_view )
           indent++;  // Plus one space
@@ -1065,9 +1112,9 @@ void FListView::onMouseDown (FMouseEvent* ev)
       if ( isShown() )
         drawList();
 
-      vbar->setValue (first_visible_line.getPosition());
+      vbar->setValue (getFirstVisiblePosition());
 
-      if ( first_line_position_before != first_visible_line.getPosition() )
+      if ( first_line_position_before != getFirstVisiblePosition() )
         vbar->drawBar();
 
       forceTerminalUpdate();
@@ -1094,13 +1141,13 @@ void FListView::onMouseUp (FMouseEvent* ev)
       }
       else if ( mouse_y > 1 && mouse_y < int(getHeight()) )  // List
       {
-        if ( itemlist.empty() )
+        if ( isEmpty() )
           return;
 
         int indent{0};
         const auto& item = getCurrentItem();
 
-        if ( tree_view )
+        if ( tree_view && item )
         {
           indent = int(item->getDepth() << 1);  // indent = 2 * depth
 
@@ -1119,7 +1166,7 @@ void FListView::onMouseUp (FMouseEvent* ev)
           }
         }
 
-        if ( hasCheckableItems() )
+        if ( hasCheckableItems() && item )
         {
           if ( tree_view )
             indent++;  // Plus one space
@@ -1156,12 +1203,12 @@ void FListView::onMouseMove (FMouseEvent* ev)
 
   const int mouse_x = ev->getX();
   const int mouse_y = ev->getY();
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( mouse_x > 1 && mouse_x < int(getWidth())
     && mouse_y > 1 && mouse_y < int(getHeight()) )
   {
-    const int new_pos = first_visible_line.getPosition() + mouse_y - 2;
+    const int new_pos = getFirstVisiblePosition() + mouse_y - 2;
 
     if ( new_pos < int(getCount()) )
       setRelativePosition (mouse_y - 2);
@@ -1169,9 +1216,9 @@ void FListView::onMouseMove (FMouseEvent* ev)
     if ( isShown() )
       drawList();
 
-    vbar->setValue (first_visible_line.getPosition());
+    vbar->setValue (getFirstVisiblePosition());
 
-    if ( first_line_position_before != first_visible_line.getPosition() )
+    if ( first_line_position_before != getFirstVisiblePosition() )
       vbar->drawBar();
 
     forceTerminalUpdate();
@@ -1198,15 +1245,15 @@ void FListView::onMouseDoubleClick (FMouseEvent* ev)
   if ( mouse_x > 1 && mouse_x < int(getWidth())
     && mouse_y > 1 && mouse_y < int(getHeight()) )
   {
-    if ( first_visible_line.getPosition() + mouse_y - 1 > int(getCount()) )
+    if ( getFirstVisiblePosition() + mouse_y - 1 > int(getCount()) )
       return;
 
-    if ( itemlist.empty() )
+    if ( isEmpty() )
       return;
 
     auto item = getCurrentItem();
 
-    if ( tree_view && item->isExpandable() )
+    if ( tree_view && item && item->isExpandable() )
     {
       if ( item->isExpand() )
         item->collapse();
@@ -1228,8 +1275,8 @@ void FListView::onMouseDoubleClick (FMouseEvent* ev)
 //----------------------------------------------------------------------
 void FListView::onTimer (FTimerEvent*)
 {
-  const int position_before = current_iter.getPosition();
-  first_line_position_before = first_visible_line.getPosition();
+  const int position_before = getCurrentPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( ( drag_scroll == DragScrollMode::Upward
       || drag_scroll == DragScrollMode::SelectUpward )
@@ -1247,9 +1294,9 @@ void FListView::onTimer (FTimerEvent*)
   if ( isShown() )
     drawList();
 
-  vbar->setValue (first_visible_line.getPosition());
+  vbar->setValue (getFirstVisiblePosition());
 
-  if ( first_line_position_before != first_visible_line.getPosition() )
+  if ( first_line_position_before != getFirstVisiblePosition() )
     vbar->drawBar();
 
   forceTerminalUpdate();
@@ -1258,9 +1305,9 @@ void FListView::onTimer (FTimerEvent*)
 //----------------------------------------------------------------------
 void FListView::onWheel (FWheelEvent* ev)
 {
-  const int position_before = current_iter.getPosition();
+  const int position_before = getCurrentPosition();
   static constexpr int wheel_distance = 4;
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( drag_scroll != DragScrollMode::None )
     stopDragScroll();
@@ -1270,15 +1317,15 @@ void FListView::onWheel (FWheelEvent* ev)
   else if ( ev->getWheel() == MouseWheel::Down )
     wheelDown (wheel_distance);
 
-  if ( position_before != current_iter.getPosition() )
+  if ( position_before != getCurrentPosition() )
     processChanged();
 
   if ( isShown() )
     drawList();
 
-  vbar->setValue (first_visible_line.getPosition());
+  vbar->setValue (getFirstVisiblePosition());
 
-  if ( first_line_position_before != first_visible_line.getPosition() )
+  if ( first_line_position_before != getFirstVisiblePosition() )
     vbar->drawBar();
 
   forceTerminalUpdate();
@@ -1308,6 +1355,12 @@ void FListView::onFocusOut (FFocusEvent*)
 //----------------------------------------------------------------------
 void FListView::adjustViewport (const int element_count)
 {
+  if ( model )
+  {
+    adjustModelViewport();
+    return;
+  }
+
   const auto height = int(getClientHeight());
 
   if ( height <= 0 || element_count == 0 )
@@ -1400,6 +1453,18 @@ FObject::iterator& FListView::getNullIterator()
   return null_iter;
 }
 
+//----------------------------------------------------------------------
+int FListView::getCurrentPosition()
+{
+  return model ? current_row : current_iter.getPosition();
+}
+
+//----------------------------------------------------------------------
+int FListView::getFirstVisiblePosition()
+{
+  return model ? first_row : first_visible_line.getPosition();
+}
+
 //----------------------------------------------------------------------
 void FListView::setNullIterator (const iterator& null_iter)
 {
@@ -1502,7 +1567,7 @@ FObject::iterator FListView::getListEnd (const FListViewItem* item)
 
   if ( this == parent )
     return itemlist.end();
-  else if ( parent->isInstanceOf("FListViewItem") )
+  else if ( parent->isA<FListViewItem>() )
     return static_cast<FListViewItem*>(parent)->end();
   else
     return getNullIterator();
@@ -1604,6 +1669,12 @@ void FListView::drawHeadlines()
 //----------------------------------------------------------------------
 void FListView::drawList()
 {
+  if ( model )
+  {
+    drawModelList();
+    return;
+  }
+
   if ( itemlist.empty() || getHeight() <= 2 || getWidth() <= 4 )
     return;
 
@@ -1612,6 +1683,7 @@ void FListView::drawList()
   const auto& itemlist_end = itemlist.end();
   auto path_end = itemlist_end;
   auto iter = first_visible_line;
+  const auto visible = getVisibleRect();
 
   while ( iter != path_end && iter != itemlist_end && y < page_height )
   {
@@ -1620,10 +1692,13 @@ void FListView::drawList()
     const int tree_offset = tree_view ? int(item->getDepth() << 1) + 1 : 0;
     const int checkbox_offset = item->isCheckable() ? 1 : 0;
     path_end = getListEnd(item);
-    print() << FPoint{2, 2 + int(y)};
 
-    // Draw one FListViewItem
-    drawListLine (item, getFlags().focus, is_current_line);
+    // Draw one FListViewItem (skip covered lines)
+    if ( isVisibleLine(visible, 2 + int(y)) )
+    {
+      print() << FPoint{2, 2 + int(y)};
+      drawListLine (item, getFlags().focus, is_current_line);
+    }
 
     if ( getFlags().focus && is_current_line )
     {
@@ -1641,19 +1716,50 @@ void FListView::drawList()
     ++iter;
   }
 
-  // Reset color
-  setColor();
+  clearEmptyLines(y);
+}
 
-  if ( FTerm::isMonochron() )
-    setReverse(true);
+//----------------------------------------------------------------------
+void FListView::drawModelList()
+{
+  // Only the visible rows are requested from the model
 
-  // Clean empty space after last element
-  while ( y < uInt(getClientHeight()) )
+  if ( getHeight() <= 2 || getWidth() <= 4 )
+    return;
+
+  uInt y{0};
+  const uInt page_height = uInt(getHeight()) - 2;
+  const auto element_count = int(model->getRowCount());
+  auto row = first_row;
+  const auto visible = getVisibleRect();
+
+  while ( row < element_count && y < page_height )
   {
-    print() << FPoint{2, 2 + int(y)}
-            << FString{std::size_t(getClientWidth()), ' '};
+    const bool is_current_line( row == current_row );
+
+    // Draw one row of the model (skip covered lines)
+    if ( isVisibleLine(visible, 2 + int(y)) )
+    {
+      print() << FPoint{2, 2 + int(y)};
+      drawModelLine (std::size_t(row), getFlags().focus, is_current_line);
+    }
+
+    if ( getFlags().focus && is_current_line )
+    {
+      int xpos = 3 - xoffset;
+
+      if ( xpos < 2 )  // Hide the cursor
+        xpos = -9999;  // by moving it outside the visible area
+
+      setVisibleCursor (false);
+      setCursorPos ({xpos, 2 + int(y)});  // first character
+    }
+
     y++;
+    row++;
   }
+
+  clearEmptyLines(y);
 }
 
 //----------------------------------------------------------------------
@@ -1667,61 +1773,93 @@ void FListView::drawListLine ( const FListViewItem* item
   // Print the entry
   const std::size_t indent = item->getDepth() << 1;  // indent = 2 * depth
   FString line{getLinePrefix (item, indent)};
+  line += getColumnsLine (item->column_list, indent, item->isCheckable());
+  printListLine (line);
+}
 
-  // Print columns
-  if ( ! item->column_list.empty() )
+//----------------------------------------------------------------------
+void FListView::drawModelLine ( std::size_t row
+                              , bool is_focus
+                              , bool is_current )
+{
+  // Set line color and attributes
+  setLineAttributes (is_current, is_focus);
+
+  FStringList column_list{};
+  column_list.reserve(header.size());
+
+  for (std::size_t col{1}; col <= header.size(); col++)
+    column_list.push_back (model->getText(row, int(col)).replaceControlCodes());
+
+  FString line{L" "};
+  line += getColumnsLine (column_list, 0, false);
+  printListLine (line);
+}
+
+//----------------------------------------------------------------------
+FString FListView::getColumnsLine ( const FStringList& column_list
+                                  , std::size_t indent
+                                  , bool is_checkable ) const
+{
+  FString line{};
+
+  for (std::size_t col{0}; col < column_list.size(); )
   {
-    for (std::size_t col{0}; col < item->column_list.size(); )
+    static constexpr std::size_t ellipsis_length = 2;
+    const auto& text = column_list[col];
+    auto width = std::size_t(header[col].width);
+    const std::size_t column_width = getColumnWidth(text);
+    // Increment the value of col for the column position
+    // and the next iteration
+    col++;
+    const Align align = getColumnAlignment(int(col));
+    const std::size_t align_offset = getAlignOffset (align, column_width, width);
+
+    if ( tree_view && col == 1 )
     {
-      static constexpr std::size_t ellipsis_length = 2;
-      const auto& text = item->column_list[col];
-      auto width = std::size_t(header[col].width);
-      const std::size_t column_width = getColumnWidth(text);
-      // Increment the value of col for the column position
-      // and the next iteration
-      col++;
-      const Align align = getColumnAlignment(int(col));
-      const std::size_t align_offset = getAlignOffset (align, column_width, width);
-
-      if ( tree_view && col == 1 )
-      {
-        width -= (indent + 1);
+      width -= (indent + 1);
 
-        if ( item->isCheckable() )
-          width -= checkbox_space;
-      }
+      if ( is_checkable )
+        width -= checkbox_space;
+    }
 
-      // Insert alignment spaces
-      if ( align_offset > 0 )
-        line += FString{align_offset, L' '};
+    // Insert alignment spaces
+    if ( align_offset > 0 )
+      line += FString{align_offset, L' '};
 
-      if ( align_offset + column_width <= width )
-      {
-        // Insert text and trailing space
-        static constexpr std::size_t leading_space = 1;
-        line += getColumnSubString (text, 1, width);
-        line += FString { leading_space + width
-                        - align_offset - column_width, L' '};
-      }
-      else if ( align == Align::Right )
-      {
-        // Ellipse right align text
-        const std::size_t first = getColumnWidth(text) + 1 - width;
-        line += FString {L".."};
-        line += getColumnSubString (text, first, width - ellipsis_length);
-        line += L' ';
-      }
-      else
-      {
-        // Ellipse left align text and center text
-        line += getColumnSubString (text, 1, width - ellipsis_length);
-        line += FString {L".. "};
-      }
+    if ( align_offset + column_width <= width )
+    {
+      // Insert text and trailing space
+      static constexpr std::size_t leading_space = 1;
+      line += getColumnSubString (text, 1, width);
+      line += FString { leading_space + width
+                      - align_offset - column_width, L' '};
+    }
+    else if ( align == Align::Right )
+    {
+      // Ellipse right align text
+      const std::size_t first = getColumnWidth(text) + 1 - width;
+      line += FString {L".."};
+      line += getColumnSubString (text, first, width - ellipsis_length);
+      line += L' ';
+    }
+    else
+    {
+      // Ellipse left align text and center text
+      line += getColumnSubString (text, 1, width - ellipsis_length);
+      line += FString {L".. "};
     }
   }
 
+  return line;
+}
+
+//----------------------------------------------------------------------
+void FListView::printListLine (const FString& list_line)
+{
   const std::size_t width = getWidth() - nf_offset - 2;
-  line = getColumnSubString ( line, std::size_t(xoffset) + 1, width );
+  const auto line = getColumnSubString ( list_line
+                                       , std::size_t(xoffset) + 1, width );
   const std::size_t len = line.getLength();
   std::size_t char_width{0};
 
@@ -1742,6 +1880,28 @@ void FListView::drawListLine ( const FListViewItem* item
     print (' ');
 }
 
+//----------------------------------------------------------------------
+void FListView::clearEmptyLines (uInt y)
+{
+  // Reset color
+  setColor();
+
+  if ( FTerm::isMonochron() )
+    setReverse(true);
+
+  // Clean empty space after last element
+  const auto visible = getVisibleRect();
+
+  while ( y < uInt(getClientHeight()) )
+  {
+    if ( isVisibleLine(visible, 2 + int(y)) )
+      print() << FPoint{2, 2 + int(y)}
+              << FString{std::size_t(getClientWidth()), ' '};
+
+    y++;
+  }
+}
+
 //----------------------------------------------------------------------
 void FListView::clearList()
 {
@@ -2057,7 +2217,7 @@ void FListView::updateDrawing (bool draw_vbar, bool draw_hbar)
   if ( isShown() )
     draw();
 
-  vbar->setValue (first_visible_line.getPosition());
+  vbar->setValue (getFirstVisiblePosition());
 
   if ( draw_vbar )
     vbar->drawBar();
@@ -2178,6 +2338,68 @@ void FListView::recalculateVerticalBar (std::size_t element_count) const
   }
 }
 
+//----------------------------------------------------------------------
+void FListView::adjustModelColumns()
+{
+  // The widths of the model columns are determined once without
+  // reading all rows, because the model can be very large
+
+  static constexpr std::size_t padding_space = 1;
+  std::size_t line_width = padding_space;  // leading space
+  int column{1};
+
+  for (auto&& header_item : header)
+  {
+    if ( ! header_item.fixed_width )
+    {
+      const auto len = model->getMaxColumnWidth(column);
+
+      if ( len > std::size_t(header_item.width) )
+        header_item.width = int(len);
+    }
+
+    // width + trailing space
+    line_width += std::size_t(header_item.width) + padding_space;
+    column++;
+  }
+
+  recalculateHorizontalBar (line_width);
+}
+
+//----------------------------------------------------------------------
+void FListView::adjustModelViewport()
+{
+  // Keeps the current row inside the visible rows
+
+  const auto element_count = int(model->getRowCount());
+  const auto height = std::max(int(getClientHeight()), 1);
+  current_row = std::max(0, std::min(current_row, element_count - 1));
+  first_row = std::max(0, std::min(first_row, element_count - height));
+
+  if ( current_row < first_row )
+    first_row = current_row;
+  else if ( current_row >= first_row + height )
+    first_row = current_row - height + 1;
+}
+
+//----------------------------------------------------------------------
+void FListView::sortModel()
+{
+  if ( sort_column < 1 || sort_order == SortOrder::Unsorted )
+    return;
+
+  if ( ! model->sort(sort_column, sort_order) )
+  {
+    // The model cannot be sorted by this column
+    sort_column = -1;
+    sort_order = SortOrder::Unsorted;
+    return;
+  }
+
+  current_row = 0;
+  first_row = 0;
+}
+
 //----------------------------------------------------------------------
 void FListView::mouseHeaderClicked()
 {
@@ -2222,6 +2444,16 @@ void FListView::mouseHeaderClicked()
 //----------------------------------------------------------------------
 void FListView::wheelUp (int pagesize)
 {
+  if ( model && current_row > 0 )
+  {
+    // Save relative position from the first line
+    const int ry = current_row - first_row;
+    first_row = std::max(0, first_row - pagesize);
+    current_row = first_row + ry;
+    adjustModelViewport();
+    return;
+  }
+
   if ( itemlist.empty() || current_iter.getPosition() == 0 )
     return;
 
@@ -2246,10 +2478,21 @@ void FListView::wheelUp (int pagesize)
 //----------------------------------------------------------------------
 void FListView::wheelDown (int pagesize)
 {
-  if ( itemlist.empty() )
+  const auto element_count = int(getCount());
+
+  if ( model && current_row + 1 < element_count )
+  {
+    // Save relative position from the first line
+    const int ry = current_row - first_row;
+    const int last_page = element_count - int(getClientHeight());
+    first_row = std::max(0, std::min(first_row + pagesize, last_page));
+    current_row = first_row + ry;
+    adjustModelViewport();
     return;
+  }
 
-  const auto element_count = int(getCount());
+  if ( itemlist.empty() )
+    return;
 
   if ( current_iter.getPosition() + 1 == element_count )
     return;
@@ -2307,7 +2550,7 @@ void FListView::dragUp (MouseButton mouse_button)
     && scroll_distance < int(getClientHeight()) )
     scroll_distance++;
 
-  if ( ! scroll_timer && current_iter.getPosition() > 0 )
+  if ( ! scroll_timer && getCurrentPosition() > 0 )
   {
     scroll_timer = true;
     addTimer(scroll_repeat);
@@ -2318,7 +2561,7 @@ void FListView::dragUp (MouseButton mouse_button)
       drag_scroll = DragScrollMode::Upward;
   }
 
-  if ( current_iter.getPosition() == 0 )
+  if ( getCurrentPosition() == 0 )
   {
     delOwnTimers();
     drag_scroll = DragScrollMode::None;
@@ -2332,7 +2575,7 @@ void FListView::dragDown (MouseButton mouse_button)
     && scroll_distance < int(getClientHeight()) )
     scroll_distance++;
 
-  if ( ! scroll_timer && current_iter.getPosition() <= int(getCount()) )
+  if ( ! scroll_timer && getCurrentPosition() <= int(getCount()) )
   {
     scroll_timer = true;
     addTimer(scroll_repeat);
@@ -2343,7 +2586,7 @@ void FListView::dragDown (MouseButton mouse_button)
       drag_scroll = DragScrollMode::Downward;
   }
 
-  if ( current_iter.getPosition() - 1 == int(getCount()) )
+  if ( getCurrentPosition() - 1 == int(getCount()) )
   {
     delOwnTimers();
     drag_scroll = DragScrollMode::None;
@@ -2371,7 +2614,7 @@ FObject::iterator FListView::appendItem (FListViewItem* item)
 //----------------------------------------------------------------------
 void FListView::processClick() const
 {
-  if ( itemlist.empty() )
+  if ( isEmpty() )
     return;
 
   emitCallback("clicked");
@@ -2432,7 +2675,7 @@ inline void FListView::collapseAndScrollLeft()
       // Jump to parent element
       const auto& parent = item->getParent();
 
-      if ( parent->isInstanceOf("FListViewItem") )
+      if ( parent->isA<FListViewItem>() )
       {
         current_iter.parentElement();
 
@@ -2492,6 +2735,13 @@ inline void FListView::expandAndScrollRight()
 //----------------------------------------------------------------------
 inline void FListView::firstPos()
 {
+  if ( model )
+  {
+    current_row = 0;
+    first_row = 0;
+    return;
+  }
+
   if ( itemlist.empty() )
     return;
 
@@ -2504,6 +2754,13 @@ inline void FListView::firstPos()
 //----------------------------------------------------------------------
 inline void FListView::lastPos()
 {
+  if ( model )
+  {
+    current_row = int(model->getRowCount()) - 1;
+    adjustModelViewport();
+    return;
+  }
+
   if ( itemlist.empty() )
     return;
 
@@ -2553,6 +2810,13 @@ inline bool FListView::collapseSubtree()
 //----------------------------------------------------------------------
 void FListView::setRelativePosition (int ry)
 {
+  if ( model )
+  {
+    current_row = first_row + ry;
+    adjustModelViewport();
+    return;
+  }
+
   current_iter = first_visible_line;
   current_iter += ry;
 }
@@ -2560,6 +2824,13 @@ void FListView::setRelativePosition (int ry)
 //----------------------------------------------------------------------
 void FListView::stepForward()
 {
+  if ( model )
+  {
+    current_row++;
+    adjustModelViewport();
+    return;
+  }
+
   if ( itemlist.empty() )
     return;
 
@@ -2582,6 +2853,13 @@ void FListView::stepForward()
 //----------------------------------------------------------------------
 void FListView::stepBackward()
 {
+  if ( model )
+  {
+    current_row--;
+    adjustModelViewport();
+    return;
+  }
+
   if ( itemlist.empty() )
     return;
 
@@ -2599,10 +2877,22 @@ void FListView::stepBackward()
 //----------------------------------------------------------------------
 void FListView::stepForward (int distance)
 {
-  if ( itemlist.empty() )
+  const auto element_count = int(getCount());
+
+  if ( model )
+  {
+    const int last_row = first_row + int(getClientHeight()) - 1;
+    current_row = std::min(current_row + distance, element_count - 1);
+
+    if ( current_row > last_row )
+      first_row += distance;  // Scrolls by the same distance
+
+    adjustModelViewport();
     return;
+  }
 
-  const auto element_count = int(getCount());
+  if ( itemlist.empty() )
+    return;
 
   if ( current_iter.getPosition() + 1 == element_count )
     return;
@@ -2635,6 +2925,17 @@ void FListView::stepForward (int distance)
 //----------------------------------------------------------------------
 void FListView::stepBackward (int distance)
 {
+  if ( model )
+  {
+    current_row = std::max(current_row - distance, 0);
+
+    if ( current_row < first_row )
+      first_row -= distance;  // Scrolls by the same distance
+
+    adjustModelViewport();
+    return;
+  }
+
   if ( itemlist.empty() || current_iter.getPosition() == 0 )
     return;
 
@@ -2682,6 +2983,17 @@ void FListView::scrollToX (int x)
 //----------------------------------------------------------------------
 void FListView::scrollToY (int y)
 {
+  if ( model )
+  {
+    // Save relative position from the top line
+    const int ry = current_row - first_row;
+    const int last_page = int(getCount()) - int(getClientHeight());
+    first_row = std::max(0, std::min(y, last_page));
+    current_row = first_row + ry;
+    adjustModelViewport();
+    return;
+  }
+
   const int pagesize = int(getClientHeight()) - 1;
   const auto element_count = int(getCount());
 
@@ -2733,7 +3045,7 @@ void FListView::cb_vbarChange (const FWidget*)
   const FScrollbar::ScrollType scrollType = vbar->getScrollType();
   static constexpr int wheel_distance = 4;
   int distance{1};
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
   assert ( scrollType == FScrollbar::ScrollType::None
         || scrollType == FScrollbar::ScrollType::Jump
         || scrollType == FScrollbar::ScrollType::StepBackward
@@ -2781,9 +3093,9 @@ void FListView::cb_vbarChange (const FWidget*)
   if ( scrollType >= FScrollbar::ScrollType::StepBackward
     && scrollType <= FScrollbar::ScrollType::PageForward )
   {
-    vbar->setValue (first_visible_line.getPosition());
+    vbar->setValue (getFirstVisiblePosition());
 
-    if ( first_line_position_before != first_visible_line.getPosition() )
+    if ( first_line_position_before != getFirstVisiblePosition() )
       vbar->drawBar();
 
     forceTerminalUpdate();
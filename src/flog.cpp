@@ -43,7 +43,7 @@ FLog& FLog::operator << (LogLevel l)
 {
   using std::placeholders::_1;
   sync();
-  std::lock_guard<std::mutex> lock_guard(mut);
+  std::lock_guard<std::recursive_mutex> lock_guard(stream_mut);
 
   switch ( l )
   {
@@ -74,7 +74,7 @@ int FLog::sync()
 {
   if ( ! str().empty() )
   {
-    std::lock_guard<std::mutex> lock_guard(mut);
+    std::lock_guard<std::recursive_mutex> lock_guard(stream_mut);
     current_log (str());
     str("");
   }
@@ -21,20 +21,114 @@
 ***********************************************************************/
 
 #include <array>
+#include <cstddef>
+#include <ctime>
 #include <string>
+#include <utility>
 
 #include "final/flogger.h"
 
 namespace finalcut
 {
 
+namespace
+{
+
+// Maximum waiting time of the idle writer thread
+constexpr std::chrono::milliseconds WRITER_WAIT_TIME{50};
+
+}  // anonymous namespace
+
 //----------------------------------------------------------------------
 // class FLogger
 //----------------------------------------------------------------------
 
 // constructors and destructor
 //----------------------------------------------------------------------
-FLogger::~FLogger() noexcept = default;  // destructor
+FLogger::~FLogger() noexcept  // destructor
+{
+  FLog::sync();  // Write pending stream data
+  stopWriter();
+  output.flush();
+}
+
+
+// public methods of FLogger
+//----------------------------------------------------------------------
+void FLogger::flush()
+{
+  if ( async )
+  {
+    // Non-blocking: the writer thread flushes after each batch
+    writer_cond.notify_one();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock_guard(output_mutex);
+
+  if ( unflushed )
+  {
+    output.flush();
+    unflushed = false;
+  }
+}
+
+//----------------------------------------------------------------------
+void FLogger::setOutputStream (const std::ostream& os)
+{
+  const bool restart = async;
+  stopWriter();
+
+  {
+    std::lock_guard<std::mutex> lock_guard(output_mutex);
+    output.flush();
+    output.rdbuf(os.rdbuf());
+    unflushed = false;
+  }
+
+  if ( restart )
+    startWriter();
+}
+
+//----------------------------------------------------------------------
+void FLogger::enableAsync (std::size_t queue_size)
+{
+  // Writes the log lines in a background thread. The queue size
+  // is rounded up to a power of two. A resize of the queue must not
+  // overlap with log calls from other threads.
+
+  std::lock_guard<std::mutex> lock_guard(getMutex());
+
+  if ( async )
+    return;
+
+  std::size_t size{2};
+
+  while ( size < queue_size )
+    size <<= 1;
+
+  if ( queue.size() != size )
+  {
+    LogQueue new_queue(size);
+
+    for (std::size_t i{0}; i < size; i++)
+      new_queue[i].sequence.store(i, std::memory_order_relaxed);
+
+    queue.swap(new_queue);
+    enqueue_pos.store(0, std::memory_order_relaxed);
+    dequeue_pos = 0;
+  }
+
+  startWriter();
+}
+
+//----------------------------------------------------------------------
+void FLogger::disableAsync()
+{
+  // Writes all queued log lines before returning
+  std::lock_guard<std::mutex> lock_guard(getMutex());
+  stopWriter();
+}
 
 
 // private methods of FLogger
@@ -54,41 +148,48 @@ void FLogger::newlineReplace ( std::string& str
 }
 
 //----------------------------------------------------------------------
-std::string FLogger::getTimeString() const
+std::string FLogger::getTimeString()
 {
-  std::array<char, 100> str;
+  // The formatted time is cached per thread for one second
+  thread_local std::time_t last_time{-1};
+  thread_local std::string time_str{};
   const auto& now = std::chrono::system_clock::now();
   const auto& t = std::chrono::system_clock::to_time_t(now);
+
+  if ( t == last_time )
+    return time_str;
+
+  std::array<char, 100> str;
   // Print RFC 2822 date
   struct tm time{};
   localtime_r (&t, &time);
   std::strftime (str.data(), str.size(), "%a, %d %b %Y %T %z", &time);
-  return {str.data()};
+  time_str = str.data();
+  last_time = t;
+  return time_str;
 }
 
 //----------------------------------------------------------------------
-std::string FLogger::getEOL()
+std::string FLogger::getEOL() const
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
+  const LineEnding eol = line_ending;
 
-  if ( getEnding() == LineEnding::LF )
+  if ( eol == LineEnding::LF )
     return "\n";
-  else if ( getEnding() == LineEnding::CR )
+  else if ( eol == LineEnding::CR )
     return "\r";
-  else if ( getEnding() == LineEnding::CRLF )
+  else if ( eol == LineEnding::CRLF )
     return "\r\n";
 
   return "";
 }
 
 //----------------------------------------------------------------------
-void FLogger::printLogLine (const std::string& msg)
+void FLogger::printLogLine (LogLevel level, const std::string& msg)
 {
-  const std::string& log_level = [this] ()
+  const std::string log_level = [level] ()
   {
-    std::lock_guard<std::mutex> lock_guard(getMutex());
-
-    switch ( getLevel() )
+    switch ( level )
     {
       case LogLevel::Info:
         return "INFO";
@@ -118,9 +219,157 @@ void FLogger::printLogLine (const std::string& msg)
   const std::string& eol = getEOL();
   const std::string replace_str = eol + prefix;
   newlineReplace (message, replace_str);
-  output << prefix << message << eol;
+  std::string line{prefix};
+  line.reserve(prefix.length() + message.length() + eol.length());
+  line += message;
+  line += eol;
+
+  if ( async && pushRecord(line) )
+    return;
+
+  std::lock_guard<std::mutex> lock_guard(output_mutex);
+  output << line;
+  unflushed = true;
 }
 
-}  // namespace finalcut
+//----------------------------------------------------------------------
+bool FLogger::pushRecord (std::string& line)
+{
+  // Bounded multi-producer queue (sequence numbers per slot).
+  // Returns false if the writer thread is not running.
+
+  const std::size_t mask = queue.size() - 1;
+  std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+
+  while ( true )
+  {
+    if ( ! async )
+      return false;
+
+    auto& record = queue[pos & mask];
+    const std::size_t seq = record.sequence.load(std::memory_order_acquire);
+    const auto diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+
+    if ( diff == 0 )
+    {
+      if ( enqueue_pos.compare_exchange_weak ( pos, pos + 1
+                                             , std::memory_order_relaxed) )
+      {
+        record.line = std::move(line);
+        record.sequence.store(pos + 1, std::memory_order_release);
+        break;
+      }
+    }
+    else if ( diff < 0 )  // Queue is full
+    {
+      if ( overflow_policy == OverflowPolicy::Drop )
+      {
+        dropped++;
+        return true;
+      }
+
+      writer_cond.notify_one();
+      std::this_thread::yield();
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+    }
+    else
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+  }
+
+  if ( (pos & 0xff) == 0 )  // Wakes the writer for big bursts
+    writer_cond.notify_one();
 
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FLogger::popRecord (std::string& line)
+{
+  auto& record = queue[dequeue_pos & (queue.size() - 1)];
+  const std::size_t seq = record.sequence.load(std::memory_order_acquire);
+
+  if ( seq != dequeue_pos + 1 )
+    return false;  // Queue is empty
+
+  line += record.line;
+  record.line.clear();
+  record.sequence.store(dequeue_pos + queue.size(), std::memory_order_release);
+  dequeue_pos++;
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FLogger::hasRecord() const
+{
+  const auto& record = queue[dequeue_pos & (queue.size() - 1)];
+  return record.sequence.load(std::memory_order_acquire) == dequeue_pos + 1;
+}
+
+//----------------------------------------------------------------------
+void FLogger::writeRecords()
+{
+  std::string batch{};
 
+  while ( true )
+  {
+    while ( popRecord(batch) )
+      if ( batch.length() > 0xffff )
+        break;
+
+    if ( ! batch.empty() )
+    {
+      std::lock_guard<std::mutex> lock_guard(output_mutex);
+      output << batch;
+      output.flush();
+      batch.clear();
+      continue;
+    }
+
+    if ( stop )
+      return;
+
+    std::unique_lock<std::mutex> lock(writer_mutex);
+    writer_cond.wait_for ( lock, WRITER_WAIT_TIME
+                         , [this] () { return stop || hasRecord(); } );
+  }
+}
+
+//----------------------------------------------------------------------
+void FLogger::startWriter()
+{
+  stop = false;
+  async = true;
+  writer = std::thread(&FLogger::writeRecords, this);
+}
+
+//----------------------------------------------------------------------
+void FLogger::stopWriter()
+{
+  if ( ! writer.joinable() )
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock_guard(writer_mutex);
+    stop = true;
+  }
+
+  writer_cond.notify_one();
+  writer.join();
+
+  // New log lines are written directly, but only after the queued
+  // lines, since the direct output waits for the output lock
+  std::lock_guard<std::mutex> lock_guard(output_mutex);
+  async = false;
+  std::string batch{};
+
+  while ( enqueue_pos.load() != dequeue_pos )
+  {
+    if ( ! popRecord(batch) )
+      std::this_thread::yield();  // The slot is reserved but not yet filled
+  }
+
+  output << batch;
+  output.flush();
+}
+
+}  // namespace finalcut
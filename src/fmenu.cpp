@@ -32,6 +32,7 @@
 #include "final/fmenu.h"
 #include "final/fmenubar.h"
 #include "final/fmenuitem.h"
+#include "final/fradiomenuitem.h"
 #include "final/fstatusbar.h"
 #include "final/fwidgetcolors.h"
 
@@ -343,19 +344,19 @@ bool FMenu::isDialog (const FWidget* w) const
 //----------------------------------------------------------------------
 bool FMenu::isMenuBar (const FWidget* w) const
 {
-  return w->isInstanceOf("FMenuBar");
+  return w->isA<FMenuBar>();
 }
 
 //----------------------------------------------------------------------
 bool FMenu::isMenu (const FWidget* w) const
 {
-  return w->isInstanceOf("FMenu");
+  return w->isA<FMenu>();
 }
 
 //----------------------------------------------------------------------
 bool FMenu::isRadioMenuItem (const FWidget* w) const
 {
-  return w->isInstanceOf("FRadioMenuItem");
+  return w->isA<FRadioMenuItem>();
 }
 
 //----------------------------------------------------------------------
@@ -719,7 +720,7 @@ void FMenu::mouseDownSelection (FMenuItem* m_item, bool& focus_changed)
   focus_changed = true;
 
   if ( focused_widget )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
   if ( getStatusBar() )
     getStatusBar()->drawMessage();
@@ -823,7 +824,7 @@ void FMenu::mouseMoveSelection (FMenuItem* m_item, MouseStates& ms)
   ms.focus_changed = true;
 
   if ( focused_widget )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
   if ( getStatusBar() )
     getStatusBar()->drawMessage();
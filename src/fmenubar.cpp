@@ -694,7 +694,7 @@ void FMenuBar::selectMenuItem (FMenuItem* item)
   item->setFocus();
 
   if ( focused_widget && ! focused_widget->isWindowWidget() )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
   item->openMenu();
   setSelectedItem(item);
@@ -196,7 +196,7 @@ void FMenuItem::delAccelerator (FWidget* obj)
 
   if ( root && ! root->setAcceleratorList().empty() )
   {
-    auto list = root->setAcceleratorList();
+    auto& list = root->setAcceleratorList();
     auto iter = list.begin();
 
     while ( iter != list.end() )
@@ -398,7 +398,7 @@ void FMenuItem::onAccel (FAccelEvent* ev)
       menu->getSelectedItem()->setFocus();
 
     if ( focused_widget && focused_widget->isWidget() )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
     menu->redraw();
 
@@ -457,18 +457,14 @@ bool FMenuItem::isDialog (const FWidget* w) const
 //----------------------------------------------------------------------
 bool FMenuItem::isMenuBar (const FWidget* w) const
 {
-  return w ? w->isInstanceOf("FMenuBar") : false;
+  return w ? w->isA<FMenuBar>() : false;
 }
 
 //----------------------------------------------------------------------
 bool FMenuItem::isMenu (const FWidget* w) const
 {
-  if ( ! w )
-    return false;
-
-  const bool m1 = w->isInstanceOf("FMenu");
-  const bool m2 = w->isInstanceOf("FDialogListMenu");
-  return m1 || m2;
+  // FDialogListMenu is also an FMenu
+  return w ? w->isA<FMenu>() : false;
 }
 
 //----------------------------------------------------------------------
@@ -24,6 +24,7 @@
 
 #include "final/fevent.h"
 #include "final/fc.h"
+#include "final/fhittestindex.h"
 #include "final/fobject.h"
 
 namespace finalcut
@@ -31,6 +32,8 @@ namespace finalcut
 
 // static class attributes
 bool FObject::timer_modify_lock;
+bool FObject::use_fixed_time{false};
+timeval FObject::fixed_time{};
 
 
 //----------------------------------------------------------------------
@@ -127,6 +130,7 @@ void FObject::addChild (FObject* obj)
   obj->parent_obj = this;
   obj->has_parent = true;
   children_list.push_back(obj);
+  FHitTestIndex::invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -142,6 +146,7 @@ void FObject::delChild (FObject* obj)
     obj->parent_obj = nullptr;
     obj->has_parent = false;
     children_list.remove(obj);
+    FHitTestIndex::invalidate();
   }
 }
 
@@ -183,6 +188,12 @@ void FObject::getCurrentTime (timeval* time)
 {
   // Get the current time as timeval struct
 
+  if ( use_fixed_time )  // Reproducible time for headless runs
+  {
+    *time = fixed_time;
+    return;
+  }
+
   gettimeofday(time, nullptr);
 
   // NTP fix
@@ -229,6 +240,22 @@ bool FObject::isTimeout (const timeval* time, uInt64 timeout)
   return ( diff_usec > timeout );
 }
 
+//----------------------------------------------------------------------
+void FObject::setFixedTime (const timeval& time)
+{
+  // From now on, getCurrentTime() returns the given time. Timers and
+  // timeouts only advance when the time is set again.
+
+  fixed_time = time;
+  use_fixed_time = true;
+}
+
+//----------------------------------------------------------------------
+void FObject::unsetFixedTime()
+{
+  use_fixed_time = false;
+}
+
 //----------------------------------------------------------------------
 int FObject::addTimer (int interval)
 {
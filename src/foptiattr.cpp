@@ -20,8 +20,11 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <array>
+#include <cstdio>
 #include <cstring>
+#include <string>
 
 #include "final/fc.h"
 #include "final/foptiattr.h"
@@ -31,6 +34,28 @@
 namespace finalcut
 {
 
+namespace
+{
+
+// Attribute bits of the second attribute byte (protect...pc_charset)
+uInt8 getAttributeMask()
+{
+  FChar mask{};
+  mask.attr.bit.protect = true;
+  mask.attr.bit.crossed_out = true;
+  mask.attr.bit.dbl_underline = true;
+  mask.attr.bit.alt_charset = true;
+  mask.attr.bit.pc_charset = true;
+  return mask.attr.byte[1];
+}
+
+const uInt8 attribute_mask = getAttributeMask();
+
+// Largest color index with a precalculated color sequence
+constexpr int MAX_COLOR_TABLE_SIZE = 256;
+
+}  // anonymous namespace
+
 //----------------------------------------------------------------------
 // class FOptiAttr
 //----------------------------------------------------------------------
@@ -325,6 +350,7 @@ void FOptiAttr::set_set_attributes (const char cap[])
   {
     F_set_attributes.cap = cap;
     F_set_attributes.caused_reset = true;
+    set_attributes_cache.clear();
   }
 }
 
@@ -499,6 +525,9 @@ void FOptiAttr::initialize()
 
   if ( hasCharsetEquivalence() )
     alt_equal_pc_charset = true;
+
+  set_attributes_cache.clear();
+  initColorTables();
 }
 
 //----------------------------------------------------------------------
@@ -548,6 +577,9 @@ const char* FOptiAttr::changeAttribute (FChar& term, FChar& next)
   const bool next_has_color = hasColor(next);
   fake_reverse = false;
   attr_buf[0] = '\0';
+  attr_len = 0;
+  sgr_run = SGRRun::None;
+  combine_sgr = FStartOptions::getFStartOptions().sgr_optimizer;
   prevent_no_color_video_attributes (term, next_has_color);
   prevent_no_color_video_attributes (next);
   detectSwitchOn (term, next);
@@ -575,9 +607,6 @@ const char* FOptiAttr::changeAttribute (FChar& term, FChar& next)
     changeAttributeSeparately (term, next);
   }
 
-  if ( FStartOptions::getFStartOptions().sgr_optimizer )
-    sgr_optimizer.optimize();
-
   return attr_buf.data();
 }
 
@@ -886,16 +915,15 @@ bool FOptiAttr::setTermAttributes ( FChar& term
 {
   if ( F_set_attributes.cap )
   {
-    const auto sgr = FTermcap::encodeParameter ( F_set_attributes.cap
-                                               , p1 && ! fake_reverse
-                                               , p2
-                                               , p3 && ! fake_reverse
-                                               , p4
-                                               , p5
-                                               , p6
-                                               , p7
-                                               , p8
-                                               , p9 );
+    const auto& sgr = getSetAttributes ( p1 && ! fake_reverse
+                                       , p2
+                                       , p3 && ! fake_reverse
+                                       , p4
+                                       , p5
+                                       , p6
+                                       , p7
+                                       , p8
+                                       , p9 );
     append_sequence (sgr.data());
     resetColor(term);
     term.attr.bit.standout      = p1;
@@ -988,8 +1016,7 @@ inline bool FOptiAttr::unsetTermPCcharset (FChar& term)
 //----------------------------------------------------------------------
 bool FOptiAttr::setTermDefaultColor (FChar& term)
 {
-  term.fg_color = FColor::Default;
-  term.bg_color = FColor::Default;
+  resetColor(term);
 
   if ( append_sequence(F_orig_pair.cap) )
     return true;
@@ -1104,19 +1131,9 @@ bool FOptiAttr::hasColor (const FChar& attr)
 //----------------------------------------------------------------------
 bool FOptiAttr::hasAttribute (const FChar& attr)
 {
-  return attr.attr.bit.bold
-      || attr.attr.bit.dim
-      || attr.attr.bit.italic
-      || attr.attr.bit.underline
-      || attr.attr.bit.blink
-      || attr.attr.bit.reverse
-      || attr.attr.bit.standout
-      || attr.attr.bit.invisible
-      || attr.attr.bit.protect
-      || attr.attr.bit.crossed_out
-      || attr.attr.bit.dbl_underline
-      || attr.attr.bit.alt_charset
-      || attr.attr.bit.pc_charset;
+  // The first attribute byte contains only attributes
+  return attr.attr.byte[0] != 0
+      || (attr.attr.byte[1] & attribute_mask) != 0;
 }
 
 //----------------------------------------------------------------------
@@ -1127,15 +1144,62 @@ bool FOptiAttr::hasNoAttribute (const FChar& attr)
 
 //----------------------------------------------------------------------
 inline bool FOptiAttr::hasColorChanged ( const FChar& term
-                                       , const FChar& next ) const
+                                       , const FChar& next )
 {
   bool frev { ( on.attr.bit.reverse
              || on.attr.bit.standout
              || off.attr.bit.reverse
              || off.attr.bit.standout ) && fake_reverse };
-  return frev
-      || term.fg_color != next.fg_color
-      || term.bg_color != next.bg_color;
+
+  if ( frev )
+    return true;
+
+  // The terminal state holds the colors actually used
+  FColor fg = next.fg_color;
+  FColor bg = next.bg_color;
+  uInt32 fg_rgb = next.fg_rgb;
+  uInt32 bg_rgb = next.bg_rgb;
+  resolveColor (fg, fg_rgb);
+  resolveColor (bg, bg_rgb);
+  return term.fg_color != fg
+      || term.bg_color != bg
+      || term.fg_rgb != fg_rgb
+      || term.bg_rgb != bg_rgb;
+}
+
+//----------------------------------------------------------------------
+inline bool FOptiAttr::hasTrueColor() const
+{
+  return truecolor
+      && ( (F_set_a_foreground.cap && F_set_a_background.cap)
+        || (F_set_foreground.cap && F_set_background.cap) );
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::resolveColor (FColor& color, uInt32& rgb)
+{
+  // Replaces a 24-bit color with the color that the terminal can show.
+  // The next character keeps its 24-bit color for the change detection.
+
+  if ( color != FColor::RGB )
+  {
+    rgb = 0;
+    return;
+  }
+
+  FColor index{};
+
+  if ( max_color >= 256 && FColorQuantizer::findPaletteColor(rgb, index) )
+    color = index;  // The palette color has the shorter sequence
+  else if ( hasTrueColor() )
+    return;
+  else
+  {
+    quantizer.setColorCount (uInt16(max_color));
+    color = quantizer.quantize(rgb);
+  }
+
+  rgb = 0;
 }
 
 //----------------------------------------------------------------------
@@ -1143,6 +1207,8 @@ inline void FOptiAttr::resetColor (FChar& attr) const
 {
   attr.fg_color = FColor::Default;
   attr.bg_color = FColor::Default;
+  attr.fg_rgb = 0;
+  attr.bg_rgb = 0;
 }
 
 //----------------------------------------------------------------------
@@ -1295,34 +1361,54 @@ void FOptiAttr::change_color (FChar& term, FChar& next)
     return;
   }
 
-  if ( next.fg_color != FColor::Default )
+  if ( next.fg_color != FColor::Default && next.fg_color != FColor::RGB )
     next.fg_color %= uInt16(max_color);
 
-  if ( next.bg_color != FColor::Default )
+  if ( next.bg_color != FColor::Default && next.bg_color != FColor::RGB )
     next.bg_color %= uInt16(max_color);
 
   FColor fg = next.fg_color;
   FColor bg = next.bg_color;
+  uInt32 fg_rgb = next.fg_rgb;
+  uInt32 bg_rgb = next.bg_rgb;
+  resolveColor (fg, fg_rgb);
+  resolveColor (bg, bg_rgb);
 
   if ( fg == FColor::Default || bg == FColor::Default )
+  {
     change_to_default_color (term, next, fg, bg);
 
+    if ( fg != FColor::RGB )  // Fallback to gray on black
+      fg_rgb = 0;
+
+    if ( bg != FColor::RGB )
+      bg_rgb = 0;
+  }
+
   if ( fake_reverse && fg == FColor::Default && bg == FColor::Default )
     return;
 
+  const FColor term_fg{fg};
+  const FColor term_bg{bg};
+  const uInt32 term_fg_rgb{fg_rgb};
+  const uInt32 term_bg_rgb{bg_rgb};
+
   if ( fake_reverse
     && (next.attr.bit.reverse || next.attr.bit.standout) )
   {
     std::swap (fg, bg);
+    std::swap (fg_rgb, bg_rgb);
 
     if ( fg == FColor::Default || bg == FColor::Default )
       setTermDefaultColor(term);
   }
 
-  change_current_color (term, fg, bg);
+  change_current_color (term, fg, bg, fg_rgb, bg_rgb);
 
-  term.fg_color = next.fg_color;
-  term.bg_color = next.bg_color;
+  term.fg_color = term_fg;
+  term.bg_color = term_bg;
+  term.fg_rgb = term_fg_rgb;
+  term.bg_rgb = term_bg_rgb;
 }
 
 //----------------------------------------------------------------------
@@ -1341,6 +1427,7 @@ inline void FOptiAttr::change_to_default_color ( FChar& term, FChar& next
       std::string sgr_39{CSI "39m"};
       append_sequence (sgr_39.c_str());
       term.fg_color = FColor::Default;
+      term.fg_rgb = 0;
     }
     else if ( bg == FColor::Default && term.bg_color != FColor::Default )
     {
@@ -1354,6 +1441,7 @@ inline void FOptiAttr::change_to_default_color ( FChar& term, FChar& next
 
       append_sequence (sgr_49);
       term.bg_color = FColor::Default;
+      term.bg_rgb = 0;
     }
   }
   else if ( ! setTermDefaultColor(term) )
@@ -1366,7 +1454,8 @@ inline void FOptiAttr::change_to_default_color ( FChar& term, FChar& next
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::change_current_color ( const FChar& term
-                                            , FColor fg, FColor bg )
+                                            , FColor fg, FColor bg
+                                            , uInt32 fg_rgb, uInt32 bg_rgb )
 {
   const auto& AF = F_set_a_foreground.cap;
   const auto& AB = F_set_a_background.cap;
@@ -1378,36 +1467,30 @@ inline void FOptiAttr::change_current_color ( const FChar& term
                    || term.attr.bit.reverse
                    || term.attr.bit.standout ) && fake_reverse );
 
+  const bool fg_changed = term.fg_color != fg || term.fg_rgb != fg_rgb || frev;
+  const bool bg_changed = term.bg_color != bg || term.bg_rgb != bg_rgb || frev;
+
+  if ( fg_changed && fg == FColor::RGB )
+    append_rgb_color ("38;2", fg_rgb);
+
+  if ( bg_changed && bg == FColor::RGB )
+    append_rgb_color ("48;2", bg_rgb);
+
   if ( AF && AB )
   {
-    const auto ansi_fg = vga2ansi(fg);
-    const auto ansi_bg = vga2ansi(bg);
-
-    if ( term.fg_color != fg || frev )
-    {
-      const auto& color_str = FTermcap::encodeParameter(AF, uInt16(ansi_fg));
-      append_sequence (color_str.data());
-    }
+    if ( fg_changed && fg != FColor::RGB )
+      append_color (AF, fg_sgr_param, fg, vga2ansi(fg));
 
-    if ( term.bg_color != bg || frev )
-    {
-      const auto& color_str = FTermcap::encodeParameter(AB, uInt16(ansi_bg));
-      append_sequence (color_str.data());
-    }
+    if ( bg_changed && bg != FColor::RGB )
+      append_color (AB, bg_sgr_param, bg, vga2ansi(bg));
   }
   else if ( Sf && Sb )
   {
-    if ( term.fg_color != fg || frev )
-    {
-      const auto& color_str = FTermcap::encodeParameter(Sf, uInt16(fg));
-      append_sequence (color_str.data());
-    }
+    if ( fg_changed && fg != FColor::RGB )
+      append_color (Sf, fg_sgr_param, fg, fg);
 
-    if ( term.bg_color != bg || frev )
-    {
-      const auto& color_str = FTermcap::encodeParameter(Sb, uInt16(bg));
-      append_sequence (color_str.data());
-    }
+    if ( bg_changed && bg != FColor::RGB )
+      append_color (Sb, bg_sgr_param, bg, bg);
   }
   else if ( sp )
   {
@@ -1486,37 +1569,21 @@ inline bool FOptiAttr::hasCharsetEquivalence() const
 //----------------------------------------------------------------------
 inline void FOptiAttr::detectSwitchOn (const FChar& term, const FChar& next)
 {
-  on.attr.bit.bold          = ! term.attr.bit.bold          && next.attr.bit.bold;
-  on.attr.bit.dim           = ! term.attr.bit.dim           && next.attr.bit.dim;
-  on.attr.bit.italic        = ! term.attr.bit.italic        && next.attr.bit.italic;
-  on.attr.bit.underline     = ! term.attr.bit.underline     && next.attr.bit.underline;
-  on.attr.bit.blink         = ! term.attr.bit.blink         && next.attr.bit.blink;
-  on.attr.bit.reverse       = ! term.attr.bit.reverse       && next.attr.bit.reverse;
-  on.attr.bit.standout      = ! term.attr.bit.standout      && next.attr.bit.standout;
-  on.attr.bit.invisible     = ! term.attr.bit.invisible     && next.attr.bit.invisible;
-  on.attr.bit.protect       = ! term.attr.bit.protect       && next.attr.bit.protect;
-  on.attr.bit.crossed_out   = ! term.attr.bit.crossed_out   && next.attr.bit.crossed_out;
-  on.attr.bit.dbl_underline = ! term.attr.bit.dbl_underline && next.attr.bit.dbl_underline;
-  on.attr.bit.alt_charset   = ! term.attr.bit.alt_charset   && next.attr.bit.alt_charset;
-  on.attr.bit.pc_charset    = ! term.attr.bit.pc_charset    && next.attr.bit.pc_charset;
+  // Attributes that are set in next but not in term
+  const auto& t = term.attr.byte;
+  const auto& n = next.attr.byte;
+  on.attr.byte[0] = uInt8(~t[0] & n[0]);
+  on.attr.byte[1] = uInt8(~t[1] & n[1] & attribute_mask);
 }
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::detectSwitchOff (const FChar& term, const FChar& next)
 {
-  off.attr.bit.bold          = term.attr.bit.bold          && ! next.attr.bit.bold;
-  off.attr.bit.dim           = term.attr.bit.dim           && ! next.attr.bit.dim;
-  off.attr.bit.italic        = term.attr.bit.italic        && ! next.attr.bit.italic;
-  off.attr.bit.underline     = term.attr.bit.underline     && ! next.attr.bit.underline;
-  off.attr.bit.blink         = term.attr.bit.blink         && ! next.attr.bit.blink;
-  off.attr.bit.reverse       = term.attr.bit.reverse       && ! next.attr.bit.reverse;
-  off.attr.bit.standout      = term.attr.bit.standout      && ! next.attr.bit.standout;
-  off.attr.bit.invisible     = term.attr.bit.invisible     && ! next.attr.bit.invisible;
-  off.attr.bit.protect       = term.attr.bit.protect       && ! next.attr.bit.protect;
-  off.attr.bit.crossed_out   = term.attr.bit.crossed_out   && ! next.attr.bit.crossed_out;
-  off.attr.bit.dbl_underline = term.attr.bit.dbl_underline && ! next.attr.bit.dbl_underline;
-  off.attr.bit.alt_charset   = term.attr.bit.alt_charset   && ! next.attr.bit.alt_charset;
-  off.attr.bit.pc_charset    = term.attr.bit.pc_charset    && ! next.attr.bit.pc_charset;
+  // Attributes that are set in term but not in next
+  const auto& t = term.attr.byte;
+  const auto& n = next.attr.byte;
+  off.attr.byte[0] = uInt8(t[0] & ~n[0]);
+  off.attr.byte[1] = uInt8(t[1] & ~n[1] & attribute_mask);
 }
 
 //----------------------------------------------------------------------
@@ -1532,15 +1599,237 @@ inline bool FOptiAttr::switchOff() const
 }
 
 //----------------------------------------------------------------------
-inline bool FOptiAttr::append_sequence (const char seq[])
+void FOptiAttr::initColorTables()
+{
+  // Precalculates the parameters of all color sequences
+  // that consist of a single SGR sequence
+
+  fg_sgr_param.clear();
+  bg_sgr_param.clear();
+
+  if ( monochron )
+    return;
+
+  const char* fg_cap{nullptr};
+  const char* bg_cap{nullptr};
+  bool ansi_colors{false};
+
+  if ( F_set_a_foreground.cap && F_set_a_background.cap )
+  {
+    fg_cap = F_set_a_foreground.cap;
+    bg_cap = F_set_a_background.cap;
+    ansi_colors = true;
+  }
+  else if ( F_set_foreground.cap && F_set_background.cap )
+  {
+    fg_cap = F_set_foreground.cap;
+    bg_cap = F_set_background.cap;
+  }
+  else
+    return;
+
+  const auto size = std::size_t(std::min(max_color, MAX_COLOR_TABLE_SIZE));
+  SGRParameterTable fg_table(size);
+  SGRParameterTable bg_table(size);
+
+  for (std::size_t index{0}; index < size; index++)
+  {
+    auto color = FColor(index);
+
+    if ( ansi_colors )
+      color = vga2ansi(color);
+
+    const auto& fg_str = FTermcap::encodeParameter(fg_cap, uInt16(color));
+    const auto& bg_str = FTermcap::encodeParameter(bg_cap, uInt16(color));
+
+    if ( ! getSGRParameter(fg_str, fg_table[index])
+      || ! getSGRParameter(bg_str, bg_table[index]) )
+      return;  // Not a pure SGR color sequence
+  }
+
+  fg_sgr_param.swap(fg_table);
+  bg_sgr_param.swap(bg_table);
+}
+
+//----------------------------------------------------------------------
+bool FOptiAttr::getSGRParameter (const std::string& seq, std::string& param)
+{
+  // Gets the parameters of a single SGR sequence (CSI <param> m)
+
+  const std::size_t len = seq.length();
+
+  if ( len < 3 || seq[0] != ESC[0] || seq[1] != '[' || seq[len - 1] != 'm' )
+    return false;
+
+  const auto iter = std::find_if ( seq.begin() + 2, seq.end() - 1
+                                 , [] (char ch)
+                                   {
+                                     return (ch < '0' || ch > '9') && ch != ';';
+                                   }
+                                 );
+
+  if ( iter != seq.end() - 1 )
+    return false;
+
+  param = seq.substr(2, len - 3);
+  return true;
+}
+
+//----------------------------------------------------------------------
+const std::string& FOptiAttr::getSetAttributes ( bool p1, bool p2, bool p3
+                                               , bool p4, bool p5, bool p6
+                                               , bool p7, bool p8, bool p9 )
+{
+  // Caches the encoded set_attributes string for each
+  // of the 512 parameter combinations
+
+  if ( set_attributes_cache.empty() )
+    set_attributes_cache.resize(512);
+
+  const std::size_t index = std::size_t(p1)      | std::size_t(p2) << 1
+                          | std::size_t(p3) << 2 | std::size_t(p4) << 3
+                          | std::size_t(p5) << 4 | std::size_t(p6) << 5
+                          | std::size_t(p7) << 6 | std::size_t(p8) << 7
+                          | std::size_t(p9) << 8;
+  auto& sgr = set_attributes_cache[index];
+
+  if ( sgr.empty() )
+    sgr = FTermcap::encodeParameter ( F_set_attributes.cap
+                                    , p1, p2, p3, p4, p5, p6, p7, p8, p9 );
+
+  return sgr;
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::append_color ( const char cap[]
+                                    , const SGRParameterTable& table
+                                    , FColor color, FColor term_color )
 {
+  const auto index = std::size_t(color);
+
+  if ( index < table.size() )
+  {
+    const auto& param = table[index];
+    append_sgr (param.data(), param.length());
+  }
+  else
+  {
+    const auto& color_str = FTermcap::encodeParameter(cap, uInt16(term_color));
+    append_sequence (color_str.data());
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::append_rgb_color (const char sgr[], uInt32 rgb)
+{
+  // Direct color sequence CSI 38;2;r;g;b m or CSI 48;2;r;g;b m
+
+  std::array<char, 24> param{};
+  const int len = std::snprintf ( param.data(), param.size()
+                                , "%s;%u;%u;%u", sgr
+                                , unsigned((rgb >> 16) & 0xff)
+                                , unsigned((rgb >> 8) & 0xff)
+                                , unsigned(rgb & 0xff) );
+
+  if ( len > 0 )
+    append_sgr (param.data(), std::min(std::size_t(len), param.size() - 1));
+}
+
+//----------------------------------------------------------------------
+bool FOptiAttr::append_sequence (const char seq[])
+{
+  // Splits the sequence into SGR sequences and other content
+
   if ( ! seq )
     return false;
 
-  char* attr_ptr{attr_buf.data()};
-  std::strncat (attr_ptr, seq, attr_buf.size() - std::strlen(attr_ptr));
-  attr_buf[attr_buf.size() - 1] = '\0';
+  const char* pos = seq;
+
+  while ( *pos != '\0' )
+  {
+    if ( pos[0] == ESC[0] && pos[1] == '[' )
+    {
+      const char* param_end = pos + 2;
+
+      while ( (*param_end >= '0' && *param_end <= '9') || *param_end == ';' )
+        param_end++;
+
+      if ( *param_end == 'm' )
+      {
+        append_sgr (pos + 2, std::size_t(param_end - pos - 2));
+        pos = param_end + 1;
+        continue;
+      }
+    }
+
+    const char* raw_end = pos + 1;
+
+    while ( *raw_end != '\0' && *raw_end != ESC[0] )
+      raw_end++;
+
+    append_raw (pos, std::size_t(raw_end - pos));
+    pos = raw_end;
+  }
+
   return true;
 }
 
+//----------------------------------------------------------------------
+void FOptiAttr::append_sgr (const char param[], std::size_t len)
+{
+  // With the SGR optimizer, all directly consecutive SGR sequences
+  // at the beginning are combined into one (CSI m CSI 1m -> CSI 0;1m)
+
+  if ( combine_sgr && sgr_run == SGRRun::Open )
+  {
+    attr_len--;  // Replaces the final 'm'
+
+    if ( sgr_count == 1 && sgr_run_empty )
+      append_chars ("0", 1);
+
+    append_chars (";", 1);
+
+    if ( len == 0 )
+      append_chars ("0", 1);
+    else
+      append_chars (param, len);
+
+    append_chars ("m", 1);
+    sgr_count++;
+    return;
+  }
+
+  append_chars (CSI, 2);
+  append_chars (param, len);
+  append_chars ("m", 1);
+
+  if ( sgr_run == SGRRun::None )
+  {
+    sgr_run = SGRRun::Open;
+    sgr_run_empty = ( len == 0 );
+    sgr_count = 1;
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::append_raw (const char str[], std::size_t len)
+{
+  if ( len == 0 )
+    return;
+
+  append_chars (str, len);
+
+  if ( sgr_run == SGRRun::Open )
+    sgr_run = SGRRun::Closed;
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::append_chars (const char str[], std::size_t len)
+{
+  const std::size_t size = std::min(len, attr_buf.size() - 1 - attr_len);
+  std::memcpy (attr_buf.data() + attr_len, str, size);
+  attr_len += size;
+  attr_buf[attr_len] = '\0';
+}
+
 }  // namespace finalcut
@@ -20,8 +20,10 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <string>
 
 #include "final/fapplication.h"
 #include "final/fc.h"
@@ -31,6 +33,17 @@
 namespace finalcut
 {
 
+namespace
+{
+
+// Saturating addition of two durations
+constexpr int addDuration (int t1, int t2)
+{
+  return ( t1 > INT_MAX - t2 ) ? INT_MAX : t1 + t2;
+}
+
+}  // anonymous namespace
+
 //----------------------------------------------------------------------
 // class FOptiMove
 //----------------------------------------------------------------------
@@ -60,6 +73,7 @@ void FOptiMove::setBaudRate (int baud)
   assert ( baud >= 0 );
   baudrate = baud;
   calculateCharDuration();
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -67,6 +81,7 @@ void FOptiMove::setTabStop (int t)
 {
   assert ( t > 0 );
   tabstop = t;
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -76,6 +91,7 @@ void FOptiMove::setTermSize (std::size_t w, std::size_t h)
   assert ( h > 0 );
   screen_width = w;
   screen_height = h;
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -123,6 +139,8 @@ void FOptiMove::set_cursor_home (const char cap[])
     F_cursor_home.duration = \
     F_cursor_home.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -140,6 +158,8 @@ void FOptiMove::set_cursor_to_ll (const char cap[])
     F_cursor_to_ll.duration = \
     F_cursor_to_ll.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -157,6 +177,8 @@ void FOptiMove::set_carriage_return (const char cap[])
     F_carriage_return.duration = \
     F_carriage_return.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -174,6 +196,8 @@ void FOptiMove::set_tabular (const char cap[])
     F_tab.duration = \
     F_tab.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -191,6 +215,8 @@ void FOptiMove::set_back_tab (const char cap[])
     F_back_tab.duration = \
     F_back_tab.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -208,6 +234,8 @@ void FOptiMove::set_cursor_up (const char cap[])
     F_cursor_up.duration = \
     F_cursor_up.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -225,6 +253,8 @@ void FOptiMove::set_cursor_down (const char cap[])
     F_cursor_down.duration = \
     F_cursor_down.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -242,6 +272,8 @@ void FOptiMove::set_cursor_left (const char cap[])
     F_cursor_left.duration = \
     F_cursor_left.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -259,6 +291,8 @@ void FOptiMove::set_cursor_right (const char cap[])
     F_cursor_right.duration = \
     F_cursor_right.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -277,6 +311,9 @@ void FOptiMove::set_cursor_address (const char cap[])
     F_cursor_address.duration = \
     F_cursor_address.length   = LONG_DURATION;
   }
+
+  setANSIForm (F_cursor_address, "%p1%d;%p2%d");
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -295,6 +332,9 @@ void FOptiMove::set_column_address (const char cap[])
     F_column_address.duration = \
     F_column_address.length   = LONG_DURATION;
   }
+
+  setANSIForm (F_column_address, "%p1%d");
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -313,6 +353,9 @@ void FOptiMove::set_row_address (const char cap[])
     F_row_address.duration = \
     F_row_address.length   = LONG_DURATION;
   }
+
+  setANSIForm (F_row_address, "%p1%d");
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -331,6 +374,9 @@ void FOptiMove::set_parm_up_cursor (const char cap[])
     F_parm_up_cursor.duration = \
     F_parm_up_cursor.length   = LONG_DURATION;
   }
+
+  setANSIForm (F_parm_up_cursor, "%p1%d");
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -349,6 +395,9 @@ void FOptiMove::set_parm_down_cursor (const char cap[])
     F_parm_down_cursor.duration = \
     F_parm_down_cursor.length   = LONG_DURATION;
   }
+
+  setANSIForm (F_parm_down_cursor, "%p1%d");
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -367,6 +416,9 @@ void FOptiMove::set_parm_left_cursor (const char cap[])
     F_parm_left_cursor.duration = \
     F_parm_left_cursor.length   = LONG_DURATION;
   }
+
+  setANSIForm (F_parm_left_cursor, "%p1%d");
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -385,6 +437,9 @@ void FOptiMove::set_parm_right_cursor (const char cap[])
     F_parm_right_cursor.duration = \
     F_parm_right_cursor.length   = LONG_DURATION;
   }
+
+  setANSIForm (F_parm_right_cursor, "%p1%d");
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -403,6 +458,8 @@ void FOptiMove::set_erase_chars (const char cap[])
     F_erase_chars.duration = \
     F_erase_chars.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -421,6 +478,8 @@ void FOptiMove::set_repeat_char (const char cap[])
     F_repeat_char.duration = \
     F_repeat_char.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -438,6 +497,8 @@ void FOptiMove::set_clr_bol (const char cap[])
     F_clr_bol.duration = \
     F_clr_bol.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -455,6 +516,8 @@ void FOptiMove::set_clr_eol (const char cap[])
     F_clr_eol.duration = \
     F_clr_eol.length   = LONG_DURATION;
   }
+
+  invalidateCache();
 }
 
 //----------------------------------------------------------------------
@@ -483,51 +546,48 @@ void FOptiMove::check_boundaries ( int& xold, int& yold
 //----------------------------------------------------------------------
 const char* FOptiMove::moveCursor (int xold, int yold, int xnew, int ynew)
 {
-  int method{0};
-  int move_time{LONG_DURATION};
-
   check_boundaries (xold, yold, xnew, ynew);
 
-  // Method 0: direct cursor addressing
-  if ( isMethod0Faster(move_time, xnew, ynew)
-    && ( xold < 0
-      || yold < 0
-      || isWideMove (xold, yold, xnew, ynew) ) )
-  {
-    return ( move_time < LONG_DURATION ) ? move_buf : nullptr;
-  }
+  // Look up the last moves
+  const MovePosition position{{xold, yold, xnew, ynew}};
+  CachedMove* lru_entry{&move_cache[0]};
 
-  // Method 1: local movement
-  if ( isMethod1Faster(move_time, xold, yold, xnew, ynew) )
-    method = 1;
-
-  // Method 2: carriage-return + local movement
-  if ( isMethod2Faster(move_time, yold, xnew, ynew) )
-    method = 2;
-
-  // Method 3: home-cursor + local movement
-  if ( isMethod3Faster(move_time, xnew, ynew) )
-    method = 3;
+  for (auto&& entry : move_cache)
+  {
+    if ( entry.generation != cache_generation )
+    {
+      lru_entry = &entry;
+      continue;
+    }
 
-  // Method 4: home-down + local movement
-  if ( isMethod4Faster(move_time, xnew, ynew) )
-    method = 4;
+    if ( entry.position == position )
+    {
+      entry.last_use = ++cache_clock;
+      return ( entry.found ) ? entry.sequence.c_str() : nullptr;
+    }
 
-  // Method 5: left margin for wrap to right-hand side
-  if ( isMethod5Faster(move_time, yold, xnew, ynew) )
-    method = 5;
+    if ( lru_entry->generation == cache_generation
+      && entry.last_use < lru_entry->last_use )
+      lru_entry = &entry;
+  }
 
-  // Copy the escape sequence for the chosen method in move_buf
-  moveByMethod (method, xold, yold, xnew, ynew);
+  // Replace the least recently used entry
+  const char* move = calculateMove (xold, yold, xnew, ynew);
+  lru_entry->position = position;
+  lru_entry->generation = cache_generation;
+  lru_entry->last_use = ++cache_clock;
+  lru_entry->found = ( move != nullptr );
 
-  if ( move_time < LONG_DURATION )
-    return move_buf;
+  if ( move )
+    lru_entry->sequence.assign(move);
   else
-    return nullptr;
+    lru_entry->sequence.clear();
+
+  return move;
 }
 
 
-// private methods of FApplication
+// private methods of FOptiMove
 //----------------------------------------------------------------------
 void FOptiMove::calculateCharDuration()
 {
@@ -603,36 +663,133 @@ int FOptiMove::capDurationToLength (int duration) const
 }
 
 //----------------------------------------------------------------------
-int FOptiMove::repeatedAppend ( const Capability& o
-                              , int count
-                              , char* dst ) const
+void FOptiMove::setANSIForm (Capability& o, const char params[])
+{
+  // Recognizes the capability forms CSI [%i] <params> <final byte>,
+  // which can be written without the terminfo parameter parser
+
+  o.ansi_final = '\0';
+  o.ansi_offset = 0;
+
+  if ( ! o.cap || std::strncmp(o.cap, CSI, 2) != 0 )
+    return;
+
+  const char* p = o.cap + 2;
+  int offset{0};
+
+  if ( std::strncmp(p, "%i", 2) == 0 )
+  {
+    offset = 1;
+    p += 2;
+  }
+
+  const std::size_t params_len = std::strlen(params);
+
+  if ( std::strncmp(p, params, params_len) != 0 )
+    return;
+
+  p += params_len;
+
+  if ( p[0] < '@' || p[0] > '~' || p[1] != '\0' )
+    return;
+
+  o.ansi_final = p[0];
+  o.ansi_offset = offset;
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::copyParameter ( char dst[], const Capability& o
+                              , int param ) const
+{
+  if ( o.ansi_final )
+  {
+    char* p = std::strcpy(dst, CSI) + 2;
+    p = writeNumber (p, param + o.ansi_offset);
+    *p++ = o.ansi_final;
+    *p = '\0';
+    return;
+  }
+
+  copyString (dst, FTermcap::encodeParameter(o.cap, param));
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::copyMotionParameter (char dst[], int col, int row) const
+{
+  const auto& o = F_cursor_address;
+
+  if ( o.ansi_final )
+  {
+    char* p = std::strcpy(dst, CSI) + 2;
+    p = writeNumber (p, row + o.ansi_offset);
+    *p++ = ';';
+    p = writeNumber (p, col + o.ansi_offset);
+    *p++ = o.ansi_final;
+    *p = '\0';
+    return;
+  }
+
+  copyString (dst, FTermcap::encodeMotionParameter(o.cap, col, row));
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::copyString (char dst[], const std::string& str)
+{
+  const std::size_t len = std::min(str.length(), BUF_SIZE - 1);
+  std::memcpy (dst, str.data(), len);
+  dst[len] = '\0';
+}
+
+//----------------------------------------------------------------------
+char* FOptiMove::writeNumber (char* dst, int number)
+{
+  // Integer-to-ASCII conversion of a non-negative number
+
+  std::array<char, 12> digits{};
+  std::size_t n{0};
+  auto value = uInt(std::max(number, 0));
+
+  do
+  {
+    digits[n++] = char('0' + value % 10);
+    value /= 10;
+  }
+  while ( value > 0 );
+
+  while ( n > 0 )
+    *dst++ = digits[--n];
+
+  return dst;
+}
+
+//----------------------------------------------------------------------
+int FOptiMove::repeatedAppend ( const Capability& o, int count
+                              , char* dst, std::size_t& dst_len ) const
 {
+  // Appends the capability count times at position dst_len.
+  // Without a destination buffer, only the duration is calculated.
+
   const std::size_t src_len = std::strlen(o.cap);
-  const std::size_t dst_len = ( dst != nullptr ) ? std::strlen(dst) : 0;
-  int total{0};
+  const std::size_t len = uInt(count) * src_len;
+
+  if ( dst_len + len >= BUF_SIZE - 1 )
+    return LONG_DURATION;
 
-  if ( (dst_len + uInt(count) * src_len) < BUF_SIZE - 1 )
+  if ( dst )
   {
-    total += count * o.duration;
+    char* p = dst + dst_len;
 
-    if ( dst )
+    for (int cnt{0}; cnt < count; cnt++)
     {
-      dst += dst_len;
-      std::size_t free = BUF_SIZE - dst_len - 2;
-      int cnt = count;
-
-      while ( cnt-- > 0 )
-      {
-        std::strncpy (dst, o.cap, free);
-        dst += src_len;
-        free -= src_len;
-      }
+      std::memcpy (p, o.cap, src_len);
+      p += src_len;
     }
+
+    *p = '\0';
   }
-  else
-    total = LONG_DURATION;
 
-  return total;
+  dst_len += len;
+  return count * o.duration;
 }
 
 //----------------------------------------------------------------------
@@ -640,6 +797,8 @@ int FOptiMove::relativeMove ( char move[]
                             , int from_x, int from_y
                             , int to_x, int to_y ) const
 {
+  // Without a move buffer, only the duration is calculated
+
   int vtime{0};
   int htime{0};
 
@@ -656,20 +815,23 @@ int FOptiMove::relativeMove ( char move[]
 
   if ( to_x != from_x )  // horizontal move
   {
-    char hmove[BUF_SIZE]{};
-    htime = horizontalMove (hmove, from_x, to_x);
+    if ( move )
+    {
+      char hmove[BUF_SIZE];
+      hmove[0] = '\0';
+      htime = horizontalMove (hmove, from_x, to_x);
 
-    if ( htime >= LONG_DURATION )
-      return LONG_DURATION;
+      if ( htime >= LONG_DURATION )
+        return LONG_DURATION;
 
-    if ( move )
+      std::strncat (move, hmove, BUF_SIZE - std::strlen(move) - 1);
+    }
+    else
     {
-      if ( *move )
-        std::strncat (move, hmove, BUF_SIZE - std::strlen(move));
-      else
-        std::strncpy (move, hmove, BUF_SIZE);
+      htime = horizontalMove (nullptr, from_x, to_x);
 
-      move[BUF_SIZE - 1] = '\0';
+      if ( htime >= LONG_DURATION )
+        return LONG_DURATION;
     }
   }
 
@@ -684,12 +846,7 @@ inline int FOptiMove::verticalMove (char move[], int from_y, int to_y) const
   if ( F_row_address.cap )
   {
     if ( move )
-    {
-      std::strncpy ( move
-                   , FTermcap::encodeParameter(F_row_address.cap, to_y).data()
-                   , BUF_SIZE );
-      move[BUF_SIZE - 1] = '\0';
-    }
+      copyParameter (move, F_row_address, to_y);
 
     vtime = F_row_address.duration;
   }
@@ -711,22 +868,15 @@ inline void FOptiMove::downMove ( char move[], int& vtime
   if ( F_parm_down_cursor.cap && F_parm_down_cursor.duration < vtime )
   {
     if ( move )
-    {
-      std::strncpy ( move
-                   , FTermcap::encodeParameter(F_parm_down_cursor.cap, num).data()
-                   , BUF_SIZE );
-      move[BUF_SIZE - 1] = '\0';
-    }
+      copyParameter (move, F_parm_down_cursor, num);
 
     vtime = F_parm_down_cursor.duration;
   }
 
   if ( F_cursor_down.cap && (num * F_cursor_down.duration < vtime) )
   {
-    if ( move )
-      move[0] = '\0';
-
-    vtime = repeatedAppend (F_cursor_down, num, move);
+    std::size_t len{0};
+    vtime = repeatedAppend (F_cursor_down, num, move, len);
   }
 }
 
@@ -739,22 +889,15 @@ inline void FOptiMove::upMove ( char move[], int& vtime
   if ( F_parm_up_cursor.cap && F_parm_up_cursor.duration < vtime )
   {
     if ( move )
-    {
-      std::strncpy ( move
-                   , FTermcap::encodeParameter(F_parm_up_cursor.cap, num).data()
-                   , BUF_SIZE );
-      move[BUF_SIZE - 1] = '\0';
-    }
+      copyParameter (move, F_parm_up_cursor, num);
 
     vtime = F_parm_up_cursor.duration;
   }
 
   if ( F_cursor_up.cap && (num * F_cursor_up.duration < vtime) )
   {
-    if ( move )
-      move[0] = '\0';
-
-    vtime = repeatedAppend (F_cursor_up, num, move);
+    std::size_t len{0};
+    vtime = repeatedAppend (F_cursor_up, num, move, len);
   }
 }
 
@@ -765,11 +908,10 @@ inline int FOptiMove::horizontalMove (char hmove[], int from_x, int to_x) const
 
   if ( F_column_address.cap )
   {
-    // Move to fixed column position1
-    std::strncat ( hmove
-                 , FTermcap::encodeParameter(F_column_address.cap, to_x).data()
-                 , BUF_SIZE - std::strlen(hmove) - 1 );
-    hmove[BUF_SIZE - 1] = '\0';
+    // Move to fixed column position
+    if ( hmove )
+      copyParameter (hmove, F_column_address, to_x);
+
     htime = F_column_address.duration;
   }
 
@@ -789,16 +931,17 @@ inline void FOptiMove::rightMove ( char hmove[], int& htime
 
   if ( F_parm_right_cursor.cap && F_parm_right_cursor.duration < htime )
   {
-    std::strncpy ( hmove
-                 , FTermcap::encodeParameter(F_parm_right_cursor.cap, num).data()
-                 , BUF_SIZE - 1);
-    hmove[BUF_SIZE - 1] = '\0';
+    if ( hmove )
+      copyParameter (hmove, F_parm_right_cursor, num);
+
     htime = F_parm_right_cursor.duration;
   }
 
   if ( F_cursor_right.cap )
   {
-    std::array<char, BUF_SIZE> str{};
+    char str[BUF_SIZE];
+    char* str_ptr = ( hmove ) ? str : nullptr;
+    std::size_t len{0};
     int htime_r{0};
     str[0] = '\0';
 
@@ -814,7 +957,7 @@ inline void FOptiMove::rightMove ( char hmove[], int& htime
         if ( tab_pos > to_x )
           break;
 
-        htime_r += repeatedAppend (F_tab, 1, str.data());
+        htime_r = addDuration (htime_r, repeatedAppend(F_tab, 1, str_ptr, len));
 
         if ( htime_r >= LONG_DURATION )
           break;
@@ -825,12 +968,13 @@ inline void FOptiMove::rightMove ( char hmove[], int& htime
       num = to_x - pos;
     }
 
-    htime_r += repeatedAppend (F_cursor_right, num, str.data());
+    htime_r = addDuration (htime_r, repeatedAppend(F_cursor_right, num, str_ptr, len));
 
     if ( htime_r < htime )
     {
-      std::strncpy (hmove, str.data(), BUF_SIZE);
-      hmove[BUF_SIZE - 1] = '\0';
+      if ( hmove )
+        std::memcpy (hmove, str, len + 1);
+
       htime = htime_r;
     }
   }
@@ -844,16 +988,17 @@ inline void FOptiMove::leftMove ( char hmove[], int& htime
 
   if ( F_parm_left_cursor.cap && F_parm_left_cursor.duration < htime )
   {
-    std::strncpy ( hmove
-                 , FTermcap::encodeParameter(F_parm_left_cursor.cap, num).data()
-                 , BUF_SIZE - 1);
-    hmove[BUF_SIZE - 1] = '\0';
+    if ( hmove )
+      copyParameter (hmove, F_parm_left_cursor, num);
+
     htime = F_parm_left_cursor.duration;
   }
 
   if ( F_cursor_left.cap )
   {
-    std::array<char, BUF_SIZE> str{};
+    char str[BUF_SIZE];
+    char* str_ptr = ( hmove ) ? str : nullptr;
+    std::size_t len{0};
     int htime_l{0};
     str[0] = '\0';
 
@@ -869,7 +1014,7 @@ inline void FOptiMove::leftMove ( char hmove[], int& htime
         if ( tab_pos < to_x )
           break;
 
-        htime_l += repeatedAppend (F_back_tab, 1, str.data());
+        htime_l = addDuration (htime_l, repeatedAppend(F_back_tab, 1, str_ptr, len));
 
         if ( htime_l >= LONG_DURATION )
           break;
@@ -880,12 +1025,13 @@ inline void FOptiMove::leftMove ( char hmove[], int& htime
       num = pos - to_x;
     }
 
-    htime_l += repeatedAppend (F_cursor_left, num, str.data());
+    htime_l = addDuration (htime_l, repeatedAppend(F_cursor_left, num, str_ptr, len));
 
     if ( htime_l < htime )
     {
-      std::strncpy (hmove, str.data(), BUF_SIZE);
-      hmove[BUF_SIZE - 1] = '\0';
+      if ( hmove )
+        std::memcpy (hmove, str, len + 1);
+
       htime = htime_l;
     }
   }
@@ -901,27 +1047,15 @@ inline bool FOptiMove::isWideMove ( int xold, int yold
 }
 
 //----------------------------------------------------------------------
-inline bool FOptiMove::isMethod0Faster ( int& move_time
-                                       , int xnew, int ynew )
+inline bool FOptiMove::isMethod0Faster (int& move_time) const
 {
   // Test method 0: direct cursor addressing
 
   if ( ! F_cursor_address.cap )
     return false;
 
-  const auto move_xy = \
-    FTermcap::encodeMotionParameter(F_cursor_address.cap, xnew, ynew);
-
-  if ( ! move_xy.empty() )
-  {
-    std::strncpy ( static_cast<char*>(move_buf)
-                 , move_xy.data(), BUF_SIZE - 1 );
-    move_buf[BUF_SIZE - 1] = '\0';
-    move_time = F_cursor_address.duration;
-    return true;
-  }
-
-  return false;
+  move_time = F_cursor_address.duration;
+  return true;
 }
 
 //----------------------------------------------------------------------
@@ -933,8 +1067,7 @@ inline bool FOptiMove::isMethod1Faster ( int& move_time
 
   if ( xold >= 0 && yold >= 0 )
   {
-    std::array<char, BUF_SIZE> null_result{};
-    const int new_time = relativeMove (null_result.data(), xold, yold, xnew, ynew);
+    const int new_time = relativeMove (nullptr, xold, yold, xnew, ynew);
 
     if ( new_time < LONG_DURATION && new_time < move_time )
     {
@@ -955,8 +1088,7 @@ inline bool FOptiMove::isMethod2Faster ( int& move_time
 
   if ( yold >= 0 && F_carriage_return.cap )
   {
-    std::array<char, BUF_SIZE> null_result{};
-    const int new_time = relativeMove (null_result.data(), 0, yold, xnew, ynew);
+    const int new_time = relativeMove (nullptr, 0, yold, xnew, ynew);
 
     if ( new_time < LONG_DURATION
       && F_carriage_return.duration + new_time < move_time )
@@ -977,8 +1109,7 @@ inline bool FOptiMove::isMethod3Faster ( int& move_time
 
   if ( F_cursor_home.cap )
   {
-    std::array<char, BUF_SIZE> null_result{};
-    const int new_time = relativeMove (null_result.data(), 0, 0, xnew, ynew);
+    const int new_time = relativeMove (nullptr, 0, 0, xnew, ynew);
 
     if ( new_time < LONG_DURATION
       && F_cursor_home.duration + new_time < move_time )
@@ -998,8 +1129,7 @@ inline bool FOptiMove::isMethod4Faster ( int& move_time
   // Test method 4: home-down + local movement
   if ( F_cursor_to_ll.cap )
   {
-    std::array<char, BUF_SIZE> null_result{};
-    const int new_time = relativeMove ( null_result.data()
+    const int new_time = relativeMove ( nullptr
                                       , 0, int(screen_height) - 1
                                       , xnew, ynew );
 
@@ -1025,8 +1155,7 @@ inline bool FOptiMove::isMethod5Faster ( int& move_time
     && yold > 0
     && F_cursor_left.cap )
   {
-    std::array<char, BUF_SIZE> null_result{};
-    const int new_time = relativeMove ( null_result.data()
+    const int new_time = relativeMove ( nullptr
                                       , int(screen_width) - 1, yold - 1
                                       , xnew, ynew );
 
@@ -1045,57 +1174,97 @@ inline bool FOptiMove::isMethod5Faster ( int& move_time
   return false;
 }
 
+//----------------------------------------------------------------------
+const char* FOptiMove::calculateMove ( int xold, int yold
+                                     , int xnew, int ynew )
+{
+  // The methods are compared by their duration. Only the escape
+  // sequence of the fastest method is created afterwards.
+
+  int method{0};
+  int move_time{LONG_DURATION};
+
+  // Method 0: direct cursor addressing
+  if ( isMethod0Faster(move_time)
+    && ( xold < 0
+      || yold < 0
+      || isWideMove (xold, yold, xnew, ynew) ) )
+  {
+    moveByMethod (0, xold, yold, xnew, ynew);
+    return ( move_buf[0] != '\0' ) ? move_buf : nullptr;
+  }
+
+  // Method 1: local movement
+  if ( isMethod1Faster(move_time, xold, yold, xnew, ynew) )
+    method = 1;
+
+  // Method 2: carriage-return + local movement
+  if ( isMethod2Faster(move_time, yold, xnew, ynew) )
+    method = 2;
+
+  // Method 3: home-cursor + local movement
+  if ( isMethod3Faster(move_time, xnew, ynew) )
+    method = 3;
+
+  // Method 4: home-down + local movement
+  if ( isMethod4Faster(move_time, xnew, ynew) )
+    method = 4;
+
+  // Method 5: left margin for wrap to right-hand side
+  if ( isMethod5Faster(move_time, yold, xnew, ynew) )
+    method = 5;
+
+  if ( move_time >= LONG_DURATION )
+    return nullptr;
+
+  // Copy the escape sequence for the chosen method in move_buf
+  moveByMethod (method, xold, yold, xnew, ynew);
+  return move_buf;
+}
+
 //----------------------------------------------------------------------
 void FOptiMove::moveByMethod ( int method
                              , int xold, int yold
                              , int xnew, int ynew )
 {
-  char* move_ptr = move_buf;
+  move_buf[0] = '\0';
 
   switch ( method )
   {
+    case 0:
+      copyMotionParameter (move_buf, xnew, ynew);
+      break;
+
     case 1:
-      relativeMove (move_ptr, xold, yold, xnew, ynew);
+      relativeMove (move_buf, xold, yold, xnew, ynew);
       break;
 
     case 2:
       if ( F_carriage_return.cap )
       {
-        std::strncpy (move_ptr, F_carriage_return.cap, BUF_SIZE - 1);
-        move_ptr[BUF_SIZE - 1] ='\0';
-        move_ptr += F_carriage_return.length;
-        relativeMove (move_ptr, 0, yold, xnew, ynew);
+        std::strncat (move_buf, F_carriage_return.cap, BUF_SIZE - 1);
+        appendRelativeMove (0, yold, xnew, ynew);
       }
       break;
 
     case 3:
-      std::strncpy (move_ptr, F_cursor_home.cap, BUF_SIZE - 1);
-      move_ptr[BUF_SIZE - 1] ='\0';
-      move_ptr += F_cursor_home.length;
-      relativeMove (move_ptr, 0, 0, xnew, ynew);
+      std::strncat (move_buf, F_cursor_home.cap, BUF_SIZE - 1);
+      appendRelativeMove (0, 0, xnew, ynew);
       break;
 
     case 4:
-      std::strncpy (move_ptr, F_cursor_to_ll.cap, BUF_SIZE - 1);
-      move_ptr[BUF_SIZE - 1] ='\0';
-      move_ptr += F_cursor_to_ll.length;
-      relativeMove (move_ptr, 0, int(screen_height) - 1, xnew, ynew);
+      std::strncat (move_buf, F_cursor_to_ll.cap, BUF_SIZE - 1);
+      appendRelativeMove (0, int(screen_height) - 1, xnew, ynew);
       break;
 
     case 5:
-      move_buf[0] = '\0';
-
       if ( xold >= 0 )
-        std::strncat ( move_ptr
-                     , F_carriage_return.cap
-                     , BUF_SIZE - std::strlen(move_ptr) - 1 );
+        std::strncat (move_buf, F_carriage_return.cap, BUF_SIZE - 1);
 
-      std::strncat ( move_ptr
+      std::strncat ( move_buf
                    , F_cursor_left.cap
-                   , BUF_SIZE - std::strlen(move_ptr) - 1);
-      move_ptr[BUF_SIZE - 1] ='\0';
-      move_ptr += std::strlen(move_buf);
-      relativeMove (move_ptr, int(screen_width) - 1, yold - 1, xnew, ynew);
+                   , BUF_SIZE - std::strlen(move_buf) - 1 );
+      appendRelativeMove (int(screen_width) - 1, yold - 1, xnew, ynew);
       break;
 
     default:
@@ -1103,6 +1272,18 @@ void FOptiMove::moveByMethod ( int method
   }
 }
 
+//----------------------------------------------------------------------
+void FOptiMove::appendRelativeMove ( int from_x, int from_y
+                                   , int to_x, int to_y )
+{
+  char move[BUF_SIZE];
+  relativeMove (move, from_x, from_y, to_x, to_y);
+  const std::size_t len = std::strlen(move_buf);
+  const std::size_t n = std::min(std::strlen(move), BUF_SIZE - len - 1);
+  std::memcpy (move_buf + len, move, n);
+  move_buf[len + n] = '\0';
+}
+
 // FOptiMove non-member function
 //----------------------------------------------------------------------
 void printDurations (const FOptiMove& om)
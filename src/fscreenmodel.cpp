@@ -0,0 +1,1021 @@
+/***********************************************************************
+* fscreenmodel.cpp - In-memory model of a terminal screen              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#if defined(__CYGWIN__)
+  #include "final/fconfig.h"  // includes _GNU_SOURCE for wcwidth()
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cwchar>
+#include <string>
+#include <vector>
+
+#include "final/fscreenmodel.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+// DEC special graphics for the characters 0x5f ... 0x7e
+constexpr std::array<wchar_t, 32> dec_graphics =
+{{
+  L' ',       // _  Blank
+  L'◆',  // `  Diamond
+  L'▒',  // a  Checkerboard
+  L'␉',  // b  HT
+  L'␌',  // c  FF
+  L'␍',  // d  CR
+  L'␊',  // e  LF
+  L'°',  // f  Degree
+  L'±',  // g  Plus/minus
+  L'␤',  // h  NL
+  L'␋',  // i  VT
+  L'┘',  // j  Lower right corner
+  L'┐',  // k  Upper right corner
+  L'┌',  // l  Upper left corner
+  L'└',  // m  Lower left corner
+  L'┼',  // n  Crossing lines
+  L'⎺',  // o  Scan line 1
+  L'⎻',  // p  Scan line 3
+  L'─',  // q  Horizontal line
+  L'⎼',  // r  Scan line 7
+  L'⎽',  // s  Scan line 9
+  L'├',  // t  Left tee
+  L'┤',  // u  Right tee
+  L'┴',  // v  Bottom tee
+  L'┬',  // w  Top tee
+  L'│',  // x  Vertical line
+  L'≤',  // y  Less than or equal
+  L'≥',  // z  Greater than or equal
+  L'π',  // {  Pi
+  L'≠',  // |  Not equal
+  L'£',  // }  Pound sign
+  L'·'   // ~  Centered dot
+}};
+
+constexpr wchar_t REPLACEMENT_CHARACTER = L'�';
+
+//----------------------------------------------------------------------
+constexpr FColor ansiToColor (int index)
+{
+  // The 16 base colors of FColor have the VGA order
+  // (blue and red are swapped compared to ANSI)
+  return ( index < 16 )
+         ? FColor((index & 0x0a) | ((index & 1) << 2) | ((index & 4) >> 2))
+         : FColor(index);
+}
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FScreenModel
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FScreenModel::FScreenModel (const FSize& size)
+{
+  reset();
+  setSize (size);
+}
+
+
+// public methods of FScreenModel
+//----------------------------------------------------------------------
+const FChar& FScreenModel::getCharacter (const FPoint& pos) const
+{
+  static const FChar empty_char{};
+  const int x = pos.getX() - 1;
+  const int y = pos.getY() - 1;
+
+  if ( x < 0 || y < 0 || x >= width || y >= height )
+    return empty_char;
+
+  return cells[std::size_t(y * width + x)];
+}
+
+//----------------------------------------------------------------------
+FString FScreenModel::getLine (int line) const
+{
+  FString text{};
+
+  if ( line < 1 || line > height )
+    return text;
+
+  const auto first = cells.begin() + (line - 1) * width;
+
+  for (auto iter = first; iter != first + width; ++iter)
+    if ( ! iter->attr.bit.fullwidth_padding )
+      text += iter->ch[0];
+
+  return text;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::setSize (const FSize& size)
+{
+  // Resizes the screen and keeps the upper left content
+
+  const auto new_width = int(std::max(size.getWidth(), std::size_t(1)));
+  const auto new_height = int(std::max(size.getHeight(), std::size_t(1)));
+  const auto resize = [this, new_width, new_height] (std::vector<FChar>& buffer)
+  {
+    std::vector<FChar> new_buffer ( std::size_t(new_width * new_height)
+                                  , getBlankCharacter() );
+
+    for (auto y{0}; y < std::min(height, new_height); y++)
+      for (auto x{0}; x < std::min(width, new_width); x++)
+        new_buffer[std::size_t(y * new_width + x)] = \
+            buffer[std::size_t(y * width + x)];
+
+    buffer.swap(new_buffer);
+  };
+
+  resize (cells);
+
+  if ( alternate_screen )
+    resize (saved_cells);
+
+  width = new_width;
+  height = new_height;
+  scroll_top = 0;
+  scroll_bottom = height - 1;
+  setCursor (cursor_x, cursor_y);
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::write (int c)
+{
+  const auto byte = uChar(c);
+  byte_count++;
+
+  switch ( state )
+  {
+    case State::Ground:
+      processGround (byte);
+      break;
+
+    case State::Escape:
+      processEscape (byte);
+      break;
+
+    case State::Charset:
+      charset[csi_intermediate == ')' ? 1 : 0] = char(byte);
+      state = State::Ground;
+      break;
+
+    case State::Hash:
+      state = State::Ground;
+      break;
+
+    case State::ControlSequence:
+      processCSI (byte);
+      break;
+
+    case State::OperatingSystemCommand:
+      if ( byte == 'P' )  // Linux console palette: ESC ] P nrrggbb
+      {
+        palette_digits = 7;
+        state = State::LinuxPalette;
+      }
+      else if ( byte == 'R' || byte == 0x07 )  // Palette reset or empty
+        state = State::Ground;
+      else if ( byte == 0x1b )
+        state = State::StringEscape;
+      else
+        state = State::String;
+
+      break;
+
+    case State::LinuxPalette:
+      palette_digits--;
+
+      if ( palette_digits == 0 )
+        state = State::Ground;
+
+      break;
+
+    case State::String:  // OSC, DCS, APC or PM up to BEL or ST
+      if ( byte == 0x07 )
+        state = State::Ground;
+      else if ( byte == 0x1b )
+        state = State::StringEscape;
+
+      break;
+
+    case State::StringEscape:
+      state = ( byte == '\\' ) ? State::Ground : State::String;
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::write (const std::string& string)
+{
+  for (auto&& ch : string)
+    write (int(uChar(ch)));
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::reset()
+{
+  attribute = FChar{};
+  attribute.ch[0] = L' ';
+  attribute.fg_color = FColor::Default;
+  attribute.bg_color = FColor::Default;
+  attribute.attr.bit.char_width = 1;
+  saved_attribute = attribute;
+  std::fill (cells.begin(), cells.end(), getBlankCharacter());
+  saved_cells.clear();
+  parameters.clear();
+  last_char = L' ';
+  utf8_bytes = 0;
+  cursor_x = 0;
+  cursor_y = 0;
+  saved_x = 0;
+  saved_y = 0;
+  scroll_top = 0;
+  scroll_bottom = height - 1;
+  state = State::Ground;
+  charset = {{ 'B', 'B' }};
+  active_charset = 0;
+  pending_wrap = false;
+  cursor_shown = true;
+  alternate_screen = false;
+}
+
+
+// private methods of FScreenModel
+//----------------------------------------------------------------------
+inline FChar& FScreenModel::cell (int x, int y)
+{
+  return cells[std::size_t(y * width + x)];
+}
+
+//----------------------------------------------------------------------
+FChar FScreenModel::getBlankCharacter() const
+{
+  // Erased cells get the current colors (background color erase)
+
+  FChar blank{};
+  blank.ch[0] = L' ';
+  blank.fg_color = attribute.fg_color;
+  blank.bg_color = attribute.bg_color;
+  blank.fg_rgb = attribute.fg_rgb;
+  blank.bg_rgb = attribute.bg_rgb;
+  blank.attr.bit.char_width = 1;
+  return blank;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::processGround (uChar byte)
+{
+  if ( utf8_bytes > 0 && (byte & 0xc0) != 0x80 )
+  {
+    // Incomplete UTF-8 sequence
+    utf8_bytes = 0;
+    printCharacter (REPLACEMENT_CHARACTER);
+  }
+
+  if ( byte == 0x1b )
+    state = State::Escape;
+  else if ( byte < 0x20 || byte == 0x7f )
+    executeControl (byte);
+  else if ( byte < 0x80 )
+  {
+    if ( charset[active_charset] == '0' && byte >= 0x5f && byte <= 0x7e )
+      printCharacter (dec_graphics[byte - 0x5f]);
+    else
+      printCharacter (wchar_t(byte));
+  }
+  else
+    decodeUTF8 (byte);
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::processEscape (uChar byte)
+{
+  state = State::Ground;
+
+  switch ( byte )
+  {
+    case '[':
+      parameters.clear();
+      csi_prefix = 0;
+      csi_intermediate = 0;
+      state = State::ControlSequence;
+      break;
+
+    case ']':  // OSC
+      state = State::OperatingSystemCommand;
+      break;
+
+    case 'P':  // DCS
+    case '_':  // APC
+    case '^':  // PM
+    case 'X':  // SOS
+      state = State::String;
+      break;
+
+    case '(':  // G0 character set
+    case ')':  // G1 character set
+    case '*':  // G2 character set
+    case '+':  // G3 character set
+      csi_intermediate = byte;
+      state = State::Charset;
+      break;
+
+    case '#':
+      state = State::Hash;
+      break;
+
+    case '7':
+      saveCursor();
+      break;
+
+    case '8':
+      restoreCursor();
+      break;
+
+    case 'D':  // Index
+      lineFeed();
+      break;
+
+    case 'E':  // Next line
+      cursor_x = 0;
+      lineFeed();
+      break;
+
+    case 'M':  // Reverse index
+      reverseLineFeed();
+      break;
+
+    case 'c':  // Full reset
+      reset();
+      break;
+
+    default:
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::processCSI (uChar byte)
+{
+  if ( byte == 0x1b )  // Cancels the sequence
+    state = State::Escape;
+  else if ( byte < 0x20 )
+    executeControl (byte);
+  else if ( byte >= '0' && byte <= '9' )
+  {
+    if ( parameters.empty() )
+      parameters.push_back(-1);
+
+    auto& value = parameters.back();
+    value = std::min(std::max(value, 0) * 10 + (byte - '0'), 99999);
+  }
+  else if ( byte == ';' || byte == ':' )
+  {
+    if ( parameters.empty() )
+      parameters.push_back(-1);
+
+    if ( parameters.size() < MAX_PARAMETERS )
+      parameters.push_back(-1);
+  }
+  else if ( byte >= 0x3c && byte <= 0x3f )  // Private marker < = > ?
+    csi_prefix = byte;
+  else if ( byte >= 0x20 && byte <= 0x2f )  // Intermediate byte
+    csi_intermediate = byte;
+  else if ( byte >= 0x40 && byte <= 0x7e )  // Final byte
+  {
+    state = State::Ground;
+    executeCSI (byte);
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::executeCSI (uChar final_byte)
+{
+  if ( csi_intermediate == '$' )
+  {
+    executeRectangleFunction (final_byte);
+    return;
+  }
+
+  if ( csi_intermediate != 0 )
+    return;
+
+  if ( csi_prefix == '?' )
+  {
+    if ( final_byte == 'h' || final_byte == 'l' )
+      executeModes (final_byte == 'h');
+
+    return;
+  }
+
+  if ( csi_prefix != 0 )
+    return;
+
+  const int n = getParameter(0);
+
+  switch ( final_byte )
+  {
+    case '@':  // Insert characters
+      insertCells (n);
+      break;
+
+    case 'A':  // Cursor up
+      setCursor (cursor_x, cursor_y - n);
+      break;
+
+    case 'B':  // Cursor down
+      setCursor (cursor_x, cursor_y + n);
+      break;
+
+    case 'C':  // Cursor forward
+      setCursor (cursor_x + n, cursor_y);
+      break;
+
+    case 'D':  // Cursor backward
+      setCursor (cursor_x - n, cursor_y);
+      break;
+
+    case 'E':  // Cursor next line
+      setCursor (0, cursor_y + n);
+      break;
+
+    case 'F':  // Cursor preceding line
+      setCursor (0, cursor_y - n);
+      break;
+
+    case 'I':  // Cursor forward tabulation
+      setCursor ((cursor_x / 8 + n) * 8, cursor_y);
+      break;
+
+    case 'Z':  // Cursor backward tabulation
+      setCursor (((cursor_x + 7) / 8 - n) * 8, cursor_y);
+      break;
+
+    case 'G':  // Cursor character absolute
+    case '`':  // Character position absolute
+      setCursor (n - 1, cursor_y);
+      break;
+
+    case 'd':  // Line position absolute
+      setCursor (cursor_x, n - 1);
+      break;
+
+    case 'H':  // Cursor position
+    case 'f':
+      setCursor (getParameter(1) - 1, n - 1);
+      break;
+
+    case 'J':  // Erase in display
+      switch ( getParameter(0, 0) )
+      {
+        case 0:
+          eraseCells (cursor_y, cursor_x, width - 1);
+          eraseRectangle (cursor_y + 1, 0, height - 1, width - 1, getBlankCharacter());
+          break;
+
+        case 1:
+          eraseRectangle (0, 0, cursor_y - 1, width - 1, getBlankCharacter());
+          eraseCells (cursor_y, 0, cursor_x);
+          break;
+
+        default:
+          eraseRectangle (0, 0, height - 1, width - 1, getBlankCharacter());
+          break;
+      }
+      break;
+
+    case 'K':  // Erase in line
+      switch ( getParameter(0, 0) )
+      {
+        case 0:
+          eraseCells (cursor_y, cursor_x, width - 1);
+          break;
+
+        case 1:
+          eraseCells (cursor_y, 0, cursor_x);
+          break;
+
+        default:
+          eraseCells (cursor_y, 0, width - 1);
+          break;
+      }
+      break;
+
+    case 'L':  // Insert lines
+      if ( cursor_y >= scroll_top && cursor_y <= scroll_bottom )
+        scrollDown (cursor_y, scroll_bottom, n);
+      break;
+
+    case 'M':  // Delete lines
+      if ( cursor_y >= scroll_top && cursor_y <= scroll_bottom )
+        scrollUp (cursor_y, scroll_bottom, n);
+      break;
+
+    case 'P':  // Delete characters
+      deleteCells (n);
+      break;
+
+    case 'S':  // Scroll up
+      scrollUp (scroll_top, scroll_bottom, n);
+      break;
+
+    case 'T':  // Scroll down
+      scrollDown (scroll_top, scroll_bottom, n);
+      break;
+
+    case 'X':  // Erase characters
+      eraseCells (cursor_y, cursor_x, std::min(cursor_x + n - 1, width - 1));
+      break;
+
+    case 'b':  // Repeat the preceding character
+      for (auto i{0}; i < std::min(n, width * height); i++)
+        printCharacter (last_char);
+      break;
+
+    case 'm':  // Select graphic rendition
+      executeSGR();
+      break;
+
+    case 'r':  // Set top and bottom margins
+    {
+      const int top = n - 1;
+      const int bottom = std::min(getParameter(1, height), height) - 1;
+
+      if ( top < bottom )
+      {
+        scroll_top = top;
+        scroll_bottom = bottom;
+        setCursor (0, 0);
+      }
+      break;
+    }
+
+    case 's':
+      saveCursor();
+      break;
+
+    case 'u':
+      restoreCursor();
+      break;
+
+    default:
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::executeModes (bool enable)
+{
+  // DEC private modes
+
+  for (auto&& mode : parameters)
+  {
+    if ( mode == 25 )  // Cursor visibility
+      cursor_shown = enable;
+    else if ( mode == 47 || mode == 1047 )
+      switchScreen (enable);
+    else if ( mode == 1049 )  // Alternate screen with saved cursor
+    {
+      if ( enable )
+      {
+        saveCursor();
+        switchScreen (true);
+      }
+      else
+      {
+        switchScreen (false);
+        restoreCursor();
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::executeSGR()
+{
+  auto& attr = attribute.attr.bit;
+
+  if ( parameters.empty() )
+    parameters.push_back(0);
+
+  for (std::size_t i{0}; i < parameters.size(); i++)
+  {
+    const int value = std::max(parameters[i], 0);
+
+    if ( value == 0 )
+    {
+      attribute.attr.byte[0] = 0;
+      attribute.attr.byte[1] = 0;
+      attribute.fg_color = FColor::Default;
+      attribute.bg_color = FColor::Default;
+      attribute.fg_rgb = 0;
+      attribute.bg_rgb = 0;
+    }
+    else if ( value == 1 )
+      attr.bold = true;
+    else if ( value == 2 )
+      attr.dim = true;
+    else if ( value == 3 )
+      attr.italic = true;
+    else if ( value == 4 )
+      attr.underline = true;
+    else if ( value == 5 )
+      attr.blink = true;
+    else if ( value == 7 )
+      attr.reverse = true;
+    else if ( value == 8 )
+      attr.invisible = true;
+    else if ( value == 9 )
+      attr.crossed_out = true;
+    else if ( value == 21 )
+      attr.dbl_underline = true;
+    else if ( value == 22 )
+    {
+      attr.bold = false;
+      attr.dim = false;
+    }
+    else if ( value == 23 )
+      attr.italic = false;
+    else if ( value == 24 )
+    {
+      attr.underline = false;
+      attr.dbl_underline = false;
+    }
+    else if ( value == 25 )
+      attr.blink = false;
+    else if ( value == 27 )
+      attr.reverse = false;
+    else if ( value == 28 )
+      attr.invisible = false;
+    else if ( value == 29 )
+      attr.crossed_out = false;
+    else if ( value >= 30 && value <= 37 )
+      attribute.fg_color = ansiToColor(value - 30);
+    else if ( value == 39 )
+      attribute.fg_color = FColor::Default;
+    else if ( value >= 40 && value <= 47 )
+      attribute.bg_color = ansiToColor(value - 40);
+    else if ( value == 49 )
+      attribute.bg_color = FColor::Default;
+    else if ( value >= 90 && value <= 97 )
+      attribute.fg_color = ansiToColor(value - 90 + 8);
+    else if ( value >= 100 && value <= 107 )
+      attribute.bg_color = ansiToColor(value - 100 + 8);
+    else if ( value == 38 || value == 48 )
+    {
+      // Extended color: 38;5;index or 38;2;red;green;blue
+      auto& color = ( value == 38 ) ? attribute.fg_color : attribute.bg_color;
+      auto& rgb = ( value == 38 ) ? attribute.fg_rgb : attribute.bg_rgb;
+
+      if ( i + 2 < parameters.size() && parameters[i + 1] == 5 )
+      {
+        color = ansiToColor(std::max(parameters[i + 2], 0) & 0xff);
+        i += 2;
+      }
+      else if ( i + 4 < parameters.size() && parameters[i + 1] == 2 )
+      {
+        color = FColor::RGB;
+        rgb = (uInt32(std::max(parameters[i + 2], 0) & 0xff) << 16)
+            | (uInt32(std::max(parameters[i + 3], 0) & 0xff) << 8)
+            | uInt32(std::max(parameters[i + 4], 0) & 0xff);
+        i += 4;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::executeRectangleFunction (uChar final_byte)
+{
+  // Rectangular area operations of the VT420 (1-based coordinates)
+
+  if ( final_byte == 'v' )  // DECCRA - Copy rectangular area
+  {
+    const int top = getParameter(0) - 1;
+    const int left = getParameter(1) - 1;
+    const int bottom = std::min(getParameter(2, height), height) - 1;
+    const int right = std::min(getParameter(3, width), width) - 1;
+    const int dest_top = getParameter(5) - 1;
+    const int dest_left = getParameter(6) - 1;
+
+    if ( top > bottom || left > right )
+      return;
+
+    // Copy via a buffer, because the areas can overlap
+    std::vector<FChar> buffer{};
+    buffer.reserve(std::size_t((bottom - top + 1) * (right - left + 1)));
+
+    for (auto y{top}; y <= bottom; y++)
+      for (auto x{left}; x <= right; x++)
+        buffer.push_back(cell(x, y));
+
+    auto iter = buffer.cbegin();
+
+    for (auto y{dest_top}; y <= dest_top + bottom - top; y++)
+    {
+      for (auto x{dest_left}; x <= dest_left + right - left; x++, ++iter)
+        if ( x < width && y < height )
+          cell(x, y) = *iter;
+    }
+  }
+  else if ( final_byte == 'x' )  // DECFRA - Fill rectangular area
+  {
+    FChar fill_char{attribute};
+    const auto byte = uChar(getParameter(0, 0));
+
+    if ( charset[active_charset] == '0' && byte >= 0x5f && byte <= 0x7e )
+      fill_char.ch[0] = dec_graphics[byte - 0x5f];
+    else
+      fill_char.ch[0] = wchar_t(byte);
+
+    eraseRectangle ( getParameter(1) - 1, getParameter(2) - 1
+                   , getParameter(3, height) - 1, getParameter(4, width) - 1
+                   , fill_char );
+  }
+  else if ( final_byte == 'z' )  // DECERA - Erase rectangular area
+  {
+    eraseRectangle ( getParameter(0) - 1, getParameter(1) - 1
+                   , getParameter(2, height) - 1, getParameter(3, width) - 1
+                   , getBlankCharacter() );
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::executeControl (uChar byte)
+{
+  switch ( byte )
+  {
+    case 0x08:  // Backspace
+      setCursor (cursor_x - 1, cursor_y);
+      break;
+
+    case 0x09:  // Horizontal tab
+      setCursor ((cursor_x / 8 + 1) * 8, cursor_y);
+      break;
+
+    case 0x0a:  // Line feed
+    case 0x0b:  // Vertical tab
+    case 0x0c:  // Form feed
+      lineFeed();
+      break;
+
+    case 0x0d:  // Carriage return
+      setCursor (0, cursor_y);
+      break;
+
+    case 0x0e:  // Shift out (G1)
+      active_charset = 1;
+      break;
+
+    case 0x0f:  // Shift in (G0)
+      active_charset = 0;
+      break;
+
+    default:
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::decodeUTF8 (uChar byte)
+{
+  if ( utf8_bytes > 0 )  // Continuation byte
+  {
+    utf8_char = wchar_t((utf8_char << 6) | (byte & 0x3f));
+    utf8_bytes--;
+
+    if ( utf8_bytes == 0 )
+      printCharacter (utf8_char);
+  }
+  else if ( (byte & 0xe0) == 0xc0 )
+  {
+    utf8_char = wchar_t(byte & 0x1f);
+    utf8_bytes = 1;
+  }
+  else if ( (byte & 0xf0) == 0xe0 )
+  {
+    utf8_char = wchar_t(byte & 0x0f);
+    utf8_bytes = 2;
+  }
+  else if ( (byte & 0xf8) == 0xf0 )
+  {
+    utf8_char = wchar_t(byte & 0x07);
+    utf8_bytes = 3;
+  }
+  else
+    printCharacter (REPLACEMENT_CHARACTER);
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::printCharacter (wchar_t ch)
+{
+  const int column_width = wcwidth(ch);
+
+  if ( column_width == 0 )  // Combining character
+    return;
+
+  // Unknown widths (e.g. in the C locale) occupy one cell
+  const int char_width = std::max(1, column_width);
+
+  if ( pending_wrap || (char_width == 2 && cursor_x == width - 1) )
+  {
+    // Automatic margins
+    cursor_x = 0;
+    lineFeed();
+  }
+
+  auto& c = cell(cursor_x, cursor_y);
+  c = attribute;
+  c.ch = {{ ch }};
+  c.attr.bit.char_width = uInt8(char_width) & 0x03;
+
+  if ( char_width == 2 && cursor_x + 1 < width )
+  {
+    auto& padding = cell(cursor_x + 1, cursor_y);
+    padding = attribute;
+    padding.ch = {{ L'\0' }};
+    padding.attr.bit.fullwidth_padding = true;
+  }
+
+  last_char = ch;
+
+  if ( cursor_x + char_width >= width )
+  {
+    cursor_x = width - 1;
+    pending_wrap = true;
+  }
+  else
+    cursor_x += char_width;
+}
+
+//----------------------------------------------------------------------
+inline int FScreenModel::getParameter (std::size_t index, int default_value) const
+{
+  // Missing and zero parameters get the default value
+  return ( index < parameters.size() && parameters[index] > 0 )
+         ? parameters[index]
+         : default_value;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::setCursor (int x, int y)
+{
+  cursor_x = std::max(0, std::min(x, width - 1));
+  cursor_y = std::max(0, std::min(y, height - 1));
+  pending_wrap = false;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::lineFeed()
+{
+  pending_wrap = false;
+
+  if ( cursor_y == scroll_bottom )
+    scrollUp (scroll_top, scroll_bottom, 1);
+  else if ( cursor_y < height - 1 )
+    cursor_y++;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::reverseLineFeed()
+{
+  pending_wrap = false;
+
+  if ( cursor_y == scroll_top )
+    scrollDown (scroll_top, scroll_bottom, 1);
+  else if ( cursor_y > 0 )
+    cursor_y--;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::scrollUp (int top, int bottom, int n)
+{
+  // Scrolls the lines top ... bottom up by n lines
+
+  n = std::min(n, bottom - top + 1);
+  const auto first = cells.begin() + top * width;
+  const auto last = cells.begin() + (bottom + 1) * width;
+  std::move (first + n * width, last, first);
+  eraseRectangle (bottom - n + 1, 0, bottom, width - 1, getBlankCharacter());
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::scrollDown (int top, int bottom, int n)
+{
+  // Scrolls the lines top ... bottom down by n lines
+
+  n = std::min(n, bottom - top + 1);
+  const auto first = cells.begin() + top * width;
+  const auto last = cells.begin() + (bottom + 1) * width;
+  std::move_backward (first, last - n * width, last);
+  eraseRectangle (top, 0, top + n - 1, width - 1, getBlankCharacter());
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::eraseCells (int y, int from, int to)
+{
+  eraseRectangle (y, from, y, to, getBlankCharacter());
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::eraseRectangle ( int top, int left, int bottom, int right
+                                  , const FChar& fill_char )
+{
+  // Fills the rectangle with fill_char (0-based, inclusive)
+
+  top = std::max(top, 0);
+  left = std::max(left, 0);
+  bottom = std::min(bottom, height - 1);
+  right = std::min(right, width - 1);
+
+  for (auto y{top}; y <= bottom; y++)
+    for (auto x{left}; x <= right; x++)
+      cell(x, y) = fill_char;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::insertCells (int n)
+{
+  n = std::min(n, width - cursor_x);
+  const auto first = cells.begin() + cursor_y * width + cursor_x;
+  const auto last = cells.begin() + (cursor_y + 1) * width;
+  std::move_backward (first, last - n, last);
+  eraseCells (cursor_y, cursor_x, cursor_x + n - 1);
+  pending_wrap = false;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::deleteCells (int n)
+{
+  n = std::min(n, width - cursor_x);
+  const auto first = cells.begin() + cursor_y * width + cursor_x;
+  const auto last = cells.begin() + (cursor_y + 1) * width;
+  std::move (first + n, last, first);
+  eraseCells (cursor_y, width - n, width - 1);
+  pending_wrap = false;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::switchScreen (bool alternate)
+{
+  if ( alternate == alternate_screen )
+    return;
+
+  if ( alternate )
+  {
+    saved_cells = cells;
+    std::fill (cells.begin(), cells.end(), getBlankCharacter());
+  }
+  else
+  {
+    cells.swap(saved_cells);
+    saved_cells.clear();
+  }
+
+  alternate_screen = alternate;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::saveCursor()
+{
+  saved_x = cursor_x;
+  saved_y = cursor_y;
+  saved_attribute = attribute;
+}
+
+//----------------------------------------------------------------------
+void FScreenModel::restoreCursor()
+{
+  attribute = saved_attribute;
+  setCursor (saved_x, saved_y);
+}
+
+}  // namespace finalcut
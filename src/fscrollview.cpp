@@ -21,6 +21,7 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <memory>
 
 #include "final/fevent.h"
@@ -451,6 +452,10 @@ void FScrollView::draw()
     setReverse(false);
 
   setViewportPrint();
+
+  if ( viewport )  // Copies the whole visible viewport
+    viewport->has_changes = true;
+
   copy2area();
 
   if ( ! hbar->isShown() )
@@ -512,10 +517,10 @@ void FScrollView::onFocusIn (FFocusEvent* in_ev)
       focusLastChild();
 
     if ( prev_element )
-      prev_element->redraw();
+      prev_element->invalidate();
 
     if ( getFocusWidget() )
-      getFocusWidget()->redraw();
+      getFocusWidget()->invalidate();
 
     FFocusEvent cfi (Event::ChildFocusIn);
     onChildFocusIn(&cfi);
@@ -672,21 +677,30 @@ void FScrollView::copy2area()
   if ( printarea->height <= ay + y_end )
     y_end = printarea->height - ay;
 
-  for (auto y{0}; y < y_end; y++)  // line loop
+  // Only the visible part of the print area is copied
+  auto visible = getVisibleRegion(printarea, getTermGeometry());
+  visible.move ( -(printarea->offset_left + ax + 1)
+               , -(printarea->offset_top + ay + 1) );
+  const int x_first = std::max(visible.getX1(), 0);
+  const int x_last = std::min(visible.getX2(), x_end - 1);
+  const int y_first = std::max(visible.getY1(), 0);
+  const int y_last = std::min(visible.getY2(), y_end - 1);
+
+  for (auto y{y_first}; y <= y_last && x_first <= x_last; y++)  // line loop
   {
     const int v_line_len = viewport->width;
     const int a_line_len = printarea->width + printarea->right_shadow;
     // viewport character
-    const auto& vc = viewport->data[(dy + y) * v_line_len + dx];
+    const auto& vc = viewport->data[(dy + y) * v_line_len + dx + x_first];
     // area character
-    auto& ac = printarea->data[(ay + y) * a_line_len + ax];
-    std::memcpy (&ac, &vc, sizeof(FChar) * unsigned(x_end));
+    auto& ac = printarea->data[(ay + y) * a_line_len + ax + x_first];
+    std::memcpy (&ac, &vc, sizeof(FChar) * unsigned(x_last - x_first + 1));
 
-    if ( int(printarea->changes[ay + y].xmin) > ax )
-      printarea->changes[ay + y].xmin = uInt(ax);
+    if ( int(printarea->changes[ay + y].xmin) > ax + x_first )
+      printarea->changes[ay + y].xmin = uInt(ax + x_first);
 
-    if ( int(printarea->changes[ay + y].xmax) < ax + x_end - 1 )
-      printarea->changes[ay + y].xmax = uInt(ax + x_end - 1);
+    if ( int(printarea->changes[ay + y].xmax) < ax + x_last )
+      printarea->changes[ay + y].xmax = uInt(ax + x_last);
   }
 
   setViewportCursor();
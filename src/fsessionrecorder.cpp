@@ -0,0 +1,482 @@
+/***********************************************************************
+* fsessionrecorder.cpp - Records terminal sessions                     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "final/fobject.h"
+#include "final/fsessionrecorder.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+//----------------------------------------------------------------------
+std::size_t getUTF8Length (const std::string& str, std::size_t pos)
+{
+  // Returns the length of a valid UTF-8 sequence at pos or 0
+
+  const auto first = uChar(str[pos]);
+  std::size_t length{0};
+
+  if ( (first & 0xe0) == 0xc0 && first >= 0xc2 )
+    length = 2;
+  else if ( (first & 0xf0) == 0xe0 )
+    length = 3;
+  else if ( (first & 0xf8) == 0xf0 && first <= 0xf4 )
+    length = 4;
+  else
+    return 0;
+
+  if ( pos + length > str.length() )
+    return 0;
+
+  for (std::size_t i{1}; i < length; i++)
+    if ( (uChar(str[pos + i]) & 0xc0) != 0x80 )
+      return 0;
+
+  return length;
+}
+
+//----------------------------------------------------------------------
+void appendEscaped (std::string& json, const std::string& data)
+{
+  // JSON string escaping. Bytes that are not part of a valid UTF-8
+  // sequence are stored as low surrogates U+DC80...U+DCFF
+  // (like Python's "surrogateescape"), so that the input can be
+  // replayed byte by byte.
+
+  std::array<char, 8> hex{};
+  std::size_t pos{0};
+
+  while ( pos < data.length() )
+  {
+    const auto ch = uChar(data[pos]);
+
+    if ( ch == '"' || ch == '\\' )
+    {
+      json += '\\';
+      json += char(ch);
+    }
+    else if ( ch == '\n' )
+      json += "\\n";
+    else if ( ch == '\r' )
+      json += "\\r";
+    else if ( ch == '\t' )
+      json += "\\t";
+    else if ( ch < 0x20 || ch == 0x7f )
+    {
+      std::snprintf (hex.data(), hex.size(), "\\u%04x", ch);
+      json += hex.data();
+    }
+    else if ( ch >= 0x80 )
+    {
+      const auto length = getUTF8Length(data, pos);
+
+      if ( length > 0 )
+      {
+        json.append (data, pos, length);
+        pos += length;
+        continue;
+      }
+
+      std::snprintf (hex.data(), hex.size(), "\\u%04x", 0xdc00 + ch);
+      json += hex.data();
+    }
+    else
+      json += char(ch);
+
+    pos++;
+  }
+}
+
+//----------------------------------------------------------------------
+void appendCodePoint (std::string& str, uInt32 code)
+{
+  if ( code < 0x80 )
+    str += char(code);
+  else if ( code < 0x800 )
+  {
+    str += char(0xc0 | (code >> 6));
+    str += char(0x80 | (code & 0x3f));
+  }
+  else if ( code < 0x10000 )
+  {
+    str += char(0xe0 | (code >> 12));
+    str += char(0x80 | ((code >> 6) & 0x3f));
+    str += char(0x80 | (code & 0x3f));
+  }
+  else
+  {
+    str += char(0xf0 | (code >> 18));
+    str += char(0x80 | ((code >> 12) & 0x3f));
+    str += char(0x80 | ((code >> 6) & 0x3f));
+    str += char(0x80 | (code & 0x3f));
+  }
+}
+
+//----------------------------------------------------------------------
+bool readHex (const std::string& json, std::size_t pos, uInt32& code)
+{
+  if ( pos + 4 > json.length() )
+    return false;
+
+  const std::string digits{json, pos, 4};
+  char* end{nullptr};
+  code = uInt32(std::strtoul(digits.c_str(), &end, 16));
+  return end == digits.c_str() + 4;
+}
+
+//----------------------------------------------------------------------
+bool readString (const std::string& json, std::size_t& pos, std::string& str)
+{
+  // Reads a JSON string that starts at pos
+
+  if ( pos >= json.length() || json[pos] != '"' )
+    return false;
+
+  pos++;
+
+  while ( pos < json.length() && json[pos] != '"' )
+  {
+    if ( json[pos] != '\\' )
+    {
+      str += json[pos];
+      pos++;
+      continue;
+    }
+
+    pos++;
+
+    if ( pos >= json.length() )
+      return false;
+
+    const char esc = json[pos];
+    pos++;
+
+    if ( esc == 'n' )
+      str += '\n';
+    else if ( esc == 'r' )
+      str += '\r';
+    else if ( esc == 't' )
+      str += '\t';
+    else if ( esc == 'b' )
+      str += '\b';
+    else if ( esc == 'f' )
+      str += '\f';
+    else if ( esc == 'u' )
+    {
+      uInt32 code{};
+
+      if ( ! readHex(json, pos, code) )
+        return false;
+
+      pos += 4;
+
+      if ( code >= 0xdc80 && code <= 0xdcff )  // Escaped raw byte
+        str += char(code - 0xdc00);
+      else if ( code >= 0xd800 && code <= 0xdbff )  // Surrogate pair
+      {
+        uInt32 low{};
+
+        if ( json.compare(pos, 2, "\\u") != 0
+          || ! readHex(json, pos + 2, low) )
+          return false;
+
+        pos += 6;
+        appendCodePoint (str, 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00));
+      }
+      else
+        appendCodePoint (str, code);
+    }
+    else  // '"', '\\' or '/'
+      str += esc;
+  }
+
+  if ( pos >= json.length() )
+    return false;
+
+  pos++;  // Skip the closing quotation mark
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline void skipSeparator (const std::string& json, std::size_t& pos)
+{
+  while ( pos < json.length()
+       && (json[pos] == ' ' || json[pos] == ',' || json[pos] == '\t') )
+    pos++;
+}
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FSessionRecorder
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FSessionRecorder::~FSessionRecorder() noexcept  // destructor
+{
+  stop();
+}
+
+
+// public methods of FSessionRecorder
+//----------------------------------------------------------------------
+bool FSessionRecorder::start (const FString& filename, const FSize& size)
+{
+  if ( recording )
+    stop();
+
+  file.open (filename.c_str(), std::ofstream::out | std::ofstream::trunc);
+
+  if ( ! file.is_open() )
+    return false;
+
+  FObject::getCurrentTime (&start_time);
+  const char* term_env = std::getenv("TERM");
+  std::string header = "{\"version\": 2, \"width\": "
+                     + std::to_string(size.getWidth())
+                     + ", \"height\": " + std::to_string(size.getHeight())
+                     + ", \"timestamp\": " + std::to_string(start_time.tv_sec)
+                     + ", \"env\": {\"TERM\": \"";
+  appendEscaped (header, term_env ? term_env : "");
+  header += "\"}}\n";
+  file << header;
+  file.flush();
+  event_count = 0;
+  stop_writer = false;
+  recording = true;
+  writer = std::thread(&FSessionRecorder::writerLoop, this);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorder::stop()
+{
+  // Writes the pending events and closes the file
+
+  if ( ! recording )
+    return;
+
+  flushOutput();
+  recording = false;
+
+  {
+    std::lock_guard<std::mutex> lock{pending_mutex};
+    stop_writer = true;
+  }
+
+  writer_cond.notify_one();
+
+  if ( writer.joinable() )
+    writer.join();
+
+  file.close();
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorder::flushOutput()
+{
+  // The bytes collected by appendOutput() become one output event
+
+  if ( output.empty() )
+    return;
+
+  recordOutput (std::move(output));
+  output.clear();
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorder::recordOutput (std::string&& data)
+{
+  if ( ! data.empty() )
+    addEvent ('o', std::move(data));
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorder::recordInput (const std::string& input)
+{
+  if ( ! input.empty() )
+    addEvent ('i', std::string(input));
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorder::recordResize (const FSize& size)
+{
+  addEvent ( 'r', std::to_string(size.getWidth()) + "x"
+                + std::to_string(size.getHeight()) );
+}
+
+//----------------------------------------------------------------------
+std::string FSessionRecorder::toJSON (const Event& event)
+{
+  // Event line: [seconds, "type", "data"]
+
+  std::array<char, 32> time_str{};
+  std::snprintf ( time_str.data(), time_str.size(), "[%llu.%06llu, \""
+                , static_cast<unsigned long long>(event.time / 1000000)
+                , static_cast<unsigned long long>(event.time % 1000000) );
+  std::string json{time_str.data()};
+  json += event.type;
+  json += "\", \"";
+  appendEscaped (json, event.data);
+  json += "\"]";
+  return json;
+}
+
+//----------------------------------------------------------------------
+bool FSessionRecorder::fromJSON (const std::string& json, Event& event)
+{
+  std::size_t pos = json.find('[');
+
+  if ( pos == std::string::npos )
+    return false;
+
+  // Time in seconds with up to six decimal places
+  pos++;
+  skipSeparator (json, pos);
+  uInt64 seconds{0};
+  uInt64 usec{0};
+  uInt64 scale{100000};
+  bool has_digits{false};
+
+  while ( pos < json.length() && json[pos] >= '0' && json[pos] <= '9' )
+  {
+    seconds = seconds * 10 + uInt64(json[pos] - '0');
+    has_digits = true;
+    pos++;
+  }
+
+  if ( pos < json.length() && json[pos] == '.' )
+    pos++;
+
+  while ( pos < json.length() && json[pos] >= '0' && json[pos] <= '9' )
+  {
+    usec += uInt64(json[pos] - '0') * scale;
+    scale /= 10;
+    pos++;
+  }
+
+  if ( ! has_digits )
+    return false;
+
+  std::string type{};
+  std::string data{};
+  skipSeparator (json, pos);
+
+  if ( ! readString(json, pos, type) || type.length() != 1 )
+    return false;
+
+  skipSeparator (json, pos);
+
+  if ( ! readString(json, pos, data) )
+    return false;
+
+  event.time = seconds * 1000000 + usec;
+  event.type = type[0];
+  event.data = std::move(data);
+  return true;
+}
+
+
+// private methods of FSessionRecorder
+//----------------------------------------------------------------------
+void FSessionRecorder::addEvent (char type, std::string&& data)
+{
+  if ( ! recording )
+    return;
+
+  timeval now{};
+  FObject::getCurrentTime (&now);
+  const timeval diff = now - start_time;
+  Event event{};
+  event.time = uInt64(diff.tv_sec) * 1000000 + uInt64(diff.tv_usec);
+  event.type = type;
+  event.data = std::move(data);
+  bool wake_writer{false};
+
+  {
+    std::lock_guard<std::mutex> lock{pending_mutex};
+    pending_bytes += event.data.length();
+    pending.push_back(std::move(event));
+    wake_writer = ( pending_bytes >= WRITE_THRESHOLD );
+  }
+
+  event_count++;
+
+  if ( wake_writer )
+    writer_cond.notify_one();
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorder::writerLoop()
+{
+  std::vector<Event> batch{};
+  std::string lines{};
+  std::unique_lock<std::mutex> lock{pending_mutex};
+
+  while ( true )
+  {
+    writer_cond.wait_for ( lock, std::chrono::milliseconds(250)
+                         , [this] ()
+                           {
+                             return stop_writer
+                                 || pending_bytes >= WRITE_THRESHOLD;
+                           } );
+    batch.swap(pending);
+    pending_bytes = 0;
+    const bool done = stop_writer;
+    lock.unlock();
+
+    // Format and write without holding the lock
+    for (auto&& event : batch)
+    {
+      lines += toJSON(event);
+      lines += '\n';
+    }
+
+    if ( ! lines.empty() )
+    {
+      file << lines;
+      file.flush();
+    }
+
+    batch.clear();
+    lines.clear();
+    lock.lock();
+
+    if ( done && pending.empty() )
+      break;
+  }
+}
+
+}  // namespace finalcut
@@ -0,0 +1,230 @@
+/***********************************************************************
+* fsessionreplay.cpp - Replays recorded terminal sessions              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "final/fheadlessterminal.h"
+#include "final/fobject.h"
+#include "final/fsessionreplay.h"
+
+namespace finalcut
+{
+
+namespace
+{
+
+//----------------------------------------------------------------------
+int getHeaderValue (const std::string& header, const std::string& key)
+{
+  // Returns the number after "key": in the header line or -1
+
+  auto pos = header.find("\"" + key + "\"");
+
+  if ( pos == std::string::npos )
+    return -1;
+
+  pos = header.find(':', pos);
+
+  if ( pos == std::string::npos )
+    return -1;
+
+  return std::atoi(header.c_str() + pos + 1);
+}
+
+}  // anonymous namespace
+
+
+//----------------------------------------------------------------------
+// class FSessionReplay
+//----------------------------------------------------------------------
+
+// public methods of FSessionReplay
+//----------------------------------------------------------------------
+bool FSessionReplay::load (const FString& filename)
+{
+  std::ifstream file{filename.c_str()};
+
+  if ( ! file.is_open() )
+    return false;
+
+  return load(file);
+}
+
+//----------------------------------------------------------------------
+bool FSessionReplay::load (std::istream& stream)
+{
+  std::string line{};
+  events.clear();
+  timings.clear();
+  next_event = 0;
+  next_timing = 0;
+  started = false;
+  waiting_for_frame = false;
+
+  // Header line
+  if ( ! std::getline(stream, line) || getHeaderValue(line, "version") != 2 )
+    return false;
+
+  const int width = getHeaderValue(line, "width");
+  const int height = getHeaderValue(line, "height");
+
+  if ( width > 0 && height > 0 )
+    size.setSize (std::size_t(width), std::size_t(height));
+
+  // Event lines
+  while ( std::getline(stream, line) )
+  {
+    if ( line.empty() )
+      continue;
+
+    Event event{};
+
+    if ( ! FSessionRecorder::fromJSON(line, event) )
+      return false;
+
+    events.push_back(std::move(event));
+  }
+
+  calculateRecordedLatency();
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FSessionReplay::process (FHeadlessTerminal& terminal)
+{
+  // Sends all events that are due and advances a fixed clock
+
+  timeval now{};
+  FObject::getCurrentTime (&now);
+
+  if ( ! started )
+  {
+    start_time = now;
+    started = true;
+  }
+
+  checkFrame (terminal);
+  const timeval diff = now - start_time;
+  const auto elapsed = uInt64(diff.tv_sec) * 1000000 + uInt64(diff.tv_usec);
+
+  while ( next_event < events.size() && events[next_event].time <= elapsed )
+  {
+    sendEvent (terminal, events[next_event]);
+    next_event++;
+  }
+
+  if ( waiting_for_frame && next_event >= events.size()
+    && elapsed > events.back().time + FRAME_TIMEOUT )
+    waiting_for_frame = false;  // The last input produced no output
+
+  if ( ! FObject::hasFixedTime() || isFinished() )
+    return;
+
+  // Fast-forward to the next event in steps of at most 20 ms,
+  // so that the flush interval of the application can elapse
+  uInt64 step = MAX_TIME_STEP;
+
+  if ( next_event < events.size() )
+    step = std::min(step, events[next_event].time - elapsed);
+
+  FHeadlessTerminal::advanceClock (std::max(step, uInt64(1)));
+}
+
+
+// private methods of FSessionReplay
+//----------------------------------------------------------------------
+void FSessionReplay::calculateRecordedLatency()
+{
+  // The recorded latency is the time from an input event
+  // to the following output event
+
+  for (auto iter = events.cbegin(); iter != events.cend(); ++iter)
+  {
+    if ( iter->type != 'i' )
+      continue;
+
+    FrameTiming timing{};
+    timing.input_time = iter->time;
+    const auto next = std::find_if ( iter + 1, events.cend()
+                                   , [] (const Event& event)
+                                     {
+                                       return event.type != 'r';
+                                     } );
+
+    if ( next != events.cend() && next->type == 'o' )
+    {
+      timing.recorded_latency = next->time - iter->time;
+      timing.recorded_frame = true;
+    }
+
+    timings.push_back(timing);
+  }
+}
+
+//----------------------------------------------------------------------
+void FSessionReplay::checkFrame (const FHeadlessTerminal& terminal)
+{
+  if ( ! waiting_for_frame
+    || terminal.getScreen().getByteCount() == byte_count )
+    return;
+
+  const auto latency = clock::now() - input_sent;
+  auto& timing = timings[next_timing - 1];
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  timing.replayed_latency = uInt64(duration_cast<microseconds>(latency).count());
+  timing.replayed_frame = true;
+  waiting_for_frame = false;
+}
+
+//----------------------------------------------------------------------
+void FSessionReplay::sendEvent (FHeadlessTerminal& terminal, const Event& event)
+{
+  if ( event.type == 'i' && next_timing < timings.size() )
+  {
+    // An input without output ends the previous measurement
+    byte_count = terminal.getScreen().getByteCount();
+    input_sent = clock::now();
+    terminal.sendInput (event.data);
+    next_timing++;
+    waiting_for_frame = true;
+  }
+  else if ( event.type == 'r' )
+  {
+    const auto separator = event.data.find('x');
+
+    if ( separator == std::string::npos )
+      return;
+
+    const int width = std::atoi(event.data.c_str());
+    const int height = std::atoi(event.data.c_str() + separator + 1);
+
+    if ( width > 0 && height > 0 )
+      terminal.setSize (FSize{std::size_t(width), std::size_t(height)});
+  }
+}
+
+}  // namespace finalcut
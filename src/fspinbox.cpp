@@ -368,8 +368,8 @@ inline void FSpinBox::updateInputField()
 {
   input_field.clear();
   input_field << pfix << value << sfix;
-  input_field.redraw();
-  redraw();
+  input_field.invalidate();
+  invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -426,9 +426,9 @@ void FSpinBox::forceFocus()
   setFocus();
 
   if ( focused_widget )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
-  redraw();
+  invalidate();
 
   if ( getStatusBar() )
     getStatusBar()->drawMessage();
@@ -49,6 +49,8 @@ FStartOptions::FStartOptions()
   , meta_sends_escape{true}
 #endif
   , dark_theme{false}
+  , termcap_cache{true}
+  , termcap_refresh{false}
 { }
 
 
@@ -69,7 +71,11 @@ void FStartOptions::setDefault()
   color_change = true;
   vgafont = false;
   newfont = false;
+  termcap_cache = true;
+  termcap_refresh = false;
   encoding = Encoding::Unknown;
+  record_file.clear();
+  compositor_threads = 1;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
   meta_sends_escape = true;
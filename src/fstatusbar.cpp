@@ -104,7 +104,7 @@ void FStatusKey::init()
   setGeometry (FPoint{1, 1}, FSize{1, 1});
   FWidget* parent = getParentWidget();
 
-  if ( parent && parent->isInstanceOf("FStatusBar") )
+  if ( parent && parent->isA<FStatusBar>() )
   {
     setConnectedStatusbar (static_cast<FStatusBar*>(parent));
 
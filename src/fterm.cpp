@@ -20,14 +20,18 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <unistd.h>
+
 #include <algorithm>
 #include <array>
+#include <cerrno>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "final/fapplication.h"
 #include "final/fc.h"
+#include "final/fcharencoder.h"
 #include "final/fcharmap.h"
 #include "final/fkey_map.h"
 #include "final/fkeyboard.h"
@@ -35,12 +39,14 @@
 #include "final/fmouse.h"
 #include "final/foptiattr.h"
 #include "final/foptimove.h"
+#include "final/fsessionrecorder.h"
 #include "final/fstartoptions.h"
 #include "final/fstring.h"
 #include "final/fsystemimpl.h"
 #include "final/fterm.h"
 #include "final/ftermbuffer.h"
 #include "final/ftermcap.h"
+#include "final/ftermcapcache.h"
 #include "final/ftermcapquirks.h"
 #include "final/ftermdata.h"
 #include "final/ftermdebugdata.h"
@@ -68,14 +74,16 @@ namespace internal
 
 struct var
 {
-  static FTerm* init_term_object;  // Global FTerm object
-  static bool   term_initialized;  // Global init state
-  static uInt   object_counter;    // Counts the number of object instances
+  static FTerm*             init_term_object;  // Global FTerm object
+  static bool               term_initialized;  // Global init state
+  static uInt               object_counter;    // Counts the number of object instances
+  static std::array<int, 2> resize_pipe;       // Self-pipe for SIGWINCH
 };
 
-FTerm* var::init_term_object{nullptr};
-bool   var::term_initialized{false};
-uInt   var::object_counter{0};
+FTerm*             var::init_term_object{nullptr};
+bool               var::term_initialized{false};
+uInt               var::object_counter{0};
+std::array<int, 2> var::resize_pipe{{-1, -1}};
 
 }  // namespace internal
 
@@ -139,6 +147,8 @@ FString FTerm::getKeyName (FKey keynum)
 //----------------------------------------------------------------------
 charSubstitution& FTerm::getCharSubstitutionMap()
 {
+  // The caller can change the map
+  FTerm::getFCharEncoder()->invalidate();
   const auto& data = FTerm::getFTermData();
   return data->getCharSubstitutionMap();
 }
@@ -218,6 +228,20 @@ auto FTerm::getFTermDetection() -> const std::unique_ptr<FTermDetection>&
   return term_detection;
 }
 
+//----------------------------------------------------------------------
+auto FTerm::getFTermcapCache() -> const std::unique_ptr<FTermcapCache>&
+{
+  static const auto& termcap_cache = make_unique<FTermcapCache>();
+  return termcap_cache;
+}
+
+//----------------------------------------------------------------------
+auto FTerm::getFCharEncoder() -> const std::unique_ptr<FCharEncoder>&
+{
+  static const auto& char_encoder = make_unique<FCharEncoder>();
+  return char_encoder;
+}
+
 //----------------------------------------------------------------------
 auto FTerm::getFTermXTerminal() -> const std::unique_ptr<FTermXTerminal>&
 {
@@ -239,6 +263,13 @@ auto FTerm::getFMouseControl() -> const std::unique_ptr<FMouseControl>&
   return mouse;
 }
 
+//----------------------------------------------------------------------
+auto FTerm::getFSessionRecorder() -> const std::unique_ptr<FSessionRecorder>&
+{
+  static const auto& recorder = make_unique<FSessionRecorder>();
+  return recorder;
+}
+
 #if defined(__linux__) || defined(UNIT_TEST)
 //----------------------------------------------------------------------
 auto FTerm::getFTermLinux() -> const std::unique_ptr<FTermLinux>&
@@ -1064,21 +1095,8 @@ wchar_t FTerm::charEncode (wchar_t c)
 //----------------------------------------------------------------------
 wchar_t FTerm::charEncode (wchar_t c, Encoding enc)
 {
-  wchar_t ch_enc = c;
-
-  for (auto&& entry : fc::character)
-  {
-    if ( entry.unicode == c )
-    {
-      ch_enc = getCharacter(entry, enc);
-      break;
-    }
-  }
-
-  if ( enc == Encoding::PC && ch_enc == c )
-    ch_enc = finalcut::unicode_to_cp437(c);
-
-  return ch_enc;
+  const auto& char_encoder = FTerm::getFCharEncoder();
+  return char_encoder->encode (c, enc);
 }
 
 //----------------------------------------------------------------------
@@ -1128,9 +1146,7 @@ void FTerm::putstring (const std::string& str, int affcnt)
 //----------------------------------------------------------------------
 int FTerm::putchar_ASCII (int c)
 {
-  const auto& fsys = FTerm::getFSystem();
-
-  if ( fsys->putchar(char(c)) == EOF )
+  if ( putbyte(char(c)) == EOF )
     return 0;
   else
     return 1;
@@ -1139,36 +1155,34 @@ int FTerm::putchar_ASCII (int c)
 //----------------------------------------------------------------------
 int FTerm::putchar_UTF8 (int c)
 {
-  const auto& fsys = FTerm::getFSystem();
-
   if ( c < 0x80 )
   {
     // 1 Byte (7-bit): 0xxxxxxx
-    fsys->putchar (c);
+    putbyte (c);
     return 1;
   }
   else if ( c < 0x800 )
   {
     // 2 byte (11-bit): 110xxxxx 10xxxxxx
-    fsys->putchar (0xc0 | (c >> 6) );
-    fsys->putchar (0x80 | (c & 0x3f) );
+    putbyte (0xc0 | (c >> 6) );
+    putbyte (0x80 | (c & 0x3f) );
     return 2;
   }
   else if ( c < 0x10000 )
   {
     // 3 byte (16-bit): 1110xxxx 10xxxxxx 10xxxxxx
-    fsys->putchar (0xe0 | (c >> 12) );
-    fsys->putchar (0x80 | ((c >> 6) & 0x3f) );
-    fsys->putchar (0x80 | (c & 0x3f) );
+    putbyte (0xe0 | (c >> 12) );
+    putbyte (0x80 | ((c >> 6) & 0x3f) );
+    putbyte (0x80 | (c & 0x3f) );
     return 3;
   }
   else if ( c < 0x200000 )
   {
     // 4 byte (21-bit): 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-    fsys->putchar (0xf0 | (c >> 18) );
-    fsys->putchar (0x80 | ((c >> 12) & 0x3f) );
-    fsys->putchar (0x80 | ((c >> 6) & 0x3f) );
-    fsys->putchar (0x80 | (c & 0x3f));
+    putbyte (0xf0 | (c >> 18) );
+    putbyte (0x80 | ((c >> 12) & 0x3f) );
+    putbyte (0x80 | ((c >> 6) & 0x3f) );
+    putbyte (0x80 | (c & 0x3f));
     return 4;
   }
   else
@@ -1219,6 +1233,20 @@ inline FStartOptions& FTerm::getStartOptions()
   return FStartOptions::getFStartOptions();
 }
 
+//----------------------------------------------------------------------
+inline int FTerm::putbyte (int c)
+{
+  // Writes a byte to the terminal. A running session recording
+  // receives exactly the bytes that are written.
+
+  const auto& recorder = getFSessionRecorder();
+
+  if ( recorder->isRecording() )
+    recorder->appendOutput (char(c));
+
+  return getFSystem()->putchar(c);
+}
+
 //----------------------------------------------------------------------
 void FTerm::init_global_values()
 {
@@ -1312,6 +1340,8 @@ void FTerm::init_alt_charset()
         getCharacter(fc::character[item], Encoding::VT100) = L'\0';
     }
   }
+
+  FTerm::getFCharEncoder()->invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -1411,6 +1441,7 @@ void FTerm::init_cygwin_charmap()
   sub_map[L'♪'] = L'♫';
   sub_map[L'√'] = L'x';
   sub_map[L'ˣ'] = L'`';
+  FTerm::getFCharEncoder()->invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -1438,6 +1469,8 @@ void FTerm::init_teraterm_charmap()
   for (auto&& entry : fc::character)
     if ( entry.pc < 0x20 )
       entry.pc = entry.ascii;
+
+  FTerm::getFCharEncoder()->invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -1445,6 +1478,10 @@ void FTerm::init_termcap()
 {
   // Initialize the terminal capabilities
 
+  // Use the cached capabilities of an already known terminal
+  if ( FTerm::getFTermcapCache()->restoreTermcap() )
+    return;
+
   FTermcap::init();
 }
 
@@ -1453,7 +1490,17 @@ void FTerm::init_quirks()
 {
   // Initialize terminal quirks
 
+  const auto& termcap_cache = FTerm::getFTermcapCache();
+
+  // The cached capabilities already contain the quirks
+  if ( termcap_cache->isRestored() )
+    return;
+
   FTermcapQuirks::terminalFixup();  // Fix terminal quirks
+
+  // Store the resolved capabilities for the next start
+  termcap_cache->storeTermcap();
+  termcap_cache->save();
 }
 
 //----------------------------------------------------------------------
@@ -1541,6 +1588,11 @@ void FTerm::init_optiAttr()
 
   const auto& opti_attr = FTerm::getFOptiAttr();
   opti_attr->setTermEnvironment(optiattr_env);
+
+  if ( FTerm::getFTermDetection()->canDisplayTrueColor() )
+    opti_attr->setTrueColorSupport();
+  else
+    opti_attr->unsetTrueColorSupport();
 }
 
 //----------------------------------------------------------------------
@@ -1640,6 +1692,9 @@ void FTerm::init_encoding()
   {
     setEncoding(getStartOptions().encoding);
   }
+
+  // Terminal type and charset are known now
+  FTerm::getFCharEncoder()->invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -2133,6 +2188,10 @@ void FTerm::init()
   if ( isXTerminal() )
     getFTermXTerminal()->metaSendsESC(true);
 
+  // Activate the bracketed paste mode on all terminals that know it
+  if ( isXTerminal() || getFTermDetection()->hasBracketedPasteSupport() )
+    getFTermXTerminal()->bracketedPaste(true);
+
   // switch to application escape key mode
   enableApplicationEscKey();
 
@@ -2142,6 +2201,10 @@ void FTerm::init()
   // Switch to the alternate screen
   useAlternateScreenBuffer();
 
+  // Activate an unambiguous keyboard protocol (if supported).
+  // Kitty keeps separate flag stacks for both screen buffers.
+  getFTermXTerminal()->keyboardProtocol(true);
+
   // Enable alternate charset
   enableAlternateCharset();
 
@@ -2218,6 +2281,11 @@ bool FTerm::init_terminal() const
   // Get output baud rate
   initBaudRate();
 
+  // Terminal capability cache
+  const auto& termcap_cache = FTerm::getFTermcapCache();
+  termcap_cache->setEnabled (getStartOptions().termcap_cache);
+  termcap_cache->setRefresh (getStartOptions().termcap_refresh);
+
   // Terminal detection
   FTermDetection::detect();
   const auto& term_detection = FTerm::getFTermDetection();
@@ -2346,6 +2414,12 @@ void FTerm::finish() const
   if ( isXTerminal() )
     getFTermXTerminal()->metaSendsESC(false);
 
+  // Deactivate the bracketed paste mode (if it was activated)
+  getFTermXTerminal()->bracketedPaste(false);
+
+  // Deactivate the keyboard protocol of the alternate screen
+  getFTermXTerminal()->keyboardProtocol(false);
+
   // Switch to the normal screen
   useNormalScreenBuffer();
 
@@ -2357,6 +2431,9 @@ void FTerm::finish() const
 
   if ( data->isNewFont() || data->isVGAFont() )
     resetFont();
+
+  // The recording ends with the restored terminal settings
+  getFSessionRecorder()->stop();
 }
 
 //----------------------------------------------------------------------
@@ -2404,6 +2481,19 @@ void FTerm::terminalSizeChange()
 
   // Initialize a resize event to the root element
   data->setTermResized(true);
+
+  // Wake up the input waiting of the main loop. All further signals
+  // until the next relayout are merged into this one notification.
+  const int fd = internal::var::resize_pipe[1];
+
+  if ( fd < 0 )
+    return;
+
+  const int saved_errno = errno;
+  const char byte{0};
+  const auto bytes = write (fd, &byte, 1);
+  static_cast<void>(bytes);
+  errno = saved_errno;
 }
 
 //----------------------------------------------------------------------
@@ -2426,6 +2516,7 @@ void FTerm::processTermination (int signum)
 //----------------------------------------------------------------------
 void FTerm::setSignalHandler()
 {
+  openResizePipe();
   signal(SIGTERM,  FTerm::signal_handler);  // Termination signal
   signal(SIGQUIT,  FTerm::signal_handler);  // Quit from keyboard (Ctrl-\)
   signal(SIGINT,   FTerm::signal_handler);  // Keyboard interrupt (Ctrl-C)
@@ -2445,6 +2536,44 @@ void FTerm::resetSignalHandler()
   signal(SIGINT,   SIG_DFL);  // Keyboard interrupt (Ctrl-C)
   signal(SIGQUIT,  SIG_DFL);  // Quit from keyboard (Ctrl-\)
   signal(SIGTERM,  SIG_DFL);  // Termination signal
+  closeResizePipe();
+}
+
+//----------------------------------------------------------------------
+void FTerm::openResizePipe()
+{
+  // The signal handler writes into this self-pipe, so that a
+  // terminal resize ends the waiting for keyboard input immediately
+
+  auto& fds = internal::var::resize_pipe;
+
+  if ( fds[0] >= 0 || pipe(fds.data()) != 0 )
+    return;
+
+  for (const auto& fd : fds)
+  {
+    fcntl (fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl (fd, F_SETFD, FD_CLOEXEC);
+  }
+
+  getFKeyboard()->setWakeupDescriptor(fds[0]);
+}
+
+//----------------------------------------------------------------------
+void FTerm::closeResizePipe()
+{
+  auto& fds = internal::var::resize_pipe;
+
+  if ( fds[0] < 0 )
+    return;
+
+  getFKeyboard()->setWakeupDescriptor(-1);
+
+  for (auto&& fd : fds)
+  {
+    close (fd);
+    fd = -1;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -26,6 +26,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cctype>
+#include <chrono>
 #include <limits>
 #include <numeric>
 #include <utility>
@@ -36,6 +38,7 @@
 #include "final/fpoint.h"
 #include "final/fterm.h"
 #include "final/ftermbuffer.h"
+#include "final/ftermdata.h"
 #include "final/ftermios.h"
 
 
@@ -58,6 +61,7 @@ static FullWidthSupport has_fullwidth_support = FullWidthSupport::Unknown;
 
 // Function prototypes
 bool hasAmbiguousWidth (wchar_t);
+std::size_t getDeviceAttributesLength (const std::string&, std::size_t);
 
 // Data array
 const wchar_t ambiguous_width_list[] =
@@ -674,51 +678,157 @@ std::size_t searchRightCharBegin (const FString& string, std::size_t pos)
 }
 
 //----------------------------------------------------------------------
-FPoint readCursorPos()
+inline std::size_t getDeviceAttributesLength ( const std::string& str
+                                             , std::size_t pos )
+{
+  // Returns the length of a device attributes report
+  // (ESC [ ? Ps ; ... c  or  ESC [ > Ps ; ... c) at position pos
+
+  if ( pos + 3 >= str.length()
+    || str[pos] != ESC[0]
+    || str[pos + 1] != '['
+    || (str[pos + 2] != '?' && str[pos + 2] != '>') )
+    return 0;
+
+  std::size_t n{pos + 3};
+
+  while ( n < str.length() && (std::isdigit(uChar(str[n])) || str[n] == ';') )
+    n++;
+
+  if ( n < str.length() && str[n] == 'c' )
+    return n - pos + 1;
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+std::string queryTerminal ( const std::string& query
+                          , uInt64 timeout
+                          , std::size_t replies )
 {
-  int x{-1};
-  int y{-1};
+  // Sends all queries in a single write, terminated by a primary
+  // device attributes request (DA1). Terminals answer requests in
+  // the order of receipt, so the DA1 report marks the end of all
+  // answers. The function returns everything that was read before
+  // this sentinel. The parameter replies gives the number of device
+  // attributes reports that are expected (including the sentinel).
+  // A terminal that does not answer the sentinel within the timeout
+  // (in µs) is marked as unresponsive and will not be queried again.
+
+  using namespace std::chrono;
+  const auto& fterm_data = FTerm::getFTermData();
+
+  if ( ! fterm_data->isTermResponsive() )
+    return {};
+
   const int stdin_no{FTermios::getStdIn()};
   const int stdout_no{FTermios::getStdOut()};
-  fd_set ifds{};
-  struct timeval tv{};
-  constexpr auto& DECXCPR{ESC "[6n"};
+  const std::string request{query + ESC "[c"};  // Append DA1
+  std::fflush(stdout);  // Write out pending output first
 
-  // Report Cursor Position (DECXCPR)
-  if ( write(stdout_no, DECXCPR, std::strlen(DECXCPR)) < 1 )
-    return {x, y};
-
-  std::fflush(stdout);
-  FD_ZERO(&ifds);
-  FD_SET(stdin_no, &ifds);
-  tv.tv_sec  = 0;
-  tv.tv_usec = 100000;  // 100 ms
-  std::array<char, 20> temp{};
-  std::size_t pos{0};
+  if ( write(stdout_no, request.data(), request.length()) == -1 )
+    return {};
 
-  // Read the answer
-  if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) != 1 )
-    return {x, y};
+  constexpr auto grace_time = microseconds(20000);  // 20 ms
+  auto deadline = steady_clock::now() + microseconds(timeout);
+  std::array<char, 512> temp{};
+  std::string answer{};
+  std::size_t reports{0};
+  std::size_t sentinel_pos{std::string::npos};
 
-  do
+  while ( reports < replies )
   {
-    std::size_t bytes_free = temp.size() - pos - 1;
-    const ssize_t bytes = read(stdin_no, &temp[pos], bytes_free);
+    const auto remaining = duration_cast<microseconds>
+    (
+      deadline - steady_clock::now()
+    ).count();
+
+    if ( remaining <= 0 )
+      break;
+
+    fd_set ifds{};
+    struct timeval tv{};
+    FD_ZERO(&ifds);
+    FD_SET(stdin_no, &ifds);
+    tv.tv_sec  = remaining / 1000000;
+    tv.tv_usec = remaining % 1000000;
+
+    if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
+      break;
+
+    const ssize_t bytes = read(stdin_no, temp.data(), temp.size());
 
     if ( bytes <= 0 )
       break;
 
-    pos += std::size_t(bytes);
+    answer.append(temp.data(), std::size_t(bytes));
+    reports = 0;
+    std::size_t n{0};
+
+    while ( n < answer.length() )
+    {
+      const auto len = getDeviceAttributesLength(answer, n);
+
+      if ( len > 0 )
+      {
+        reports++;
+        sentinel_pos = n;
+        n += len;
+      }
+      else
+        n++;
+    }
+
+    // All outstanding reports follow the first one immediately
+    if ( reports > 0 )
+      deadline = std::min(deadline, steady_clock::now() + grace_time);
   }
-  while ( pos < temp.size() && ! std::strchr(temp.data(), 'R') );
 
-  if ( pos > 4 )
+  if ( reports == 0 )
+  {
+    // The terminal does not answer queries
+    fterm_data->setTermResponsive(false);
+    return answer;
+  }
+
+  // Remove the sentinel report
+  const auto len = getDeviceAttributesLength(answer, sentinel_pos);
+  answer.erase(sentinel_pos, len);
+  return answer;
+}
+
+//----------------------------------------------------------------------
+FPoint parseCursorPos (const std::string& answer)
+{
+  // Searches the answer for the cursor position report
+
+  std::size_t pos{0};
+
+  while ( (pos = answer.find(ESC "[", pos)) != std::string::npos )
   {
-    constexpr auto parse = "\033[%4d;%4dR";
-    std::sscanf(temp.data(), parse, &y, &x );
+    int x{-1};
+    int y{-1};
+    char final_char{'\0'};
+    constexpr auto parse = "\033[%4d;%4d%c";
+
+    if ( std::sscanf(answer.c_str() + pos, parse, &y, &x, &final_char) == 3
+      && final_char == 'R' )
+      return {x, y};
+
+    pos += 2;
   }
 
-  return {x, y};
+  return {-1, -1};
+}
+
+//----------------------------------------------------------------------
+FPoint readCursorPos()
+{
+  constexpr auto& DECXCPR{ESC "[6n"};
+
+  // Report Cursor Position (DECXCPR)
+  const auto& answer = queryTerminal (DECXCPR, 100000);  // 100 ms
+  return parseCursorPos(answer);
 }
 
 }  // namespace finalcut
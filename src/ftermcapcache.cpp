@@ -0,0 +1,518 @@
+/***********************************************************************
+* ftermcapcache.cpp - On-disk cache of detected terminal capabilities  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/fkey_map.h"
+#include "final/fterm.h"
+#include "final/ftermcap.h"
+#include "final/ftermcapcache.h"
+#include "final/ftermdata.h"
+#include "final/ftermdetection.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+struct TermcapFlag
+{
+  const char* name;
+  bool*       var;
+};
+
+struct TermcapNumber
+{
+  const char* name;
+  int*        var;
+};
+
+//----------------------------------------------------------------------
+const std::array<TermcapFlag, 12>& getTermcapFlags()
+{
+  static const std::array<TermcapFlag, 12> flags
+  {{
+    { "background_color_erase",    &FTermcap::background_color_erase },
+    { "can_change_color_palette",  &FTermcap::can_change_color_palette },
+    { "automatic_left_margin",     &FTermcap::automatic_left_margin },
+    { "automatic_right_margin",    &FTermcap::automatic_right_margin },
+    { "eat_nl_glitch",             &FTermcap::eat_nl_glitch },
+    { "has_ansi_escape_sequences", &FTermcap::has_ansi_escape_sequences },
+    { "ansi_default_color",        &FTermcap::ansi_default_color },
+    { "osc_support",               &FTermcap::osc_support },
+    { "no_utf8_acs_chars",         &FTermcap::no_utf8_acs_chars },
+    { "no_padding_char",           &FTermcap::no_padding_char },
+    { "xon_xoff_flow_control",     &FTermcap::xon_xoff_flow_control },
+    { "monochron",                 nullptr }  // stored in FTermData
+  }};
+
+  return flags;
+}
+
+//----------------------------------------------------------------------
+const std::array<TermcapNumber, 4>& getTermcapNumbers()
+{
+  static const std::array<TermcapNumber, 4> numbers
+  {{
+    { "max_color",          &FTermcap::max_color },
+    { "tabstop",            &FTermcap::tabstop },
+    { "padding_baudrate",   &FTermcap::padding_baudrate },
+    { "attr_without_color", &FTermcap::attr_without_color }
+  }};
+
+  return numbers;
+}
+
+//----------------------------------------------------------------------
+std::string getTerminalTypeString()
+{
+  // Returns the detected terminal type bits as a hex string
+
+  const auto& type = FTerm::getFTermDetection()->getTermTypeStruct();
+  std::array<uChar, sizeof(type)> bytes{};
+  std::memcpy (bytes.data(), &type, sizeof(type));
+  std::string hex{};
+
+  for (const auto& byte : bytes)
+  {
+    static constexpr char digits[] = "0123456789abcdef";
+    hex += digits[byte >> 4];
+    hex += digits[byte & 0x0f];
+  }
+
+  return hex;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FTermcapCache
+//----------------------------------------------------------------------
+
+// public methods of FTermcapCache
+//----------------------------------------------------------------------
+std::string FTermcapCache::getFileName() const
+{
+  const auto& dir = getCacheDirectory();
+
+  if ( dir.empty() || key.empty() )
+    return {};
+
+  // 64-bit FNV-1a hash of the cache key
+  uInt64 hash{0xcbf29ce484222325};
+
+  for (const auto& ch : key)
+  {
+    hash ^= uChar(ch);
+    hash *= 0x100000001b3;
+  }
+
+  std::array<char, 17> hex{};
+  std::snprintf (hex.data(), hex.size(), "%016llx", static_cast<unsigned long long>(hash));
+  return dir + "/termcap-" + hex.data();
+}
+
+//----------------------------------------------------------------------
+const std::string& FTermcapCache::getValue (const std::string& name) const
+{
+  static const std::string empty{};
+  const auto iter = values.find(name);
+  return ( iter != values.end() ) ? iter->second : empty;
+}
+
+//----------------------------------------------------------------------
+bool FTermcapCache::load ( const std::string& term
+                         , const std::string& answerback
+                         , const std::string& sec_da )
+{
+  // Creates the cache key and reads the matching cache file
+
+  clear();
+
+  if ( ! enabled )
+    return false;
+
+  key = encode(term) + ' '
+      + encode(answerback) + ' '
+      + encode(sec_da);
+
+  if ( refresh )
+    return false;
+
+  std::ifstream file{getFileName()};
+
+  if ( ! file.is_open() )
+    return false;
+
+  std::string line{};
+
+  if ( ! std::getline(file, line) || line != getHeader() )
+    return false;
+
+  if ( ! std::getline(file, line) || line != "key=" + key )
+    return false;
+
+  std::map<std::string, std::string> entries{};
+
+  while ( std::getline(file, line) )
+  {
+    const auto pos = line.find('=');
+
+    if ( pos != std::string::npos )
+      entries[line.substr(0, pos)] = decode(line.substr(pos + 1));
+  }
+
+  values = std::move(entries);
+  loaded = true;
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FTermcapCache::save() const
+{
+  // Writes the cache file atomically via a temporary file
+
+  if ( ! enabled || key.empty() )
+    return false;
+
+  const auto& dir = getCacheDirectory();
+
+  if ( dir.empty() )
+    return false;
+
+  // Create the cache directory (and its parent) if necessary
+  const auto parent = dir.substr(0, dir.rfind('/'));
+  ::mkdir (parent.data(), 0700);
+  ::mkdir (dir.data(), 0700);
+
+  const auto& filename = getFileName();
+  const auto& tmp_filename = filename + ".tmp" + std::to_string(::getpid());
+
+  {
+    std::ofstream file{tmp_filename, std::ios::trunc};
+
+    if ( ! file.is_open() )
+      return false;
+
+    file << getHeader() << '\n'
+         << "key=" << key << '\n';
+
+    for (const auto& entry : values)
+      file << entry.first << '=' << encode(entry.second) << '\n';
+
+    file.flush();
+
+    if ( ! file.good() )
+    {
+      file.close();
+      std::remove (tmp_filename.data());
+      return false;
+    }
+  }
+
+  if ( std::rename(tmp_filename.data(), filename.data()) != 0 )
+  {
+    std::remove (tmp_filename.data());
+    return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FTermcapCache::restoreTermcap()
+{
+  // Sets the termcap variables from the cached values
+
+  restored = false;
+
+  if ( ! loaded || ! hasValue("termcap.termtype") )
+    return false;
+
+  // The cached values are only valid for the same detection result
+  const auto& fterm_data = FTerm::getFTermData();
+  const auto& term_detection = FTerm::getFTermDetection();
+  const auto gnome_id = std::to_string(term_detection->getGnomeTerminalID());
+  const auto& termtype = fterm_data->getTermType();
+
+  if ( getValue("termcap.detected") != termtype
+    || getValue("termcap.terminfo_mtime") != getTerminfoMTime(termtype)
+    || getValue("termcap.terminal_type") != internal::getTerminalTypeString()
+    || getValue("termcap.gnome_terminal_id") != gnome_id )
+    return false;
+
+  string_pool.clear();
+
+  for (const auto& flag : internal::getTermcapFlags())
+  {
+    const bool value = getValue(std::string("termcap.") + flag.name) == "1";
+
+    if ( flag.var )
+      *flag.var = value;
+    else
+      fterm_data->setMonochron(value);
+  }
+
+  for (const auto& number : internal::getTermcapNumbers())
+  {
+    const auto& value = getValue(std::string("termcap.") + number.name);
+    *number.var = std::atoi(value.data());
+  }
+
+  for (std::size_t i{0}; i < FTermcap::strings.size(); i++)
+    FTermcap::strings[i].string = restoreString("termcap.s." + std::to_string(i));
+
+  for (std::size_t i{0}; i < fc::fkey_cap_table.size(); i++)
+    fc::fkey_cap_table[i].string = restoreString("termcap.k." + std::to_string(i));
+
+  const auto& pc = TCAP(t_pad_char);
+  FTermcap::PC = ( pc ) ? pc[0] : '\0';
+  FTermcap::setBaudrate (int(fterm_data->getBaudrate()));
+  FTermcap::initialized = true;
+  fterm_data->setTermType (getValue("termcap.termtype"));
+  restored = true;
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermcapCache::storeTermcap()
+{
+  // Stores the resolved termcap variables (incl. quirks) in the cache
+
+  const auto& fterm_data = FTerm::getFTermData();
+  const auto& term_detection = FTerm::getFTermDetection();
+  setValue ("termcap.detected", term_detection->getTermType());
+  setValue ( "termcap.terminfo_mtime"
+           , getTerminfoMTime(term_detection->getTermType()) );
+  setValue ("termcap.termtype", fterm_data->getTermType());
+  setValue ("termcap.terminal_type", internal::getTerminalTypeString());
+  setValue ( "termcap.gnome_terminal_id"
+           , std::to_string(term_detection->getGnomeTerminalID()) );
+
+  for (const auto& flag : internal::getTermcapFlags())
+  {
+    const bool value = ( flag.var ) ? *flag.var : fterm_data->isMonochron();
+    setValue (std::string("termcap.") + flag.name, value ? "1" : "0");
+  }
+
+  for (const auto& number : internal::getTermcapNumbers())
+    setValue (std::string("termcap.") + number.name, std::to_string(*number.var));
+
+  for (std::size_t i{0}; i < FTermcap::strings.size(); i++)
+  {
+    const auto& name = "termcap.s." + std::to_string(i);
+
+    if ( FTermcap::strings[i].string )
+      setValue (name, FTermcap::strings[i].string);
+    else
+      values.erase(name);
+  }
+
+  for (std::size_t i{0}; i < fc::fkey_cap_table.size(); i++)
+  {
+    const auto& name = "termcap.k." + std::to_string(i);
+
+    if ( fc::fkey_cap_table[i].string )
+      setValue (name, fc::fkey_cap_table[i].string);
+    else
+      values.erase(name);
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermcapCache::clear()
+{
+  values.clear();
+  key.clear();
+  loaded = false;
+  restored = false;
+}
+
+
+// private methods of FTermcapCache
+//----------------------------------------------------------------------
+std::string FTermcapCache::getCacheDirectory()
+{
+  const char* cache_home = std::getenv("XDG_CACHE_HOME");
+
+  // The XDG specification only permits absolute paths
+  if ( cache_home && cache_home[0] == '/' )
+    return std::string(cache_home) + "/finalcut";
+
+  const char* home = std::getenv("HOME");
+
+  if ( home && home[0] == '/' )
+    return std::string(home) + "/.cache/finalcut";
+
+  return {};
+}
+
+//----------------------------------------------------------------------
+std::string FTermcapCache::getTerminfoMTime (const std::string& term)
+{
+  // Returns the modification time of the terminfo file for term
+
+  if ( term.empty() || term.find('/') != std::string::npos )
+    return "0";
+
+  std::vector<std::string> dirs{};
+  const char* terminfo = std::getenv("TERMINFO");
+  const char* home = std::getenv("HOME");
+  const char* terminfo_dirs = std::getenv("TERMINFO_DIRS");
+
+  if ( terminfo )
+    dirs.emplace_back(terminfo);
+
+  if ( home )
+    dirs.emplace_back(std::string(home) + "/.terminfo");
+
+  if ( terminfo_dirs )
+  {
+    std::string list{terminfo_dirs};
+    std::size_t start{0};
+
+    while ( start <= list.length() )
+    {
+      auto end = list.find(':', start);
+
+      if ( end == std::string::npos )
+        end = list.length();
+
+      if ( end > start )
+        dirs.emplace_back(list.substr(start, end - start));
+
+      start = end + 1;
+    }
+  }
+
+  for (const auto& dir : { "/etc/terminfo", "/lib/terminfo"
+                         , "/usr/share/terminfo", "/usr/lib/terminfo" })
+    dirs.emplace_back(dir);
+
+  std::array<char, 3> hex_dir{};
+  std::snprintf (hex_dir.data(), hex_dir.size(), "%02x", uChar(term[0]));
+
+  for (const auto& dir : dirs)
+  {
+    // Letter subdirectories (ncurses) or hex subdirectories (macOS)
+    for (const auto& subdir : { std::string(1, term[0])
+                              , std::string(hex_dir.data()) })
+    {
+      struct stat file_stat{};
+      const auto& path = dir + '/' + subdir + '/' + term;
+
+      if ( ::stat(path.data(), &file_stat) == 0 )
+        return std::to_string(file_stat.st_mtime);
+    }
+  }
+
+  return "0";
+}
+
+//----------------------------------------------------------------------
+std::string FTermcapCache::encode (const std::string& str)
+{
+  std::string encoded{};
+
+  for (const auto& ch : str)
+  {
+    const auto uch = uChar(ch);
+
+    if ( uch <= ' ' || uch == '\\' || uch == '=' || uch >= 0x7f )
+    {
+      std::array<char, 5> octal{};
+      std::snprintf (octal.data(), octal.size(), "\\%03o", uInt(uch));
+      encoded += octal.data();
+    }
+    else
+      encoded += ch;
+  }
+
+  return encoded;
+}
+
+//----------------------------------------------------------------------
+std::string FTermcapCache::decode (const std::string& str)
+{
+  std::string decoded{};
+  std::size_t i{0};
+
+  while ( i < str.length() )
+  {
+    const bool is_octal = str[i] == '\\'
+                       && i + 3 < str.length()
+                       && str.find_first_not_of("01234567", i + 1) >= i + 4;
+
+    if ( is_octal )
+    {
+      decoded += char(std::strtoul(str.substr(i + 1, 3).data(), nullptr, 8));
+      i += 4;
+    }
+    else
+    {
+      decoded += str[i];
+      i++;
+    }
+  }
+
+  return decoded;
+}
+
+//----------------------------------------------------------------------
+std::string FTermcapCache::getHeader()
+{
+  // Version line - a change of the library or the
+  // capability tables invalidates all cache files
+
+  return "finalcut-termcap-cache " + std::to_string(version)
+       + ' ' + F_PACKAGE_VERSION
+       + ' ' + std::to_string(FTermcap::strings.size())
+       + ' ' + std::to_string(fc::fkey_cap_table.size());
+}
+
+//----------------------------------------------------------------------
+const char* FTermcapCache::restoreString (const std::string& name)
+{
+  // Returns a persistent copy of a cached string (nullptr if unset)
+
+  const auto iter = values.find(name);
+
+  if ( iter == values.end() )
+    return nullptr;
+
+  string_pool.emplace_back(iter->second);
+  return string_pool.back().data();
+}
+
+}  // namespace finalcut
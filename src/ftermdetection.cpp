@@ -24,6 +24,7 @@
   #include "final/fconfig.h"  // includes _GNU_SOURCE for fd_set
 #endif
 
+#include <algorithm>
 #include <array>
 
 #include "final/emptyfstring.h"
@@ -31,12 +32,15 @@
 #include "final/fc.h"
 #include "final/flog.h"
 #include "final/fkeyboard.h"
+#include "final/fstartoptions.h"
 #include "final/fsystem.h"
 #include "final/fterm.h"
 #include "final/ftermcap.h"
+#include "final/ftermcapcache.h"
 #include "final/ftermdata.h"
 #include "final/ftermdetection.h"
 #include "final/ftermios.h"
+#include "final/ftermxterminal.h"
 #include "final/ftypes.h"
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
@@ -57,11 +61,17 @@ FTermDetection::secondaryDA   FTermDetection::secondary_da{};
 char                          FTermDetection::termtype[256]{};
 char                          FTermDetection::ttytypename[256]{};
 bool                          FTermDetection::decscusr_support{};
+bool                          FTermDetection::rectangle_support{};
+bool                          FTermDetection::kitty_keyboard{};
+bool                          FTermDetection::modify_other_keys{};
+bool                          FTermDetection::bracketed_paste{};
 bool                          FTermDetection::terminal_detection{};
 bool                          FTermDetection::color256{};
+bool                          FTermDetection::truecolor{};
 const FString*                FTermDetection::answer_back{nullptr};
 const FString*                FTermDetection::sec_da{nullptr};
 int                           FTermDetection::gnome_terminal_id{};
+FPoint                        FTermDetection::cursor_pos{-1, -1};
 
 #if DEBUG
   char FTermDetection::termtype_256color[256]{};
@@ -83,6 +93,10 @@ FTermDetection::FTermDetection()
 
   // Preset to false
   decscusr_support = false;
+  rectangle_support = false;
+  kitty_keyboard = false;
+  modify_other_keys = false;
+  bracketed_paste = false;
 
   // Gnome terminal id from SecDA
   // Example: vte version 0.40.0 = 0 * 100 + 40 * 100 + 0 = 4000
@@ -141,6 +155,54 @@ void FTermDetection::detect()
   detectTerminal();
 }
 
+//----------------------------------------------------------------------
+void FTermDetection::parseKeyboardProtocols (const std::string& answer)
+{
+  // A terminal with the kitty keyboard protocol answers the flags
+  // query with ESC [ ? flags u. A terminal with modifyOtherKeys
+  // answers the XTQMODKEYS query with ESC [ > 4 ; value m.
+  // A terminal that knows the bracketed paste mode reports it
+  // as set or reset (1 or 2) with ESC [ ? 2004 ; Ps $ y.
+
+  const auto isReport = [&answer] ( std::size_t pos
+                                  , const std::string& prefix
+                                  , char final_byte )
+  {
+    pos += prefix.length();
+    const auto start = pos;
+
+    while ( pos < answer.length()
+         && ( std::isdigit(uChar(answer[pos])) || answer[pos] == ';' ) )
+      pos++;
+
+    return pos > start
+        && pos < answer.length()
+        && answer[pos] == final_byte;
+  };
+
+  const auto findReport = [&answer, &isReport] ( const std::string& prefix
+                                               , char final_byte )
+  {
+    auto pos = answer.find(prefix);
+
+    while ( pos != std::string::npos )
+    {
+      if ( isReport(pos, prefix, final_byte) )
+        return true;
+
+      pos = answer.find(prefix, pos + 1);
+    }
+
+    return false;
+  };
+
+  kitty_keyboard = findReport (ESC "[?", 'u');
+  modify_other_keys = findReport (ESC "[>4;", 'm')
+                   || answer.find(ESC "[>4m") != std::string::npos;
+  bracketed_paste = answer.find(ESC "[?2004;1$y") != std::string::npos
+                 || answer.find(ESC "[?2004;2$y") != std::string::npos;
+}
+
 
 // private methods of FTermDetection
 //----------------------------------------------------------------------
@@ -316,6 +378,11 @@ void FTermDetection::termtypeAnalysis()
     terminal_type.kterm = true;
   }
 
+  // xterm
+  if ( std::strncmp(termtype, "xterm", 5) == 0
+    || std::strncmp(termtype, "Eterm", 5) == 0 )
+    terminal_type.xterm = true;
+
   // mlterm
   if ( std::strncmp(termtype, "mlterm", 6) == 0 )
     terminal_type.mlterm = true;
@@ -360,33 +427,45 @@ void FTermDetection::detectTerminal()
     FTermios::setCaptureSendCharacters();
     const auto& keyboard = FTerm::getFKeyboard();
     keyboard->setNonBlockingInput();
+    FTerm::getFTermData()->setTermResponsive();
 
     // Initialize 256 colors terminals
     new_termtype = init_256colorTerminal();
 
+    // Request the answerback-message, the secondary device
+    // attributes (SEC_DA) and all other terminal data
+    // in a single round trip
+    const auto& answer = queryTerminalID();
+
     // Identify the terminal via the answerback-message
-    new_termtype = parseAnswerbackMsg (new_termtype);
+    new_termtype = parseAnswerbackMsg (answer, new_termtype);
 
     // Identify the terminal via the secondary device attributes (SEC_DA)
-    new_termtype = parseSecDA (new_termtype);
+    new_termtype = parseSecDA (answer, new_termtype);
+
+    // Check the answers to the keyboard protocol and paste mode queries
+    parseKeyboardProtocols (answer);
+
+    // Look up the results of a previous start in the capability cache
+    FTerm::getFTermcapCache()->load ( termtype
+                                    , getAnswerbackMsg(answer).toString()
+                                    , getSecDA(answer).toString() );
 
     // Determines the maximum number of colors
-    new_termtype = determineMaxColor(new_termtype);
+    new_termtype = determineMaxColor(new_termtype, answer);
 
     keyboard->unsetNonBlockingInput();
     FTermios::unsetCaptureSendCharacters();
   }
+  else
+    FTerm::getFTermcapCache()->load (termtype, {}, {});
 
   //
   // Additional termtype analysis
   //
 
-  // Test if the terminal is a xterm
-  if ( std::strncmp(termtype, "xterm", 5) == 0
-    || std::strncmp(termtype, "Eterm", 5) == 0 )
+  if ( terminal_type.xterm )
   {
-    terminal_type.xterm = true;
-
     // Each xterm should be able to use at least 16 colors
     if ( ! new_termtype && std::strlen(termtype) == 5 )
       new_termtype = "xterm-16color";
@@ -424,6 +503,11 @@ const char* FTermDetection::init_256colorTerminal()
   else
     color256 = false;
 
+  // Direct colors are announced by COLORTERM=truecolor or 24bit
+  const auto& colorterm = color_env.string1;
+  truecolor = colorterm && ( std::strcmp(colorterm, "truecolor") == 0
+                          || std::strcmp(colorterm, "24bit") == 0 );
+
   new_termtype = termtype_256color_quirks();
 
 #if DEBUG
@@ -532,22 +616,53 @@ const char* FTermDetection::termtype_256color_quirks()
 }
 
 //----------------------------------------------------------------------
-const char* FTermDetection::determineMaxColor (const char current_termtype[])
+std::string FTermDetection::getColorQuery()
+{
+  // Query the colors 0, 255, 87 and 15 for determineMaxColor().
+  // A Tera Term is only known from the answer, so that it gets
+  // the query, but its answer is not used.
+
+  if ( color256
+    || isCygwinTerminal()
+    || isLinuxTerm()
+    || isNetBSDTerm() )
+    return {};
+
+  return OSC "4;0;?" BEL
+         OSC "4;255;?" BEL
+         OSC "4;87;?" BEL
+         OSC "4;15;?" BEL;
+}
+
+//----------------------------------------------------------------------
+const char* FTermDetection::determineMaxColor ( const char current_termtype[]
+                                              , const std::string& answer )
 {
   // Determine xterm maximum number of colors via OSC 4
 
   const char* new_termtype = current_termtype;
-  const auto& keyboard = FTerm::getFKeyboard();
-  keyboard->setNonBlockingInput();
-
-  if ( ! color256
-    && ! isCygwinTerminal()
-    && ! isTeraTerm()
-    && ! isLinuxTerm()
-    && ! isNetBSDTerm()
-    && ! getXTermColorName(FColor(0)).isEmpty() )
+
+  if ( color256
+    || isCygwinTerminal()
+    || isTeraTerm()
+    || isLinuxTerm()
+    || isNetBSDTerm() )
+    return new_termtype;
+
+  const auto& termcap_cache = FTerm::getFTermcapCache();
+
+  if ( termcap_cache->hasValue("color.termtype") )
+  {
+    // Color count already determined by a previous start
+    const auto& cached_termtype = termcap_cache->getValue("color.termtype");
+    color256 = termcap_cache->getValue("color.256color") == "1";
+    return ( cached_termtype.empty() ) ? new_termtype : cached_termtype.data();
+  }
+
+  // The answer contains the reports of getColorQuery()
+  if ( ! getXTermColorName(answer, FColor(0)).isEmpty() )
   {
-    if ( ! getXTermColorName(FColor(255)).isEmpty() )
+    if ( ! getXTermColorName(answer, FColor(255)).isEmpty() )
     {
       color256 = true;
 
@@ -556,85 +671,51 @@ const char* FTermDetection::determineMaxColor (const char current_termtype[])
       else
         new_termtype = "xterm-256color";
     }
-    else if ( ! getXTermColorName(FColor(87)).isEmpty() )
+    else if ( ! getXTermColorName(answer, FColor(87)).isEmpty() )
     {
       new_termtype = "xterm-88color";
     }
-    else if ( ! getXTermColorName(FColor(15)).isEmpty() )
+    else if ( ! getXTermColorName(answer, FColor(15)).isEmpty() )
     {
       new_termtype = "xterm-16color";
     }
   }
 
-  keyboard->unsetNonBlockingInput();
+  termcap_cache->setValue ("color.256color", color256 ? "1" : "0");
+  termcap_cache->setValue ("color.termtype", new_termtype ? new_termtype : "");
   return new_termtype;
 }
 
 //----------------------------------------------------------------------
-FString FTermDetection::getXTermColorName (FColor color)
+FString FTermDetection::getXTermColorName ( const std::string& answer
+                                          , FColor color )
 {
-  FString color_str{""};
-  std::array<char, 30> buf{};
-  fd_set ifds{};
-  struct timeval tv{};
-  const int stdin_no = FTermios::getStdIn();
-
-  // get color
-  auto index = uInt16(color);
-  std::fprintf (stdout, OSC "4;%hu;?" BEL, index);
-  std::fflush (stdout);
-  FD_ZERO(&ifds);
-  FD_SET(stdin_no, &ifds);
-  tv.tv_sec  = 0;
-  tv.tv_usec = 150000;  // 150 ms
-
-  // read the terminal answer
-  if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
-    return color_str;
-
-  constexpr auto parse = "\033]4;%10hu;%509[^\n]s";
-  std::array<char, 35> temp{};
-  std::size_t pos{0};
-
-  do
-  {
-    std::size_t bytes_free = temp.size() - pos - 1;
-    const ssize_t bytes = read(stdin_no, &temp[pos], bytes_free);
+  // Searches the answer for the OSC 4 report of the given color
 
-    if ( bytes <= 0 )
-      break;
-
-    pos += std::size_t(bytes);
-  }
-  while ( pos < temp.size() );
-
-  if ( pos > 4 && std::sscanf(temp.data(), parse, &index, buf.data()) == 2 )
-  {
-    std::size_t n = std::strlen(buf.data());
+  std::string prefix{OSC "4;"};
+  prefix += std::to_string(uInt16(color)) + ';';
+  const auto pos = answer.find(prefix);
 
-    // BEL + '\0' = string terminator
-    if ( n >= 6 && buf[n - 1] == BEL[0] && buf[n] == '\0' )
-      buf[n - 1] = '\0';
+  if ( pos == std::string::npos )
+    return {};
 
-    // Esc + \ = OSC string terminator (mintty)
-    if ( n >= 6 && buf[n - 2] == ESC[0] && buf[n - 1] == '\\' )
-      buf[n - 2] = '\0';
+  const auto begin = pos + prefix.length();
+  // BEL or Esc + \ (mintty) = OSC string terminator
+  const auto end = answer.find_first_of(BEL ESC, begin);
 
-    color_str = buf.data();
-  }
+  if ( end == std::string::npos || end - begin < 5 )
+    return {};
 
-  return color_str;
+  return {answer.substr(begin, end - begin)};
 }
 
 //----------------------------------------------------------------------
-const char* FTermDetection::parseAnswerbackMsg (const char current_termtype[])
+const char* FTermDetection::parseAnswerbackMsg ( const std::string& answer
+                                               , const char current_termtype[] )
 {
   const char* new_termtype = current_termtype;
-  const auto& keyboard = FTerm::getFKeyboard();
-  keyboard->setNonBlockingInput();
-  // send ENQ and read the answerback message
-  const auto& ans = getAnswerbackMsg();
-  keyboard->unsetNonBlockingInput();
+  // Get the answerback message from the terminal answer
+  const auto& ans = getAnswerbackMsg(answer);
 
   try
   {
@@ -675,54 +756,71 @@ const char* FTermDetection::parseAnswerbackMsg (const char current_termtype[])
 }
 
 //----------------------------------------------------------------------
-FString FTermDetection::getAnswerbackMsg()
+std::string FTermDetection::queryTerminalID()
 {
-  FString answerback{""};
-  fd_set ifds{};
-  struct timeval tv{};
-  const int stdin_no = FTermios::getStdIn();
-  // Send enquiry character
-  std::putchar (ENQ[0]);
-  std::fflush(stdout);
-  FD_ZERO(&ifds);
-  FD_SET(stdin_no, &ifds);
-  tv.tv_sec  = 0;
-  tv.tv_usec = 150000;  // 150 ms
-
-  // Read the answerback message
-  if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
-    return answerback;
+  // Send the enquiry character (ENQ) for the answerback message,
+  // the secondary device attributes request (SEC_DA), the keyboard
+  // protocol and bracketed paste queries, the color queries, the xterm
+  // font and title queries and the cursor position request (DECXCPR)
+  // in one write
 
-  std::array<char, 10> temp{};
-  std::size_t pos{0};
+  std::string query{ENQ};
+  std::size_t replies{1};  // The DA1 sentinel
 
-  do
+  // The Linux console and older cygwin terminals knows no Sec_DA
+  if ( ! isLinuxTerm() && ! isCygwinTerminal() )
   {
-    std::size_t bytes_free = temp.size() - pos - 1;
-    const ssize_t bytes = read(stdin_no, &temp[pos], bytes_free);
+    query += ESC "[>c";
+    replies++;  // The SEC_DA answer is a device attributes report too
+
+    // Only supporting terminals answer these queries, so they
+    // are not counted. The SEC_DA answer is received first.
+    query += ESC "[?u";    // Kitty keyboard protocol flags
+    query += ESC "[?4m";   // xterm modifyOtherKeys (XTQMODKEYS)
+    query += ESC "[?2004$p";  // Bracketed paste mode (DECRQM)
+  }
 
-    if ( bytes <= 0 )
-      break;
+  query += getColorQuery();
+  std::string font_and_title_query{};
+  const auto& xterm = FTerm::getFTermXTerminal();
 
-    pos += std::size_t(bytes);
-  }
-  while ( pos < temp.size() );
+  if ( FStartOptions::getFStartOptions().terminal_data_request )
+    font_and_title_query = xterm->getFontAndTitleQuery(replies);
+
+  query += font_and_title_query;
+  query += ESC "[6n";  // DECXCPR
+  const auto& answer = queryTerminal (query, 600000, replies);  // 600 ms
 
-  if ( pos > 0 )
-    answerback = temp.data();
+  if ( ! font_and_title_query.empty() )
+    xterm->captureFontAndTitle(answer);
 
-  return answerback;
+  cursor_pos = parseCursorPos(answer);
+  return answer;
 }
 
 //----------------------------------------------------------------------
-const char* FTermDetection::parseSecDA (const char current_termtype[])
+FString FTermDetection::getAnswerbackMsg (const std::string& answer)
+{
+  // The answerback message precedes all escape sequences
+  const auto end = answer.find(ESC[0]);
+  const auto& msg = answer.substr(0, std::min(end, std::size_t(9)));
+
+  if ( msg.empty() )
+    return {""};
+
+  return {msg};
+}
+
+//----------------------------------------------------------------------
+const char* FTermDetection::parseSecDA ( const std::string& answer
+                                       , const char current_termtype[] )
 {
   // The Linux console and older cygwin terminals knows no Sec_DA
   if ( isLinuxTerm() || isCygwinTerminal() )
     return current_termtype;
 
    // Secondary device attributes (SEC_DA) <- decTerminalID string
-  const auto& ans = getSecDA();
+  const auto& ans = getSecDA(answer);
 
   try
   {
@@ -810,50 +908,21 @@ int FTermDetection::str2int (const FString& s)
 }
 
 //----------------------------------------------------------------------
-FString FTermDetection::getSecDA()
+FString FTermDetection::getSecDA (const std::string& answer)
 {
   FString sec_da_str{""};
 
   int a{0};
   int b{0};
   int c{0};
-  const int stdin_no{FTermios::getStdIn()};
-  const int stdout_no{FTermios::getStdOut()};
-  fd_set ifds{};
-  struct timeval tv{};
-  constexpr auto& SECDA{ESC "[>c"};
-
-  // Get the secondary device attributes
-  if ( write(stdout_no, SECDA, std::strlen(SECDA)) == -1 )
-    return sec_da_str;
+  const auto pos = answer.find(ESC "[>");
 
-  std::fflush(stdout);
-  FD_ZERO(&ifds);
-  FD_SET(stdin_no, &ifds);
-  tv.tv_sec  = 0;
-  tv.tv_usec = 600000;  // 600 ms
-
-  // Read the answer
-  if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
+  if ( pos == std::string::npos )
     return sec_da_str;
 
   constexpr auto parse = "\033[>%10d;%10d;%10dc";
-  std::array<char, 40> temp{};
-  std::size_t pos{0};
 
-  do
-  {
-    std::size_t bytes_free = temp.size() - pos - 1;
-    const ssize_t bytes = read(stdin_no, &temp[pos], bytes_free);
-
-    if ( bytes <= 0 )
-      break;
-
-    pos += std::size_t(bytes);
-  }
-  while ( pos < temp.size() && ! std::strchr(temp.data(), 'c') );
-
-  if ( pos > 3 && std::sscanf(temp.data(), parse, &a, &b, &c) == 3 )
+  if ( std::sscanf(answer.c_str() + pos, parse, &a, &b, &c) == 3 )
     sec_da_str.sprintf("\033[>%d;%d;%dc", a, b, c);
 
   return sec_da_str;
@@ -863,6 +932,7 @@ FString FTermDetection::getSecDA()
 const char* FTermDetection::secDA_Analysis (const char current_termtype[])
 {
   const char* new_termtype = current_termtype;
+  rectangle_support = false;
 
   switch ( secondary_da.terminal_id_type )
   {
@@ -887,6 +957,9 @@ const char* FTermDetection::secDA_Analysis (const char current_termtype[])
       break;
 
     case 41:  // DEC VT420
+      new_termtype = secDA_Analysis_41(current_termtype);
+      break;
+
     case 61:  // DEC VT510
     case 64:  // DEC VT520
       break;
@@ -1005,6 +1078,23 @@ inline const char* FTermDetection::secDA_Analysis_32 (const char[])
   return new_termtype;
 }
 
+//----------------------------------------------------------------------
+inline const char* FTermDetection::secDA_Analysis_41 (const char current_termtype[])
+{
+  // Terminal ID 41 - DEC VT420 (default of xterm)
+
+  // Of the terminals with this id, only xterm itself is known to
+  // implement the rectangular area operations (DECCRA, DECFRA and
+  // DECERA) correctly. It identifies itself with XTERM_VERSION.
+  if ( std::strncmp(current_termtype, "xterm", 5) == 0
+    && std::getenv("XTERM_VERSION")
+    && ! isGnomeTerminal()
+    && ! isKdeTerminal() )
+    rectangle_support = true;
+
+  return current_termtype;
+}
+
 //----------------------------------------------------------------------
 inline const char* FTermDetection::secDA_Analysis_65 (const char current_termtype[])
 {
@@ -21,6 +21,7 @@
 ***********************************************************************/
 
 #include "final/fapplication.h"
+#include "final/fcharencoder.h"
 #include "final/fcharmap.h"
 #include "final/flog.h"
 #include "final/fsystem.h"
@@ -151,6 +152,8 @@ void FTermFreeBSD::initCharMap()
   for (auto&& entry : fc::character)
     if ( entry.pc < 0x1c )
       entry.pc = entry.ascii;
+
+  FTerm::getFCharEncoder()->invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -25,6 +25,7 @@
 
 #include "final/fapplication.h"
 #include "final/fc.h"
+#include "final/fcharencoder.h"
 #include "final/fcharmap.h"
 #include "final/flog.h"
 #include "final/fsystem.h"
@@ -235,6 +236,8 @@ void FTermLinux::initCharMap() const
         characterFallback (ucs, { L'ˣ', L'ⁿ', L'ˆ', L'`' });
       }
     }
+
+    FTerm::getFCharEncoder()->invalidate();
   }
 
   initSpecialCharacter();
@@ -164,6 +164,50 @@ void FTermXTerminal::metaSendsESC (bool enable)
     disableXTermMetaSendsESC();
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::bracketedPaste (bool enable)
+{
+  // activate/deactivate the xterm bracketed paste mode
+
+  if ( enable )
+    enableXTermBracketedPaste();
+  else
+    disableXTermBracketedPaste();
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::keyboardProtocol (bool enable)
+{
+  // activate/deactivate the unambiguous keyboard encoding
+
+  if ( enable )
+    enableXTermKeyboardProtocol();
+  else
+    disableXTermKeyboardProtocol();
+}
+
+//----------------------------------------------------------------------
+std::string FTermXTerminal::getFontAndTitleQuery (std::size_t& replies) const
+{
+  // Returns the query for the xterm font and the window title.
+  // replies is increased by the device attributes reports that
+  // the query causes.
+
+  const auto& term_detection = FTerm::getFTermDetection();
+
+  if ( ( ! term_detection->isXTerminal()
+      && ! term_detection->isUrxvtTerminal() )
+    || term_detection->isRxvtTerminal() )
+    return {};
+
+  const auto& font_query = getFontQuery();
+
+  if ( ! font_query.empty() && ! getOscPrefix().empty() )
+    replies++;  // Tunneled DA1 report of the outer terminal
+
+  return font_query + getTitleQuery();
+}
+
 //----------------------------------------------------------------------
 void FTermXTerminal::setDefaults()
 {
@@ -274,20 +318,39 @@ void FTermXTerminal::resetTitle()
 //----------------------------------------------------------------------
 void FTermXTerminal::captureFontAndTitle()
 {
-  const auto& term_detection = FTerm::getFTermDetection();
-
-  if ( ( term_detection->isXTerminal()
-    || term_detection->isUrxvtTerminal() )
-    && ! term_detection->isRxvtTerminal() )
+  if ( font_and_title_captured )
   {
-    FTermios::setCaptureSendCharacters();
-    const auto& keyboard = FTerm::getFKeyboard();
-    keyboard->setNonBlockingInput();
-    xterm_font  = captureXTermFont();
-    xterm_title = captureXTermTitle();
-    keyboard->unsetNonBlockingInput();
-    FTermios::unsetCaptureSendCharacters();
+    // The terminal detection has already received the answer
+    font_and_title_captured = false;
+    return;
   }
+
+  std::size_t replies{1};  // The DA1 sentinel
+  const auto& query = getFontAndTitleQuery(replies);
+
+  if ( query.empty() )
+    return;
+
+  FTermios::setCaptureSendCharacters();
+  const auto& keyboard = FTerm::getFKeyboard();
+  keyboard->setNonBlockingInput();
+  // Query the font and the title in a single round trip
+  const auto& answer = queryTerminal (query, 150000, replies);  // 150 ms
+  keyboard->unsetNonBlockingInput();
+  FTermios::unsetCaptureSendCharacters();
+  captureFontAndTitle (answer);
+  font_and_title_captured = false;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::captureFontAndTitle (const std::string& answer)
+{
+  // Takes the font and the title from the answer to
+  // the query of getFontAndTitleQuery()
+
+  xterm_font  = captureXTermFont(answer);
+  xterm_title = captureXTermTitle(answer);
+  font_and_title_captured = true;
 }
 
 
@@ -703,24 +766,26 @@ bool FTermXTerminal::canResetColor() const
 }
 
 //----------------------------------------------------------------------
-void FTermXTerminal::oscPrefix() const
+std::string FTermXTerminal::getOscPrefix() const
 {
   const auto& term_detection = FTerm::getFTermDetection();
 
   if ( term_detection->isTmuxTerm() )
   {
     // tmux device control string
-    FTerm::putstring (ESC "Ptmux;" ESC);
+    return ESC "Ptmux;" ESC;
   }
   else if ( term_detection->isScreenTerm() )
   {
     // GNU Screen device control string
-    FTerm::putstring (ESC "P");
+    return ESC "P";
   }
+
+  return {};
 }
 
 //----------------------------------------------------------------------
-void FTermXTerminal::oscPostfix() const
+std::string FTermXTerminal::getOscPostfix() const
 {
   const auto& term_detection = FTerm::getFTermDetection();
 
@@ -728,12 +793,32 @@ void FTermXTerminal::oscPostfix() const
     || term_detection->isTmuxTerm() )
   {
     // GNU Screen/tmux string terminator
-    FTerm::putstring (ESC "\\");
+    return ESC "\\";
   }
+
+  return {};
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::oscPrefix() const
+{
+  const auto& prefix = getOscPrefix();
+
+  if ( ! prefix.empty() )
+    FTerm::putstring (prefix);
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::oscPostfix() const
+{
+  const auto& postfix = getOscPostfix();
+
+  if ( ! postfix.empty() )
+    FTerm::putstring (postfix);
 }
 
 //----------------------------------------------------------------------
-FString FTermXTerminal::captureXTermFont() const
+std::string FTermXTerminal::getFontQuery() const
 {
   const auto& term_detection = FTerm::getFTermDetection();
 
@@ -744,113 +829,68 @@ FString FTermXTerminal::captureXTermFont() const
     return {};
   }
 
-  fd_set ifds{};
-  struct timeval tv{};
-  const int stdin_no = FTermios::getStdIn();
+  const auto& prefix = getOscPrefix();
+  const auto& postfix = getOscPostfix();
 
   // Querying the terminal font
-  oscPrefix();
-  FTerm::putstring (OSC "50;?" BEL);
-  oscPostfix();
-  std::fflush(stdout);
-  FD_ZERO(&ifds);
-  FD_SET(stdin_no, &ifds);
-  tv.tv_sec  = 0;
-  tv.tv_usec = 150000;  // 150 ms
-
-  // Read the terminal answer
-  if ( select(stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
-    return {};
-
-  std::array<char, 150> temp{};
-  std::size_t pos{0};
-
-  do
-  {
-    std::size_t bytes_free = temp.size() - pos - 1;
-    const ssize_t bytes = read(stdin_no, &temp[pos], bytes_free);
-
-    if ( bytes <= 0 )
-      break;
-
-    pos += std::size_t(bytes);
-  }
-  while ( pos < temp.size() && ! std::strchr(temp.data(), '\a') );
+  std::string query{prefix + OSC "50;?" BEL + postfix};
 
-  if ( pos > 5 && temp[0] == ESC[0] && temp[1] == ']' && temp[2] == '5'
-               && temp[3] == '0' && temp[4] == ';' )
-  {
-    // Skip leading Esc ] 5 0 ;
-    char* str = &temp[5];
-    const std::size_t n = std::strlen(str);
-
-    // BEL + '\0' = string terminator
-    if ( n >= 5 && str[n - 1] == BEL[0] && str[n] == '\0' )
-      str[n - 1] = '\0';
-
-    return {str};
-  }
+  // A tunneled query needs its own DA1 request to the outer terminal,
+  // because the terminal multiplexer answers the sentinel itself
+  if ( ! prefix.empty() )
+    query += prefix + CSI "c" + postfix;
 
-  return {};
+  return query;
 }
 
 //----------------------------------------------------------------------
-FString FTermXTerminal::captureXTermTitle() const
+std::string FTermXTerminal::getTitleQuery() const
 {
   const auto& term_detection = FTerm::getFTermDetection();
 
   if ( term_detection->isKdeTerminal() )
     return {};
 
-  fd_set ifds{};
-  struct timeval tv{};
-  const int stdin_no{FTermios::getStdIn()};
-
   // Report window title
-  FTerm::putstring (CSI "21t");
-  std::fflush(stdout);
-  FD_ZERO(&ifds);
-  FD_SET(stdin_no, &ifds);
-  tv.tv_sec  = 0;
-  tv.tv_usec = 150000;  // 150 ms
+  return CSI "21t";
+}
 
-  // read the terminal answer
-  if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
+//----------------------------------------------------------------------
+FString FTermXTerminal::captureXTermFont (const std::string& answer) const
+{
+  const auto pos = answer.find(OSC "50;");
+
+  if ( pos == std::string::npos )
     return {};
 
-  std::array<char, 512> temp{};
-  std::size_t pos{0};
+  // Skip leading Esc ] 5 0 ;
+  const auto begin = pos + 5;
+  // BEL = string terminator
+  const auto end = answer.find(BEL, begin);
 
-  do
-  {
-    std::size_t bytes_free = temp.size() - pos - 1;
-    const ssize_t bytes = read(stdin_no, &temp[pos], bytes_free);
+  if ( end == std::string::npos || end - begin < 4 )
+    return {};
 
-    if ( bytes <= 0 )
-      break;
+  return {answer.substr(begin, end - begin)};
+}
 
-    pos += std::size_t(bytes);
-  }
-  while ( pos < temp.size() && std::strstr(temp.data(), ESC "\\") == nullptr );
+//----------------------------------------------------------------------
+FString FTermXTerminal::captureXTermTitle (const std::string& answer) const
+{
+  const auto pos = answer.find(OSC "l");
 
-  if ( pos > 6 && temp[0] == ESC[0] && temp[1] == ']' && temp[2] == 'l' )
-  {
-    // Skip leading Esc + ] + l = OSC l
-    char* str = &temp[3];
-    const std::size_t n = std::strlen(str);
-
-    // Esc + \ = OSC string terminator
-    if ( n >= 2 && str[n - 2] == ESC[0] && str[n - 1] == '\\' )
-    {
-      if ( n < 4 )
-        return {};
-
-      str[n - 2] = '\0';
-      return {str};
-    }
-  }
+  if ( pos == std::string::npos )
+    return {};
 
-  return {};
+  // Skip leading Esc + ] + l = OSC l
+  const auto begin = pos + 3;
+  // Esc + \ = OSC string terminator
+  const auto end = answer.find(ESC "\\", begin);
+
+  if ( end == std::string::npos || end - begin < 2 )
+    return {};
+
+  return {answer.substr(begin, end - begin)};
 }
 
 //----------------------------------------------------------------------
@@ -914,4 +954,72 @@ void FTermXTerminal::disableXTermMetaSendsESC()
   meta_sends_esc = false;
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::enableXTermBracketedPaste()
+{
+  // Activate the xterm bracketed paste mode
+
+  if ( bracketed_paste )
+    return;
+
+  FTerm::putstring (CSI "?2004h");  // enable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste = true;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::disableXTermBracketedPaste()
+{
+  // Deactivate the xterm bracketed paste mode
+
+  if ( ! bracketed_paste )
+    return;
+
+  FTerm::putstring (CSI "?2004l");  // disable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste = false;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::enableXTermKeyboardProtocol()
+{
+  // Activate the kitty keyboard protocol or xterm's modifyOtherKeys,
+  // so that the escape key and modified keys are unambiguous
+
+  if ( kitty_keyboard || modify_other_keys )
+    return;
+
+  if ( FTermDetection::hasKittyKeyboardSupport() )
+  {
+    FTerm::putstring (CSI ">1u");  // push the disambiguate flag
+    kitty_keyboard = true;
+  }
+  else if ( FTermDetection::hasModifyOtherKeysSupport() )
+  {
+    FTerm::putstring (CSI ">4;2m");  // set modifyOtherKeys to 2
+    modify_other_keys = true;
+  }
+  else
+    return;
+
+  std::fflush(stdout);
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::disableXTermKeyboardProtocol()
+{
+  // Deactivate the kitty keyboard protocol or xterm's modifyOtherKeys
+
+  if ( kitty_keyboard )
+    FTerm::putstring (CSI "<u");  // pop the keyboard flags
+  else if ( modify_other_keys )
+    FTerm::putstring (CSI ">4m");  // reset modifyOtherKeys
+  else
+    return;
+
+  std::fflush(stdout);
+  kitty_keyboard = false;
+  modify_other_keys = false;
+}
+
 }  // namespace finalcut
@@ -354,7 +354,7 @@ void FTextView::onMouseDown (FMouseEvent* ev)
     setFocus();
 
     if ( focused_widget )
-      focused_widget->redraw();
+      focused_widget->invalidate();
 
     if ( getStatusBar() )
       getStatusBar()->drawMessage();
@@ -402,8 +402,8 @@ void FTextView::onMouseUp (FMouseEvent* ev)
     }
   }
 
-  vbar->redraw();
-  hbar->redraw();
+  vbar->invalidate();
+  hbar->invalidate();
 }
 
 //----------------------------------------------------------------------
@@ -650,8 +650,13 @@ void FTextView::drawText()
   if ( FTerm::isMonochron() )
     setReverse(true);
 
+  const auto visible = getVisibleRect();
+
   for (std::size_t y{0}; y < num; y++)  // Line loop
   {
+    if ( ! isVisibleLine(visible, 2 - nf_offset + int(y)) )
+      continue;  // Skip covered lines
+
     const std::size_t n = std::size_t(yoffset) + y;
     const std::size_t pos = std::size_t(xoffset) + 1;
     const auto text_width = getTextWidth();
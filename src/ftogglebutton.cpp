@@ -24,8 +24,10 @@
 
 #include "final/fapplication.h"
 #include "final/fbuttongroup.h"
+#include "final/fcheckbox.h"
 #include "final/fevent.h"
 #include "final/fpoint.h"
+#include "final/fradiobutton.h"
 #include "final/fstatusbar.h"
 #include "final/ftogglebutton.h"
 #include "final/fwidget.h"
@@ -44,7 +46,7 @@ FToggleButton::FToggleButton (FWidget* parent)
 {
   init();
 
-  if ( parent && parent->isInstanceOf("FButtonGroup") )
+  if ( parent && parent->isA<FButtonGroup>() )
   {
     setGroup(static_cast<FButtonGroup*>(parent));
 
@@ -60,7 +62,7 @@ FToggleButton::FToggleButton (const FString& txt, FWidget* parent)
   FToggleButton::setText(txt);  // call own method
   init();
 
-  if ( parent && parent->isInstanceOf("FButtonGroup") )
+  if ( parent && parent->isA<FButtonGroup>() )
   {
     setGroup(static_cast<FButtonGroup*>(parent));
 
@@ -217,9 +219,9 @@ void FToggleButton::onMouseDown (FMouseEvent* ev)
   setFocus();
 
   if ( focused_widget )
-    focused_widget->redraw();
+    focused_widget->invalidate();
 
-  redraw();
+  invalidate();
 
   if ( getStatusBar() )
     getStatusBar()->drawMessage();
@@ -248,7 +250,7 @@ void FToggleButton::onMouseUp (FMouseEvent* ev)
     processToggle();
   }
 
-  redraw();
+  invalidate();
   processClick();
 }
 
@@ -274,7 +276,7 @@ void FToggleButton::onAccel (FAccelEvent* ev)
     if ( focused_widget && focused_widget->isWidget() )
     {
       setFocus();
-      focused_widget->redraw();
+      focused_widget->invalidate();
     }
   }
 
@@ -292,7 +294,7 @@ void FToggleButton::onAccel (FAccelEvent* ev)
     processToggle();
   }
 
-  redraw();
+  invalidate();
 
   if ( getStatusBar() )
     getStatusBar()->drawMessage();
@@ -331,21 +333,21 @@ void FToggleButton::onFocusOut (FFocusEvent* out_ev)
     if ( out_ev->getFocusType() == FocusTypes::PreviousWidget )
       getGroup()->focusPrevChild();
 
-    redraw();
+    invalidate();
   }
   else if ( this == getGroup()->getLastButton()
          && out_ev->getFocusType() == FocusTypes::NextWidget )
   {
     out_ev->ignore();
     getGroup()->focusNextChild();
-    redraw();
+    invalidate();
   }
   else if ( this == getGroup()->getFirstButton()
          && out_ev->getFocusType() == FocusTypes::PreviousWidget )
   {
     out_ev->ignore();
     getGroup()->focusPrevChild();
-    redraw();
+    invalidate();
   }
 }
 
@@ -360,13 +362,13 @@ void FToggleButton::setHotkeyAccelerator()
 //----------------------------------------------------------------------
 bool FToggleButton::isRadioButton() const
 {
-  return isInstanceOf("FRadioButton");
+  return isA<FRadioButton>();
 }
 
 //----------------------------------------------------------------------
 bool FToggleButton::isCheckboxButton() const
 {
-  return isInstanceOf("FCheckBox");
+  return isA<FCheckBox>();
 }
 
 //----------------------------------------------------------------------
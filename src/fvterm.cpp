@@ -24,20 +24,28 @@
   #include <unistd.h>  // need for ttyname_r
 #endif
 
+#include <algorithm>
+#include <memory>
 #include <numeric>
 #include <queue>
 #include <string>
 #include <vector>
 
 #include "final/fapplication.h"
+#include "final/fareapool.h"
 #include "final/fc.h"
+#include "final/fcharencoder.h"
 #include "final/fcharmap.h"
 #include "final/fcolorpair.h"
+#include "final/fcolorquantizer.h"
+#include "final/fdamageregion.h"
 #include "final/fkeyboard.h"
+#include "final/flineanalyzer.h"
 #include "final/flog.h"
 #include "final/fmouse.h"
 #include "final/foptiattr.h"
 #include "final/foptimove.h"
+#include "final/fsessionrecorder.h"
 #include "final/fstyle.h"
 #include "final/fsystem.h"
 #include "final/fterm.h"
@@ -50,35 +58,91 @@
 #include "final/fvterm.h"
 #include "final/fwidget.h"
 #include "final/fwindow.h"
+#include "final/fworkerpool.h"
 
 namespace finalcut
 {
 
+namespace
+{
+
+// Rectangular area operations of the VT420 (page 1, 1-based coordinates)
+constexpr char DECCRA[] = "\033[%p1%d;%p2%d;%p3%d;%p4%d;1;%p5%d;%p6%d;1$v";
+constexpr char DECFRA[] = "\033[%p1%d;%p2%d;%p3%d;%p4%d;%p5%d$x";
+constexpr char DECERA[] = "\033[%p1%d;%p2%d;%p3%d;%p4%d$z";
+
+//----------------------------------------------------------------------
+FAreaPool& getAreaPool()
+{
+  static FAreaPool area_pool{};
+  return area_pool;
+}
+
+//----------------------------------------------------------------------
+template <typename T>
+void resizeAreaBuffer (T*& buffer, std::size_t& block_size, std::size_t count)
+{
+  // Keeps the block while it is large enough and not oversized,
+  // otherwise it is exchanged for a block of the pool
+
+  const std::size_t size = count * sizeof(T);
+
+  if ( buffer
+    && size <= block_size
+    && FAreaPool::getBlockSize(size) * 4 > block_size )
+    return;
+
+  auto& pool = getAreaPool();
+  pool.deallocate (buffer, block_size);
+  buffer = nullptr;
+  block_size = 0;
+  std::size_t new_block_size{0};
+  auto block = static_cast<T*>(pool.allocate(size, new_block_size));
+  std::uninitialized_fill_n (block, new_block_size / sizeof(T), T{});
+  buffer = block;
+  block_size = new_block_size;
+}
+
+//----------------------------------------------------------------------
+template <typename T>
+void freeAreaBuffer (T*& buffer, std::size_t& block_size)
+{
+  getAreaPool().deallocate (buffer, block_size);
+  buffer = nullptr;
+  block_size = 0;
+}
+
+}  // anonymous namespace
+
 // static class attributes
 bool                 FVTerm::draw_completed{false};
 bool                 FVTerm::combined_char_support{false};
+bool                 FVTerm::rectangle_support{false};
 bool                 FVTerm::no_terminal_updates{false};
 bool                 FVTerm::cursor_hideable{false};
 bool                 FVTerm::force_terminal_update{false};
 uInt64               FVTerm::flush_wait{MIN_FLUSH_WAIT};
 uInt64               FVTerm::flush_average{MIN_FLUSH_WAIT};
 uInt64               FVTerm::flush_median{MIN_FLUSH_WAIT};
-uInt64               FVTerm::term_size_check_timeout{500000};  // 500 ms
 uInt                 FVTerm::erase_char_length{};
 uInt                 FVTerm::repeat_char_length{};
 uInt                 FVTerm::clr_bol_length{};
 uInt                 FVTerm::clr_eol_length{};
 uInt                 FVTerm::cursor_address_length{};
 struct timeval       FVTerm::time_last_flush{};
-struct timeval       FVTerm::last_term_size_check{};
 const FVTerm*        FVTerm::init_object{nullptr};
 FVTerm::FTermArea*   FVTerm::vterm{nullptr};
 FVTerm::FTermArea*   FVTerm::vdesktop{nullptr};
 FVTerm::FTermArea*   FVTerm::active_area{nullptr};
 FChar                FVTerm::term_attribute{};
 FChar                FVTerm::next_attribute{};
-FChar                FVTerm::s_ch{};
-FChar                FVTerm::i_ch{};
+thread_local FChar   FVTerm::s_ch{};
+thread_local FChar   FVTerm::i_ch{};
+FVTerm::FRectangleCopy FVTerm::rect_copy{};
+FDamageRegion        FVTerm::rect_fills{};
+std::unique_ptr<FWorkerPool> FVTerm::compositor_pool{};
+FLineAnalyzer        FVTerm::line_analyzer{};
+FColorQuantizer      FVTerm::color_quantizer{256};
 
 
 //----------------------------------------------------------------------
@@ -128,6 +192,12 @@ FPoint FVTerm::getPrintCursor()
   return {0, 0};
 }
 
+//----------------------------------------------------------------------
+std::size_t FVTerm::getCompositorThreads()
+{
+  return compositor_pool ? compositor_pool->getThreadCount() : 1;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::setTermXY (int x, int y) const
 {
@@ -208,12 +278,17 @@ void FVTerm::setPrintCursor (const FPoint& pos)
 //----------------------------------------------------------------------
 FColor FVTerm::rgb2ColorIndex (uInt8 r, uInt8 g, uInt8 b) const
 {
-  // Converts a 24-bit RGB color to a 256-color compatible approximation
+  // Converts a 24-bit RGB color to the nearest color of the 256-color
+  // palette. Grays are mapped to the grayscale ramp (232...255) if it
+  // is nearer than the color cube.
 
-  const uInt16 ri = (((r * 5) + 127) / 255) * 36;
-  const uInt16 gi = (((g * 5) + 127) / 255) * 6;
-  const uInt16 bi = (((b * 5) + 127) / 255);
-  return FColor(16 + ri + gi + bi);
+  const uInt32 rgb = (uInt32(r) << 16) | (uInt32(g) << 8) | uInt32(b);
+  FColor color{};
+
+  if ( FColorQuantizer::findPaletteColor(rgb, color) )
+    return color;
+
+  return color_quantizer.quantize(rgb);
 }
 
 //----------------------------------------------------------------------
@@ -237,6 +312,18 @@ void FVTerm::setNonBlockingRead (bool enable)
   FKeyboard::setReadBlockingTime (blocking_time);
 }
 
+//----------------------------------------------------------------------
+void FVTerm::setCompositorThreads (std::size_t thread_count)
+{
+  // Composes the areas into the virtual terminal with thread_count
+  // threads (0 = one thread per hardware thread, 1 = no worker threads)
+
+  if ( thread_count == 1 )
+    compositor_pool.reset();
+  else
+    compositor_pool = make_unique<FWorkerPool>(thread_count);
+}
+
 //----------------------------------------------------------------------
 void FVTerm::clearArea (wchar_t fillchar)
 {
@@ -260,7 +347,12 @@ void FVTerm::resizeVTerm (const FSize& size) const
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   const FSize shadow{0, 0};
+  cancelRectangleCopy();
   resizeArea (box, shadow, vterm);
+  const auto& recorder = FTerm::getFSessionRecorder();
+
+  if ( recorder->isRecording() )
+    recorder->recordResize (size);
 }
 
 //----------------------------------------------------------------------
@@ -291,6 +383,16 @@ bool FVTerm::updateTerminal() const
 
   std::size_t changedlines = 0;
 
+  if ( rectangle_support )
+  {
+    // Let the terminal move and fill rectangles itself
+    if ( rect_copy.area )
+      copyRectangle();
+
+    fillRectangles();
+  }
+
+  cancelRectangleCopy();
 
   for (uInt y{0}; y < uInt(vterm->height); y++)
   {
@@ -604,6 +706,11 @@ void FVTerm::flush() const
   }
 
   std::fflush(stdout);
+  const auto& recorder = FTerm::getFSessionRecorder();
+
+  if ( recorder->isRecording() )
+    recorder->flushOutput();  // One output event per flush
+
   const auto& mouse = FTerm::getFMouseControl();
   mouse->drawPointer();
   FObject::getCurrentTime (&time_last_flush);
@@ -635,6 +742,70 @@ FVTerm::FTermArea* FVTerm::getPrintArea()
   return vdesktop;
 }
 
+//----------------------------------------------------------------------
+FRect FVTerm::getVisibleRegion (FTermArea* area, const FRect& box)
+{
+  // Returns the part of the box (in terminal coordinates) that lies
+  // inside the area and the terminal and is not covered by opaque
+  // windows above. Covered rows or columns are only removed at the
+  // edges, so the result is the bounding rectangle of the visible
+  // cells. Child print areas (scroll view content) are not clipped.
+
+  if ( ! area )
+    return {};
+
+  FRect region { area->offset_left, area->offset_top
+               , std::size_t(area->width + area->right_shadow)
+               , std::size_t(area->height + area->bottom_shadow) };
+  FRect term_box{box};
+  term_box.move (-1, -1);
+  region = region.intersect(term_box);
+  const auto& win_list = FWidget::getWindowList();
+  const bool is_window = win_list
+      && std::any_of ( win_list->begin(), win_list->end()
+                     , [&area] (const FWidget* w)
+                       {
+                         return w->getVWin() == area;
+                       } );
+
+  if ( area != vdesktop && ! is_window )
+    return box;
+
+  if ( vterm )
+  {
+    region = region.intersect ({ 0, 0, std::size_t(vterm->width)
+                                     , std::size_t(vterm->height) });
+  }
+
+  const FRect on_screen{region};
+  bool found{ area == vdesktop };
+
+  if ( win_list )
+  {
+    for (auto&& win_obj : *win_list)
+    {
+      const auto& win = win_obj->getVWin();
+
+      if ( win == area )
+        found = true;
+      else if ( found && win && win->visible )
+        cutCoveredRegion (region, win);
+    }
+  }
+
+  if ( region != on_screen )
+    area->has_covered_cells = true;
+
+  region.move (1, 1);
+  return region;
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::isFlushTimeout()
+{
+  return FObject::isTimeout (&time_last_flush, flush_wait);
+}
+
 //----------------------------------------------------------------------
 void FVTerm::createArea ( const FRect& box
                         , const FSize& shadow
@@ -734,18 +905,12 @@ void FVTerm::removeArea (FTermArea*& area)
   if ( area == nullptr )
     return;
 
-  if ( area->changes != nullptr )
-  {
-    delete[] area->changes;
-    area->changes = nullptr;
-  }
-
-  if ( area->data != nullptr )
-  {
-    delete[] area->data;
-    area->data = nullptr;
-  }
+  if ( rect_copy.area == area )
+    cancelRectangleCopy();
 
+  // Returns the buffers to the pool
+  freeAreaBuffer (area->changes, area->changes_block_size);
+  freeAreaBuffer (area->data, area->data_block_size);
   delete area;
   area = nullptr;
 }
@@ -779,17 +944,17 @@ void FVTerm::restoreVTerm (const FRect& box)
   if ( h < 0 )
     return;
 
+  queueRectangleFill (FRect{x, y, std::size_t(w), std::size_t(h)});
+
+  // Compose the region from the desktop and the visible windows
+  // (painter's algorithm), so that opaque spans are copied in one
+  // piece instead of searching all windows for each character
   for (auto ty{0}; ty < h; ty++)
   {
     const int ypos = y + ty;
-
-    for (auto tx{0}; tx < w; tx++)
-    {
-      const int xpos = x + tx;
-      auto& tc = vterm->data[ypos * vterm->width + xpos];  // terminal character
-      auto sc = generateCharacter(FPoint{xpos, ypos});  // shown character
-      std::memcpy (&tc, &sc, sizeof(tc));
-    }
+    const auto& dc = vdesktop->data[ypos * vdesktop->width + x];  // desktop character
+    auto& tc = vterm->data[ypos * vterm->width + x];  // terminal character
+    putAreaLine (dc, tc, std::size_t(w));
 
     if ( int(vterm->changes[ypos].xmin) > x )
       vterm->changes[ypos].xmin = uInt(x);
@@ -798,7 +963,21 @@ void FVTerm::restoreVTerm (const FRect& box)
       vterm->changes[ypos].xmax = uInt(x + w - 1);
   }
 
+  if ( FWidget::getWindowList() )
+  {
+    const FRect restore_box {x, y, std::size_t(w), std::size_t(h)};
+
+    for (auto& win_obj : *FWidget::getWindowList())
+    {
+      const auto& win = win_obj->getVWin();
+
+      if ( win && win->visible )
+        composeArea (win, restore_box);
+    }
+  }
+
   vterm->has_changes = true;
+  invalidateCoveredCells (box);
 }
 
 //----------------------------------------------------------------------
@@ -938,92 +1117,37 @@ void FVTerm::putArea (const FTermArea* area) const
   if ( ! area || ! area->visible )
     return;
 
-  int ax  = area->offset_left;
-  const int ay  = area->offset_top;
-  const int width = area->width + area->right_shadow;
-  const int height = area->height + area->bottom_shadow;
-  int ol{0};  // Outside left
-  int y_end{};
-
   // Call the preprocessing handler methods
   callPreprocessingHandler(area);
 
-  if ( ax < 0 )
-  {
-    ol = std::abs(ax);
-    ax = 0;
-  }
-
-  if ( height + ay > vterm->height )
-    y_end = vterm->height - ay;
-  else
-    y_end = height;
-
-  for (auto y{0}; y < y_end; y++)  // Line loop
-  {
-    bool modified{false};
-    auto line_xmin = int(area->changes[y].xmin);
-    auto line_xmax = int(area->changes[y].xmax);
-
-    if ( line_xmin > line_xmax )
-      continue;
-
-    if ( ax == 0 )
-      line_xmin = ol;
-
-    if ( width + ax - ol >= vterm->width )
-      line_xmax = vterm->width + ol - ax - 1;
-
-    if ( ax + line_xmin >= vterm->width )
-      continue;
-
-    for (auto x = line_xmin; x <= line_xmax; x++)  // Column loop
-    {
-      // Global terminal positions
-      int tx = ax + x;
-      const int ty = ay + y;
-
-      if ( tx < 0 || ty < 0 )
-        continue;
-
-      tx -= ol;
-      bool update = updateVTermCharacter(area, FPoint{x, y}, FPoint{tx, ty});
-
-      if ( ! modified && ! update )
-        line_xmin++;  // Don't update covered character
-
-      if ( update )
-        modified = true;
-    }
-
-    int _xmin = ax + line_xmin - ol;
-    int _xmax = ax + line_xmax;
-
-    if ( _xmin < int(vterm->changes[ay + y].xmin) )
-      vterm->changes[ay + y].xmin = uInt(_xmin);
-
-    if ( _xmax >= vterm->width )
-      _xmax = vterm->width - 1;
-
-    if ( _xmax > int(vterm->changes[ay + y].xmax) )
-      vterm->changes[ay + y].xmax = uInt(_xmax);
-
-    area->changes[y].xmin = uInt(width);
-    area->changes[y].xmax = 0;
-  }
-
+  putAreaLines (area, 0, vterm->height);
   vterm->has_changes = true;
   updateVTermCursor(area);
 }
 
 //----------------------------------------------------------------------
-void FVTerm::putArea (const FPoint& pos, const FTermArea* area)
+void FVTerm::putArea (const FPoint& pos, FTermArea* area)
 {
   // Copies the given area block to the virtual terminal position
 
   if ( ! area || ! area->visible )
     return;
 
+  if ( rectangle_support && area->has_put_pos
+    && ( area->put_left != pos.getX() - 1
+      || area->put_top != pos.getY() - 1 ) )
+  {
+    // The area was moved
+    queueRectangleCopy (area, pos.getX() - 1, pos.getY() - 1);
+  }
+
+  area->put_left = pos.getX() - 1;
+  area->put_top = pos.getY() - 1;
+  area->has_put_pos = true;
+
+  if ( area->has_covered_cells && area->widget )
+    area->widget->invalidate();  // Skipped cells can now be visible
+
   int ax = pos.getX() - 1;
   const int ay = pos.getY() - 1;
   const int width = area->width + area->right_shadow;
@@ -1051,6 +1175,12 @@ void FVTerm::putArea (const FPoint& pos, const FTermArea* area)
   if ( length < 1 )
     return;
 
+  if ( area->has_fill )
+  {
+    area->has_fill = false;
+    queueRectangleFill (FRect{ax, ay, std::size_t(length), std::size_t(y_end)});
+  }
+
   for (auto y{0}; y < y_end; y++)  // line loop
   {
     if ( area->changes[y].trans_count == 0 )
@@ -1083,6 +1213,27 @@ void FVTerm::putArea (const FPoint& pos, const FTermArea* area)
   vterm->has_changes = true;
 }
 
+//----------------------------------------------------------------------
+void FVTerm::markAreaChanged (FTermArea* area)
+{
+  // Marks the entire area to be composed into the virtual terminal
+  // again without repainting its content (e.g. after a vterm resize)
+
+  if ( ! area )
+    return;
+
+  const auto width = uInt(area->width + area->right_shadow);
+  const int height = area->height + area->bottom_shadow;
+
+  for (auto y{0}; y < height; y++)
+  {
+    area->changes[y].xmin = 0;
+    area->changes[y].xmax = width - 1;
+  }
+
+  area->has_changes = true;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::scrollAreaForward (FTermArea* area) const
 {
@@ -1205,6 +1356,14 @@ void FVTerm::clearArea (FTermArea* area, wchar_t fillchar) const
     return;
   }
 
+  area->has_fill = true;  // Candidate for DECFRA or DECERA
+
+  if ( area->has_clip )
+  {
+    clearClippedArea (area, nc);
+    return;
+  }
+
   const auto w = uInt(area->width + area->right_shadow);
 
   if ( area->right_shadow == 0 )
@@ -1241,6 +1400,29 @@ void FVTerm::clearArea (FTermArea* area, wchar_t fillchar) const
   area->has_changes = true;
 }
 
+//----------------------------------------------------------------------
+void FVTerm::setAreaClip (FTermArea* area, const FRect& box)
+{
+  // Restricts the printing on the area to a rectangle
+  // in terminal coordinates
+
+  if ( ! area )
+    return;
+
+  area->clip_left = box.getX1() - area->offset_left - 1;
+  area->clip_top = box.getY1() - area->offset_top - 1;
+  area->clip_right = box.getX2() - area->offset_left - 1;
+  area->clip_bottom = box.getY2() - area->offset_top - 1;
+  area->has_clip = true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::unsetAreaClip (FTermArea* area)
+{
+  if ( area )
+    area->has_clip = false;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::forceTerminalUpdate() const
 {
@@ -1259,13 +1441,6 @@ bool FVTerm::processTerminalUpdate() const
   if ( data && data->hasTermResized() )
     return false;
 
-  // Monitor whether the terminal size has changed
-  if ( isTermSizeChanged() )
-  {
-    raise (SIGWINCH);  // Send SIGWINCH
-    return false;
-  }
-
   // Update data on VTerm
   updateVTerm();
 
@@ -1302,6 +1477,9 @@ void FVTerm::initTerminal()
 
   // Check for support for combined characters
   init_combined_character();
+
+  // Check for rectangular area operations
+  init_rectangle_support();
 }
 
 
@@ -1336,18 +1514,12 @@ inline bool FVTerm::reallocateTextArea ( FTermArea* area
                                        , std::size_t size )
 {
   // Reallocate "height" lines for changes
-  // and "size" bytes for the text area
-
-  if ( area->changes != nullptr )
-    delete[] area->changes;
-
-  if ( area->data != nullptr )
-    delete[] area->data;
+  // and "size" characters for the text area
 
   try
   {
-    area->changes = new FLineChanges[height];
-    area->data    = new FChar[size];
+    resizeAreaBuffer (area->changes, area->changes_block_size, height);
+    resizeAreaBuffer (area->data, area->data_block_size, size);
   }
   catch (const std::bad_alloc&)
   {
@@ -1361,14 +1533,11 @@ inline bool FVTerm::reallocateTextArea ( FTermArea* area
 //----------------------------------------------------------------------
 inline bool FVTerm::reallocateTextArea (FTermArea* area, std::size_t size)
 {
-  // Reallocate "size" bytes for the text area
-
-  if ( area->data != nullptr )
-    delete[] area->data;
+  // Reallocate "size" characters for the text area
 
   try
   {
-    area->data = new FChar[size];
+    resizeAreaBuffer (area->data, area->data_block_size, size);
   }
   catch (const std::bad_alloc&)
   {
@@ -1433,6 +1602,103 @@ FVTerm::CoveredState FVTerm::isCovered ( const FPoint& pos
   return is_covered;
 }
 
+//----------------------------------------------------------------------
+bool FVTerm::isOpaqueLine ( const FTermArea* win
+                          , const FPoint& start, const FPoint& end )
+{
+  // Checks the window characters between two terminal positions
+
+  const int line_len = win->width + win->right_shadow;
+
+  for (auto y{start.getY()}; y <= end.getY(); y++)
+  {
+    for (auto x{start.getX()}; x <= end.getX(); x++)
+    {
+      const auto& ch = win->data[(y - win->offset_top) * line_len
+                                 + x - win->offset_left];
+
+      if ( ch.attr.bit.transparent
+        || ch.attr.bit.color_overlay
+        || ch.attr.bit.inherit_background )
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::cutCoveredRegion (FRect& region, const FTermArea* win)
+{
+  // Removes the rows or columns at the edges of the region
+  // that are completely covered by the given window
+
+  const FRect body { win->offset_left, win->offset_top
+                   , std::size_t(win->width), std::size_t(win->height) };
+
+  if ( region.getWidth() == 0 || region.getHeight() == 0
+    || ! body.overlap(region) )
+    return;
+
+  if ( body.getX1() <= region.getX1() && body.getX2() >= region.getX2() )
+  {
+    // The window covers the full width
+    while ( region.getHeight() > 0
+         && body.contains(region.getX1(), region.getY1())
+         && isOpaqueLine ( win, {region.getX1(), region.getY1()}
+                              , {region.getX2(), region.getY1()} ) )
+      region.setY1 (region.getY1() + 1);
+
+    while ( region.getHeight() > 0
+         && body.contains(region.getX1(), region.getY2())
+         && isOpaqueLine ( win, {region.getX1(), region.getY2()}
+                              , {region.getX2(), region.getY2()} ) )
+      region.setY2 (region.getY2() - 1);
+  }
+  else if ( body.getY1() <= region.getY1() && body.getY2() >= region.getY2() )
+  {
+    // The window covers the full height
+    while ( region.getWidth() > 0
+         && body.contains(region.getX1(), region.getY1())
+         && isOpaqueLine ( win, {region.getX1(), region.getY1()}
+                              , {region.getX1(), region.getY2()} ) )
+      region.setX1 (region.getX1() + 1);
+
+    while ( region.getWidth() > 0
+         && body.contains(region.getX2(), region.getY1())
+         && isOpaqueLine ( win, {region.getX2(), region.getY1()}
+                              , {region.getX2(), region.getY2()} ) )
+      region.setX2 (region.getX2() - 1);
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTerm::invalidateCoveredCells (const FRect& box)
+{
+  // Requests the redrawing of skipped cells that became visible
+
+  const auto invalidate = [&box] (FWidget* widget)
+  {
+    FRect exposed{box.intersect(widget->getTermGeometryWithShadow())};
+    exposed.move (1 - widget->getTermX(), 1 - widget->getTermY());
+    widget->invalidate(exposed);
+  };
+
+  if ( vdesktop && vdesktop->has_covered_cells && vdesktop->widget )
+    invalidate (vdesktop->widget);
+
+  if ( ! FWidget::getWindowList() )
+    return;
+
+  for (auto&& win_obj : *FWidget::getWindowList())
+  {
+    const auto& win = win_obj->getVWin();
+
+    if ( win && win->visible && win->has_covered_cells )
+      invalidate (win_obj);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::updateOverlappedColor ( const FChar& area_char
                                           , const FChar& over_char
@@ -1445,6 +1711,8 @@ inline void FVTerm::updateOverlappedColor ( const FChar& area_char
   std::memcpy (&nc, &area_char, sizeof(nc));
   nc.fg_color = over_char.fg_color;
   nc.bg_color = over_char.bg_color;
+  nc.fg_rgb   = over_char.fg_rgb;
+  nc.bg_rgb   = over_char.bg_rgb;
   nc.attr.bit.reverse  = false;
   nc.attr.bit.standout = false;
 
@@ -1480,6 +1748,8 @@ inline void FVTerm::updateShadedCharacter ( const FChar& area_char
 
   cover_char.fg_color = area_char.fg_color;
   cover_char.bg_color = area_char.bg_color;
+  cover_char.fg_rgb   = area_char.fg_rgb;
+  cover_char.bg_rgb   = area_char.bg_rgb;
   cover_char.attr.bit.reverse  = false;
   cover_char.attr.bit.standout = false;
 
@@ -1507,6 +1777,7 @@ inline void FVTerm::updateInheritBackground ( const FChar& area_char
   FChar nc{};
   std::memcpy (&nc, &area_char, sizeof(nc));
   nc.bg_color = cover_char.bg_color;
+  nc.bg_rgb   = cover_char.bg_rgb;
   nc.attr.bit.no_changes = \
       bool(vterm_char.attr.bit.printed && vterm_char == nc);
   std::memcpy (&vterm_char, &nc, sizeof(vterm_char));
@@ -1585,40 +1856,165 @@ void FVTerm::updateVTerm() const
 {
   // Updates the character data from all areas to VTerm
 
-  if ( hasPendingUpdates(vdesktop) )
-  {
-    putArea(vdesktop);
-    vdesktop->has_changes = false;
-  }
+  // Areas with changes in z-order (second = only child area changes)
+  std::vector<std::pair<FTermArea*, bool>> areas{};
 
-  const FWidget* widget = vterm->widget;
+  if ( vdesktop && vdesktop->visible && hasPendingUpdates(vdesktop) )
+    areas.emplace_back (vdesktop, false);
 
-  if ( ! widget || ! widget->getWindowList()
-    || widget->getWindowList()->empty() )
-    return;
+  const FWidget* widget = vterm->widget;
 
-  for (auto&& window : *(widget->getWindowList()))
+  if ( widget && widget->getWindowList() )
   {
-    auto v_win = window->getVWin();
+    for (auto&& window : *(widget->getWindowList()))
+    {
+      auto v_win = window->getVWin();
 
-    if ( ! (v_win && v_win->visible) )
-      continue;
+      if ( ! (v_win && v_win->visible) )
+        continue;
 
-    if ( hasPendingUpdates(v_win) )
-    {
-      putArea(v_win);
-      v_win->has_changes = false;
-    }
-    else if ( hasChildAreaChanges(v_win) )
-    {
-      putArea(v_win);  // and call the child area processing handler there
-      clearChildAreaChanges(v_win);
+      if ( hasPendingUpdates(v_win) )
+        areas.emplace_back (v_win, false);
+      else if ( hasChildAreaChanges(v_win) )
+        areas.emplace_back (v_win, true);
     }
   }
-}
 
-//----------------------------------------------------------------------
-void FVTerm::callPreprocessingHandler (const FTermArea* area)
+  if ( areas.empty() )
+    return;
+
+  // The preprocessing handlers copy the child areas into their
+  // windows before any window is composed into the virtual terminal
+  for (auto&& entry : areas)
+  {
+    callPreprocessingHandler(entry.first);
+    queueRectangleFill(entry.first);
+  }
+
+  const int height = vterm->height;
+
+  if ( compositor_pool && height > 1
+    && vterm->width * height >= MIN_PARALLEL_CELLS )
+  {
+    // Each line band gets all areas in z-order. The bands are
+    // independent because a line only reads the areas and writes
+    // its own vterm line, so the result equals the serial one.
+    const int bands = std::min ( height, BANDS_PER_THREAD
+                                 * int(compositor_pool->getThreadCount()) );
+    compositor_pool->run ( std::size_t(bands)
+                         , [&areas, bands, height] (std::size_t band)
+                           {
+                             const int first_line = int(band) * height / bands;
+                             const int last_line = int(band + 1) * height / bands;
+
+                             for (auto&& entry : areas)
+                               putAreaLines (entry.first, first_line, last_line);
+                           } );
+  }
+  else
+  {
+    for (auto&& entry : areas)
+      putAreaLines (entry.first, 0, height);
+  }
+
+  for (auto&& entry : areas)
+  {
+    updateVTermCursor(entry.first);
+
+    if ( entry.second )
+      clearChildAreaChanges(entry.first);
+    else
+      entry.first->has_changes = false;
+  }
+
+  vterm->has_changes = true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::putAreaLines (const FTermArea* area, int first_line, int last_line)
+{
+  // Add the area changes in the terminal lines first_line
+  // to last_line - 1 to the virtual terminal
+
+  int ax  = area->offset_left;
+  const int ay  = area->offset_top;
+  const int width = area->width + area->right_shadow;
+  const int height = area->height + area->bottom_shadow;
+  int ol{0};  // Outside left
+
+  if ( ax < 0 )
+  {
+    ol = std::abs(ax);
+    ax = 0;
+  }
+
+  // Area lines above the terminal belong to the first line band
+  const int y_start = ( first_line > 0 ) ? std::max(first_line - ay, 0) : 0;
+  const int y_end = std::min(height, last_line - ay);
+
+  for (auto y{y_start}; y < y_end; y++)  // Line loop
+  {
+    bool modified{false};
+    auto line_xmin = int(area->changes[y].xmin);
+    auto line_xmax = int(area->changes[y].xmax);
+
+    if ( line_xmin > line_xmax )
+      continue;
+
+    if ( ay + y < 0 )  // Outside the terminal
+    {
+      area->changes[y].xmin = uInt(width);
+      area->changes[y].xmax = 0;
+      continue;
+    }
+
+    if ( ax == 0 )
+      line_xmin = ol;
+
+    if ( width + ax - ol >= vterm->width )
+      line_xmax = vterm->width + ol - ax - 1;
+
+    if ( ax + line_xmin >= vterm->width )
+      continue;
+
+    for (auto x = line_xmin; x <= line_xmax; x++)  // Column loop
+    {
+      // Global terminal positions
+      int tx = ax + x;
+      const int ty = ay + y;
+
+      if ( tx < 0 )
+        continue;
+
+      tx -= ol;
+      bool update = updateVTermCharacter(area, FPoint{x, y}, FPoint{tx, ty});
+
+      if ( ! modified && ! update )
+        line_xmin++;  // Don't update covered character
+
+      if ( update )
+        modified = true;
+    }
+
+    int _xmin = ax + line_xmin - ol;
+    int _xmax = ax + line_xmax;
+
+    if ( _xmin < int(vterm->changes[ay + y].xmin) )
+      vterm->changes[ay + y].xmin = uInt(_xmin);
+
+    if ( _xmax >= vterm->width )
+      _xmax = vterm->width - 1;
+
+    if ( _xmax > int(vterm->changes[ay + y].xmax) )
+      vterm->changes[ay + y].xmax = uInt(_xmax);
+
+    area->changes[y].xmin = uInt(width);
+    area->changes[y].xmax = 0;
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTerm::callPreprocessingHandler (const FTermArea* area)
 {
   // Call preprocessing handler
 
@@ -1679,73 +2075,97 @@ bool FVTerm::isInsideArea (const FPoint& pos, const FTermArea* area)
 }
 
 //----------------------------------------------------------------------
-FChar FVTerm::generateCharacter (const FPoint& pos)
+void FVTerm::composeArea (const FTermArea* area, const FRect& box)
 {
-  // Generates characters for a given position considering all areas
+  // Puts the part of an area that lies inside box (terminal
+  // coordinates) over the already composed virtual terminal
 
-  const int x = pos.getX();
-  const int y = pos.getY();
-  auto sc = &vdesktop->data[y * vdesktop->width + x];  // shown character
+  const int area_x = area->offset_left;
+  const int area_y = area->offset_top;
+  const int line_len = area->width + area->right_shadow;
+  const int area_height = area->height + area->bottom_shadow;
+  const int x1 = std::max(box.getX(), area_x);
+  const int y1 = std::max(box.getY(), area_y);
+  const int x2 = std::min(box.getX() + int(box.getWidth()), area_x + line_len);
+  const int y2 = std::min(box.getY() + int(box.getHeight()), area_y + area_height);
+
+  if ( x1 >= x2 || y1 >= y2 )  // No intersection
+    return;
 
-  if ( ! FWidget::getWindowList() || FWidget::getWindowList()->empty() )
-    return *sc;
+  const auto length = std::size_t(x2 - x1);
 
-  for (auto& win_obj : *FWidget::getWindowList())
+  for (auto ypos{y1}; ypos < y2; ypos++)
   {
-    const auto& win = win_obj->getVWin();
+    const auto ac = &area->data[(ypos - area_y) * line_len + (x1 - area_x)];
+    const auto tc = &vterm->data[ypos * vterm->width + x1];
+    composeAreaLine (ac, tc, length);
+  }
+}
 
-    if ( ! win || ! win->visible )
-      continue;
+//----------------------------------------------------------------------
+void FVTerm::composeAreaLine ( const FChar* area_char
+                             , FChar* vterm_char
+                             , std::size_t length )
+{
+  // Opaque characters are copied in spans, transparent,
+  // shadow and inherit-background characters one by one
 
-    const int win_x = win->offset_left;
-    const int win_y = win->offset_top;
-    const FRect geometry { win_x, win_y
-        , std::size_t(win->width) + std::size_t(win->right_shadow)
-        , std::size_t(win->height) + std::size_t(win->bottom_shadow) };
+  std::size_t span_start{0};
 
-    // Window is visible and contains current character
-    if ( geometry.contains(x, y) )
-    {
-      const int line_len = win->width + win->right_shadow;
-      auto tmp = &win->data[(y - win_y) * line_len + (x - win_x)];
+  for (std::size_t i{0}; i < length; i++)
+  {
+    const auto& ac = area_char[i];
 
-      if ( ! tmp->attr.bit.transparent )   // Current character not transparent
-      {
-        if ( tmp->attr.bit.color_overlay )  // Transparent shadow
-        {
-          // Keep the current vterm character
-          if ( sc != &s_ch )
-            std::memcpy (&s_ch, sc, sizeof(s_ch));
-
-          s_ch.fg_color = tmp->fg_color;
-          s_ch.bg_color = tmp->bg_color;
-          s_ch.attr.bit.reverse  = false;
-          s_ch.attr.bit.standout = false;
-
-          if ( s_ch.ch[0] == UniChar::LowerHalfBlock
-            || s_ch.ch[0] == UniChar::UpperHalfBlock
-            || s_ch.ch[0] == UniChar::LeftHalfBlock
-            || s_ch.ch[0] == UniChar::RightHalfBlock
-            || s_ch.ch[0] == UniChar::MediumShade
-            || s_ch.ch[0] == UniChar::FullBlock )
-            s_ch.ch[0] = ' ';
-
-          sc = &s_ch;
-        }
-        else if ( tmp->attr.bit.inherit_background )
-        {
-          // Add the covered background to this character
-          std::memcpy (&i_ch, tmp, sizeof(i_ch));
-          i_ch.bg_color = sc->bg_color;  // Last background color
-          sc = &i_ch;
-        }
-        else  // Default
-          sc = tmp;
-      }
-    }
+    if ( ! ac.attr.bit.transparent
+      && ! ac.attr.bit.color_overlay
+      && ! ac.attr.bit.inherit_background )
+      continue;
+
+    if ( i > span_start )
+      putAreaLine (area_char[span_start], vterm_char[span_start], i - span_start);
+
+    composeCharacter (ac, vterm_char[i]);
+    span_start = i + 1;
   }
 
-  return *sc;
+  if ( length > span_start )
+    putAreaLine (area_char[span_start], vterm_char[span_start], length - span_start);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::composeCharacter (const FChar& area_char, FChar& vterm_char)
+{
+  // Combines a non-opaque area character with the character below
+
+  if ( area_char.attr.bit.transparent )  // Keep the covered character
+    return;
+
+  if ( area_char.attr.bit.color_overlay )  // Transparent shadow
+  {
+    vterm_char.fg_color = area_char.fg_color;
+    vterm_char.bg_color = area_char.bg_color;
+    vterm_char.fg_rgb   = area_char.fg_rgb;
+    vterm_char.bg_rgb   = area_char.bg_rgb;
+    vterm_char.attr.bit.reverse  = false;
+    vterm_char.attr.bit.standout = false;
+
+    if ( vterm_char.ch[0] == UniChar::LowerHalfBlock
+      || vterm_char.ch[0] == UniChar::UpperHalfBlock
+      || vterm_char.ch[0] == UniChar::LeftHalfBlock
+      || vterm_char.ch[0] == UniChar::RightHalfBlock
+      || vterm_char.ch[0] == UniChar::MediumShade
+      || vterm_char.ch[0] == UniChar::FullBlock )
+      vterm_char.ch[0] = ' ';
+  }
+  else if ( area_char.attr.bit.inherit_background )
+  {
+    // Add the covered background to this character
+    const auto bg_color = vterm_char.bg_color;  // Last background color
+    const auto bg_rgb = vterm_char.bg_rgb;
+    std::memcpy (&vterm_char, &area_char, sizeof(vterm_char));
+    vterm_char.bg_color = bg_color;
+    vterm_char.bg_rgb   = bg_rgb;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -1866,11 +2286,9 @@ void FVTerm::init()
   vdesktop->visible = true;
   active_area = vdesktop;
 
-  // Initialize the flush and last terminal size check time
+  // Initialize the flush time
   time_last_flush.tv_sec = 0;
   time_last_flush.tv_usec = 0;
-  last_term_size_check.tv_sec = 0;
-  last_term_size_check.tv_usec = 0;
 }
 
 //----------------------------------------------------------------------
@@ -1924,6 +2342,14 @@ void FVTerm::init_combined_character()
   }
 }
 
+//----------------------------------------------------------------------
+void FVTerm::init_rectangle_support()
+{
+  // DECCRA, DECFRA and DECERA are available from the VT420 on
+  const auto& term_detection = FTerm::getFTermDetection();
+  rectangle_support = term_detection->hasRectangleSupport();
+}
+
 //----------------------------------------------------------------------
 void FVTerm::finish() const
 {
@@ -1943,6 +2369,7 @@ void FVTerm::finish() const
   removeArea (vdesktop);
   removeArea (vterm);
 
+  compositor_pool.reset();
   init_object = nullptr;
 }
 
@@ -1972,6 +2399,8 @@ void FVTerm::putAreaCharacter ( const FPoint& pos, const FTermArea* area
       FChar ch = getCoveredCharacter (pos, area);
       ch.fg_color = area_char.fg_color;
       ch.bg_color = area_char.bg_color;
+      ch.fg_rgb   = area_char.fg_rgb;
+      ch.bg_rgb   = area_char.bg_rgb;
       ch.attr.bit.reverse  = false;
       ch.attr.bit.standout = false;
 
@@ -1992,6 +2421,7 @@ void FVTerm::putAreaCharacter ( const FPoint& pos, const FTermArea* area
       std::memcpy (&ch, &area_char, sizeof(ch));
       FChar cc = getCoveredCharacter (pos, area);
       ch.bg_color = cc.bg_color;
+      ch.bg_rgb   = cc.bg_rgb;
       std::memcpy (&vterm_char, &ch, sizeof(vterm_char));
     }
     else  // Default
@@ -2019,6 +2449,8 @@ void FVTerm::getAreaCharacter ( const FPoint& pos, const FTermArea* area
       std::memcpy (&s_ch, cc, sizeof(s_ch));
       s_ch.fg_color = tmp.fg_color;
       s_ch.bg_color = tmp.bg_color;
+      s_ch.fg_rgb   = tmp.fg_rgb;
+      s_ch.bg_rgb   = tmp.bg_rgb;
       s_ch.attr.bit.reverse  = false;
       s_ch.attr.bit.standout = false;
       cc = &s_ch;
@@ -2028,6 +2460,7 @@ void FVTerm::getAreaCharacter ( const FPoint& pos, const FTermArea* area
       // Add the covered background to this character
       std::memcpy (&i_ch, &tmp, sizeof(i_ch));
       i_ch.bg_color = cc->bg_color;  // last background color
+      i_ch.bg_rgb   = cc->bg_rgb;
       cc = &i_ch;
     }
     else  // default
@@ -2053,6 +2486,8 @@ bool FVTerm::clearTerm (wchar_t fillchar) const
     return false;
   }
 
+  cancelRectangleCopy();  // The old terminal content is gone
+
   if ( cl )  // Clear screen
   {
     appendOutputBuffer (FTermControl{cl});
@@ -2136,6 +2571,33 @@ void FVTerm::clearAreaWithShadow (const FTermArea* area, const FChar& nc)
   }
 }
 
+//----------------------------------------------------------------------
+void FVTerm::clearClippedArea (FTermArea* area, const FChar& nc)
+{
+  // Clears only the characters inside the clipping rectangle
+
+  FChar t_char = nc;
+  t_char.attr.bit.transparent = true;
+  const int x1 = std::max(area->clip_left, 0);
+  const int y1 = std::max(area->clip_top, 0);
+  const int x2 = std::min(area->clip_right, area->width + area->right_shadow - 1);
+  const int y2 = std::min(area->clip_bottom, area->height + area->bottom_shadow - 1);
+
+  for (auto y{y1}; y <= y2; y++)
+  {
+    for (auto x{x1}; x <= x2; x++)
+    {
+      // The shadow stays transparent
+      if ( x >= area->width || y >= area->height )
+        setAreaCharacter (area, x, y, t_char);
+      else
+        setAreaCharacter (area, x, y, nc);
+    }
+  }
+
+  area->has_changes = true;
+}
+
 //----------------------------------------------------------------------
 bool FVTerm::canClearToEOL (uInt xmin, uInt y)
 {
@@ -2148,21 +2610,12 @@ bool FVTerm::canClearToEOL (uInt xmin, uInt y)
 
   if ( ce && min_char.ch[0] == ' ' )
   {
-    uInt beginning_whitespace = 1;
+    // The run at the line end starts at xmin or in front of it
+    const uInt beginning_whitespace = uInt(vt->width) - xmin;
     const bool normal = FTerm::isNormal(min_char);
     const bool& ut = FTermcap::background_color_erase;
 
-    for (uInt x = xmin + 1; x < uInt(vt->width); x++)
-    {
-      const auto& ch = vt->data[y * uInt(vt->width) + x];
-
-      if ( min_char == ch )
-        beginning_whitespace++;
-      else
-        break;
-    }
-
-    if ( beginning_whitespace == uInt(vt->width) - xmin
+    if ( line_analyzer.getTrailingRun() >= beginning_whitespace
       && (ut || normal)
       && clr_eol_length < beginning_whitespace )
       return true;
@@ -2183,20 +2636,10 @@ bool FVTerm::canClearLeadingWS (uInt& xmin, uInt y)
 
   if ( cb && first_char.ch[0] == ' ' )
   {
-    uInt leading_whitespace = 1;
+    const uInt leading_whitespace = line_analyzer.getEqualRun(0);
     const bool normal = FTerm::isNormal(first_char);
     const bool& ut = FTermcap::background_color_erase;
 
-    for (uInt x{1}; x < uInt(vt->width); x++)
-    {
-      const auto& ch = vt->data[y * uInt(vt->width) + x];
-
-      if ( first_char == ch )
-        leading_whitespace++;
-      else
-        break;
-    }
-
     if ( leading_whitespace > xmin
       && (ut || normal)
       && clr_bol_length < leading_whitespace )
@@ -2221,20 +2664,12 @@ bool FVTerm::canClearTrailingWS (uInt& xmax, uInt y)
 
   if ( ce && last_char.ch[0] == ' ' )
   {
-    uInt trailing_whitespace = 1;
+    // Trailing run + 1, so that xmax is the column in front of it
+    const uInt trailing_whitespace = 1 + std::min ( line_analyzer.getTrailingRun()
+                                                  , uInt(vt->width) - 1 );
     const bool normal = FTerm::isNormal(last_char);
     const bool& ut = FTermcap::background_color_erase;
 
-    for (uInt x = uInt(vt->width) - 1; x >  0 ; x--)
-    {
-      const auto& ch = vt->data[y * uInt(vt->width) + x];
-
-      if ( last_char == ch )
-        trailing_whitespace++;
-      else
-        break;
-    }
-
     if ( trailing_whitespace > uInt(vt->width) - xmax
       && (ut || normal)
       && clr_bol_length < trailing_whitespace )
@@ -2258,17 +2693,7 @@ bool FVTerm::skipUnchangedCharacters (uInt& x, uInt xmax, uInt y) const
 
   if ( print_char.attr.bit.no_changes )
   {
-    uInt count{1};
-
-    for (uInt i = x + 1; i <= xmax; i++)
-    {
-      const auto& ch = vt->data[y * uInt(vt->width) + i];
-
-      if ( ch.attr.bit.no_changes )
-        count++;
-      else
-        break;
-    }
+    const uInt count = std::min(line_analyzer.getUnchangedRun(x), xmax - x + 1);
 
     if ( count > cursor_address_length )
     {
@@ -2292,7 +2717,10 @@ void FVTerm::printRange ( uInt xmin, uInt xmax, uInt y
     const auto& rp = TCAP(t_repeat_char);
     auto& print_char = vt->data[y * uInt(vt->width) + x];
     print_char.attr.bit.printed = true;
-    replaceNonPrintableFullwidth (x, print_char);
+
+    // A replaced character starts a new run
+    if ( replaceNonPrintableFullwidth(x, print_char) )
+      line_analyzer.analyze (&vt->data[y * uInt(vt->width)], uInt(vt->width), x, xmax);
 
     // skip character with no changes
     if ( skipUnchangedCharacters(x, xmax, y) )
@@ -2320,7 +2748,7 @@ void FVTerm::printRange ( uInt xmin, uInt xmax, uInt y
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::replaceNonPrintableFullwidth ( uInt x
+inline bool FVTerm::replaceNonPrintableFullwidth ( uInt x
                                                  , FChar& print_char ) const
 {
   // Replace non-printable full-width characters that are truncated
@@ -2331,14 +2759,18 @@ inline void FVTerm::replaceNonPrintableFullwidth ( uInt x
     print_char.ch[0] = wchar_t(UniChar::SingleLeftAngleQuotationMark);  // ‹
     print_char.ch[1] = L'\0';
     print_char.attr.bit.fullwidth_padding = false;
+    return true;
   }
-  else if ( x == uInt(vterm->width - 1)
-         && isFullWidthChar(print_char) )
+
+  if ( x == uInt(vterm->width - 1) && isFullWidthChar(print_char) )
   {
     print_char.ch[0] = wchar_t(UniChar::SingleRightAngleQuotationMark);  // ›
     print_char.ch[1] = L'\0';
     print_char.attr.bit.char_width = 1;
+    return true;
   }
+
+  return false;
 }
 
 //----------------------------------------------------------------------
@@ -2379,6 +2811,8 @@ void FVTerm::printFullWidthCharacter ( uInt& x, uInt y
     && print_char.attr.byte[1] == next_char.attr.byte[1]
     && print_char.fg_color == next_char.fg_color
     && print_char.bg_color == next_char.bg_color
+    && print_char.fg_rgb == next_char.fg_rgb
+    && print_char.bg_rgb == next_char.bg_rgb
     && isFullWidthChar(print_char)
     && isFullWidthPaddingChar(next_char) )
   {
@@ -2418,6 +2852,8 @@ void FVTerm::printFullWidthPaddingCharacter ( uInt& x, uInt y
     && print_char.attr.byte[1] == prev_char.attr.byte[1]
     && print_char.fg_color == prev_char.fg_color
     && print_char.bg_color == prev_char.bg_color
+    && print_char.fg_rgb == prev_char.fg_rgb
+    && print_char.bg_rgb == prev_char.bg_rgb
     && isFullWidthChar(prev_char)
     && isFullWidthPaddingChar(print_char) )
   {
@@ -2513,17 +2949,7 @@ FVTerm::PrintState FVTerm::eraseCharacters ( uInt& x, uInt xmax, uInt y
   if ( ! ec || print_char.ch[0] != ' ' )
     return PrintState::NothingPrinted;
 
-  uInt whitespace{1};
-
-  for (uInt i = x + 1; i <= xmax; i++)
-  {
-    const auto& ch = vt->data[y * uInt(vt->width) + i];
-
-    if ( print_char == ch )
-      whitespace++;
-    else
-      break;
-  }
+  const uInt whitespace = std::min(line_analyzer.getEqualRun(x), xmax - x + 1);
 
   if ( whitespace == 1 )
   {
@@ -2578,17 +3004,7 @@ FVTerm::PrintState FVTerm::repeatCharacter (uInt& x, uInt xmax, uInt y) const
   if ( ! rp )
     return PrintState::NothingPrinted;
 
-  uInt repetitions{1};
-
-  for (uInt i = x + 1; i <= xmax; i++)
-  {
-    const auto& ch = vt->data[y * uInt(vt->width) + i];
-
-    if ( print_char == ch )
-      repetitions++;
-    else
-      break;
-  }
+  const uInt repetitions = std::min(line_analyzer.getEqualRun(x), xmax - x + 1);
 
   if ( repetitions == 1 )
   {
@@ -2697,12 +3113,27 @@ inline void FVTerm::printCharacterOnCoordinate ( FTermArea* area
                                                , const int& ay
                                                , const FChar& ch) const
 {
-  if ( area->cursor_x <= 0
-    || area->cursor_y <= 0
-    || ax >= area->width + area->right_shadow
+  if ( area->cursor_x <= 0 || area->cursor_y <= 0 )
+    return;
+
+  setAreaCharacter (area, ax, ay, ch);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::setAreaCharacter ( FTermArea* area
+                                     , const int& ax
+                                     , const int& ay
+                                     , const FChar& ch )
+{
+  if ( ax >= area->width + area->right_shadow
     || ay >= area->height + area->bottom_shadow )
     return;
 
+  if ( area->has_clip
+    && ( ax < area->clip_left || ax > area->clip_right
+      || ay < area->clip_top || ay > area->clip_bottom ) )
+    return;
+
   const int line_len = area->width + area->right_shadow;
   auto& ac = area->data[ay * line_len + ax];  // area character
 
@@ -2764,6 +3195,340 @@ void FVTerm::printPaddingCharacter (FTermArea* area, const FChar& term_char)
   print (area, pc);
 }
 
+//----------------------------------------------------------------------
+void FVTerm::queueRectangleCopy (const FTermArea* area, int x, int y)
+{
+  // Remembers the terminal cells at the old position of a moved area,
+  // so that the next terminal update can copy them with DECCRA
+
+  if ( rect_copy.area == area )  // Moved again before the update
+  {
+    rect_copy.dx += x - area->put_left;
+    rect_copy.dy += y - area->put_top;
+    return;
+  }
+
+  if ( rect_copy.area )  // Only one copy per terminal update
+    return;
+
+  const int x1 = std::max(area->put_left, 0);
+  const int y1 = std::max(area->put_top, 0);
+  const int x2 = std::min(area->put_left + area->width, vterm->width);
+  const int y2 = std::min(area->put_top + area->height, vterm->height);
+
+  if ( x1 >= x2 || y1 >= y2 )
+    return;
+
+  rect_copy.data.reserve(std::size_t((x2 - x1) * (y2 - y1)));
+
+  for (auto line{y1}; line < y2; line++)
+  {
+    const auto* begin = &vterm->data[line * vterm->width + x1];
+    const auto* end = begin + (x2 - x1);
+
+    // The terminal has to show exactly these characters
+    if ( ! std::all_of ( begin, end
+                       , [] (const FChar& ch)
+                         {
+                           return ch.attr.bit.printed;
+                         } ) )
+    {
+      rect_copy.data.clear();
+      return;
+    }
+
+    rect_copy.data.insert (rect_copy.data.end(), begin, end);
+  }
+
+  rect_copy.area   = area;
+  rect_copy.x      = x1;
+  rect_copy.y      = y1;
+  rect_copy.width  = x2 - x1;
+  rect_copy.height = y2 - y1;
+  rect_copy.dx     = x - area->put_left;
+  rect_copy.dy     = y - area->put_top;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::cancelRectangleCopy()
+{
+  rect_copy.area = nullptr;
+  rect_copy.data.clear();
+}
+
+//----------------------------------------------------------------------
+void FVTerm::queueRectangleFill (const FRect& box)
+{
+  // Remembers a terminal region (0-based) in which fillRectangles()
+  // looks for blocks of the same character
+
+  if ( rectangle_support )
+    rect_fills.add(box);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::queueRectangleFill (FTermArea* area)
+{
+  if ( ! area->has_fill )
+    return;
+
+  area->has_fill = false;
+  queueRectangleFill (FRect{ area->offset_left, area->offset_top
+                           , std::size_t(area->width + area->right_shadow)
+                           , std::size_t(area->height + area->bottom_shadow) });
+}
+
+//----------------------------------------------------------------------
+void FVTerm::copyRectangle() const
+{
+  // Copies the remembered cells with DECCRA to the new area position
+  // if most of them are still the same there
+
+  const auto& rc = rect_copy;
+  const auto source_char = [&rc] (int x, int y) -> const FChar&
+  {
+    return rc.data[std::size_t((y - rc.y) * rc.width + x - rc.x)];
+  };
+  const auto target_char = [&rc] (int x, int y) -> FChar&
+  {
+    return vterm->data[(y + rc.dy) * vterm->width + x + rc.dx];
+  };
+
+  // Source cells with a target inside the terminal
+  const int x1 = std::max(rc.x, -rc.dx);
+  const int y1 = std::max(rc.y, -rc.dy);
+  const int x2 = std::min(rc.x + rc.width, vterm->width - rc.dx);
+  const int y2 = std::min(rc.y + rc.height, vterm->height - rc.dy);
+
+  if ( x1 >= x2 || y1 >= y2 || (rc.dx == 0 && rc.dy == 0) )
+    return;
+
+  int matches{0};
+
+  for (auto y{y1}; y < y2; y++)
+  {
+    // Full-width characters must not be cut at the edges
+    if ( isFullWidthPaddingChar(source_char(x1, y))
+      || isFullWidthChar(source_char(x2 - 1, y)) )
+      return;
+
+    for (auto x{x1}; x < x2; x++)
+    {
+      const auto& source = source_char(x, y);
+      const auto& target = target_char(x, y);
+
+      if ( source == target )
+        matches++;
+      else if ( isFullWidthChar(source) || isFullWidthPaddingChar(source)
+             || isFullWidthChar(target) || isFullWidthPaddingChar(target) )
+        return;
+    }
+  }
+
+  if ( matches < MIN_RECTANGLE_CELLS || 2 * matches < (x2 - x1) * (y2 - y1) )
+    return;  // Printing the characters is cheaper
+
+  const auto& cra = FTermcap::encodeParameter ( DECCRA, y1 + 1, x1 + 1
+                                              , y2, x2
+                                              , y1 + rc.dy + 1
+                                              , x1 + rc.dx + 1 );
+  appendOutputBuffer (FTermControl{cra});
+
+  for (auto y{y1}; y < y2; y++)
+  {
+    for (auto x{x1}; x < x2; x++)
+    {
+      // Different characters have to be printed again
+      auto& target = target_char(x, y);
+      const bool is_copied = bool(source_char(x, y) == target);
+      target.attr.bit.printed = is_copied;
+      target.attr.bit.no_changes = is_copied;
+    }
+
+    auto& changes = vterm->changes[y + rc.dy];
+    changes.xmin = std::min(changes.xmin, uInt(x1 + rc.dx));
+    changes.xmax = std::max(changes.xmax, uInt(x2 - 1 + rc.dx));
+    trimLineChanges (uInt(y + rc.dy));
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTerm::fillRectangles() const
+{
+  // Outputs changed blocks of the same character over several
+  // lines with a single DECFRA or DECERA sequence. Only the queued
+  // regions of cleared areas and restored terminal parts are searched.
+
+  const auto width = uInt(vterm->width);
+  const FRect terminal{0, 0, std::size_t(vterm->width), std::size_t(vterm->height)};
+  rect_fills.merge();
+
+  for (auto&& queued : rect_fills.getRects())
+  {
+    const auto box = queued.intersect(terminal);
+
+    if ( box.getWidth() == 0 || box.getHeight() < 2 )
+      continue;
+
+    const auto box_x2 = uInt(box.getX2());
+    const auto box_y_end = uInt(box.getY2() + 1);
+
+    for (auto y = uInt(box.getY1()); y + 1 < box_y_end; y++)
+    {
+      const auto& changes = vterm->changes[y];
+
+      for (auto x = std::max(changes.xmin, uInt(box.getX1()));
+           x <= std::min(changes.xmax, box_x2); x++)
+      {
+        FChar fill_char{vterm->data[y * width + x]};
+
+        if ( ! isRectangleFillChar(fill_char) )
+          continue;
+
+        uInt x_end = x + 1;
+
+        while ( x_end <= std::min(changes.xmax, box_x2) )
+        {
+          const auto& ch = vterm->data[y * width + x_end];
+
+          if ( ! isRectangleFillChar(ch) || ch != fill_char )
+            break;
+
+          x_end++;
+        }
+
+        const uInt y_end = getRectangleFillEnd(x, x_end, y, box_y_end);
+
+        if ( y_end > y + 1
+          && (x_end - x) * (y_end - y) >= uInt(MIN_RECTANGLE_CELLS) )
+        {
+          const FRect fill_box { FPoint{int(x), int(y)}
+                               , FPoint{int(x_end - 1), int(y_end - 1)} };
+          fillRectangle (fill_box, fill_char);
+        }
+
+        x = x_end - 1;
+      }
+    }
+  }
+
+  rect_fills.clear();
+}
+
+//----------------------------------------------------------------------
+void FVTerm::fillRectangle (const FRect& box, FChar& fill_char) const
+{
+  // Fills the terminal rectangle box (0-based) with fill_char
+
+  const int top = box.getY1() + 1;
+  const int left = box.getX1() + 1;
+  const int bottom = box.getY2() + 1;
+  const int right = box.getX2() + 1;
+  appendAttributes (fill_char);
+
+  if ( fill_char.ch[0] == L' ' && FTerm::isNormal(fill_char) )
+  {
+    const auto& era = FTermcap::encodeParameter ( DECERA, top, left
+                                                , bottom, right );
+    appendOutputBuffer (FTermControl{era});
+  }
+  else
+  {
+    const auto& fra = FTermcap::encodeParameter ( DECFRA, fill_char.ch[0]
+                                                , top, left
+                                                , bottom, right );
+    appendOutputBuffer (FTermControl{fra});
+  }
+
+  for (auto y = box.getY1(); y <= box.getY2(); y++)
+  {
+    for (auto x = box.getX1(); x <= box.getX2(); x++)
+    {
+      auto& ch = vterm->data[y * vterm->width + x];
+      ch.attr.bit.printed = true;
+      ch.attr.bit.no_changes = true;
+    }
+
+    trimLineChanges (uInt(y));
+  }
+}
+
+//----------------------------------------------------------------------
+uInt FVTerm::getRectangleFillEnd ( uInt x, uInt x_end
+                                 , uInt y, uInt y_limit ) const
+{
+  // Returns the line below the last line (before y_limit) that has
+  // the same changed characters in the columns x ... x_end - 1
+
+  const auto width = uInt(vterm->width);
+  const FChar fill_char{vterm->data[y * width + x]};
+  uInt line{y};
+
+  while ( line < y_limit )
+  {
+    const auto& changes = vterm->changes[line];
+
+    if ( changes.xmin > x || changes.xmax + 1 < x_end )
+      break;
+
+    // The line output jumps over a filled block inside the
+    // changes only if this is cheaper than printing it
+    if ( changes.xmin != x && changes.xmax + 1 != x_end
+      && x_end - x <= cursor_address_length )
+      break;
+
+    const auto* begin = &vterm->data[line * width + x];
+
+    if ( ! std::all_of ( begin, begin + (x_end - x)
+                       , [&fill_char] (const FChar& ch)
+                         {
+                           return isRectangleFillChar(ch) && ch == fill_char;
+                         } ) )
+      break;
+
+    line++;
+  }
+
+  return line;
+}
+
+//----------------------------------------------------------------------
+inline bool FVTerm::isRectangleFillChar (const FChar& ch)
+{
+  // DECFRA can only fill with changed single-width ASCII characters
+  return ! ch.attr.bit.no_changes
+      && ch.ch[0] >= L' ' && ch.ch[0] <= L'~' && ch.ch[1] == L'\0'
+      && ! ch.attr.bit.alt_charset
+      && ! ch.attr.bit.pc_charset
+      && ! ch.attr.bit.fullwidth_padding;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::trimLineChanges (uInt y)
+{
+  // Removes printed and unchanged characters at both ends
+  // of the changed line range
+
+  auto& changes = vterm->changes[y];
+  const auto* line = &vterm->data[y * uInt(vterm->width)];
+  const auto is_unchanged = [] (const FChar& ch)
+  {
+    return ch.attr.bit.printed && ch.attr.bit.no_changes;
+  };
+
+  while ( changes.xmin <= changes.xmax && is_unchanged(line[changes.xmin]) )
+    changes.xmin++;
+
+  while ( changes.xmin <= changes.xmax && is_unchanged(line[changes.xmax]) )
+    changes.xmax--;
+
+  if ( changes.xmin > changes.xmax )  // No more changes
+  {
+    changes.xmin = uInt(vterm->width);
+    changes.xmax = 0;
+  }
+}
+
 //----------------------------------------------------------------------
 bool FVTerm::updateTerminalLine (uInt y) const
 {
@@ -2781,6 +3546,17 @@ bool FVTerm::updateTerminalLine (uInt y) const
     bool draw_trailing_ws = false;
     const auto& ce = TCAP(t_clr_eol);
 
+    // Find the character runs from xmin to xmax
+    // (from the line start, if leading whitespace can be cleared)
+    const auto& cb = TCAP(t_clr_bol);
+    const auto line = &vt->data[y * uInt(vt->width)];
+    const uInt first = ( cb && line[0].ch[0] == ' ' ) ? 0 : xmin;
+    line_analyzer.analyze (line, uInt(vt->width), first, xmax);
+
+    // The whitespace at the line end can only be cleared with el
+    if ( ce && line[vt->width - 1].ch[0] == ' ' )
+      line_analyzer.analyzeTrailingRun (line, uInt(vt->width));
+
     // Clear rest of line
     bool is_eol_clean = canClearToEOL (xmin, y);
 
@@ -2806,7 +3582,6 @@ bool FVTerm::updateTerminalLine (uInt y) const
     {
       if ( draw_leading_ws )
       {
-        const auto& cb = TCAP(t_clr_bol);
         auto& first_char = vt->data[y * uInt(vt->width)];
         appendAttributes (first_char);
         appendOutputBuffer (FTermControl{cb});
@@ -2868,30 +3643,6 @@ bool FVTerm::isInsideTerminal (const FPoint& pos) const
     return false;
 }
 
-//----------------------------------------------------------------------
-inline bool FVTerm::isTermSizeChanged() const
-{
-  if ( ! isTermSizeCheckTimeout() )
-    return false;
-
-  FObject::getCurrentTime (&last_term_size_check);
-
-  const auto& data = FTerm::getFTermData();
-
-  if ( ! data )
-    return false;
-
-  const auto& old_term_geometry = data->getTermGeometry();
-  FTerm::detectTermSize();
-  auto term_geometry = data->getTermGeometry();
-  term_geometry.move (-1, -1);
-
-  if ( old_term_geometry.getSize() != term_geometry.getSize() )
-    return true;
-
-  return false;
-}
-
 //----------------------------------------------------------------------
 inline void FVTerm::flushTimeAdjustment() const
 {
@@ -2938,18 +3689,6 @@ inline void FVTerm::flushTimeAdjustment() const
   }
 }
 
-//----------------------------------------------------------------------
-inline bool FVTerm::isFlushTimeout()
-{
-  return FObject::isTimeout (&time_last_flush, flush_wait);
-}
-
-//----------------------------------------------------------------------
-inline bool FVTerm::isTermSizeCheckTimeout()
-{
-  return FObject::isTimeout (&last_term_size_check, term_size_check_timeout);
-}
-
 //----------------------------------------------------------------------
 inline bool FVTerm::hasPendingUpdates (const FTermArea* area)
 {
@@ -3000,39 +3739,15 @@ inline void FVTerm::charsetChanges (FChar& next_char)
   if ( FTerm::getEncoding() == Encoding::UTF8 )
     return;
 
-  const wchar_t ch_enc = FTerm::charEncode(ch);
-
-  if ( ch_enc == ch )
-    return;
-
-  if ( ch_enc == 0 )
-  {
-    next_char.encoded_char[0] = wchar_t(FTerm::charEncode(ch, Encoding::ASCII));
-    return;
-  }
-
-  next_char.encoded_char[0] = ch_enc;
+  const auto& char_encoder = FTerm::getFCharEncoder();
+  const auto& out = char_encoder->getOutputChar(ch, FTerm::getEncoding());
+  next_char.encoded_char[0] = out.encoded;
 
-  if ( FTerm::getEncoding() == Encoding::VT100 )
+  if ( out.alt_charset )
     next_char.attr.bit.alt_charset = true;
-  else if ( FTerm::getEncoding() == Encoding::PC )
-  {
-    next_char.attr.bit.pc_charset = true;
-
-    if ( FTerm::isPuttyTerminal() )
-      return;
 
-    if ( FTerm::isXTerminal() && ch_enc < 0x20 )  // Character 0x00..0x1f
-    {
-      if ( FTerm::hasUTF8() )
-        next_char.encoded_char[0] = int(FTerm::charEncode(ch, Encoding::ASCII));
-      else
-      {
-        next_char.encoded_char[0] += 0x5f;
-        next_char.attr.bit.alt_charset = true;
-      }
-    }
-  }
+  if ( out.pc_charset )
+    next_char.attr.bit.pc_charset = true;
 }
 
 //----------------------------------------------------------------------
@@ -3140,10 +3855,11 @@ void FVTerm::appendLowerRight (FChar& last_char) const
 //----------------------------------------------------------------------
 inline void FVTerm::characterFilter (FChar& next_char) const
 {
-  charSubstitution& sub_map = fterm->getCharSubstitutionMap();
-
-  if ( sub_map.find(next_char.encoded_char[0]) != sub_map.end() )
-    next_char.encoded_char[0] = sub_map[next_char.encoded_char[0]];
+  // The output table contains the substituted characters
+  const auto& char_encoder = FTerm::getFCharEncoder();
+  const auto& out = char_encoder->getOutputChar ( next_char.ch[0]
+                                                , FTerm::getEncoding() );
+  next_char.encoded_char[0] = out.output;
 }
 
 //----------------------------------------------------------------------
@@ -20,6 +20,7 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <vector>
 
 #include "final/fapplication.h"
@@ -58,6 +59,10 @@ FWidget::FWidgetList* FWidget::window_list{nullptr};
 FWidget::FWidgetList* FWidget::dialog_list{nullptr};
 FWidget::FWidgetList* FWidget::always_on_top_list{nullptr};
 FWidget::FWidgetList* FWidget::close_widget{nullptr};
+FDamageRegion         FWidget::damage_region{};
+FRect                 FWidget::damage_clip{};
+std::size_t           FWidget::paint_count{0};
+std::size_t           FWidget::last_paint_count{0};
 bool                  FWidget::init_terminal{false};
 bool                  FWidget::init_desktop{false};
 uInt                  FWidget::modal_dialog_counter{};
@@ -271,6 +276,7 @@ void FWidget::setMainWidget (FWidget* obj)
 //----------------------------------------------------------------------
 bool FWidget::setVisible (bool enable)
 {
+  invalidateHitTest();
   return (flags.visible = enable);
 }
 
@@ -282,6 +288,7 @@ bool FWidget::setEnable (bool enable)
   else
     emitCallback("disable");
 
+  invalidateHitTest();
   return (flags.active = enable);
 }
 
@@ -365,6 +372,7 @@ void FWidget::setX (int x, bool adjust)
   if ( ! isWindowWidget() && x < 1 )
     x = 1;
 
+  invalidateHitTest();
   wsize.setX(x);
   adjust_wsize.setX(x);
 
@@ -381,6 +389,7 @@ void FWidget::setY (int y, bool adjust)
   if ( ! isWindowWidget() && y < 1 )
     y = 1;
 
+  invalidateHitTest();
   wsize.setY(y);
   adjust_wsize.setY(y);
 
@@ -408,6 +417,7 @@ void FWidget::setPos (const FPoint& p, bool adjust)
       pos.setY(1);
   }
 
+  invalidateHitTest();
   wsize.setPos(pos);
   adjust_wsize.setPos(pos);
 
@@ -427,6 +437,7 @@ void FWidget::setWidth (std::size_t width, bool adjust)
   if ( width < 1 )
     width = 1;
 
+  invalidateHitTest();
   wsize.setWidth(width);
   adjust_wsize.setWidth(width);
 
@@ -449,6 +460,7 @@ void FWidget::setHeight (std::size_t height, bool adjust)
   if ( height < 1 )
     height = 1;
 
+  invalidateHitTest();
   wsize.setHeight(height);
   adjust_wsize.setHeight(height);
 
@@ -479,6 +491,7 @@ void FWidget::setSize (const FSize& size, bool adjust)
   if ( height < 1 )
     height = 1;
 
+  invalidateHitTest();
   wsize.setWidth(width);
   wsize.setHeight(height);
   adjust_wsize.setWidth(width);
@@ -499,6 +512,7 @@ void FWidget::setTopPadding (int top, bool adjust)
   if ( padding.top == top )
     return;
 
+  invalidateHitTest();
   padding.top = top;
 
   if ( adjust )
@@ -520,6 +534,7 @@ void FWidget::setLeftPadding (int left, bool adjust)
   if ( padding.left == left )
     return;
 
+  invalidateHitTest();
   padding.left = left;
 
   if ( adjust )
@@ -541,6 +556,7 @@ void FWidget::setBottomPadding (int bottom, bool adjust)
   if ( padding.bottom == bottom )
     return;
 
+  invalidateHitTest();
   padding.bottom = bottom;
 
   if ( adjust )
@@ -567,6 +583,7 @@ void FWidget::setRightPadding (int right, bool adjust)
   if ( padding.right == right )
     return;
 
+  invalidateHitTest();
   padding.right = right;
 
   if ( adjust )
@@ -594,6 +611,7 @@ void FWidget::setTermSize (const FSize& size) const
 
   if ( FTerm::isXTerminal() )
   {
+    FHitTestIndex::invalidate();
     internal::var::root_widget->wsize.setRect(FPoint{1, 1}, size);
     internal::var::root_widget->adjust_wsize = internal::var::root_widget->wsize;
     FTerm::setTermSize(size);  // width = columns / height = lines
@@ -632,6 +650,7 @@ void FWidget::setGeometry (const FPoint& p, const FSize& s, bool adjust)
   ( w < 1 ) ? wsize.setWidth(1) : wsize.setWidth(w);
   ( h < 1 ) ? wsize.setHeight(1) : wsize.setHeight(h);
 
+  invalidateHitTest();
   adjust_wsize = wsize;
   const int term_x = getTermX();
   const int term_y = getTermY();
@@ -784,24 +803,36 @@ FWidget* FWidget::childWidgetAt (const FPoint& pos)
   if ( ! hasChildren() )
     return nullptr;
 
-  for (auto&& child : getChildren())
-  {
-    if ( ! child->isWidget() )
-      continue;
+  const auto generation = getHitTestGeneration();
 
-    auto widget = static_cast<FWidget*>(child);
+  if ( ! child_index.isValid(generation) )
+  {
+    // Rebuild the hit-test index of the child widgets
+    child_index.clear();
 
-    if ( widget->isEnabled()
-      && widget->isShown()
-      && ! widget->isWindowWidget()
-      && widget->getTermGeometry().contains(pos) )
+    for (auto&& child : getChildren())
     {
-      auto sub_child = widget->childWidgetAt(pos);
-      return ( sub_child != nullptr ) ? sub_child : widget;
+      if ( ! child->isWidget() )
+        continue;
+
+      auto widget = static_cast<FWidget*>(child);
+
+      if ( widget->isEnabled()
+        && widget->isShown()
+        && ! widget->isWindowWidget() )
+        child_index.insert (widget->getTermGeometry(), widget);
     }
+
+    child_index.build (generation);
   }
 
-  return nullptr;
+  auto widget = child_index.find(pos);
+
+  if ( ! widget )
+    return nullptr;
+
+  auto sub_child = widget->childWidgetAt(pos);
+  return ( sub_child != nullptr ) ? sub_child : widget;
 }
 
 //----------------------------------------------------------------------
@@ -854,6 +885,22 @@ bool FWidget::close()
     return false;
 }
 
+//----------------------------------------------------------------------
+FWidget* FWidget::getAcceleratorTarget (FKey key) const
+{
+  // Returns the widget to which the accelerator key is assigned
+
+  if ( ! accelerator_map_valid )
+    updateAcceleratorMap();
+
+  const auto iter = accelerator_map.find(key);
+
+  if ( iter == accelerator_map.end() )
+    return nullptr;
+
+  return iter->second;
+}
+
 //----------------------------------------------------------------------
 void FWidget::addAccelerator (FKey key, FWidget* obj)
 {
@@ -866,7 +913,12 @@ void FWidget::addAccelerator (FKey key, FWidget* obj)
     widget = getRootWidget();
 
   if ( widget )
+  {
     widget->accelerator_list.push_back(accel);
+
+    if ( widget->accelerator_map_valid )
+      widget->accelerator_map.emplace(key, obj);  // Keeps a previous entry
+  }
 }
 
 //----------------------------------------------------------------------
@@ -891,6 +943,8 @@ void FWidget::delAccelerator (FWidget* obj)
       else
         ++iter;
     }
+
+    widget->updateAcceleratorMap();
   }
 }
 
@@ -914,6 +968,7 @@ void FWidget::redraw()
     return;
 
   draw();
+  paint_count++;
 
   if ( isRootWidget() )
     drawWindows();
@@ -927,6 +982,47 @@ void FWidget::redraw()
     redraw_root_widget = nullptr;
 }
 
+//----------------------------------------------------------------------
+void FWidget::invalidate()
+{
+  // Marks the whole widget for redrawing in the next frame
+
+  if ( ! (isRootWidget() || isShown()) )
+    return;
+
+  if ( const auto& owner = getChildAreaOwner() )
+  {
+    // Scroll view content has its own coordinates
+    owner->invalidate();
+    return;
+  }
+
+  damage_region.add (getTermGeometryWithShadow());
+  const auto& v_win = getVWin();
+
+  if ( v_win )  // Repainting the window also draws its covered cells
+    v_win->has_covered_cells = false;
+}
+
+//----------------------------------------------------------------------
+void FWidget::invalidate (const FRect& box)
+{
+  // Marks a rectangle in widget coordinates for redrawing
+
+  if ( ! (isRootWidget() || isShown()) )
+    return;
+
+  if ( const auto& owner = getChildAreaOwner() )
+  {
+    owner->invalidate();
+    return;
+  }
+
+  FRect damage_box{box};
+  damage_box.move (getTermX() - 1, getTermY() - 1);
+  damage_region.add (damage_box.intersect(getTermGeometryWithShadow()));
+}
+
 //----------------------------------------------------------------------
 void FWidget::resize()
 {
@@ -975,6 +1071,7 @@ void FWidget::show()
   initWidgetLayout();  // Makes initial layout settings
   adjustSize();        // Alignment before drawing
   draw();              // Draw the widget
+  invalidateHitTest();
   flags.hidden = false;
   flags.shown = true;
 
@@ -1005,6 +1102,7 @@ void FWidget::hide()
 {
   // Hide the widget
 
+  invalidateHitTest();
   flags.hidden = true;
 
   if ( isVisible() )
@@ -1112,6 +1210,7 @@ bool FWidget::focusLastChild()
 //----------------------------------------------------------------------
 void FWidget::move (const FPoint& pos)
 {
+  invalidateHitTest();
   wsize.move(pos);
   adjust_wsize.move(pos);
 }
@@ -1158,6 +1257,43 @@ FVTerm::FTermArea* FWidget::getPrintArea()
   return getVirtualDesktop();
 }
 
+//----------------------------------------------------------------------
+FRect FWidget::getClipRect()
+{
+  // Returns the part of the widget (in widget coordinates)
+  // that is currently being repainted
+
+  const FRect widget_box{FPoint{1, 1}, getSize()};
+
+  // The damage clip does not apply to the content of scroll views
+  if ( damage_clip.getWidth() == 0 || damage_clip.getHeight() == 0
+    || getChildAreaOwner() )
+    return widget_box;
+
+  FRect clip{damage_clip};
+  clip.move (1 - getTermX(), 1 - getTermY());
+  return clip.intersect(widget_box);
+}
+
+//----------------------------------------------------------------------
+FRect FWidget::getVisibleRect()
+{
+  // Returns the part of the widget (in widget coordinates) that
+  // is visible on the screen and is currently being repainted.
+  // Drawing methods can skip the rows and columns outside of it.
+
+  FRect visible{getClipRect()};
+
+  // The content of a scroll view stays complete for scrolling
+  if ( getChildAreaOwner() )
+    return visible;
+
+  visible.move (getTermX() - 1, getTermY() - 1);
+  visible = getVisibleRegion(getPrintArea(), visible);
+  visible.move (1 - getTermX(), 1 - getTermY());
+  return visible;
+}
+
 //----------------------------------------------------------------------
 void FWidget::addPreprocessingHandler ( const FVTerm* instance
                                       , FPreprocessingFunction&& function )
@@ -1220,7 +1356,10 @@ void FWidget::setParentOffset()
   const auto& p = getParentWidget();
 
   if ( p )
+  {
+    invalidateHitTest();
     woffset = p->wclient_offset;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -1229,6 +1368,7 @@ void FWidget::setTermOffset()
   const auto& r = getRootWidget();
   const auto w = int(r->getWidth());
   const auto h = int(r->getHeight());
+  invalidateHitTest();
   woffset.setCoordinates (0, 0, w - 1, h - 1);
 }
 
@@ -1236,6 +1376,7 @@ void FWidget::setTermOffset()
 void FWidget::setTermOffsetWithPadding()
 {
   const auto& r = getRootWidget();
+  invalidateHitTest();
   woffset.setCoordinates ( r->getLeftPadding()
                          , r->getTopPadding()
                          , int(r->getWidth()) - 1 - r->getRightPadding()
@@ -1295,6 +1436,8 @@ void FWidget::initLayout()
 //----------------------------------------------------------------------
 void FWidget::adjustSize()
 {
+  invalidateHitTest();
+
   if ( ! isRootWidget() )
   {
     const auto& p = getParentWidget();
@@ -1519,6 +1662,67 @@ bool FWidget::focusPrevChild()
   return true;
 }
 
+//----------------------------------------------------------------------
+void FWidget::processDamage()
+{
+  // Repaints the invalidated rectangles once per frame.
+  // Only widgets that intersect a rectangle are drawn.
+
+  const auto& root = internal::var::root_widget;
+
+  if ( root && ! damage_region.isEmpty() )
+  {
+    damage_region.merge();
+    // Drawing can invalidate further rectangles for the next frame
+    const auto damage_rects = damage_region.getRects();
+    damage_region.clear();
+    const auto& desktop = root->getTermGeometry();
+    const bool full_redraw =
+        std::any_of ( damage_rects.begin(), damage_rects.end()
+                    , [&desktop] (const FRect& box)
+                      {
+                        return box.contains(desktop);
+                      } );
+
+    if ( full_redraw )
+      root->redraw();
+    else
+    {
+      startDrawing();
+
+      for (const auto& box : damage_rects)
+      {
+        damage_clip = box;
+        root->paintDesktop (box);
+
+        if ( window_list )
+          for (auto&& window : *window_list)
+            window->paintWindow (box);
+      }
+
+      damage_clip = FRect{};
+      finishDrawing();
+    }
+  }
+
+  // Counts per frame
+  last_paint_count = paint_count;
+  paint_count = 0;
+}
+
+//----------------------------------------------------------------------
+void FWidget::invalidateHitTest()
+{
+  // Outdates the hit-test indexes inside the window of this widget
+
+  FWidget* owner = FWindow::getWindowWidget(this);
+
+  if ( ! owner )
+    owner = getRootWidget();  // Non-window widgets on the desktop
+
+  owner->hit_test_generation++;
+}
+
 //----------------------------------------------------------------------
 bool FWidget::event (FEvent* ev)
 {
@@ -1534,6 +1738,10 @@ bool FWidget::event (FEvent* ev)
   {
     KeyDownEvent (static_cast<FKeyEvent*>(ev));
   }
+  else if ( ev->getType() == Event::Paste )
+  {
+    onPaste (static_cast<FPasteEvent*>(ev));
+  }
   else if ( ev->getType() == Event::MouseDown )
   {
     emitCallback("mouse-press");
@@ -1625,6 +1833,13 @@ void FWidget::onKeyDown (FKeyEvent*)
   // to receive key down events for the widget
 }
 
+//----------------------------------------------------------------------
+void FWidget::onPaste (FPasteEvent*)
+{
+  // This event handler can be reimplemented in a subclass
+  // to receive pasted text as a whole
+}
+
 //----------------------------------------------------------------------
 void FWidget::onMouseDown (FMouseEvent*)
 {
@@ -1699,8 +1914,18 @@ void FWidget::onAccel (FAccelEvent*)
 void FWidget::onResize (FResizeEvent* ev)
 {
   // The terminal was resized
-  internal::var::root_widget->resize();
-  internal::var::root_widget->redraw();
+  const auto& root = internal::var::root_widget;
+  const auto old_desktop_size = root->getSize();
+  const auto old_geometries = root->getWindowGeometries();
+  root->resize();
+
+  // A signal without a size change (e.g. from a reattached terminal
+  // multiplexer) asks for a complete repaint of the screen
+  if ( root->getSize() == old_desktop_size )
+    root->redraw();
+  else
+    root->redrawResizedWindows (old_geometries);
+
   ev->accept();
 }
 
@@ -1728,6 +1953,17 @@ void FWidget::onClose (FCloseEvent* ev)
 
 
 // private methods of FWidget
+//----------------------------------------------------------------------
+void FWidget::updateAcceleratorMap() const
+{
+  accelerator_map.clear();
+
+  for (auto&& item : accelerator_list)
+    accelerator_map.emplace(item.key, item.object);
+
+  accelerator_map_valid = true;
+}
+
 //----------------------------------------------------------------------
 void FWidget::determineDesktopSize()
 {
@@ -1736,6 +1972,7 @@ void FWidget::determineDesktopSize()
   detectTermSize();
   auto width = getDesktopWidth();
   auto height = getDesktopHeight();
+  FHitTestIndex::invalidate();
   wsize.setRect(1, 1, width, height);
   adjust_wsize = wsize;
   woffset.setRect(0, 0, width, height);
@@ -1986,8 +2223,8 @@ bool FWidget::changeFocus ( FWidget* follower, FWidget* parent
 
     if ( in.isAccepted() )
     {
-      redraw();
-      follower->redraw();
+      invalidate();
+      follower->invalidate();
     }
   }
 
@@ -2005,33 +2242,180 @@ void FWidget::draw()
 void FWidget::drawWindows() const
 {
   // redraw windows
+  if ( ! window_list || window_list->empty() )
+    return;
+
+  for (auto&& window : *window_list)
+  {
+    if ( window->isShown() )
+      redrawWindow (window);
+  }
+}
+
+//----------------------------------------------------------------------
+void FWidget::redrawWindow (FWidget* window)
+{
+  // Clears the window area and draws the window completely
+
   FChar default_char{};
   default_char.ch[0]        = ' ';
   default_char.fg_color     = FColor::Black;
   default_char.bg_color     = FColor::Black;
   default_char.attr.byte[0] = 0;
   default_char.attr.byte[1] = 0;
+  auto v_win = window->getVWin();
+  const int w = v_win->width  + v_win->right_shadow;
+  const int h = v_win->height + v_win->bottom_shadow;
+  std::fill_n (v_win->data, w * h, default_char);
+  window->redraw();
+}
 
-  if ( ! window_list || window_list->empty() )
+//----------------------------------------------------------------------
+void FWidget::drawChildren()
+{
+  // draw child elements
+  if ( ! hasChildren() )
     return;
 
+  for (auto&& child : getChildren())
+  {
+    if ( child->isWidget() )
+    {
+      auto widget = static_cast<FWidget*>(child);
+
+      if ( widget->isShown() && ! widget->isWindowWidget() )
+        widget->redraw();
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+FWidget::FWindowGeometries FWidget::getWindowGeometries() const
+{
+  FWindowGeometries geometries{};
+
+  if ( ! window_list )
+    return geometries;
+
+  geometries.reserve(window_list->size());
+
   for (auto&& window : *window_list)
+    geometries.emplace_back (window, window->getTermGeometryWithShadow());
+
+  return geometries;
+}
+
+//----------------------------------------------------------------------
+void FWidget::redrawResizedWindows (const FWindowGeometries& old_geometries)
+{
+  // After a terminal resize, only the desktop and the windows whose
+  // geometry has changed are repainted. The other windows keep their
+  // areas and are only composed into the new virtual terminal.
+
+  startDrawing();
+  paintDesktop (getTermGeometry());
+
+  if ( window_list )
   {
-    if ( window->isShown() )
+    for (auto&& window : *window_list)
     {
-      auto v_win = window->getVWin();
-      const int w = v_win->width  + v_win->right_shadow;
-      const int h = v_win->height + v_win->bottom_shadow;
-      std::fill_n (v_win->data, w * h, default_char);
-      window->redraw();
+      if ( ! window->isShown() )
+        continue;
+
+      const auto& v_win = window->getVWin();
+      const auto iter = \
+          std::find_if ( old_geometries.begin()
+                       , old_geometries.end()
+                       , [&window] (const FWindowGeometries::value_type& entry)
+                         {
+                           return entry.first == window;
+                         } );
+
+      // Windows with skipped covered cells are drawn completely
+      if ( iter != old_geometries.end()
+        && iter->second == window->getTermGeometryWithShadow()
+        && ! v_win->has_covered_cells )
+        markAreaChanged (v_win);
+      else
+        redrawWindow (window);
     }
   }
+
+  finishDrawing();
 }
 
 //----------------------------------------------------------------------
-void FWidget::drawChildren()
+FWidget* FWidget::getChildAreaOwner()
+{
+  // Returns the widget that provides the child print area
+  // in which this widget draws (e.g. a scroll view)
+
+  const auto& area = getPrintArea();
+
+  if ( ! area )
+    return nullptr;
+
+  auto p = getParentWidget();
+
+  while ( p && p->getChildPrintArea() != area )
+    p = p->getParentWidget();
+
+  return p;
+}
+
+//----------------------------------------------------------------------
+void FWidget::paintDesktop (const FRect& box)
+{
+  // Repaints the desktop background inside the box
+
+  auto vdesktop = getVirtualDesktop();
+  setAreaClip (vdesktop, box);
+  auto color_theme = getColorTheme();
+  setColor (color_theme->term_fg, color_theme->term_bg);
+  clearArea (vdesktop);
+  draw();
+  paint_count++;
+  paintClippedChildren (box);  // Non-window children of the desktop
+  unsetAreaClip (vdesktop);
+}
+
+//----------------------------------------------------------------------
+void FWidget::paintWindow (const FRect& box)
+{
+  auto v_win = getVWin();
+
+  if ( ! (v_win && isShown() && getTermGeometryWithShadow().overlap(box)) )
+    return;
+
+  setAreaClip (v_win, box);
+  paintClipped (box);
+  unsetAreaClip (v_win);
+}
+
+//----------------------------------------------------------------------
+void FWidget::paintClipped (const FRect& box)
+{
+  // Draws the widget and its children restricted to the box
+
+  if ( ! isShown() || ! getTermGeometryWithShadow().overlap(box) )
+    return;
+
+  if ( getChildPrintArea() )
+  {
+    // Widgets with their own print area (scroll views) are
+    // repainted completely
+    redraw();
+    return;
+  }
+
+  draw();
+  paint_count++;
+  paintClippedChildren (box);
+}
+
+//----------------------------------------------------------------------
+void FWidget::paintClippedChildren (const FRect& box)
 {
-  // draw child elements
   if ( ! hasChildren() )
     return;
 
@@ -2041,8 +2425,8 @@ void FWidget::drawChildren()
     {
       auto widget = static_cast<FWidget*>(child);
 
-      if ( widget->isShown() && ! widget->isWindowWidget() )
-        widget->redraw();
+      if ( ! widget->isWindowWidget() )
+        widget->paintClipped (box);
     }
   }
 }
@@ -2121,6 +2505,17 @@ void FWidget::setStatusbarText (bool enable) const
   }
 }
 
+//----------------------------------------------------------------------
+uInt64 FWidget::getHitTestGeneration()
+{
+  const FWidget* owner = FWindow::getWindowWidget(this);
+
+  if ( ! owner )
+    owner = getRootWidget();
+
+  return owner->hit_test_generation;
+}
+
 
 // non-member functions
 //----------------------------------------------------------------------
@@ -2128,6 +2523,7 @@ void detectTermSize()
 {
   const auto& r = internal::var::root_widget;
   FTerm::detectTermSize();
+  FHitTestIndex::invalidate();
   r->adjust_wsize.setRect (1, 1, r->getDesktopWidth(), r->getDesktopHeight());
   r->woffset.setRect (0, 0, r->getDesktopWidth(), r->getDesktopHeight());
   r->wclient_offset.setCoordinates
@@ -52,6 +52,17 @@ bool isFocusPrevKey (const FKey key)
   return false;
 }
 
+//----------------------------------------------------------------------
+bool isVisibleLine (const FRect& visible, int y)
+{
+  // Checks whether line y lies in the visible rectangle
+  // that was returned by FWidget::getVisibleRect()
+
+  return visible.getWidth() > 0
+      && y >= visible.getY1()
+      && y <= visible.getY2();
+}
+
 //----------------------------------------------------------------------
 FApplication* getFApplication()
 {
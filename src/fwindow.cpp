@@ -20,6 +20,7 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <utility>
 
 #include "final/fapplication.h"
@@ -35,6 +36,8 @@ namespace finalcut
 
 // static attributes
 FWindow* FWindow::previous_window{nullptr};
+FHitTestIndex FWindow::window_index{};
+std::vector<FWindow*> FWindow::moved_windows{};
 
 
 //----------------------------------------------------------------------
@@ -92,6 +95,7 @@ bool FWindow::setWindowWidget (bool enable)
   if ( isWindowWidget() == enable )
     return true;
 
+  FHitTestIndex::invalidate();
   setFlags().window_widget = enable;
 
   if ( enable )
@@ -272,6 +276,8 @@ void FWindow::show()
   if ( isVirtualWindow() )
     getVWin()->visible = true;
 
+  invalidateWindowIndex();
+
   FWidget::show();
 }
 
@@ -290,6 +296,8 @@ void FWindow::hide()
   if ( isVirtualWindow() )
     virtual_win->visible = false;
 
+  invalidateWindowIndex();
+
   FWidget::hide();
   const auto& t_geometry = getTermGeometryWithShadow();
   restoreVTerm (t_geometry);
@@ -429,8 +437,16 @@ void FWindow::move (const FPoint& pos)
 FWindow* FWindow::getWindowWidgetAt (int x, int y)
 {
   // returns the window object to the corresponding coordinates
-  if ( getWindowList() && ! getWindowList()->empty() )
+
+  if ( ! getWindowList() || getWindowList()->empty() )
+    return nullptr;
+
+  updateWindowIndex();
+
+  if ( ! window_index.isValid() )
   {
+    // Rebuild the index with the topmost window first
+    window_index.clear();
     auto iter = getWindowList()->end();
     const auto begin = getWindowList()->begin();
 
@@ -439,22 +455,23 @@ FWindow* FWindow::getWindowWidgetAt (int x, int y)
       --iter;
       auto w = static_cast<FWindow*>(*iter);
 
-      if ( *iter && ! w->isWindowHidden()
-        && w->getTermGeometry().contains(x, y) )
-      {
-        return w;
-      }
+      if ( *iter && ! w->isWindowHidden() )
+        window_index.insert (w->getTermGeometry(), w);
     }
     while ( iter != begin );
+
+    window_index.build();
   }
 
-  return nullptr;
+  return static_cast<FWindow*>(window_index.find({x, y}));
 }
 
 //----------------------------------------------------------------------
 void FWindow::addWindow (FWidget* obj)
 {
   // add the window object obj to the window list
+  invalidateWindowIndex();
+
   if ( getWindowList() )
     getWindowList()->push_back(obj);
 
@@ -465,6 +482,8 @@ void FWindow::addWindow (FWidget* obj)
 void FWindow::delWindow (const FWidget* obj)
 {
   // delete the window object obj from the window list
+  invalidateWindowIndex();
+
   if ( ! getWindowList() || getWindowList()->empty() )
     return;
 
@@ -597,6 +616,7 @@ bool FWindow::raiseWindow (FWidget* obj)
     {
       getWindowList()->erase (iter);
       getWindowList()->push_back (obj);
+      invalidateWindowIndex();
       FEvent ev(Event::WindowRaised);
       FApplication::sendEvent(obj, &ev);
       processAlwaysOnTop();
@@ -637,6 +657,7 @@ bool FWindow::lowerWindow (FWidget* obj)
     {
       getWindowList()->erase (iter);
       getWindowList()->insert (getWindowList()->begin(), obj);
+      invalidateWindowIndex();
       FEvent ev(Event::WindowLowered);
       FApplication::sendEvent(obj, &ev);
       return true;
@@ -723,7 +744,7 @@ void FWindow::switchToPrevWindow (const FWidget* widget)
       focus->setFocus();
 
       if ( ! focus->isWindowWidget() )
-        focus->redraw();
+        focus->invalidate();
     }
   }
 
@@ -789,6 +810,18 @@ void FWindow::adjustSize()
   }
 }
 
+//----------------------------------------------------------------------
+void FWindow::invalidateHitTest()
+{
+  FWidget::invalidateHitTest();
+
+  // Remember this window to update only its entry in the window index
+  if ( window_index.isValid()
+    && std::find(moved_windows.begin(), moved_windows.end(), this)
+       == moved_windows.end() )
+    moved_windows.push_back(this);
+}
+
 //----------------------------------------------------------------------
 bool FWindow::event (FEvent* ev)
 {
@@ -879,12 +912,40 @@ void FWindow::processAlwaysOnTop()
     delWindow (*iter);
 
     if ( getWindowList() )
+    {
       getWindowList()->push_back(*iter);
+      invalidateWindowIndex();
+    }
 
     ++iter;
   }
 }
 
+//----------------------------------------------------------------------
+void FWindow::invalidateWindowIndex()
+{
+  // The window order or visibility has changed
+  window_index.clear();
+  moved_windows.clear();
+}
+
+//----------------------------------------------------------------------
+void FWindow::updateWindowIndex()
+{
+  // Moves the entries of the changed windows
+
+  for (auto&& window : moved_windows)
+  {
+    if ( ! window_index.update(window->getTermGeometry(), window) )
+    {
+      window_index.clear();  // Not indexed yet
+      break;
+    }
+  }
+
+  moved_windows.clear();
+}
+
 // non-member functions
 //----------------------------------------------------------------------
 void closeDropDown (const FWidget* widget, const FPoint& mouse_position)
@@ -897,8 +958,7 @@ void closeDropDown (const FWidget* widget, const FPoint& mouse_position)
   if ( ! openmenu )
     return;
 
-  if ( openmenu->isInstanceOf("FMenu")
-    || openmenu->isInstanceOf("FDialogListMenu") )
+  if ( openmenu->isA<FMenu>() )  // FMenu or FDialogListMenu
   {
     bool contains_menu_structure;
     auto menu = static_cast<FMenu*>(openmenu);
@@ -909,7 +969,7 @@ void closeDropDown (const FWidget* widget, const FPoint& mouse_position)
       return;
   }
 
-  if ( openmenu->isInstanceOf("FDropDownListBox") )
+  if ( openmenu->isA<FDropDownListBox>() )
   {
     auto drop_down = static_cast<FDropDownListBox*>(openmenu);
 
@@ -0,0 +1,138 @@
+/***********************************************************************
+* fworkerpool.cpp - Runs indexed tasks on a pool of threads            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include "final/fworkerpool.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWorkerPool
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FWorkerPool::FWorkerPool (std::size_t thread_count)
+{
+  // The calling thread of run() is the first thread of the pool.
+  // A thread count of 0 uses one thread per hardware thread.
+
+  if ( thread_count == 0 )
+    thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+
+  workers.reserve(thread_count - 1);
+
+  for (std::size_t i{1}; i < thread_count; i++)
+    workers.emplace_back (&FWorkerPool::workerLoop, this);
+}
+
+//----------------------------------------------------------------------
+FWorkerPool::~FWorkerPool() noexcept  // destructor
+{
+  {
+    std::lock_guard<std::mutex> lock{pool_mutex};
+    stop_workers = true;
+  }
+
+  start_cond.notify_all();
+
+  for (auto&& worker : workers)
+    worker.join();
+}
+
+
+// public methods of FWorkerPool
+//----------------------------------------------------------------------
+void FWorkerPool::run (std::size_t count, const Task& func)
+{
+  if ( count == 0 )
+    return;
+
+  if ( workers.empty() || count == 1 )
+  {
+    for (std::size_t i{0}; i < count; i++)
+      func(i);
+
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{pool_mutex};
+    task = &func;
+    task_count = count;
+    next_task = 0;
+    busy_workers = workers.size();
+    generation++;
+  }
+
+  start_cond.notify_all();
+  runTasks();  // The calling thread helps out
+  std::unique_lock<std::mutex> lock{pool_mutex};
+  done_cond.wait (lock, [this] () { return busy_workers == 0; });
+  task = nullptr;
+}
+
+
+// private methods of FWorkerPool
+//----------------------------------------------------------------------
+void FWorkerPool::workerLoop()
+{
+  uInt64 last_generation{0};
+
+  while ( true )
+  {
+    {
+      std::unique_lock<std::mutex> lock{pool_mutex};
+      start_cond.wait ( lock, [this, &last_generation] ()
+                              {
+                                return stop_workers
+                                    || generation != last_generation;
+                              } );
+
+      if ( stop_workers )
+        return;
+
+      last_generation = generation;
+    }
+
+    runTasks();
+    std::lock_guard<std::mutex> lock{pool_mutex};
+
+    if ( --busy_workers == 0 )
+      done_cond.notify_one();
+  }
+}
+
+//----------------------------------------------------------------------
+void FWorkerPool::runTasks()
+{
+  // Takes the next free task index until all tasks are assigned
+
+  std::size_t index{};
+
+  while ( (index = next_task.fetch_add(1)) < task_count )
+    (*task)(index);
+}
+
+}  // namespace finalcut
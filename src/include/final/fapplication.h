@@ -170,11 +170,13 @@ class FApplication : public FWidget
     // Methods
     void                  init();
     static void           setTerminalEncoding (const FString&);
+    static void           setCompositorThreadCount (const FString&);
     static void           setLongOptions(std::vector<CmdOption>&);
     static void           setCmdOptionsMap (CmdMap&);
     static void           cmdOptions (const Args&);
     static FStartOptions& getStartOptions();
     static void           showParameterUsage();
+    void                  startRecording() const;
     void                  destroyLog();
     void                  findKeyboardWidget() const;
     bool                  isKeyPressed() const;
@@ -182,8 +184,10 @@ class FApplication : public FWidget
     void                  keyReleased() const;
     void                  escapeKeyPressed() const;
     void                  mouseTracking() const;
+    void                  textPasted();
     void                  performKeyboardAction();
     void                  performMouseAction() const;
+    void                  performPasteAction();
     void                  mouseEvent (const FMouseData&);
     void                  sendEscapeKeyPressEvent() const;
     bool                  sendKeyDownEvent (FWidget*) const;
@@ -0,0 +1,105 @@
+/***********************************************************************
+* fareapool.h - Recycles the character buffers of terminal areas    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FAreaPool ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The pool provides the memory blocks for the character data and
+ * the line changes of FTermArea. Requests are rounded up to a
+ * power-of-two size class, so that a growing window gets a block
+ * with space for the following resize steps. Released blocks are
+ * kept per size class and reused by the next window or popup of
+ * a similar size. Blocks from 2 MiB upwards (vterm and vdesktop on
+ * big terminals) are aligned for transparent huge pages on Linux.
+ */
+
+#ifndef FAREAPOOL_H
+#define FAREAPOOL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <vector>
+
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FAreaPool
+//----------------------------------------------------------------------
+
+class FAreaPool final
+{
+  public:
+    // Constructor
+    FAreaPool() = default;
+
+    // Disable copy constructor
+    FAreaPool (const FAreaPool&) = delete;
+
+    // Destructor
+    ~FAreaPool();
+
+    // Disable copy assignment operator (=)
+    FAreaPool& operator = (const FAreaPool&) = delete;
+
+    // Accessors
+    FString             getClassName() const;
+    std::size_t         getFreeBlockCount() const;
+    std::size_t         getFreeBytes() const;
+    static std::size_t  getBlockSize (std::size_t);
+
+    // Methods
+    void*               allocate (std::size_t, std::size_t&);
+    void                deallocate (void*, std::size_t);
+    void                clear();
+
+  private:
+    // Constants
+    static constexpr std::size_t CLASS_COUNT = 24;  // 256 B ... 2 GiB
+
+    // Methods
+    static std::size_t  getClassIndex (std::size_t);
+    static void*        allocateBlock (std::size_t);
+    static void         freeBlock (void*, std::size_t);
+
+    // Data members
+    std::array<std::vector<void*>, CLASS_COUNT> free_blocks{};
+};
+
+// FAreaPool inline functions
+//----------------------------------------------------------------------
+inline FString FAreaPool::getClassName() const
+{ return "FAreaPool"; }
+
+}  // namespace finalcut
+
+#endif  // FAREAPOOL_H
@@ -77,8 +77,9 @@ class FButtonGroup : public FScrollView
     // Disable copy assignment operator (=)
     FButtonGroup& operator = (const FButtonGroup&) = delete;
 
-    // Accessor
+    // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     FToggleButton*      getFirstButton();
     FToggleButton*      getLastButton();
     FToggleButton*      getButton (int) const;
@@ -95,6 +96,7 @@ class FButtonGroup : public FScrollView
     bool                isChecked(int) const;
     bool                hasFocusedButton() const;
     bool                hasCheckedButton() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                hide() override;
@@ -145,6 +147,14 @@ class FButtonGroup : public FScrollView
 inline FString FButtonGroup::getClassName() const
 { return "FButtonGroup"; }
 
+//----------------------------------------------------------------------
+constexpr auto FButtonGroup::getClassTypeId() -> FTypeId
+{ return makeTypeId("FButtonGroup"); }
+
+//----------------------------------------------------------------------
+inline bool FButtonGroup::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FScrollView::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline bool FButtonGroup::unsetEnable()
 { return setEnable(false); }
@@ -56,6 +56,7 @@ enum class Event
   KeyPress,          // key pressed
   KeyUp,             // key released
   KeyDown,           // key pressed
+  Paste,             // text pasted
   MouseDown,         // mouse button pressed
   MouseUp,           // mouse button released
   MouseDoubleClick,  // mouse button double click
@@ -698,6 +699,7 @@ enum class FKey : uInt32
   X11mouse                   = 0x02000020,  // xterm mouse
   Extended_mouse             = 0x02000021,  // SGR extended mouse
   Urxvt_mouse                = 0x02000022,  // urxvt mouse extension
+  Bracketed_paste            = 0x02000023,  // bracketed paste text
   Meta_offset                = 0x020000e0,  // meta key offset
   Meta_tab                   = 0x020000e9,  // M-tab
   Meta_enter                 = 0x020000ea,  // M-enter
@@ -1141,7 +1143,8 @@ enum class FColor : uInt16
   Grey89            = 254,  // #e4e4e4
   Grey93            = 255,  // #eeeeee
   Default           = static_cast<uInt16>(-1),
-  Undefined         = static_cast<uInt16>(-2)
+  Undefined         = static_cast<uInt16>(-2),
+  RGB               = static_cast<uInt16>(-3)   // 24-bit color in FChar
 };
 
 constexpr FColor operator >> (const FColor& c, const uInt16 n) noexcept
@@ -0,0 +1,133 @@
+/***********************************************************************
+* fcharencoder.h - Table-driven terminal character encoding            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FCharEncoder ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The encoder replaces the linear searches in fc::character and
+ * fc::cp437_ucs with a dense lookup table per encoding. Characters
+ * beyond the table range are kept in a hash map.
+ *
+ * The output table combines the charset encoding of the current
+ * terminal encoding, the PC charset quirks of PuTTY and xterm and
+ * the character substitution map. Every change of these sources
+ * must call invalidate(), whereupon the tables are rebuilt on
+ * their next use.
+ */
+
+#ifndef FCHARENCODER_H
+#define FCHARENCODER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FCharEncoder
+//----------------------------------------------------------------------
+
+class FCharEncoder final
+{
+  public:
+    // Encoded output character
+    struct FOutputChar
+    {
+      wchar_t encoded;      // Character in the terminal charset
+      wchar_t output;       // Encoded character after the substitution
+      bool    alt_charset;  // Requires the alternate charset
+      bool    pc_charset;   // Requires the PC charset
+    };
+
+    // Constructor
+    FCharEncoder() = default;
+
+    // Accessors
+    FString             getClassName() const;
+    const FOutputChar&  getOutputChar (wchar_t, Encoding);
+
+    // Methods
+    void                invalidate();
+    wchar_t             encode (wchar_t, Encoding);
+
+  private:
+    // Constants
+    static constexpr std::size_t TABLE_SIZE = 0x2700;  // U+0000...U+26FF
+    static constexpr auto NUM_OF_ENCODINGS = \
+        std::size_t(Encoding::NUM_OF_ENCODINGS);
+
+    // Using-declarations
+    using CharsetTable = std::vector<wchar_t>;
+    using CharsetMap = std::unordered_map<wchar_t, wchar_t>;
+    using OutputTable = std::vector<FOutputChar>;
+    using OutputMap = std::unordered_map<wchar_t, FOutputChar>;
+
+    // Methods
+    void                buildCharsetTable (Encoding);
+    void                buildOutputTable (Encoding);
+    const FOutputChar&  getOutputMapChar (wchar_t, Encoding);
+    FOutputChar         createOutputChar (wchar_t, Encoding);
+
+    // Data members
+    std::array<CharsetTable, NUM_OF_ENCODINGS>  charset_table{};
+    std::array<CharsetMap, NUM_OF_ENCODINGS>    charset_map{};
+    OutputTable                                 output_table{};
+    OutputMap                                   output_map{};
+    Encoding                                    output_encoding{Encoding::Unknown};
+};
+
+// FCharEncoder inline functions
+//----------------------------------------------------------------------
+inline FString FCharEncoder::getClassName() const
+{ return "FCharEncoder"; }
+
+//----------------------------------------------------------------------
+inline const FCharEncoder::FOutputChar&
+    FCharEncoder::getOutputChar (wchar_t c, Encoding enc)
+{
+  if ( enc != output_encoding || output_table.empty() )
+    buildOutputTable(enc);
+
+  if ( std::size_t(c) < TABLE_SIZE )
+    return output_table[std::size_t(c)];
+
+  return getOutputMapChar(c, enc);
+}
+
+}  // namespace finalcut
+
+#endif  // FCHARENCODER_H
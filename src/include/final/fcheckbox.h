@@ -77,8 +77,12 @@ class FCheckBox : public FToggleButton
     // Disable copy assignment operator (=)
     FCheckBox& operator = (const FCheckBox&) = delete;
 
-    // Accessor
+    // Accessors
     FString       getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
+
+    // Inquiry
+    bool          isKindOf (FTypeId) const override;
 
   private:
     // Methods
@@ -94,6 +98,14 @@ class FCheckBox : public FToggleButton
 inline FString FCheckBox::getClassName() const
 { return "FCheckBox"; }
 
+//----------------------------------------------------------------------
+constexpr auto FCheckBox::getClassTypeId() -> FTypeId
+{ return makeTypeId("FCheckBox"); }
+
+//----------------------------------------------------------------------
+inline bool FCheckBox::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FToggleButton::isKindOf(id); }
+
 }  // namespace finalcut
 
 #endif  // FCHECKBOX_H
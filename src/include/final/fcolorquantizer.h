@@ -0,0 +1,106 @@
+/***********************************************************************
+* fcolorquantizer.h - Maps 24-bit colors to terminal palette colors    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FColorQuantizer ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The quantizer finds the nearest palette color for a 24-bit color
+ * (0xRRGGBB). The results are cached in a lookup cube with 5 bits
+ * per channel, which is allocated and filled on demand. With 256 colors, the
+ * xterm color cube and the grayscale ramp (16...255) are searched,
+ * otherwise the 8 or 16 VGA base colors.
+ *
+ * dither() distributes the quantization error of a color block to
+ * the neighboring cells (Floyd-Steinberg), so that large gradients
+ * do not break down into a few flat color bands.
+ */
+
+#ifndef FCOLORQUANTIZER_H
+#define FCOLORQUANTIZER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <vector>
+
+#include "final/fc.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FColorQuantizer
+//----------------------------------------------------------------------
+
+class FColorQuantizer final
+{
+  public:
+    // Constructor
+    explicit FColorQuantizer (uInt16 = 256);
+
+    // Accessors
+    FString             getClassName() const;
+    uInt16              getColorCount() const;
+    static uInt32       getPaletteRGB (FColor);
+
+    // Mutator
+    void                setColorCount (uInt16);
+
+    // Methods
+    FColor              quantize (uInt32);
+    FColor              quantize (uInt8, uInt8, uInt8);
+    std::vector<FColor> dither (const std::vector<uInt32>&, std::size_t);
+    static bool         findPaletteColor (uInt32, FColor&);
+
+  private:
+    // Methods
+    FColor              findNearestColor (int, int, int) const;
+
+    // Data members
+    std::vector<uInt16>  cube{};
+    uInt16               color_count{256};
+};
+
+// FColorQuantizer inline functions
+//----------------------------------------------------------------------
+inline FString FColorQuantizer::getClassName() const
+{ return "FColorQuantizer"; }
+
+//----------------------------------------------------------------------
+inline uInt16 FColorQuantizer::getColorCount() const
+{ return color_count; }
+
+//----------------------------------------------------------------------
+inline FColor FColorQuantizer::quantize (uInt8 r, uInt8 g, uInt8 b)
+{ return quantize((uInt32(r) << 16) | (uInt32(g) << 8) | uInt32(b)); }
+
+}  // namespace finalcut
+
+#endif  // FCOLORQUANTIZER_H
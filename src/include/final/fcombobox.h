@@ -87,12 +87,14 @@ class FDropDownListBox : public FWindow
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
 
     // Mutators
     void                setGeometry ( const FPoint&, const FSize&
                                     , bool = true ) override;
     // Inquiries
     bool                isEmpty() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                show() override;
@@ -120,6 +122,14 @@ class FDropDownListBox : public FWindow
 inline FString FDropDownListBox::getClassName() const
 { return "FDropDownListBox"; }
 
+//----------------------------------------------------------------------
+constexpr auto FDropDownListBox::getClassTypeId() -> FTypeId
+{ return makeTypeId("FDropDownListBox"); }
+
+//----------------------------------------------------------------------
+inline bool FDropDownListBox::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWindow::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline bool FDropDownListBox::isEmpty() const
 { return list.getCount() == 0; }
@@ -152,6 +162,7 @@ class FComboBox : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     std::size_t         getCount() const;
     FString             getText() const;
     template <typename DT>
@@ -180,6 +191,7 @@ class FComboBox : public FWidget
 
     // Inquiries
     bool                hasShadow() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                insert (const FListBoxItem&);
@@ -241,6 +253,14 @@ bool closeComboBox (FDropDownListBox*, const FPoint&);
 inline FString FComboBox::getClassName() const
 { return "FComboBox"; }
 
+//----------------------------------------------------------------------
+constexpr auto FComboBox::getClassTypeId() -> FTypeId
+{ return makeTypeId("FComboBox"); }
+
+//----------------------------------------------------------------------
+inline bool FComboBox::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWidget::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline std::size_t FComboBox::getCount() const
 { return list_window.list.getCount(); }
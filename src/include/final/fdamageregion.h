@@ -0,0 +1,106 @@
+/***********************************************************************
+* fdamageregion.h - Collects and merges damaged screen rectangles   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FDamageRegion ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The damage region collects the screen rectangles that have to be
+ * redrawn. Before drawing, merge() combines overlapping rectangles
+ * and rectangles whose bounding box is not larger than both together,
+ * so that each screen cell is painted only once per frame.
+ */
+
+#ifndef FDAMAGEREGION_H
+#define FDAMAGEREGION_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <vector>
+
+#include "final/frect.h"
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FDamageRegion
+//----------------------------------------------------------------------
+
+class FDamageRegion final
+{
+  public:
+    // Using-declaration
+    using FRectList = std::vector<FRect>;
+
+    // Constructor
+    FDamageRegion() = default;
+
+    // Accessors
+    FString             getClassName() const;
+    const FRectList&    getRects() const;
+    std::size_t         getCount() const;
+
+    // Inquiry
+    bool                isEmpty() const;
+
+    // Methods
+    void                add (const FRect&);
+    void                merge();
+    void                clear();
+
+  private:
+    // Data members
+    FRectList           rects{};
+};
+
+// FDamageRegion inline functions
+//----------------------------------------------------------------------
+inline FString FDamageRegion::getClassName() const
+{ return "FDamageRegion"; }
+
+//----------------------------------------------------------------------
+inline const FDamageRegion::FRectList& FDamageRegion::getRects() const
+{ return rects; }
+
+//----------------------------------------------------------------------
+inline std::size_t FDamageRegion::getCount() const
+{ return rects.size(); }
+
+//----------------------------------------------------------------------
+inline bool FDamageRegion::isEmpty() const
+{ return rects.empty(); }
+
+//----------------------------------------------------------------------
+inline void FDamageRegion::clear()
+{ rects.clear(); }
+
+}  // namespace finalcut
+
+#endif  // FDAMAGEREGION_H
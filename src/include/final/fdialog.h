@@ -94,6 +94,7 @@ class FDialog : public FWindow
 
     // Accessors
     FString               getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     virtual FString       getText() const;
 
     // Mutators
@@ -113,6 +114,7 @@ class FDialog : public FWindow
     bool                  isModal() const;
     bool                  isScrollable() const;
     bool                  hasBorder() const;
+    bool                  isKindOf (FTypeId) const override;
 
     // Methods
     void                  show() override;
@@ -244,6 +246,10 @@ class FDialog : public FWindow
 inline FString FDialog::getClassName() const
 { return "FDialog"; }
 
+//----------------------------------------------------------------------
+constexpr auto FDialog::getClassTypeId() -> FTypeId
+{ return makeTypeId("FDialog"); }
+
 //----------------------------------------------------------------------
 inline FString FDialog::getText() const
 { return tb_text; }
@@ -280,6 +286,10 @@ inline bool FDialog::isScrollable() const
 inline bool FDialog::hasBorder() const
 { return ! getFlags().no_border; }
 
+//----------------------------------------------------------------------
+inline bool FDialog::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWindow::isKindOf(id); }
+
 }  // namespace finalcut
 
 #endif  // FDIALOG_H
@@ -85,6 +85,10 @@ class FDialogListMenu : public FMenu
 
     // Accessors
     FString getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
+
+    // Inquiry
+    bool    isKindOf (FTypeId) const override;
 
   private:
     // Method
@@ -97,6 +101,14 @@ class FDialogListMenu : public FMenu
 inline FString FDialogListMenu::getClassName() const
 { return "FDialogListMenu"; }
 
+//----------------------------------------------------------------------
+constexpr auto FDialogListMenu::getClassTypeId() -> FTypeId
+{ return makeTypeId("FDialogListMenu"); }
+
+//----------------------------------------------------------------------
+inline bool FDialogListMenu::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FMenu::isKindOf(id); }
+
 }  // namespace finalcut
 
 #endif  // FDIALOGLISTMENU_H
@@ -33,6 +33,10 @@
  *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▏
  *      │
  *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *      ├─────▏FPasteEvent ▏
+ *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *      │
+ *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
  *      ├─────▏FMouseEvent ▏
  *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  *      │
@@ -86,6 +90,7 @@
 #include "final/fc.h"
 #include "final/fdata.h"
 #include "final/fpoint.h"
+#include "final/fstring.h"
 #include "final/ftypes.h"
 
 namespace finalcut
@@ -140,6 +145,28 @@ class FKeyEvent : public FEvent  // keyboard event
 };
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+class FPasteEvent : public FEvent  // bracketed paste event
+{
+  public:
+    FPasteEvent() = default;
+    FPasteEvent (Event, const FString&);
+    ~FPasteEvent() = default;
+
+    const FString& getText() const;
+    bool     isAccepted() const;
+    void     accept();
+    void     ignore();
+
+  private:
+    FString  text{};
+    bool     accpt{false};
+};
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
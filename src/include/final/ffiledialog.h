@@ -65,7 +65,11 @@
 #include <libgen.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "final/fbutton.h"
@@ -124,8 +128,9 @@ class FFileDialog : public FDialog
     bool                 setShowHiddenFiles (bool = true);
     bool                 unsetShowHiddenFiles();
 
-    // Event handler
+    // Event handlers
     void                 onKeyPress (FKeyEvent*) override;
+    void                 onTimer (FTimerEvent*) override;
 
     // Methods
     static FString fileOpenChooser ( FWidget*
@@ -165,12 +170,18 @@ class FFileDialog : public FDialog
         , socket{entry.socket}
       { }
 
+      // Move constructor
+      FDirEntry (FDirEntry&&) noexcept = default;
+
       // Destructor
       ~FDirEntry() = default;
 
       // Copy assignment operator (=)
       FDirEntry& operator = (const FDirEntry&) = default;
 
+      // Move assignment operator (=)
+      FDirEntry& operator = (FDirEntry&&) noexcept = default;
+
       // Data members
       std::string  name{};
       // Type of file
@@ -186,19 +197,41 @@ class FFileDialog : public FDialog
 
     using DirEntries = std::vector<FDirEntry>;
 
+    // The directory is read in a background thread
+    struct FDirReader
+    {
+      std::thread              thread{};
+      std::mutex               mut{};
+      std::condition_variable  cond{};
+      DirEntries               entries{};  // Entries not yet taken over
+      std::atomic<bool>        cancel{false};
+      bool                     done{true};
+      bool                     read_error{false};
+      bool                     close_error{false};
+    };
+
     // Methods
     void                 init();
     void                 widgetSettings (const FPoint&);
     void                 initCallbacks();
-    bool                 patternMatch (const char* const, const char[]) const;
+    static bool          patternMatch ( const char* const, const char[]
+                                      , bool );
     void                 clear();
-    sInt64               numOfDirs();
-    void                 sortDir();
+    static bool          sortDirEntries (const FDirEntry&, const FDirEntry&);
     int                  readDir();
-    void                 getEntry (const char* const, const struct dirent*);
-    void                 followSymLink (const char* const, FDirEntry&) const;
+    static void          readDirEntries ( FDirReader&, DIR*
+                                        , const std::string&
+                                        , bool, bool );
+    static bool          getEntry ( int, const struct dirent*
+                                  , const std::string&, bool, FDirEntry& );
+    static void          followSymLink (int, FDirEntry&);
+    void                 stopDirReader();
+    bool                 fetchDirEntries();
+    int                  finishReadDir();
     void                 dirEntriesToList();
-    void                 selectDirectoryEntry (const char* const);
+    void                 appendToList (std::size_t);
+    void                 insertListEntry (const FDirEntry&);
+    bool                 selectDirectoryEntry (const char* const);
     int                  changeDir (const FString&);
     void                 printPath (const FString&);
     static FString       getHomeDir();
@@ -212,8 +245,9 @@ class FFileDialog : public FDialog
     void                 cb_processShowHidden();
 
     // Data members
-    DIR*             directory_stream{nullptr};
+    FDirReader       dir_reader{};
     DirEntries       dir_entries{};
+    std::string      select_entry{};
     FString          directory{};
     FString          filter_pattern{};
     FLineEdit        filename{this};
@@ -222,6 +256,7 @@ class FFileDialog : public FDialog
     FButton          cancel_btn{this};
     FButton          open_btn{this};
     DialogType       dlg_type{DialogType::Open};
+    int              read_timer{0};
     bool             show_hidden{false};
 
     // Friend functions
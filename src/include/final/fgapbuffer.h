@@ -0,0 +1,155 @@
+/***********************************************************************
+* fgapbuffer.h - Editable text with a movable gap                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FGapBuffer ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* A gap buffer stores the text in one array with an unused gap at the
+ * edit position. Inserting and removing at the gap does not move the
+ * rest of the text, and moving the gap only copies the characters
+ * between the old and the new position. The column width of every
+ * character is computed once on insertion. With the sum of the column
+ * widths in front of the gap, the column of a text position is found
+ * in the time it takes to walk from the gap to this position.
+ */
+
+#ifndef FGAPBUFFER_H
+#define FGAPBUFFER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <vector>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FGapBuffer
+//----------------------------------------------------------------------
+
+class FGapBuffer final
+{
+  public:
+    // Constants
+    static constexpr auto NOT_FOUND = static_cast<std::size_t>(-1);
+
+    // Constructors
+    FGapBuffer() = default;
+    explicit FGapBuffer (const FString&);
+
+    // Overloaded operator
+    wchar_t             operator [] (std::size_t) const;
+
+    // Accessors
+    FString             getClassName() const;
+    std::size_t         getLength() const;
+    std::size_t         getGapPosition() const;
+    std::size_t         getColumnWidth() const;
+    std::size_t         getColumnWidth (std::size_t) const;
+    std::size_t         getCharWidth (std::size_t) const;
+    FString             getString() const;
+    FString             getSubString (std::size_t, std::size_t) const;
+
+    // Mutator
+    void                setString (const FString&);
+
+    // Inquiry
+    bool                isEmpty() const;
+
+    // Methods
+    void                moveGap (std::size_t);
+    void                insert (std::size_t, wchar_t);
+    void                insert (std::size_t, const FString&);
+    void                overwrite (std::size_t, const FString&);
+    void                remove (std::size_t, std::size_t);
+    void                clear();
+    void                updateColumnWidths();
+    int                 getCharLength (std::size_t) const;
+    int                 getPrevCharLength (std::size_t) const;
+    std::size_t         searchLeftCharBegin (std::size_t) const;
+    std::size_t         searchRightCharBegin (std::size_t) const;
+
+  private:
+    // Constants
+    static constexpr std::size_t MIN_GAP_SIZE = 64;
+
+    // Accessor
+    std::size_t         getIndex (std::size_t) const;
+
+    // Method
+    void                reserveGap (std::size_t);
+
+    // Data members
+    std::vector<wchar_t> chars{};
+    std::vector<uInt8>   widths{};  // Column width of each character
+    std::size_t          gap_start{0};
+    std::size_t          gap_end{0};
+    std::size_t          front_columns{0};  // Columns in front of the gap
+    std::size_t          total_columns{0};
+};
+
+// FGapBuffer inline functions
+//----------------------------------------------------------------------
+inline wchar_t FGapBuffer::operator [] (std::size_t pos) const
+{ return ( pos < getLength() ) ? chars[getIndex(pos)] : L'\0'; }
+
+//----------------------------------------------------------------------
+inline FString FGapBuffer::getClassName() const
+{ return "FGapBuffer"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FGapBuffer::getLength() const
+{ return chars.size() - (gap_end - gap_start); }
+
+//----------------------------------------------------------------------
+inline std::size_t FGapBuffer::getGapPosition() const
+{ return gap_start; }
+
+//----------------------------------------------------------------------
+inline std::size_t FGapBuffer::getColumnWidth() const
+{ return total_columns; }
+
+//----------------------------------------------------------------------
+inline std::size_t FGapBuffer::getCharWidth (std::size_t pos) const
+{ return ( pos < getLength() ) ? widths[getIndex(pos)] : 0; }
+
+//----------------------------------------------------------------------
+inline bool FGapBuffer::isEmpty() const
+{ return getLength() == 0; }
+
+//----------------------------------------------------------------------
+inline std::size_t FGapBuffer::getIndex (std::size_t pos) const
+{ return ( pos < gap_start ) ? pos : pos + (gap_end - gap_start); }
+
+}  // namespace finalcut
+
+#endif  // FGAPBUFFER_H
@@ -0,0 +1,199 @@
+/***********************************************************************
+* fheadlessterminal.h - Terminal without a real tty                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Inheritance diagram
+ *  ═══════════════════
+ *
+ *    ▕▔▔▔▔▔▔▔▔▔▏
+ *    ▕ FSystem ▏
+ *    ▕▁▁▁▁▁▁▁▁▁▏
+ *         ▲
+ *         │
+ *  ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *  ▕ FSystemImpl ▏
+ *  ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *         ▲
+ *         │
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏1     1▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FHeadlessTerminal ▏- - - -▕ FScreenModel ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* FHeadlessTerminal runs a FINAL CUT application without a real
+ * terminal, e.g. for benchmarks and screen tests in a CI pipeline.
+ * The constructor opens a pseudo terminal and connects its slave side
+ * to stdin and stdout. The terminal output of FTerm is not written to
+ * the pty but interpreted by an FScreenModel, whose content can be
+ * compared with the virtual terminal of the application
+ * (isVTermEqual() and findVTermDifference()). Keyboard and mouse
+ * input is written to the master side with sendInput().
+ *
+ * The profile selects the terminal type (TERM) that the application
+ * sees. The terminal detection with query sequences is disabled
+ * while the headless terminal exists, because nobody would answer
+ * them.
+ *
+ * install() replaces the FSystem object of FTerm and must be called
+ * before the FApplication object is created:
+ *
+ *   auto& terminal = FHeadlessTerminal::install(Profile::Linux);
+ *   FHeadlessTerminal::setClock();
+ *   Scenario app{argc, argv};
+ *
+ * A scenario can be driven from FApplication::processExternalUserEvent(),
+ * which is called once per pass of the event loop:
+ *
+ *   void Scenario::processExternalUserEvent()
+ *   {
+ *     FHeadlessTerminal::advanceClock (20000);  // 20 ms per pass
+ *
+ *     if ( ++step == 10 )
+ *       terminal.sendInput ("\033[B\r");
+ *     else if ( step == 20 )
+ *       quit();
+ *   }
+ *
+ * With setClock() the timers, timeouts and flush intervals of the
+ * application use a fixed time that only advances with advanceClock(),
+ * and the keyboard no longer waits for input. Screen updates are
+ * flushed only after the flush interval of the virtual terminal
+ * (at least 16.7 ms) has passed.
+ */
+
+#ifndef FHEADLESSTERMINAL_H
+#define FHEADLESSTERMINAL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <sys/time.h>
+
+#include <string>
+
+#include "final/fpoint.h"
+#include "final/fscreenmodel.h"
+#include "final/fsize.h"
+#include "final/fstring.h"
+#include "final/fsystemimpl.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FHeadlessTerminal
+//----------------------------------------------------------------------
+
+class FHeadlessTerminal final : public FSystemImpl
+{
+  public:
+    // Enumeration
+    enum class Profile
+    {
+      Xterm256color,
+      Linux,
+      Vt100
+    };
+
+    // Constructor
+    explicit FHeadlessTerminal ( Profile = Profile::Xterm256color
+                               , const FSize& = FSize{80, 24} );
+
+    // Disable copy constructor
+    FHeadlessTerminal (const FHeadlessTerminal&) = delete;
+
+    // Destructor
+    ~FHeadlessTerminal() noexcept override;
+
+    // Disable copy assignment operator (=)
+    FHeadlessTerminal& operator = (const FHeadlessTerminal&) = delete;
+
+    // Accessors
+    FString             getClassName() const;
+    Profile             getProfile() const;
+    static const char*  getTermType (Profile);
+    FScreenModel&       getScreen();
+    const FScreenModel& getScreen() const;
+
+    // Mutators
+    void                setSize (const FSize&);
+    static void         setClock (const timeval& = timeval{0, 0});
+    static void         advanceClock (uInt64);
+
+    // Inquiries
+    bool                isOpen() const;
+    bool                isVTermEqual() const;
+
+    // Methods
+    int                 putchar (int) override;
+    bool                sendInput (const std::string&);
+    FPoint              findVTermDifference() const;
+    static FHeadlessTerminal& install ( Profile = Profile::Xterm256color
+                                      , const FSize& = FSize{80, 24} );
+
+  private:
+    // Methods
+    void                openPseudoTerminal();
+    void                closePseudoTerminal();
+    void                setWindowSize (const FSize&) const;
+    void                drainOutput() const;
+
+    // Data members
+    FScreenModel        screen;
+    std::string         saved_term{};
+    Profile             profile{Profile::Xterm256color};
+    int                 master_fd{-1};
+    int                 saved_stdin{-1};
+    int                 saved_stdout{-1};
+    bool                had_term{false};
+    bool                saved_detection{true};
+};
+
+// FHeadlessTerminal inline functions
+//----------------------------------------------------------------------
+inline FString FHeadlessTerminal::getClassName() const
+{ return "FHeadlessTerminal"; }
+
+//----------------------------------------------------------------------
+inline FHeadlessTerminal::Profile FHeadlessTerminal::getProfile() const
+{ return profile; }
+
+//----------------------------------------------------------------------
+inline FScreenModel& FHeadlessTerminal::getScreen()
+{ return screen; }
+
+//----------------------------------------------------------------------
+inline const FScreenModel& FHeadlessTerminal::getScreen() const
+{ return screen; }
+
+//----------------------------------------------------------------------
+inline bool FHeadlessTerminal::isOpen() const
+{ return master_fd >= 0; }
+
+//----------------------------------------------------------------------
+inline bool FHeadlessTerminal::isVTermEqual() const
+{ return findVTermDifference().isOrigin(); }
+
+}  // namespace finalcut
+
+#endif  // FHEADLESSTERMINAL_H
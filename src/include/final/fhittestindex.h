@@ -0,0 +1,144 @@
+/***********************************************************************
+* fhittestindex.h - Spatial index for widget hit-testing               *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FHitTestIndex ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The index holds widget rectangles in priority order (the first
+ * inserted rectangle wins if several contain a point). The rows are
+ * split into spans at the top and bottom borders of the rectangles.
+ * Each span has a bucket sorted by the left border, so that a point
+ * lookup is a binary search for the span and one in its bucket.
+ *
+ * An index is valid as long as the generation passed to build()
+ * matches. Widgets pass the generation of their window, so that a
+ * change inside one window leaves the other indexes intact. The
+ * static invalidate() outdates all indexes at once, e.g. after a
+ * terminal resize. update() moves a single rectangle without
+ * collecting the rectangles again.
+ */
+
+#ifndef FHITTESTINDEX_H
+#define FHITTESTINDEX_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <vector>
+
+#include "final/fpoint.h"
+#include "final/frect.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FWidget;
+
+//----------------------------------------------------------------------
+// class FHitTestIndex
+//----------------------------------------------------------------------
+
+class FHitTestIndex final
+{
+  public:
+    // Constructor
+    FHitTestIndex() = default;
+
+    // Accessors
+    FString             getClassName() const;
+    std::size_t         getCount() const;
+
+    // Inquiry
+    bool                isValid (uInt64 = 0) const;
+
+    // Methods
+    static void         invalidate();
+    void                clear();
+    void                insert (const FRect&, FWidget*);
+    bool                update (const FRect&, const FWidget*);
+    void                build (uInt64 = 0);
+    FWidget*            find (const FPoint&) const;
+
+  private:
+    struct Entry
+    {
+      FRect    geometry;
+      FWidget* widget;
+    };
+
+    struct RowEntry
+    {
+      int         x1;
+      int         max_x2;  // Largest right border up to this entry
+      std::size_t index;   // Priority of the entry
+    };
+
+    // Using-declaration
+    using RowList = std::vector<RowEntry>;
+
+    struct Span
+    {
+      int     y1;   // First row (the span ends before the next one)
+      RowList row;
+    };
+
+    // Methods
+    void                buildSpans();
+    FWidget*            findInRow (const RowList&, int) const;
+
+    // Data members
+    std::vector<Entry>  entries{};
+    std::vector<Span>   spans{};
+    uInt64              generation{0};
+    uInt64              local_generation{0};
+    static uInt64       current_generation;
+};
+
+// FHitTestIndex inline functions
+//----------------------------------------------------------------------
+inline FString FHitTestIndex::getClassName() const
+{ return "FHitTestIndex"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FHitTestIndex::getCount() const
+{ return entries.size(); }
+
+//----------------------------------------------------------------------
+inline bool FHitTestIndex::isValid (uInt64 local) const
+{ return generation == current_generation && local_generation == local; }
+
+//----------------------------------------------------------------------
+inline void FHitTestIndex::invalidate()
+{ current_generation++; }
+
+}  // namespace finalcut
+
+#endif  // FHITTESTINDEX_H
@@ -30,24 +30,32 @@
 #include <final/sgr_optimizer.h>
 #include <final/fkey_map.h>
 #include <final/fapplication.h>
+#include <final/fareapool.h>
 #include <final/fbuttongroup.h>
 #include <final/fbutton.h>
 #include <final/fbusyindicator.h>
 #include <final/fc.h>
 #include <final/fdata.h>
+#include <final/fdamageregion.h>
 #include <final/fobject.h>
 #include <final/fcolorpalette.h>
 #include <final/fcolorpair.h>
+#include <final/fcolorquantizer.h>
 #include <final/fcombobox.h>
+#include <final/fcharencoder.h>
 #include <final/fcharmap.h>
 #include <final/fcheckbox.h>
 #include <final/fcheckmenuitem.h>
 #include <final/fdialog.h>
 #include <final/fdialoglistmenu.h>
 #include <final/fevent.h>
+#include <final/fhittestindex.h>
 #include <final/ffiledialog.h>
+#include <final/fgapbuffer.h>
+#include <final/fheadlessterminal.h>
 #include <final/fkeyboard.h>
 #include <final/flabel.h>
+#include <final/flineanalyzer.h>
 #include <final/flineedit.h>
 #include <final/flistbox.h>
 #include <final/flistview.h>
@@ -65,8 +73,11 @@
 #include <final/fradiobutton.h>
 #include <final/fradiomenuitem.h>
 #include <final/frect.h>
+#include <final/fscreenmodel.h>
 #include <final/fscrollbar.h>
 #include <final/fscrollview.h>
+#include <final/fsessionrecorder.h>
+#include <final/fsessionreplay.h>
 #include <final/fsize.h>
 #include <final/fspinbox.h>
 #include <final/fstartoptions.h>
@@ -78,6 +89,7 @@
 #include <final/fterm.h>
 #include <final/ftermbuffer.h>
 #include <final/ftermcap.h>
+#include <final/ftermcapcache.h>
 #include <final/ftermcapquirks.h>
 #include <final/ftermdata.h>
 #include <final/ftermdebugdata.h>
@@ -92,6 +104,7 @@
 #include <final/fwidgetcolors.h>
 #include <final/fwidget.h>
 #include <final/fwindow.h>
+#include <final/fworkerpool.h>
 
 #if defined(UNIT_TEST)
   #include <final/ftermlinux.h>
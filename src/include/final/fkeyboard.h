@@ -41,6 +41,7 @@
 #include <functional>
 #include <memory>
 #include <queue>
+#include <string>
 
 #include "final/fkey_map.h"
 #include "final/fstring.h"
@@ -107,6 +108,7 @@ class FKeyboard final
     FString               getClassName() const;
     FKey                  getKey() const;
     FString               getKeyName (const FKey) const;
+    const FString&        getPasteText() const;
     keybuffer&            getKeyBuffer();
     timeval*              getKeyPressedTime();
     static uInt64         getKeypressTimeout();
@@ -116,9 +118,11 @@ class FKeyboard final
     template <typename T>
     void                  setTermcapMap (const T&);
     void                  setTermcapMap();
+    void                  setKey (FKey);
     static void           setKeypressTimeout (const uInt64);
     static void           setReadBlockingTime (const uInt64);
     static void           setNonBlockingInputSupport (bool = true);
+    void                  setWakeupDescriptor (int);
     bool                  setNonBlockingInput (bool = true);
     bool                  unsetNonBlockingInput();
     void                  enableUTF8();
@@ -129,10 +133,12 @@ class FKeyboard final
     void                  setReleaseCommand (const FKeyboardCommand&);
     void                  setEscPressedCommand (const FKeyboardCommand&);
     void                  setMouseTrackingCommand (const FKeyboardCommand&);
+    void                  setPasteCommand (const FKeyboardCommand&);
 
     // Inquiry
     bool                  hasPendingInput() const;
     bool                  hasDataInQueue() const;
+    bool                  isPasting() const;
 
     // Methods
     bool&                 hasUnprocessedInput();
@@ -150,9 +156,11 @@ class FKeyboard final
     // Constants
     static constexpr FKey NOT_SET = static_cast<FKey>(-1);
     static constexpr std::size_t MAX_QUEUE_SIZE = 32;
+    static constexpr uInt64 PASTE_TIMEOUT = 1000000;  // 1 s
 
     // Accessors
     FKey                  getMouseProtocolKey() const;
+    FKey                  getKeyboardProtocolKey();
     FKey                  getTermcapKey();
     FKey                  getKnownKey();
     FKey                  getSingleKey();
@@ -163,21 +171,29 @@ class FKeyboard final
 
     // Methods
     FKey                  UTF8decode (const char[]) const;
+    bool                  waitForInput (uInt64);
     ssize_t               readKey();
     void                  parseKeyBuffer();
     FKey                  parseKeyString();
     FKey                  keyCorrection (const FKey&) const;
     void                  substringKeyHandling();
+    bool                  isPasteStart() const;
+    void                  startPaste();
+    void                  readPasteData (std::string*);
+    void                  finishPaste (std::size_t);
+    FString               decodePasteData() const;
     void                  keyPressed() const;
     void                  keyReleased() const;
     void                  escapeKeyPressed() const;
     void                  mouseTracking() const;
+    void                  textPasted() const;
 
     // Data members
     FKeyboardCommand      keypressed_cmd{};
     FKeyboardCommand      keyreleased_cmd{};
     FKeyboardCommand      escape_key_cmd{};
     FKeyboardCommand      mouse_tracking_cmd{};
+    FKeyboardCommand      paste_cmd{};
 
     static timeval        time_keypressed;
     static uInt64         read_blocking_time;
@@ -186,18 +202,23 @@ class FKeyboard final
     static bool           non_blocking_input_support;
     FKeyMapPtr            key_map{};
     std::queue<FKey>      fkey_queue{};
+    std::queue<FString>   paste_queue{};
+    std::string           paste_data{};
+    FString               paste_text{};
     FKey                  fkey{FKey::None};
     FKey                  key{FKey::None};
     char                  read_character{};
     char                  fifo_buf[FIFO_BUF_SIZE]{'\0'};
     int                   fifo_offset{0};
     int                   stdin_status_flags{0};
+    int                   wakeup_fd{-1};
     bool                  has_pending_input{false};
     bool                  fifo_in_use{false};
     bool                  unprocessed_buffer_data{false};
     bool                  utf8_input{false};
     bool                  mouse_support{true};
     bool                  non_blocking_stdin{false};
+    bool                  paste_mode{false};
 };
 
 // FKeyboard inline functions
@@ -209,6 +230,10 @@ inline FString FKeyboard::getClassName() const
 inline FKey FKeyboard::getKey() const
 { return key; }
 
+//----------------------------------------------------------------------
+inline const FString& FKeyboard::getPasteText() const
+{ return paste_text; }
+
 //----------------------------------------------------------------------
 inline FKeyboard::keybuffer& FKeyboard::getKeyBuffer()
 { return fifo_buf; }
@@ -237,6 +262,10 @@ inline void FKeyboard::setTermcapMap ()
   key_map = std::make_shared<type>(fc::fkey_cap_table);
 }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setKey (FKey k)
+{ key = k; }
+
 //----------------------------------------------------------------------
 inline void FKeyboard::setKeypressTimeout (const uInt64 timeout)
 { key_timeout = timeout; }
@@ -249,6 +278,10 @@ inline void FKeyboard::setReadBlockingTime (const uInt64 blocking_time)
 inline void FKeyboard::setNonBlockingInputSupport (bool enable)
 { non_blocking_input_support = enable; }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setWakeupDescriptor (int fd)
+{ wakeup_fd = fd; }
+
 //----------------------------------------------------------------------
 inline bool FKeyboard::unsetNonBlockingInput()
 { return setNonBlockingInput(false); }
@@ -261,6 +294,10 @@ inline bool FKeyboard::hasPendingInput() const
 inline bool FKeyboard::hasDataInQueue() const
 { return ! fkey_queue.empty(); }
 
+//----------------------------------------------------------------------
+inline bool FKeyboard::isPasting() const
+{ return paste_mode; }
+
 //----------------------------------------------------------------------
 inline void FKeyboard::enableUTF8()
 { utf8_input = true; }
@@ -293,6 +330,10 @@ inline void FKeyboard::setEscPressedCommand (const FKeyboardCommand& cmd)
 inline void FKeyboard::setMouseTrackingCommand (const FKeyboardCommand& cmd)
 { mouse_tracking_cmd = cmd; }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setPasteCommand (const FKeyboardCommand& cmd)
+{ paste_cmd = cmd; }
+
 }  // namespace finalcut
 
 #endif  // FKEYBOARD_H
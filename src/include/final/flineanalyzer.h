@@ -0,0 +1,120 @@
+/***********************************************************************
+* flineanalyzer.h - Finds the character runs of a terminal line        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FLineAnalyzer ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The line analyzer scans the changed columns of a virtual terminal
+ * line once from right to left and stores for each column the length
+ * of the run of equal characters and the length of the run of
+ * unchanged characters that start there. A run ends at the last
+ * analyzed column, and columns outside the analyzed range have
+ * no runs. The terminal output uses these runs for skipping
+ * unchanged characters, for erasing (ech, el1) and for repeating
+ * characters (rep). analyzeTrailingRun() finds the run at the line
+ * end separately, because only the erasing with el needs it.
+ *
+ * isEqual() compares two characters like operator == (const FChar&,
+ * const FChar&). It compares the relevant bytes under a mask with
+ * SSE2 or NEON instructions and with 64-bit words on other platforms.
+ * The run detection itself is a scalar loop that compares one pair
+ * of neighboring characters per step.
+ */
+
+#ifndef FLINEANALYZER_H
+#define FLINEANALYZER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <limits>
+#include <vector>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FLineAnalyzer
+//----------------------------------------------------------------------
+
+class FLineAnalyzer final
+{
+  public:
+    // Constructor
+    FLineAnalyzer() = default;
+
+    // Accessors
+    FString             getClassName() const;
+    uInt                getWidth() const;
+    uInt                getEqualRun (uInt) const;
+    uInt                getUnchangedRun (uInt) const;
+    uInt                getTrailingRun() const;
+
+    // Methods
+    void                analyze ( const FChar*, uInt, uInt = 0
+                                , uInt = std::numeric_limits<uInt>::max() );
+    void                analyzeTrailingRun (const FChar*, uInt);
+    static bool         isEqual (const FChar&, const FChar&);
+
+  private:
+    // Data members
+    std::vector<uInt>   equal_run{};      // Characters equal to column x
+    std::vector<uInt>   unchanged_run{};  // Characters without changes
+    uInt                trailing_run{0};  // Run at the end of the line
+    uInt                width{0};
+    uInt                first{0};  // First analyzed column
+    uInt                last{0};   // Last analyzed column
+};
+
+// FLineAnalyzer inline functions
+//----------------------------------------------------------------------
+inline FString FLineAnalyzer::getClassName() const
+{ return "FLineAnalyzer"; }
+
+//----------------------------------------------------------------------
+inline uInt FLineAnalyzer::getWidth() const
+{ return width; }
+
+//----------------------------------------------------------------------
+inline uInt FLineAnalyzer::getEqualRun (uInt x) const
+{ return ( x >= first && x <= last && x < width ) ? equal_run[x] : 0; }
+
+//----------------------------------------------------------------------
+inline uInt FLineAnalyzer::getUnchangedRun (uInt x) const
+{ return ( x >= first && x <= last && x < width ) ? unchanged_run[x] : 0; }
+
+//----------------------------------------------------------------------
+inline uInt FLineAnalyzer::getTrailingRun() const
+{ return trailing_run; }
+
+}  // namespace finalcut
+
+#endif  // FLINEANALYZER_H
@@ -51,6 +51,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "final/fgapbuffer.h"
 #include "final/fwidget.h"
 
 namespace finalcut
@@ -145,6 +146,7 @@ class FLineEdit : public FWidget
 
     // Event handlers
     void                onKeyPress (FKeyEvent*) override;
+    void                onPaste (FPasteEvent*) override;
     void                onMouseDown (FMouseEvent*) override;
     void                onMouseUp (FMouseEvent*) override;
     void                onMouseMove (FMouseEvent*) override;
@@ -177,11 +179,13 @@ class FLineEdit : public FWidget
     std::size_t         printTextField();
     std::size_t         printPassword();
     std::size_t         getCursorColumnPos() const;
-    FString             getPasswordText() const;
+    std::size_t         getColumnPos (std::size_t) const;
+    std::size_t         getCharWidth (std::size_t) const;
     bool                isPasswordField() const;
     offsetPair          endPosToOffset (std::size_t);
     std::size_t         clickPosToCursorPos (std::size_t);
     void                adjustTextOffset();
+    void                appendText (const FString&);
     void                cursorLeft();
     void                cursorRight();
     void                cursorHome();
@@ -191,13 +195,13 @@ class FLineEdit : public FWidget
     void                switchInsertMode();
     void                acceptInput();
     bool                keyInput (FKey);
+    bool                pasteInput (const FString&);
     wchar_t             characterFilter (const wchar_t) const;
     void                processActivate();
     void                processChanged() const;
 
     // Data members
-    FString          text{""};
-    FString          print_text{""};
+    FGapBuffer       text{};
     FString          label_text{""};
     FLabel*          label{};
     FWidget*         label_associated_widget{this};
@@ -225,7 +229,7 @@ inline FLineEdit& FLineEdit::operator << (const typeT& s)
 {
   FString str{};
   str << s;
-  setText(text + str);
+  appendText(str);
   return *this;
 }
 
@@ -235,7 +239,7 @@ inline FString FLineEdit::getClassName() const
 
 //----------------------------------------------------------------------
 inline FString FLineEdit::getText() const
-{ return text; }
+{ return text.getString(); }
 
 //----------------------------------------------------------------------
 inline std::size_t FLineEdit::getMaxLength() const
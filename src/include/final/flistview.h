@@ -90,6 +90,7 @@ class FListViewItem : public FObject
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     uInt                getColumnCount() const;
     int                 getSortColumn() const;
     FString             getText (int) const;
@@ -104,9 +105,10 @@ class FListViewItem : public FObject
     void                setCheckable (bool = true);
     void                setChecked (bool = true);
 
-    // Inquiry
+    // Inquiries
     bool                isChecked() const;
     bool                isExpand() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     iterator            insert (FListViewItem*);
@@ -168,6 +170,14 @@ inline FListViewItem::FListViewItem ( const FStringList& cols
 inline FString FListViewItem::getClassName() const
 { return "FListViewItem"; }
 
+//----------------------------------------------------------------------
+constexpr auto FListViewItem::getClassTypeId() -> FTypeId
+{ return makeTypeId("FListViewItem"); }
+
+//----------------------------------------------------------------------
+inline bool FListViewItem::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FObject::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline uInt FListViewItem::getColumnCount() const
 { return static_cast<uInt>(column_list.size()); }
@@ -290,6 +300,51 @@ inline int& FListViewIterator::getPosition()
 { return position; }
 
 
+//----------------------------------------------------------------------
+// class FListViewModel
+//----------------------------------------------------------------------
+
+// A data provider for FListView without FListViewItem objects.
+// The view only queries the rows that are currently visible,
+// so the size of the model does not affect the drawing and scrolling.
+// The rows are counted from 0 and the columns from 1.
+// The list view does not own the model. FListView::clear() and
+// setModel(nullptr) detach it, and reloadModel() must be called
+// after the number of rows has changed.
+
+class FListViewModel
+{
+  public:
+    // Constructor
+    FListViewModel() = default;
+
+    // Destructor
+    virtual ~FListViewModel() noexcept;
+
+    // Accessors
+    virtual FString       getClassName() const;
+    virtual std::size_t   getRowCount() const = 0;
+    virtual FString       getText (std::size_t, int) const = 0;
+    virtual std::size_t   getMaxColumnWidth (int) const;
+
+    // Method
+    virtual bool          sort (int, SortOrder);
+};
+
+// FListViewModel inline functions
+//----------------------------------------------------------------------
+inline FString FListViewModel::getClassName() const
+{ return "FListViewModel"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FListViewModel::getMaxColumnWidth (int) const
+{ return 0; }  // Unknown width - the column keeps the header width
+
+//----------------------------------------------------------------------
+inline bool FListViewModel::sort (int, SortOrder)
+{ return false; }  // The model cannot be sorted
+
+
 //----------------------------------------------------------------------
 // class FListView
 //----------------------------------------------------------------------
@@ -315,6 +370,7 @@ class FListView : public FWidget
 
     // Accessors
     FString               getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     std::size_t           getCount() const;
     Align                 getColumnAlignment (int) const;
     FString               getColumnText (int) const;
@@ -322,6 +378,8 @@ class FListView : public FWidget
     SortOrder             getSortOrder() const;
     int                   getSortColumn() const;
     FListViewItem*        getCurrentItem();
+    std::size_t           getCurrentRow();
+    FListViewModel*       getModel() const;
 
     // Mutators
     void                  setSize (const FSize&, bool = true) override;
@@ -338,6 +396,12 @@ class FListView : public FWidget
     void                  hideSortIndicator (bool = true);
     bool                  setTreeView (bool = true);
     bool                  unsetTreeView();
+    void                  setModel (FListViewModel*);
+
+    // Inquiries
+    bool                  isKindOf (FTypeId) const override;
+    bool                  isEmpty() const;
+    bool                  hasModel() const;
 
     // Methods
     virtual int           addColumn (const FString&, int = USE_MAX_SIZE);
@@ -379,6 +443,7 @@ class FListView : public FWidget
                                  , iterator );
     void                  remove (FListViewItem*);
     void                  clear();
+    void                  reloadModel();
     FListViewItems&       getData();
     const FListViewItems& getData() const;
 
@@ -418,8 +483,10 @@ class FListView : public FWidget
 
     // Accessors
     static iterator&      getNullIterator();
+    int                   getCurrentPosition();
+    int                   getFirstVisiblePosition();
 
-    // Mutators
+    // Mutator
     static void           setNullIterator (const iterator&);
 
     // Inquiry
@@ -441,7 +508,13 @@ class FListView : public FWidget
     void                  drawScrollbars() const;
     void                  drawHeadlines();
     void                  drawList();
+    void                  drawModelList();
     void                  drawListLine (const FListViewItem*, bool, bool);
+    void                  drawModelLine (std::size_t, bool, bool);
+    FString               getColumnsLine ( const FStringList&
+                                         , std::size_t, bool ) const;
+    void                  printListLine (const FString&);
+    void                  clearEmptyLines (uInt);
     void                  clearList();
     void                  setLineAttributes (bool, bool) const;
     FString               getCheckBox (const FListViewItem* item) const;
@@ -458,6 +531,9 @@ class FListView : public FWidget
     void                  afterInsertion();
     void                  recalculateHorizontalBar (std::size_t);
     void                  recalculateVerticalBar (std::size_t) const;
+    void                  adjustModelColumns();
+    void                  adjustModelViewport();
+    void                  sortModel();
     void                  mouseHeaderClicked();
     void                  wheelUp (int);
     void                  wheelDown (int);
@@ -495,6 +571,7 @@ class FListView : public FWidget
 
     // Data members
     iterator              root{};
+    FListViewModel*       model{nullptr};
     FObjectList           selflist{};
     FObjectList           itemlist{};
     FListViewIterator     current_iter{};
@@ -517,6 +594,8 @@ class FListView : public FWidget
     int                   scroll_repeat{100};
     int                   scroll_distance{1};
     int                   xoffset{0};
+    int                   current_row{0};  // Model mode
+    int                   first_row{0};    // Model mode
     int                   sort_column{-1};
     SortOrder             sort_order{SortOrder::Unsorted};
     bool                  scroll_timer{false};
@@ -554,6 +633,14 @@ struct FListView::Header
 inline FString FListView::getClassName() const
 { return "FListView"; }
 
+//----------------------------------------------------------------------
+constexpr auto FListView::getClassTypeId() -> FTypeId
+{ return makeTypeId("FListView"); }
+
+//----------------------------------------------------------------------
+inline bool FListView::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWidget::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline SortOrder FListView::getSortOrder() const
 { return sort_order; }
@@ -564,7 +651,20 @@ inline int FListView::getSortColumn() const
 
 //----------------------------------------------------------------------
 inline FListViewItem* FListView::getCurrentItem()
-{ return static_cast<FListViewItem*>(*current_iter); }
+{
+  if ( model || itemlist.empty() )
+    return nullptr;
+
+  return static_cast<FListViewItem*>(*current_iter);
+}
+
+//----------------------------------------------------------------------
+inline std::size_t FListView::getCurrentRow()
+{ return std::size_t(getCurrentPosition()); }
+
+//----------------------------------------------------------------------
+inline FListViewModel* FListView::getModel() const
+{ return model; }
 
 //----------------------------------------------------------------------
 template <typename Compare>
@@ -588,6 +688,14 @@ inline bool FListView::setTreeView (bool enable)
 inline bool FListView::unsetTreeView()
 { return setTreeView(false); }
 
+//----------------------------------------------------------------------
+inline bool FListView::isEmpty() const
+{ return model ? model->getRowCount() == 0 : itemlist.empty(); }
+
+//----------------------------------------------------------------------
+inline bool FListView::hasModel() const
+{ return model != nullptr; }
+
 //----------------------------------------------------------------------
 inline FObject::iterator FListView::insert (FListViewItem* item)
 { return insert (item, root); }
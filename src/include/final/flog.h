@@ -106,11 +106,12 @@ class FLog : public std::stringbuf
 
   private:
     // Data member
-    LogLevel     level{LogLevel::Info};
-    LineEnding   end_of_line{LineEnding::CRLF};
-    std::mutex   mut{};
-    FLogPrint    current_log{std::bind(&FLog::info, this, std::placeholders::_1)};
-    std::ostream stream{this};
+    LogLevel             level{LogLevel::Info};
+    LineEnding           end_of_line{LineEnding::CRLF};
+    std::mutex           mut{};
+    std::recursive_mutex stream_mut{};  // The stream output re-enters sync()
+    FLogPrint            current_log{std::bind(&FLog::info, this, std::placeholders::_1)};
+    std::ostream         stream{this};
 
     // Friend Non-member operator functions
     friend std::ostream& operator << (std::ostream&, LogLevel);
@@ -121,7 +122,7 @@ class FLog : public std::stringbuf
 template <typename T>
 inline FLog& FLog::operator << (const T& s)
 {
-  std::lock_guard<std::mutex> lock_guard(mut);
+  std::lock_guard<std::recursive_mutex> lock_guard(stream_mut);
   stream << s;
   return *this;
 }
@@ -129,7 +130,7 @@ inline FLog& FLog::operator << (const T& s)
 //----------------------------------------------------------------------
 inline FLog& FLog::operator << (IOManip pf)
 {
-  std::lock_guard<std::mutex> lock_guard(mut);
+  std::lock_guard<std::recursive_mutex> lock_guard(stream_mut);
   pf(stream);
   return *this;
 }
@@ -153,7 +154,7 @@ inline FLog::LogLevel& FLog::setLevel()
 //----------------------------------------------------------------------
 inline const FLog::LineEnding& FLog::getEnding()
 {
-  std::lock_guard<std::mutex> lock_guard(mut);
+  // Like setEnding(), protected by getMutex() in the derived class
   return end_of_line;
 }
 
@@ -45,10 +45,15 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <chrono>
 #include <iomanip>
@@ -65,14 +70,31 @@ namespace finalcut
 class FLogger : public FLog
 {
   public:
+    // Enumeration
+    enum class OverflowPolicy
+    {
+      Drop,  // Discard the record if the queue is full
+      Block  // Wait until the writer thread frees a slot
+    };
+
     // Constructor
     FLogger() = default;
 
     // Destructor
     ~FLogger() noexcept override;
 
-    // Methods
+    // Accessors
     FString getClassName() const override;
+    OverflowPolicy getOverflowPolicy() const;
+    std::size_t getDroppedCount() const;
+
+    // Mutator
+    void setOverflowPolicy (OverflowPolicy);
+
+    // Inquiry
+    bool isAsync() const;
+
+    // Methods
     void info (const std::string&) override;
     void warn (const std::string&) override;
     void error (const std::string&) override;
@@ -82,17 +104,48 @@ class FLogger : public FLog
     void setLineEnding (LineEnding) override;
     void enableTimestamp() override;
     void disableTimestamp() override;
+    void enableAsync (std::size_t = 4096);
+    void disableAsync();
 
   private:
+    // A queue slot with a preformatted log line
+    struct LogRecord
+    {
+      std::atomic<std::size_t> sequence{0};
+      std::string              line{};
+    };
+
+    // Using-declaration
+    using LogQueue = std::vector<LogRecord>;
+
     // Methods
-    void              newlineReplace (std::string&, const std::string&) const;
-    std::string       getTimeString() const;
-    std::string       getEOL();
-    void              printLogLine (const std::string&);
+    void               newlineReplace (std::string&, const std::string&) const;
+    static std::string getTimeString();
+    std::string        getEOL() const;
+    void               printLogLine (LogLevel, const std::string&);
+    bool               pushRecord (std::string&);
+    bool               popRecord (std::string&);
+    bool               hasRecord() const;
+    void               writeRecords();
+    void               startWriter();
+    void               stopWriter();
 
     // Data member
-    bool         timestamp{false};
-    std::ostream output{std::cerr.rdbuf()};
+    std::atomic<bool>           timestamp{false};
+    std::atomic<LineEnding>     line_ending{LineEnding::CRLF};
+    std::atomic<OverflowPolicy> overflow_policy{OverflowPolicy::Drop};
+    std::atomic<bool>           async{false};
+    std::atomic<bool>           stop{false};
+    std::atomic<std::size_t>    dropped{0};
+    std::atomic<std::size_t>    enqueue_pos{0};
+    std::size_t                 dequeue_pos{0};  // Writer thread only
+    LogQueue                    queue{};
+    std::thread                 writer{};
+    std::mutex                  writer_mutex{};
+    std::condition_variable     writer_cond{};
+    std::mutex                  output_mutex{};
+    std::ostream                output{std::cerr.rdbuf()};
+    bool                        unflushed{false};
 };
 
 // FLogger inline functions
@@ -101,49 +154,43 @@ inline FString FLogger::getClassName() const
 { return "FLogger"; }
 
 //----------------------------------------------------------------------
-inline void FLogger::info (const std::string& msg)
-{
-  std::lock_guard<std::mutex> lock_guard(getMutex());
-  setLevel() = LogLevel::Info;
-  printLogLine (msg);
-}
+inline FLogger::OverflowPolicy FLogger::getOverflowPolicy() const
+{ return overflow_policy; }
 
 //----------------------------------------------------------------------
-inline void FLogger::warn (const std::string& msg)
-{
-  std::lock_guard<std::mutex> lock_guard(getMutex());
-  setLevel() = LogLevel::Warn;
-  printLogLine (msg);
-}
+inline std::size_t FLogger::getDroppedCount() const
+{ return dropped; }
 
 //----------------------------------------------------------------------
-inline void FLogger::error (const std::string& msg)
+inline void FLogger::setOverflowPolicy (OverflowPolicy policy)
+{ overflow_policy = policy; }
+
+//----------------------------------------------------------------------
+inline bool FLogger::isAsync() const
+{ return async; }
+
+//----------------------------------------------------------------------
+inline void FLogger::info (const std::string& msg)
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
-  setLevel() = LogLevel::Error;
-  printLogLine (msg);
+  printLogLine (LogLevel::Info, msg);
 }
 
 //----------------------------------------------------------------------
-inline void FLogger::debug (const std::string& msg)
+inline void FLogger::warn (const std::string& msg)
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
-  setLevel() = LogLevel::Debug;
-  printLogLine (msg);
+  printLogLine (LogLevel::Warn, msg);
 }
 
 //----------------------------------------------------------------------
-inline void FLogger::flush()
+inline void FLogger::error (const std::string& msg)
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
-  output.flush();
+  printLogLine (LogLevel::Error, msg);
 }
 
 //----------------------------------------------------------------------
-inline void FLogger::setOutputStream (const std::ostream& os)
+inline void FLogger::debug (const std::string& msg)
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
-  output.rdbuf(os.rdbuf());
+  printLogLine (LogLevel::Debug, msg);
 }
 
 //----------------------------------------------------------------------
@@ -151,19 +198,18 @@ inline void FLogger::setLineEnding (LineEnding eol)
 {
   std::lock_guard<std::mutex> lock_guard(getMutex());
   setEnding() = eol;
+  line_ending = eol;
 }
 
 //----------------------------------------------------------------------
 inline void FLogger::enableTimestamp()
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
   timestamp = true;
 }
 
 //----------------------------------------------------------------------
 inline void FLogger::disableTimestamp()
 {
-  std::lock_guard<std::mutex> lock_guard(getMutex());
   timestamp = false;
 }
 
@@ -92,6 +92,7 @@ class FMenu : public FWindow, public FMenuList
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     FString             getText() const;
     FMenuItem*          getItem();
 
@@ -112,6 +113,7 @@ class FMenu : public FWindow, public FMenuList
     bool                isSelected() const;
     bool                hasHotkey() const;
     bool                hasMenu() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                show() override;
@@ -249,6 +251,14 @@ std::tuple<bool, bool> closeOpenMenus (FMenu*, const FPoint&);
 inline FString FMenu::getClassName() const
 { return "FMenu"; }
 
+//----------------------------------------------------------------------
+constexpr auto FMenu::getClassTypeId() -> FTypeId
+{ return makeTypeId("FMenu"); }
+
+//----------------------------------------------------------------------
+inline bool FMenu::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWindow::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline FString FMenu::getText() const
 { return menuitem.getText(); }
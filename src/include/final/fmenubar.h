@@ -84,6 +84,10 @@ class FMenuBar : public FWindow, public FMenuList
 
     // Accessors
     FString       getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
+
+    // Inquiry
+    bool          isKindOf (FTypeId) const override;
 
     // Methods
     void          resetColors() override;
@@ -160,6 +164,14 @@ class FMenuBar : public FWindow, public FMenuList
 inline FString FMenuBar::getClassName() const
 { return "FMenuBar"; }
 
+//----------------------------------------------------------------------
+constexpr auto FMenuBar::getClassTypeId() -> FTypeId
+{ return makeTypeId("FMenuBar"); }
+
+//----------------------------------------------------------------------
+inline bool FMenuBar::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWindow::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline bool FMenuBar::isMenu (const FMenuItem* mi) const
 { return mi->hasMenu(); }
@@ -89,6 +89,7 @@ class FMenuItem : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     FKey                getHotkey() const;
     FMenu*              getMenu() const;
     std::size_t         getTextLength() const;
@@ -120,6 +121,7 @@ class FMenuItem : public FWidget
     bool                isRadioButton() const;
     bool                hasHotkey() const;
     bool                hasMenu() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                addAccelerator (FKey, FWidget*) override;
@@ -203,6 +205,10 @@ class FMenuItem : public FWidget
 inline FString FMenuItem::getClassName() const
 { return "FMenuItem"; }
 
+//----------------------------------------------------------------------
+constexpr auto FMenuItem::getClassTypeId() -> FTypeId
+{ return makeTypeId("FMenuItem"); }
+
 //----------------------------------------------------------------------
 inline FKey FMenuItem::getHotkey() const
 { return hotkey; }
@@ -297,6 +303,10 @@ inline bool FMenuItem::hasHotkey() const
 inline bool FMenuItem::hasMenu() const
 { return menu != nullptr; }
 
+//----------------------------------------------------------------------
+inline bool FMenuItem::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWidget::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline FWidget* FMenuItem::getSuperMenu() const
 { return super_menu; }
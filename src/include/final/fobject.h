@@ -46,6 +46,7 @@
 #include <cstring>
 #include <list>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "final/fstring.h"
@@ -56,6 +57,7 @@ namespace finalcut
 // class forward declaration
 class FEvent;
 class FKeyEvent;
+class FPasteEvent;
 class FMouseEvent;
 class FWheelEvent;
 class FFocusEvent;
@@ -66,6 +68,16 @@ class FCloseEvent;
 class FTimerEvent;
 class FUserEvent;
 
+// Compile-time class type identifier (FNV-1a hash of the class name)
+using FTypeId = uInt32;
+
+constexpr FTypeId makeTypeId (const char* name, FTypeId hash = 2166136261u)
+{
+  return ( *name == '\0' )
+         ? hash
+         : makeTypeId (name + 1, (hash ^ FTypeId(uChar(*name))) * 16777619u);
+}
+
 //----------------------------------------------------------------------
 // class FObject
 //----------------------------------------------------------------------
@@ -97,6 +109,7 @@ class FObject
 
     // Accessors
     virtual FString       getClassName() const;
+    static constexpr auto getClassTypeId() -> FTypeId;
     FObject*              getParent() const;
     FObject*              getChild (int) const;
     FObjectList&          getChildren();
@@ -122,6 +135,9 @@ class FObject
     bool                  isDirectChild (const FObject*) const;
     bool                  isWidget() const;
     bool                  isInstanceOf (const FString&) const;
+    virtual bool          isKindOf (FTypeId) const;
+    template <typename T>
+    bool                  isA() const;
     bool                  isTimerInUpdating() const;
 
     // Methods
@@ -136,6 +152,9 @@ class FObject
     // Timer methods
     static void           getCurrentTime (timeval*);
     static bool           isTimeout (const timeval*, uInt64);
+    static void           setFixedTime (const timeval&);
+    static void           unsetFixedTime();
+    static bool           hasFixedTime();
     int                   addTimer (int);
     bool                  delTimer (int) const;
     bool                  delOwnTimers() const;
@@ -179,6 +198,8 @@ class FObject
     bool                  has_parent{false};
     bool                  widget_object{false};
     static bool           timer_modify_lock;
+    static bool           use_fixed_time;
+    static timeval        fixed_time;
 };
 
 
@@ -186,6 +207,10 @@ class FObject
 inline FString FObject::getClassName() const
 { return "FObject"; }
 
+//----------------------------------------------------------------------
+constexpr auto FObject::getClassTypeId() -> FTypeId
+{ return makeTypeId("FObject"); }
+
 //----------------------------------------------------------------------
 inline FObject* FObject::getParent() const
 { return parent_obj; }
@@ -262,10 +287,29 @@ inline bool FObject::isWidget() const
 inline bool FObject::isInstanceOf (const FString& classname) const
 { return classname == getClassName(); }
 
+//----------------------------------------------------------------------
+inline bool FObject::isKindOf (FTypeId id) const
+{ return id == getClassTypeId(); }
+
+//----------------------------------------------------------------------
+template <typename T>
+inline bool FObject::isA() const
+{
+  // An inherited isKindOf() would match the id of the base class
+  static_assert ( std::is_same< decltype(&T::isKindOf)
+                              , bool (T::*)(FTypeId) const >::value
+                , "T must declare its own getClassTypeId() and isKindOf()" );
+  return isKindOf(T::getClassTypeId());
+}
+
 //----------------------------------------------------------------------
 inline bool FObject::isTimerInUpdating() const
 { return timer_modify_lock; }
 
+//----------------------------------------------------------------------
+inline bool FObject::hasFixedTime()
+{ return use_fixed_time; }
+
 //----------------------------------------------------------------------
 inline FObject::FTimerList* FObject::getTimerList() const
 { return globalTimerList().get(); }
@@ -275,6 +319,23 @@ inline void FObject::setWidgetProperty (bool property)
 { widget_object = property; }
 
 
+// FObject non-member functions
+//----------------------------------------------------------------------
+template <typename T>
+inline T* dyn_cast (FObject* obj)
+{
+  // Checked downcast without RTTI
+  return ( obj && obj->isA<T>() ) ? static_cast<T*>(obj) : nullptr;
+}
+
+//----------------------------------------------------------------------
+template <typename T>
+inline const T* dyn_cast (const FObject* obj)
+{
+  return ( obj && obj->isA<T>() ) ? static_cast<const T*>(obj) : nullptr;
+}
+
+
 //----------------------------------------------------------------------
 // Operator functions for timeval
 //----------------------------------------------------------------------
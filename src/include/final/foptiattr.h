@@ -37,7 +37,10 @@
 
 #include <assert.h>
 #include <algorithm>  // need for std::swap
+#include <string>
+#include <vector>
 
+#include "final/fcolorquantizer.h"
 #include "final/fstring.h"
 #include "final/sgr_optimizer.h"
 
@@ -114,6 +117,8 @@ class FOptiAttr final
     void          setNoColorVideo (int);
     void          setDefaultColorSupport();
     void          unsetDefaultColorSupport();
+    void          setTrueColorSupport();
+    void          unsetTrueColorSupport();
     void          set_enter_bold_mode (const char[]);
     void          set_exit_bold_mode (const char[]);
     void          set_enter_dim_mode (const char[]);
@@ -165,8 +170,9 @@ class FOptiAttr final
       bool  caused_reset;
     };
 
-    // Using-declaration
+    // Using-declarations
     using AttributeBuffer = SGRoptimizer::AttributeBuffer;
+    using SGRParameterTable = std::vector<std::string>;
 
     // Enumerations
     enum init_reset_tests
@@ -180,6 +186,13 @@ class FOptiAttr final
       all_tests       = 0x1f
     };
 
+    enum class SGRRun
+    {
+      None,    // No SGR sequence written yet
+      Open,    // The buffer ends with the first SGR sequence
+      Closed   // Other content follows the first SGR sequence
+    };
+
     enum attr_modes
     {
       standout_mode    = 1,
@@ -243,7 +256,9 @@ class FOptiAttr final
     static bool   hasNoAttribute (const FChar&);
 
     // Methods
-    bool          hasColorChanged (const FChar&, const FChar&) const;
+    bool          hasColorChanged (const FChar&, const FChar&);
+    bool          hasTrueColor() const;
+    void          resolveColor (FColor&, uInt32&);
     void          resetColor (FChar&) const;
     void          prevent_no_color_video_attributes (FChar&, bool = false);
     void          deactivateAttributes (FChar&, FChar&);
@@ -251,7 +266,8 @@ class FOptiAttr final
     void          changeAttributeSeparately (FChar&, FChar&);
     void          change_color (FChar&, FChar&);
     void          change_to_default_color (FChar&, FChar&, FColor&, FColor&);
-    void          change_current_color (const FChar&, FColor, FColor);
+    void          change_current_color ( const FChar&, FColor, FColor
+                                       , uInt32, uInt32 );
     void          resetAttribute (FChar&) const;
     void          reset (FChar&) const;
     bool          caused_reset_attributes (const char[], uChar = all_tests) const;
@@ -260,7 +276,18 @@ class FOptiAttr final
     void          detectSwitchOff (const FChar&, const FChar&);
     bool          switchOn() const;
     bool          switchOff() const;
+    void          initColorTables();
+    static bool   getSGRParameter (const std::string&, std::string&);
+    const std::string& getSetAttributes ( bool, bool, bool
+                                        , bool, bool, bool
+                                        , bool, bool, bool );
+    void          append_color ( const char[], const SGRParameterTable&
+                               , FColor, FColor );
+    void          append_rgb_color (const char[], uInt32);
     bool          append_sequence (const char[]);
+    void          append_sgr (const char[], std::size_t);
+    void          append_raw (const char[], std::size_t);
+    void          append_chars (const char[], std::size_t);
 
     // Data members
     Capability      F_enter_bold_mode{};
@@ -303,15 +330,25 @@ class FOptiAttr final
     FChar           off{};
     FChar           reset_byte_mask{};
 
-    SGRoptimizer    sgr_optimizer{attr_buf};
     AttributeBuffer attr_buf{};
+    std::size_t     attr_len{0};
+    std::size_t     sgr_count{0};
+    SGRRun          sgr_run{SGRRun::None};
+
+    SGRParameterTable fg_sgr_param{};
+    SGRParameterTable bg_sgr_param{};
+    SGRParameterTable set_attributes_cache{};
+    FColorQuantizer   quantizer{};
 
     int             max_color{1};
     int             attr_without_color{0};
     bool            ansi_default_color{false};
+    bool            truecolor{false};
     bool            alt_equal_pc_charset{false};
     bool            monochron{true};
     bool            fake_reverse{false};
+    bool            combine_sgr{false};
+    bool            sgr_run_empty{false};
 };
 
 
@@ -336,6 +373,14 @@ inline void FOptiAttr::setDefaultColorSupport()
 inline void FOptiAttr::unsetDefaultColorSupport()
 { ansi_default_color = false; }
 
+//----------------------------------------------------------------------
+inline void FOptiAttr::setTrueColorSupport()
+{ truecolor = true; }
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::unsetTrueColorSupport()
+{ truecolor = false; }
+
 }  // namespace finalcut
 
 #endif  // FOPTIATTR_H
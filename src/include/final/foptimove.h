@@ -39,11 +39,13 @@
 #endif
 
 #include <assert.h>
+#include <array>
 #include <cctype>
 #include <climits>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <string>
 
 #include "final/fstring.h"
 
@@ -151,6 +153,21 @@ class FOptiMove final
       const char* cap;
       int duration;
       int length;
+      char ansi_final;   // Final byte of a known ANSI form or '\0'
+      int ansi_offset;   // 1 for a parameter increment (%i)
+    };
+
+    // Using-declaration
+    using MovePosition = std::array<int, 4>;  // xold, yold, xnew, ynew
+
+    // Entry of the cache with the recently calculated moves
+    struct CachedMove
+    {
+      MovePosition position;
+      uInt64       generation;
+      uInt64       last_use;
+      bool         found;
+      std::string  sequence;
     };
 
     // Constant
@@ -161,12 +178,20 @@ class FOptiMove final
     // value for a long capability waiting time
     static constexpr int MOVE_LIMIT{7};
     // maximum character distance to avoid direct cursor addressing
+    static constexpr std::size_t MOVE_CACHE_SIZE{32};
+    // number of moves in the least recently used cache
 
     // Methods
     void          calculateCharDuration();
     int           capDuration (const char[], int) const;
     int           capDurationToLength (int) const;
-    int           repeatedAppend (const Capability&, int, char*) const;
+    static void   setANSIForm (Capability&, const char[]);
+    void          copyParameter (char[], const Capability&, int) const;
+    void          copyMotionParameter (char[], int, int) const;
+    static void   copyString (char[], const std::string&);
+    static char*  writeNumber (char*, int);
+    int           repeatedAppend ( const Capability&, int
+                                 , char*, std::size_t& ) const;
     int           relativeMove (char[], int, int, int, int) const;
     int           verticalMove (char[], int, int) const;
     void          downMove (char[], int&, int, int) const;
@@ -176,13 +201,16 @@ class FOptiMove final
     void          leftMove (char[], int&, int, int) const;
 
     bool          isWideMove (int, int, int, int) const;
-    bool          isMethod0Faster (int&, int, int);
+    bool          isMethod0Faster (int&) const;
     bool          isMethod1Faster (int&, int, int, int, int) const;
     bool          isMethod2Faster (int&, int, int, int) const;
     bool          isMethod3Faster (int&, int, int) const;
     bool          isMethod4Faster (int&, int, int) const;
     bool          isMethod5Faster (int&, int, int, int) const;
+    const char*   calculateMove (int, int, int, int);
     void          moveByMethod (int, int, int, int, int);
+    void          appendRelativeMove (int, int, int, int);
+    void          invalidateCache();
 
     // Data members
     Capability    F_cursor_home{};
@@ -212,6 +240,9 @@ class FOptiMove final
     int           baudrate{9600};
     int           tabstop{0};
     char          move_buf[BUF_SIZE]{'\0'};
+    std::array<CachedMove, MOVE_CACHE_SIZE> move_cache{};
+    uInt64        cache_generation{1};
+    uInt64        cache_clock{0};
     bool          automatic_left_margin{false};
     bool          eat_nl_glitch{false};
 
@@ -307,11 +338,21 @@ inline uInt FOptiMove::getClrEolLength() const
 
 //----------------------------------------------------------------------
 inline void FOptiMove::set_auto_left_margin (bool bcap)
-{ automatic_left_margin = bcap; }
+{
+  automatic_left_margin = bcap;
+  invalidateCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiMove::set_eat_newline_glitch (bool bcap)
-{ eat_nl_glitch = bcap; }
+{
+  eat_nl_glitch = bcap;
+  invalidateCache();
+}
+
+//----------------------------------------------------------------------
+inline void FOptiMove::invalidateCache()
+{ cache_generation++; }
 
 
 // FOptiMove non-member function forward declaration
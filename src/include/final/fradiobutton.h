@@ -77,8 +77,12 @@ class FRadioButton : public FToggleButton
     // Disable copy assignment operator (=)
     FRadioButton& operator = (const FRadioButton&) = delete;
 
-    // Accessor
+    // Accessors
     FString       getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
+
+    // Inquiry
+    bool          isKindOf (FTypeId) const override;
 
   private:
     // Methods
@@ -95,6 +99,14 @@ class FRadioButton : public FToggleButton
 inline FString FRadioButton::getClassName() const
 { return "FRadioButton"; }
 
+//----------------------------------------------------------------------
+constexpr auto FRadioButton::getClassTypeId() -> FTypeId
+{ return makeTypeId("FRadioButton"); }
+
+//----------------------------------------------------------------------
+inline bool FRadioButton::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FToggleButton::isKindOf(id); }
+
 }  // namespace finalcut
 
 #endif  // FRADIOBUTTON_H
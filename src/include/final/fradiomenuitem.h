@@ -77,8 +77,12 @@ class FRadioMenuItem : public FMenuItem
     // Disable copy assignment operator (=)
     FRadioMenuItem& operator = (const FRadioMenuItem&) = delete;
 
-    // Accessor
+    // Accessors
     FString       getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
+
+    // Inquiry
+    bool          isKindOf (FTypeId) const override;
 
   private:
     // Methods
@@ -92,6 +96,14 @@ class FRadioMenuItem : public FMenuItem
 inline FString FRadioMenuItem::getClassName() const
 { return "FRadioMenuItem"; }
 
+//----------------------------------------------------------------------
+constexpr auto FRadioMenuItem::getClassTypeId() -> FTypeId
+{ return makeTypeId("FRadioMenuItem"); }
+
+//----------------------------------------------------------------------
+inline bool FRadioMenuItem::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FMenuItem::isKindOf(id); }
+
 }  // namespace finalcut
 
 #endif  // FRADIOMENUITEM_H
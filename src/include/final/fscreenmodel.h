@@ -0,0 +1,201 @@
+/***********************************************************************
+* fscreenmodel.h - In-memory model of a terminal screen                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FScreenModel ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The screen model interprets the byte stream that FINAL CUT sends
+ * to an xterm, a Linux console or a VT100 and keeps the resulting
+ * characters, colors and attributes in memory. It understands the
+ * cursor movements, erase and scroll functions, SGR attributes with
+ * 256 and 24-bit colors, the DEC special graphics character set,
+ * the alternate screen and the rectangular area operations of the
+ * VT420. Unknown control sequences are skipped. Colors are stored
+ * like in the virtual terminal, i.e. the 16 ANSI colors are converted
+ * to the VGA order of FColor.
+ *
+ * FHeadlessTerminal uses it as the screen of a terminal without
+ * a real tty.
+ */
+
+#ifndef FSCREENMODEL_H
+#define FSCREENMODEL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/fpoint.h"
+#include "final/fsize.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FScreenModel
+//----------------------------------------------------------------------
+
+class FScreenModel final
+{
+  public:
+    // Constructor
+    explicit FScreenModel (const FSize& = FSize{80, 24});
+
+    // Accessors
+    FString             getClassName() const;
+    std::size_t         getWidth() const;
+    std::size_t         getHeight() const;
+    FPoint              getCursorPos() const;
+    const FChar&        getCharacter (const FPoint&) const;
+    FString             getLine (int) const;
+    std::size_t         getByteCount() const;
+
+    // Mutator
+    void                setSize (const FSize&);
+
+    // Inquiries
+    bool                isCursorVisible() const;
+    bool                isInAlternateScreen() const;
+
+    // Methods
+    void                write (int);
+    void                write (const std::string&);
+    void                reset();
+
+  private:
+    // Enumeration
+    enum class State
+    {
+      Ground,
+      Escape,
+      Charset,
+      Hash,
+      ControlSequence,
+      OperatingSystemCommand,
+      LinuxPalette,
+      String,
+      StringEscape
+    };
+
+    // Constants
+    static constexpr std::size_t MAX_PARAMETERS = 16;
+
+    // Methods
+    FChar&              cell (int, int);
+    FChar               getBlankCharacter() const;
+    void                processGround (uChar);
+    void                processEscape (uChar);
+    void                processCSI (uChar);
+    void                executeCSI (uChar);
+    void                executeModes (bool);
+    void                executeSGR();
+    void                executeRectangleFunction (uChar);
+    void                executeControl (uChar);
+    void                decodeUTF8 (uChar);
+    void                printCharacter (wchar_t);
+    int                 getParameter (std::size_t, int = 1) const;
+    void                setCursor (int, int);
+    void                lineFeed();
+    void                reverseLineFeed();
+    void                scrollUp (int, int, int);
+    void                scrollDown (int, int, int);
+    void                eraseCells (int, int, int);
+    void                eraseRectangle (int, int, int, int, const FChar&);
+    void                insertCells (int);
+    void                deleteCells (int);
+    void                switchScreen (bool);
+    void                saveCursor();
+    void                restoreCursor();
+
+    // Data members
+    std::vector<FChar>  cells{};
+    std::vector<FChar>  saved_cells{};  // Primary screen content
+    std::vector<int>    parameters{};
+    FChar               attribute{};
+    FChar               saved_attribute{};
+    wchar_t             last_char{L' '};
+    wchar_t             utf8_char{0};
+    int                 width{0};
+    int                 height{0};
+    int                 cursor_x{0};
+    int                 cursor_y{0};
+    int                 saved_x{0};
+    int                 saved_y{0};
+    int                 scroll_top{0};
+    int                 scroll_bottom{0};
+    int                 utf8_bytes{0};
+    int                 palette_digits{0};
+    std::size_t         byte_count{0};
+    State               state{State::Ground};
+    std::array<char, 2> charset{{'B', 'B'}};  // G0 and G1
+    std::size_t         active_charset{0};
+    uChar               csi_prefix{0};
+    uChar               csi_intermediate{0};
+    bool                pending_wrap{false};
+    bool                cursor_shown{true};
+    bool                alternate_screen{false};
+};
+
+// FScreenModel inline functions
+//----------------------------------------------------------------------
+inline FString FScreenModel::getClassName() const
+{ return "FScreenModel"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FScreenModel::getWidth() const
+{ return std::size_t(width); }
+
+//----------------------------------------------------------------------
+inline std::size_t FScreenModel::getHeight() const
+{ return std::size_t(height); }
+
+//----------------------------------------------------------------------
+inline FPoint FScreenModel::getCursorPos() const
+{ return { cursor_x + 1, cursor_y + 1 }; }
+
+//----------------------------------------------------------------------
+inline std::size_t FScreenModel::getByteCount() const
+{ return byte_count; }
+
+//----------------------------------------------------------------------
+inline bool FScreenModel::isCursorVisible() const
+{ return cursor_shown; }
+
+//----------------------------------------------------------------------
+inline bool FScreenModel::isInAlternateScreen() const
+{ return alternate_screen; }
+
+}  // namespace finalcut
+
+#endif  // FSCREENMODEL_H
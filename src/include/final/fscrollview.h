@@ -81,6 +81,7 @@ class FScrollView : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     std::size_t         getViewportWidth() const;
     std::size_t         getViewportHeight() const;
     FSize               getViewportSize() const;
@@ -116,6 +117,7 @@ class FScrollView : public FWidget
     // Inquiries
     bool                hasBorder() const;
     bool                isViewportPrint() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                clearArea (wchar_t = L' ') override;
@@ -192,6 +194,14 @@ class FScrollView : public FWidget
 inline FString FScrollView::getClassName() const
 { return "FScrollView"; }
 
+//----------------------------------------------------------------------
+constexpr auto FScrollView::getClassTypeId() -> FTypeId
+{ return makeTypeId("FScrollView"); }
+
+//----------------------------------------------------------------------
+inline bool FScrollView::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWidget::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline std::size_t FScrollView::getViewportWidth() const
 { return getWidth() - vertical_border_spacing - std::size_t(nf_offset); }
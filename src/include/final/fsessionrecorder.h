@@ -0,0 +1,158 @@
+/***********************************************************************
+* fsessionrecorder.h - Records terminal sessions                       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FSessionRecorder ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* The session recorder writes the terminal output, the raw keyboard
+ * and mouse input and the terminal resizes of an application to an
+ * asciicast v2 file (https://docs.asciinema.org). FTerm passes every
+ * byte written to the terminal to appendOutput(), including the output
+ * of the terminal initialization and reset. Every flush of the virtual
+ * terminal becomes one output event.
+ *
+ * The UI thread only moves the data into a pending event list. The
+ * timestamp and JSON formatting and the file access are done by a
+ * background writer thread that wakes up when enough data has been
+ * collected, or at the latest every 250 ms.
+ *
+ * The recording is started with the command line option
+ * --record=<FILE> or with FTerm::getFSessionRecorder()->start().
+ * FSessionReplay plays the input of a recording back.
+ */
+
+#ifndef FSESSIONRECORDER_H
+#define FSESSIONRECORDER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <sys/time.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "final/fsize.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FSessionRecorder
+//----------------------------------------------------------------------
+
+class FSessionRecorder final
+{
+  public:
+    // Recorded event
+    struct Event
+    {
+      uInt64      time{0};   // µs since the start of the recording
+      char        type{'o'};  // 'o' = output, 'i' = input, 'r' = resize
+      std::string data{};
+    };
+
+    // Constructor
+    FSessionRecorder() = default;
+
+    // Disable copy constructor
+    FSessionRecorder (const FSessionRecorder&) = delete;
+
+    // Destructor
+    ~FSessionRecorder() noexcept;
+
+    // Disable copy assignment operator (=)
+    FSessionRecorder& operator = (const FSessionRecorder&) = delete;
+
+    // Accessors
+    FString             getClassName() const;
+    std::size_t         getEventCount() const;
+
+    // Inquiry
+    bool                isRecording() const;
+
+    // Methods
+    bool                start (const FString&, const FSize&);
+    void                stop();
+    void                appendOutput (char);
+    void                flushOutput();
+    void                recordOutput (std::string&&);
+    void                recordInput (const std::string&);
+    void                recordResize (const FSize&);
+    static std::string  toJSON (const Event&);
+    static bool         fromJSON (const std::string&, Event&);
+
+  private:
+    // Constants
+    static constexpr std::size_t WRITE_THRESHOLD = 64 * 1024;
+
+    // Methods
+    void                addEvent (char, std::string&&);
+    void                writerLoop();
+
+    // Data members
+    std::vector<Event>       pending{};
+    std::string              output{};
+    std::ofstream            file{};
+    timeval                  start_time{};
+    std::size_t              pending_bytes{0};
+    std::atomic<std::size_t> event_count{0};
+    std::atomic<bool>        recording{false};
+    bool                     stop_writer{false};
+    std::mutex               pending_mutex{};
+    std::condition_variable  writer_cond{};
+    std::thread              writer{};
+};
+
+// FSessionRecorder inline functions
+//----------------------------------------------------------------------
+inline FString FSessionRecorder::getClassName() const
+{ return "FSessionRecorder"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FSessionRecorder::getEventCount() const
+{ return event_count; }
+
+//----------------------------------------------------------------------
+inline bool FSessionRecorder::isRecording() const
+{ return recording; }
+
+//----------------------------------------------------------------------
+inline void FSessionRecorder::appendOutput (char c)
+{ output += c; }
+
+}  // namespace finalcut
+
+#endif  // FSESSIONRECORDER_H
@@ -0,0 +1,156 @@
+/***********************************************************************
+* fsessionreplay.h - Replays recorded terminal sessions                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FSessionReplay ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* FSessionReplay reads an asciicast v2 file of FSessionRecorder and
+ * sends the recorded input and terminal resizes to an application
+ * that runs in an FHeadlessTerminal. process() is called once per
+ * pass of the event loop, e.g. from
+ * FApplication::processExternalUserEvent(). With a fixed clock
+ * (FHeadlessTerminal::setClock()) the replay advances the time itself
+ * and runs as fast as the application can process the events.
+ *
+ * For every input event, the time until the next frame is compared:
+ * the recorded latency is the time until the next output event of
+ * the recording, the replayed latency is the measured real time until
+ * the application writes to the terminal again.
+ */
+
+#ifndef FSESSIONREPLAY_H
+#define FSESSIONREPLAY_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <sys/time.h>
+
+#include <chrono>
+#include <istream>
+#include <vector>
+
+#include "final/fsessionrecorder.h"
+#include "final/fsize.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FHeadlessTerminal;
+
+//----------------------------------------------------------------------
+// class FSessionReplay
+//----------------------------------------------------------------------
+
+class FSessionReplay final
+{
+  public:
+    // Input-to-frame latency of one input event in µs
+    struct FrameTiming
+    {
+      uInt64 input_time{0};
+      uInt64 recorded_latency{0};
+      uInt64 replayed_latency{0};
+      bool   recorded_frame{false};  // Output followed the input
+      bool   replayed_frame{false};
+    };
+
+    // Using-declaration
+    using Event = FSessionRecorder::Event;
+
+    // Constructor
+    FSessionReplay() = default;
+
+    // Accessors
+    FString             getClassName() const;
+    const FSize&        getSize() const;
+    std::size_t         getEventCount() const;
+    const std::vector<FrameTiming>& getFrameTimings() const;
+
+    // Inquiry
+    bool                isFinished() const;
+
+    // Methods
+    bool                load (const FString&);
+    bool                load (std::istream&);
+    void                process (FHeadlessTerminal&);
+
+  private:
+    // Using-declaration
+    using clock = std::chrono::steady_clock;
+
+    // Constants
+    static constexpr uInt64 MAX_TIME_STEP = 20000;     // 20 ms
+    static constexpr uInt64 FRAME_TIMEOUT = 1000000;   // 1 s
+
+    // Methods
+    void                calculateRecordedLatency();
+    void                checkFrame (const FHeadlessTerminal&);
+    void                sendEvent (FHeadlessTerminal&, const Event&);
+
+    // Data members
+    std::vector<Event>       events{};
+    std::vector<FrameTiming> timings{};
+    FSize                    size{80, 24};
+    timeval                  start_time{};
+    clock::time_point        input_sent{};
+    std::size_t              next_event{0};
+    std::size_t              next_timing{0};
+    std::size_t              byte_count{0};
+    bool                     started{false};
+    bool                     waiting_for_frame{false};
+};
+
+// FSessionReplay inline functions
+//----------------------------------------------------------------------
+inline FString FSessionReplay::getClassName() const
+{ return "FSessionReplay"; }
+
+//----------------------------------------------------------------------
+inline const FSize& FSessionReplay::getSize() const
+{ return size; }
+
+//----------------------------------------------------------------------
+inline std::size_t FSessionReplay::getEventCount() const
+{ return events.size(); }
+
+//----------------------------------------------------------------------
+inline const std::vector<FSessionReplay::FrameTiming>&
+    FSessionReplay::getFrameTimings() const
+{ return timings; }
+
+//----------------------------------------------------------------------
+inline bool FSessionReplay::isFinished() const
+{ return started && next_event >= events.size() && ! waiting_for_frame; }
+
+}  // namespace finalcut
+
+#endif  // FSESSIONREPLAY_H
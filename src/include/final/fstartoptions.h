@@ -91,10 +91,14 @@ class FStartOptions final
 #endif
 
     uInt16 dark_theme           : 1;
-    uInt16                      : 15;  // padding bits
+    uInt16 termcap_cache        : 1;
+    uInt16 termcap_refresh      : 1;
+    uInt16                      : 13;  // padding bits
 
     Encoding                    encoding{Encoding::Unknown};
     std::ofstream               logfile_stream{};
+    FString                     record_file{};
+    std::size_t                 compositor_threads{1};
 };
 
 //----------------------------------------------------------------------
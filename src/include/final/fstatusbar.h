@@ -192,6 +192,7 @@ class FStatusBar : public FWindow
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     FStatusKey*         getStatusKey (int) const;
     FString             getMessage() const;
     std::size_t         getCount() const;
@@ -205,6 +206,7 @@ class FStatusBar : public FWindow
     // Inquiries
     bool                isActivated (int) const;
     bool                hasActivatedKey() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                hide() override;
@@ -253,6 +255,14 @@ class FStatusBar : public FWindow
 inline FString FStatusBar::getClassName() const
 { return "FStatusBar"; }
 
+//----------------------------------------------------------------------
+constexpr auto FStatusBar::getClassTypeId() -> FTypeId
+{ return makeTypeId("FStatusBar"); }
+
+//----------------------------------------------------------------------
+inline bool FStatusBar::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWindow::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline FStatusKey* FStatusBar::getStatusKey (int index) const
 { return key_list[uInt(index - 1)]; }
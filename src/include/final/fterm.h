@@ -133,10 +133,13 @@ class FMouseControl;
 class FOptiAttr;
 class FOptiMove;
 class FPoint;
+class FSessionRecorder;
 class FStartOptions;
 class FSize;
 class FString;
 class FTermBuffer;
+class FCharEncoder;
+class FTermcapCache;
 class FTermData;
 class FTermDebugData;
 class FTermDetection;
@@ -194,9 +197,12 @@ class FTerm final
     static auto              getFOptiMove() -> const std::unique_ptr<FOptiMove>&;
     static auto              getFOptiAttr() -> const std::unique_ptr<FOptiAttr>&;
     static auto              getFTermDetection() -> const std::unique_ptr<FTermDetection>&;
+    static auto              getFTermcapCache() -> const std::unique_ptr<FTermcapCache>&;
+    static auto              getFCharEncoder() -> const std::unique_ptr<FCharEncoder>&;
     static auto              getFTermXTerminal() -> const std::unique_ptr<FTermXTerminal>&;
     static auto              getFKeyboard() -> const std::unique_ptr<FKeyboard>&;
     static auto              getFMouseControl() -> const std::unique_ptr<FMouseControl>&;
+    static auto              getFSessionRecorder() -> const std::unique_ptr<FSessionRecorder>&;
 
 #if defined(__linux__) || defined(UNIT_TEST)
     static auto              getFTermLinux() -> const std::unique_ptr<FTermLinux>&;
@@ -307,6 +313,7 @@ class FTerm final
   private:
     // Methods
     static FStartOptions&    getStartOptions();
+    static int               putbyte (int);
     static void              init_global_values();
     static void              init_terminal_device_path();
     static void              oscPrefix();
@@ -360,6 +367,8 @@ class FTerm final
     [[noreturn]] static void processTermination (int);
     static void              setSignalHandler();
     static void              resetSignalHandler();
+    static void              openResizePipe();
+    static void              closeResizePipe();
     static void              signal_handler (int);
 };
 
@@ -386,6 +395,8 @@ int getCharLength (const FString&, std::size_t);
 int getPrevCharLength (const FString&, std::size_t);
 std::size_t searchLeftCharBegin (const FString&, std::size_t);
 std::size_t searchRightCharBegin (const FString&, std::size_t);
+std::string queryTerminal (const std::string&, uInt64, std::size_t = 1);
+FPoint parseCursorPos (const std::string&);
 FPoint readCursorPos();
 
 // Check for 7-bit ASCII
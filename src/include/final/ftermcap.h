@@ -138,6 +138,9 @@ class FTermcap final
     static int           baudrate;
     static char          PC;
     static char          string_buf[BUF_SIZE];
+
+    // Friend class
+    friend class FTermcapCache;
 };
 
 // FTermcap inline functions
@@ -0,0 +1,166 @@
+/***********************************************************************
+* ftermcapcache.h - On-disk cache of detected terminal capabilities    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTermcapCache ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* Cache file format
+ * -----------------
+ * The cache is a text file under $XDG_CACHE_HOME/finalcut/ (default
+ * ~/.cache/finalcut/) with one "name=value" entry per line. Control
+ * characters, spaces and backslashes in values are stored as octal
+ * escapes (\ooo). The first line contains the format version and the
+ * size of the capability tables, the second line the cache key
+ * (TERM, answerback message and secondary DA). The termcap values
+ * are only used if the detected terminal type and the mtime of its
+ * terminfo file are unchanged.
+ */
+
+#ifndef FTERMCAPCACHE_H
+#define FTERMCAPCACHE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FTermcapCache
+//----------------------------------------------------------------------
+
+class FTermcapCache final
+{
+  public:
+    // Constructors
+    FTermcapCache() = default;
+
+    // Disable copy constructor
+    FTermcapCache (const FTermcapCache&) = delete;
+
+    // Destructor
+    ~FTermcapCache() noexcept = default;
+
+    // Disable copy assignment operator (=)
+    FTermcapCache& operator = (const FTermcapCache&) = delete;
+
+    // Accessors
+    FString              getClassName() const;
+    const std::string&   getKey() const;
+    std::string          getFileName() const;
+    const std::string&   getValue (const std::string&) const;
+
+    // Mutators
+    void                 setEnabled (bool = true);
+    void                 setRefresh (bool = true);
+    void                 setValue (const std::string&, const std::string&);
+
+    // Inquiries
+    bool                 isEnabled() const;
+    bool                 isLoaded() const;
+    bool                 isRestored() const;
+    bool                 hasValue (const std::string&) const;
+
+    // Methods
+    bool                 load ( const std::string&
+                              , const std::string&
+                              , const std::string& );
+    bool                 save() const;
+    bool                 restoreTermcap();
+    void                 storeTermcap();
+    void                 clear();
+
+  private:
+    // Constant
+    static constexpr int version{1};
+
+    // Methods
+    static std::string   getCacheDirectory();
+    static std::string   getTerminfoMTime (const std::string&);
+    static std::string   encode (const std::string&);
+    static std::string   decode (const std::string&);
+    static std::string   getHeader();
+    const char*          restoreString (const std::string&);
+
+    // Data members
+    std::map<std::string, std::string> values{};
+    std::deque<std::string>            string_pool{};
+    std::string                        key{};
+    bool                               enabled{false};
+    bool                               refresh{false};
+    bool                               loaded{false};
+    bool                               restored{false};
+};
+
+// FTermcapCache inline functions
+//----------------------------------------------------------------------
+inline FString FTermcapCache::getClassName() const
+{ return "FTermcapCache"; }
+
+//----------------------------------------------------------------------
+inline const std::string& FTermcapCache::getKey() const
+{ return key; }
+
+//----------------------------------------------------------------------
+inline void FTermcapCache::setEnabled (bool enable)
+{ enabled = enable; }
+
+//----------------------------------------------------------------------
+inline void FTermcapCache::setRefresh (bool enable)
+{ refresh = enable; }
+
+//----------------------------------------------------------------------
+inline void FTermcapCache::setValue ( const std::string& name
+                                    , const std::string& value )
+{ values[name] = value; }
+
+//----------------------------------------------------------------------
+inline bool FTermcapCache::isEnabled() const
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline bool FTermcapCache::isLoaded() const
+{ return loaded; }
+
+//----------------------------------------------------------------------
+inline bool FTermcapCache::isRestored() const
+{ return restored; }
+
+//----------------------------------------------------------------------
+inline bool FTermcapCache::hasValue (const std::string& name) const
+{ return values.find(name) != values.end(); }
+
+}  // namespace finalcut
+
+#endif  // FTERMCAPCACHE_H
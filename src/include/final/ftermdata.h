@@ -35,6 +35,7 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
+#include <csignal>
 #include <unordered_map>
 #include <string>
 
@@ -100,6 +101,7 @@ class FTermData final
     bool               isVGAFont() const;
     bool               isMonochron() const;
     bool               hasTermResized() const;
+    bool               isTermResponsive() const;
 
     // Mutators
     void               setTermEncoding (Encoding);
@@ -119,6 +121,7 @@ class FTermData final
     void               setVGAFont (bool = true);
     void               setMonochron (bool = true);
     void               setTermResized (bool = true);
+    void               setTermResponsive (bool = true);
     void               setTermType (const std::string&);
     void               setTermFileName (const std::string&);
     void               setXtermFont (const FString&);
@@ -159,7 +162,8 @@ class FTermData final
     bool               new_font{false};
     bool               vga_font{false};
     bool               monochron{false};
-    bool               resize_term{false};
+    volatile std::sig_atomic_t resize_term{0};  // Set by the signal handler
+    bool               term_responsive{true};  // Answers terminal queries
 };
 
 // FTermData inline functions
@@ -271,7 +275,11 @@ inline bool FTermData::isMonochron() const
 
 //----------------------------------------------------------------------
 inline bool FTermData::hasTermResized() const
-{ return resize_term; }
+{ return resize_term != 0; }
+
+//----------------------------------------------------------------------
+inline bool FTermData::isTermResponsive() const
+{ return term_responsive; }
 
 //----------------------------------------------------------------------
 inline void FTermData::setTermEncoding (Encoding enc)
@@ -339,7 +347,11 @@ inline void FTermData::setMonochron (bool mono)
 
 //----------------------------------------------------------------------
 inline void FTermData::setTermResized (bool resize)
-{ resize_term = resize; }
+{ resize_term = resize ? 1 : 0; }
+
+//----------------------------------------------------------------------
+inline void FTermData::setTermResponsive (bool responsive)
+{ term_responsive = responsive; }
 
 //----------------------------------------------------------------------
 inline void FTermData::setTermType (const std::string& name)
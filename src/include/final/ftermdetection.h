@@ -39,6 +39,9 @@
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
+#include <string>
+
+#include "final/fpoint.h"
 
 namespace finalcut
 {
@@ -94,6 +97,7 @@ class FTermDetection final
     static FString        getClassName();
     static const char*    getTermType();
     static int            getGnomeTerminalID();
+    static FPoint         getCursorPos();
     FTerminalType&        getTermTypeStruct();
 
 #if DEBUG
@@ -126,8 +130,13 @@ class FTermDetection final
     static bool           isKtermTerminal();
     static bool           isMltermTerminal();
     static bool           canDisplay256Colors();
+    static bool           canDisplayTrueColor();
     static bool           hasTerminalDetection();
     static bool           hasSetCursorStyleSupport();
+    static bool           hasRectangleSupport();
+    static bool           hasKittyKeyboardSupport();
+    static bool           hasModifyOtherKeysSupport();
+    static bool           hasBracketedPasteSupport();
 
     // Mutators
     static void           setAnsiTerminal (bool = true);
@@ -151,10 +160,12 @@ class FTermDetection final
     static void           setKtermTerminal (bool = true);
     static void           setMltermTerminal (bool = true);
     static void           setTerminalDetection (bool = true);
+    static void           setRectangleSupport (bool = true);
     static void           setTtyTypeFileName (const char[]);
 
     // Methods
     static void           detect();
+    static void           parseKeyboardProtocols (const std::string&);
 
   private:
     struct colorEnv;      // forward declaration
@@ -172,18 +183,21 @@ class FTermDetection final
     static const char*    init_256colorTerminal();
     static bool           get256colorEnvString();
     static const char*    termtype_256color_quirks();
-    static const char*    determineMaxColor (const char[]);
-    static FString        getXTermColorName (FColor);
-    static const char*    parseAnswerbackMsg (const char[]);
-    static FString        getAnswerbackMsg();
-    static const char*    parseSecDA (const char[]);
+    static std::string    getColorQuery();
+    static const char*    determineMaxColor (const char[], const std::string&);
+    static FString        getXTermColorName (const std::string&, FColor);
+    static std::string    queryTerminalID();
+    static const char*    parseAnswerbackMsg (const std::string&, const char[]);
+    static FString        getAnswerbackMsg (const std::string&);
+    static const char*    parseSecDA (const std::string&, const char[]);
     static int            str2int (const FString&);
-    static FString        getSecDA();
+    static FString        getSecDA (const std::string&);
     static const char*    secDA_Analysis (const char[]);
     static const char*    secDA_Analysis_0 (const char[]);
     static const char*    secDA_Analysis_1 (const char[]);
     static const char*    secDA_Analysis_24 (const char[]);
     static const char*    secDA_Analysis_32 (const char[]);
+    static const char*    secDA_Analysis_41 (const char[]);
     static const char*    secDA_Analysis_65 (const char[]);
     static const char*    secDA_Analysis_67 (const char[]);
     static const char*    secDA_Analysis_77 (const char[]);
@@ -202,9 +216,15 @@ class FTermDetection final
     static char           termtype[256];
     static char           ttytypename[256];
     static bool           decscusr_support;
+    static bool           rectangle_support;
+    static bool           kitty_keyboard;
+    static bool           modify_other_keys;
+    static bool           bracketed_paste;
     static bool           terminal_detection;
     static bool           color256;
+    static bool           truecolor;
     static int            gnome_terminal_id;
+    static FPoint         cursor_pos;
     static const FString* answer_back;
     static const FString* sec_da;
     static FTerminalType  terminal_type;
@@ -251,6 +271,10 @@ inline const char* FTermDetection::getTermType()
 inline int FTermDetection::getGnomeTerminalID()
 { return gnome_terminal_id; }
 
+//----------------------------------------------------------------------
+inline FPoint FTermDetection::getCursorPos()
+{ return cursor_pos; }
+
 //----------------------------------------------------------------------
 inline FTermDetection::FTerminalType& FTermDetection::getTermTypeStruct()
 { return terminal_type; }
@@ -273,10 +297,30 @@ inline const char* FTermDetection::getTermType_SecDA()
 inline bool FTermDetection::canDisplay256Colors()
 { return color256; }
 
+//----------------------------------------------------------------------
+inline bool FTermDetection::canDisplayTrueColor()
+{ return truecolor; }
+
 //----------------------------------------------------------------------
 inline bool FTermDetection::hasSetCursorStyleSupport()
 { return decscusr_support; }
 
+//----------------------------------------------------------------------
+inline bool FTermDetection::hasRectangleSupport()
+{ return rectangle_support; }
+
+//----------------------------------------------------------------------
+inline bool FTermDetection::hasKittyKeyboardSupport()
+{ return kitty_keyboard; }
+
+//----------------------------------------------------------------------
+inline bool FTermDetection::hasModifyOtherKeysSupport()
+{ return modify_other_keys; }
+
+//----------------------------------------------------------------------
+inline bool FTermDetection::hasBracketedPasteSupport()
+{ return bracketed_paste; }
+
 //----------------------------------------------------------------------
 inline bool FTermDetection::isXTerminal()
 { return terminal_type.xterm; }
@@ -445,6 +489,10 @@ inline void FTermDetection::setTmuxTerm (bool enable)
 inline void FTermDetection::setTerminalDetection (bool enable)
 { terminal_detection = enable; }
 
+//----------------------------------------------------------------------
+inline void FTermDetection::setRectangleSupport (bool enable)
+{ rectangle_support = enable; }
+
 }  // namespace finalcut
 
 #endif  // FTERMDETECTION_H
@@ -75,6 +75,8 @@ class FTermXTerminal final
     static void           setMouseSupport (bool = true);
     static void           unsetMouseSupport();
     void                  metaSendsESC (bool = true);
+    void                  bracketedPaste (bool = true);
+    void                  keyboardProtocol (bool = true);
 
     // Accessors
     FString               getClassName() const;
@@ -87,6 +89,7 @@ class FTermXTerminal final
     FString               getMouseForeground() const;
     FString               getMouseBackground() const;
     FString               getHighlightBackground() const;
+    std::string           getFontAndTitleQuery (std::size_t&) const;
 
     // Inquiries
     bool                  hasFont() const;
@@ -104,6 +107,7 @@ class FTermXTerminal final
     void                  resetDefaults();
     void                  resetTitle();
     void                  captureFontAndTitle();
+    void                  captureFontAndTitle (const std::string&);
 
   private:
     // Methods
@@ -130,20 +134,32 @@ class FTermXTerminal final
     void                  resetXTermMouseBackground() const;
     void                  resetXTermHighlightBackground() const;
     bool                  canResetColor() const;
+    std::string           getOscPrefix() const;
+    std::string           getOscPostfix() const;
     void                  oscPrefix() const;
     void                  oscPostfix() const;
-    FString               captureXTermFont() const;
-    FString               captureXTermTitle() const;
+    std::string           getFontQuery() const;
+    std::string           getTitleQuery() const;
+    FString               captureXTermFont (const std::string&) const;
+    FString               captureXTermTitle (const std::string&) const;
     static void           enableXTermMouse();
     static void           disableXTermMouse();
     void                  enableXTermMetaSendsESC();
     void                  disableXTermMetaSendsESC();
+    void                  enableXTermBracketedPaste();
+    void                  disableXTermBracketedPaste();
+    void                  enableXTermKeyboardProtocol();
+    void                  disableXTermKeyboardProtocol();
 
     // Data members
     static bool           mouse_support;
     bool                  meta_sends_esc{false};
+    bool                  bracketed_paste{false};
+    bool                  kitty_keyboard{false};
+    bool                  modify_other_keys{false};
     bool                  xterm_default_colors{false};
     bool                  title_was_changed{false};
+    bool                  font_and_title_captured{false};
     std::size_t           term_width{80};
     std::size_t           term_height{24};
     FString               xterm_font{};
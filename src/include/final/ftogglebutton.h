@@ -80,6 +80,7 @@ class FToggleButton : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     FString&            getText();
 
     // Mutators
@@ -100,6 +101,7 @@ class FToggleButton : public FWidget
 
     // Inquiries
     bool                isChecked() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Method
     void                hide() override;
@@ -164,6 +166,10 @@ class FToggleButton : public FWidget
 inline FString FToggleButton::getClassName() const
 { return "FToggleButton"; }
 
+//----------------------------------------------------------------------
+constexpr auto FToggleButton::getClassTypeId() -> FTypeId
+{ return makeTypeId("FToggleButton"); }
+
 //----------------------------------------------------------------------
 inline FString& FToggleButton::getText()
 { return text; }
@@ -191,6 +197,10 @@ inline bool FToggleButton::unsetChecked()
 inline bool FToggleButton::isChecked() const
 { return checked; }
 
+//----------------------------------------------------------------------
+inline bool FToggleButton::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWidget::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline FButtonGroup* FToggleButton::getGroup() const
 { return button_group; }
@@ -170,6 +170,8 @@ struct FChar
   FColor    fg_color{};      // Foreground color
   FColor    bg_color{};      // Background color
   attribute attr{};          // Attributes
+  uInt32    fg_rgb{};        // 24-bit foreground color (FColor::RGB)
+  uInt32    bg_rgb{};        // 24-bit background color (FColor::RGB)
 };
 
 // FChar operator functions
@@ -179,6 +181,8 @@ inline bool operator == (const FChar& lhs, const FChar& rhs)
   return operator == (lhs.ch, rhs.ch)  // Compare FUnicode
       && lhs.fg_color     == rhs.fg_color
       && lhs.bg_color     == rhs.bg_color
+      && lhs.fg_rgb       == rhs.fg_rgb
+      && lhs.bg_rgb       == rhs.bg_rgb
       && lhs.attr.byte[0] == rhs.attr.byte[0]
       && lhs.attr.byte[1] == rhs.attr.byte[1]
       && lhs.attr.bit.fullwidth_padding \
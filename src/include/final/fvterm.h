@@ -71,6 +71,9 @@ namespace finalcut
 
 // class forward declaration
 class FColorPair;
+class FColorQuantizer;
+class FDamageRegion;
+class FLineAnalyzer;
 class FPoint;
 class FRect;
 class FSize;
@@ -80,6 +83,7 @@ class FTermBuffer;
 class FTermDebugData;
 class FStyle;
 class FWidget;
+class FWorkerPool;
 
 //----------------------------------------------------------------------
 // class FVTerm
@@ -150,6 +154,7 @@ class FVTerm
     FPoint                getPrintCursor();
     static FChar          getAttribute();
     FTerm&                getFTerm() const;
+    static std::size_t    getCompositorThreads();
 
     // Mutators
     void                  setTermXY (int, int) const;
@@ -159,6 +164,9 @@ class FVTerm
     void                  setPrintCursor (const FPoint&);
     FColor                rgb2ColorIndex (uInt8, uInt8, uInt8) const;
     static void           setColor (FColor, FColor);
+    static void           setRGBColor (uInt32, uInt32);
+    static void           setRGBForegroundColor (uInt32);
+    static void           setRGBBackgroundColor (uInt32);
     static void           setNormal();
     static bool           setBold (bool = true);
     static bool           unsetBold();
@@ -194,6 +202,7 @@ class FVTerm
     static bool           unsetInheritBackground();
     static void           setNonBlockingRead (bool = true);
     static void           unsetNonBlockingRead();
+    static void           setCompositorThreads (std::size_t);
 
     // Inquiries
     static bool           isBold();
@@ -248,6 +257,7 @@ class FVTerm
     FTermArea*            getCurrentPrintArea() const;
     FTermArea*            getVirtualDesktop() const;
     FTermArea*            getVirtualTerminal() const;
+    static FRect          getVisibleRegion (FTermArea*, const FRect&);
 
     // Mutators
     void                  setPrintArea (FTermArea*);
@@ -260,6 +270,7 @@ class FVTerm
     bool                  hasChildPrintArea() const;
     bool                  isVirtualWindow() const;
     bool                  isCursorHideable() const;
+    static bool           isFlushTimeout();
 
     // Methods
     void                  createArea ( const FRect&
@@ -277,10 +288,13 @@ class FVTerm
     static void           getArea (const FPoint&, const FTermArea*);
     static void           getArea (const FRect&, const FTermArea*);
     void                  putArea (const FTermArea*) const;
-    static void           putArea (const FPoint&, const FTermArea*);
+    static void           putArea (const FPoint&, FTermArea*);
+    static void           markAreaChanged (FTermArea*);
     void                  scrollAreaForward (FTermArea*) const;
     void                  scrollAreaReverse (FTermArea*) const;
     void                  clearArea (FTermArea*, wchar_t = L' ') const;
+    static void           setAreaClip (FTermArea*, const FRect&);
+    static void           unsetAreaClip (FTermArea*);
     void                  forceTerminalUpdate() const;
     bool                  processTerminalUpdate() const;
     static void           startDrawing();
@@ -338,6 +352,18 @@ class FVTerm
       std::string string{};
     };
 
+    struct FRectangleCopy  // Pending copy of a moved area (DECCRA)
+    {
+      const FTermArea* area{nullptr};
+      int x{0};       // Terminal cells at the old position
+      int y{0};       // (0-based)
+      int width{0};
+      int height{0};
+      int dx{0};      // Distance to the new position
+      int dy{0};
+      std::vector<FChar> data{};
+    };
+
     // Using-declaration
     using OutputData = std::tuple<OutputType, TermString>;
     using OutputBuffer = std::queue<OutputData>;
@@ -348,6 +374,12 @@ class FVTerm
     //   Upper and lower flush limit
     static constexpr uInt64 MIN_FLUSH_WAIT = 16667;   //   16.6 ms = 60 Hz
     static constexpr uInt64 MAX_FLUSH_WAIT = 200000;  //  200.0 ms = 5 Hz
+    //   Minimum number of cells for a rectangular copy or fill
+    static constexpr int MIN_RECTANGLE_CELLS = 8;
+    //   Minimum vterm size for the parallel composition of the areas
+    static constexpr int MIN_PARALLEL_CELLS = 8192;
+    //   Row bands per compositor thread (balances uneven window loads)
+    static constexpr int BANDS_PER_THREAD = 4;
 
     // Methods
     void                  resetTextAreaToDefault ( const FTermArea*
@@ -358,6 +390,10 @@ class FVTerm
     static bool           reallocateTextArea ( FTermArea*
                                              , std::size_t );
     static CoveredState   isCovered (const FPoint&, const FTermArea*);
+    static bool           isOpaqueLine ( const FTermArea*
+                                       , const FPoint&, const FPoint& );
+    static void           cutCoveredRegion (FRect&, const FTermArea*);
+    static void           invalidateCoveredCells (const FRect&);
     static void           updateOverlappedColor (const FChar&, const FChar&, FChar&);
     static void           updateOverlappedCharacter (FChar&, FChar&);
     static void           updateShadedCharacter (const FChar&, FChar&, FChar&);
@@ -367,11 +403,14 @@ class FVTerm
                                                , const FPoint&
                                                , const FPoint& );
     void                  updateVTerm() const;
+    static void           putAreaLines (const FTermArea*, int, int);
     static void           callPreprocessingHandler (const FTermArea*);
     bool                  hasChildAreaChanges (FTermArea*) const;
     void                  clearChildAreaChanges (const FTermArea*) const;
     static bool           isInsideArea (const FPoint&, const FTermArea*);
-    static FChar          generateCharacter (const FPoint&);
+    static void           composeArea (const FTermArea*, const FRect&);
+    static void           composeAreaLine (const FChar*, FChar*, std::size_t);
+    static void           composeCharacter (const FChar&, FChar&);
     static FChar          getCharacter ( CharacterType
                                        , const FPoint&
                                        , const FTermArea* );
@@ -380,6 +419,7 @@ class FVTerm
     void                  init();
     static void           init_characterLengths();
     static void           init_combined_character();
+    static void           init_rectangle_support();
     void                  finish() const;
     static void           putAreaLine (const FChar&, FChar&, std::size_t);
     static void           putAreaCharacter ( const FPoint&, const FTermArea*
@@ -389,12 +429,13 @@ class FVTerm
     bool                  clearTerm (wchar_t = L' ') const;
     bool                  clearFullArea (const FTermArea*, FChar&) const;
     static void           clearAreaWithShadow (const FTermArea*, const FChar&);
+    static void           clearClippedArea (FTermArea*, const FChar&);
     static bool           canClearToEOL (uInt, uInt);
     static bool           canClearLeadingWS (uInt&, uInt);
     static bool           canClearTrailingWS (uInt&, uInt);
     bool                  skipUnchangedCharacters (uInt&, uInt, uInt) const;
     void                  printRange (uInt, uInt, uInt, bool) const;
-    void                  replaceNonPrintableFullwidth (uInt, FChar&) const;
+    bool                  replaceNonPrintableFullwidth (uInt, FChar&) const;
     void                  printCharacter (uInt&, uInt, bool, FChar&) const;
     void                  printFullWidthCharacter (uInt&, uInt, FChar&) const;
     void                  printFullWidthPaddingCharacter (uInt&, uInt, FChar&) const;
@@ -410,14 +451,25 @@ class FVTerm
                                                      , const int&
                                                      , const int&
                                                      , const FChar&) const;
+    static void           setAreaCharacter ( FTermArea*
+                                           , const int&
+                                           , const int&
+                                           , const FChar& );
     void                  printPaddingCharacter (FTermArea*, const FChar&);
+    static void           queueRectangleCopy (const FTermArea*, int, int);
+    static void           cancelRectangleCopy();
+    static void           queueRectangleFill (const FRect&);
+    static void           queueRectangleFill (FTermArea*);
+    void                  copyRectangle() const;
+    void                  fillRectangles() const;
+    void                  fillRectangle (const FRect&, FChar&) const;
+    uInt                  getRectangleFillEnd (uInt, uInt, uInt, uInt) const;
+    static bool           isRectangleFillChar (const FChar&);
+    static void           trimLineChanges (uInt);
     bool                  updateTerminalLine (uInt) const;
     bool                  updateTerminalCursor() const;
     bool                  isInsideTerminal (const FPoint&) const;
-    bool                  isTermSizeChanged() const;
     void                  flushTimeAdjustment() const;
-    static bool           isFlushTimeout();
-    static bool           isTermSizeCheckTimeout();
     static bool           hasPendingUpdates (const FTermArea*);
     static void           markAsPrinted (uInt, uInt);
     static void           markAsPrinted (uInt, uInt, uInt);
@@ -446,24 +498,31 @@ class FVTerm
     static FTermArea*             active_area;  // active area
     static FChar                  term_attribute;
     static FChar                  next_attribute;
-    static FChar                  s_ch;      // shadow character
-    static FChar                  i_ch;      // inherit background character
+    static thread_local FChar     s_ch;      // shadow character
+    static thread_local FChar     i_ch;      // inherit background character
+    static FRectangleCopy         rect_copy;
+    static FDamageRegion          rect_fills;  // Regions for DECFRA/DECERA
+    static std::unique_ptr<FWorkerPool> compositor_pool;
+    static FLineAnalyzer          line_analyzer;
+    static FColorQuantizer        color_quantizer;  // Cached nearest colors
     static timeval                time_last_flush;
-    static timeval                last_term_size_check;
     static bool                   draw_completed;
     static bool                   combined_char_support;
+    static bool                   rectangle_support;
     static bool                   no_terminal_updates;
     static bool                   force_terminal_update;
     static uInt64                 flush_wait;
     static uInt64                 flush_average;
     static uInt64                 flush_median;
-    static uInt64                 term_size_check_timeout;
     static uInt                   erase_char_length;
     static uInt                   repeat_char_length;
     static uInt                   clr_bol_length;
     static uInt                   clr_eol_length;
     static uInt                   cursor_address_length;
     static bool                   cursor_hideable;
+
+    // Friend class
+    friend class FHeadlessTerminal;
 };
 
 
@@ -496,12 +555,24 @@ struct FVTerm::FTermArea  // define virtual terminal character properties
   int cursor_y{0};           // Y-position for the next write operation
   int input_cursor_x{-1};    // X-position input cursor
   int input_cursor_y{-1};    // Y-position input cursor
+  int put_left{0};           // Terminal position (0-based) of
+  int put_top{0};            // the last putArea() call
+  int clip_left{0};          // Clipping rectangle in area coordinates,
+  int clip_top{0};           // outside of which printing has no effect
+  int clip_right{-1};
+  int clip_bottom{-1};
   FWidget* widget{nullptr};  // Widget that owns this FTermArea
   FPreprocessing preproc_list{};
   FLineChanges* changes{nullptr};
   FChar* data{nullptr};      // FChar data of the drawing area
+  std::size_t changes_block_size{0};  // Allocated bytes (FAreaPool)
+  std::size_t data_block_size{0};
   bool input_cursor_visible{false};
   bool has_changes{false};
+  bool has_clip{false};
+  bool has_covered_cells{false};  // Covered cells may not be drawn
+  bool has_put_pos{false};   // put_left and put_top are valid
+  bool has_fill{false};      // Cleared since the last composition
   bool visible{false};
 };
 
@@ -631,6 +702,34 @@ inline void FVTerm::setColor (FColor fg, FColor bg)
   // Changes colors
   next_attribute.fg_color = fg;
   next_attribute.bg_color = bg;
+
+  if ( fg != FColor::RGB )
+    next_attribute.fg_rgb = 0;
+
+  if ( bg != FColor::RGB )
+    next_attribute.bg_rgb = 0;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::setRGBColor (uInt32 fg_rgb, uInt32 bg_rgb)
+{
+  // Changes to 24-bit colors (0xRRGGBB)
+  setRGBForegroundColor (fg_rgb);
+  setRGBBackgroundColor (bg_rgb);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::setRGBForegroundColor (uInt32 rgb)
+{
+  next_attribute.fg_color = FColor::RGB;
+  next_attribute.fg_rgb = rgb & 0xffffff;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::setRGBBackgroundColor (uInt32 rgb)
+{
+  next_attribute.bg_color = FColor::RGB;
+  next_attribute.bg_rgb = rgb & 0xffffff;
 }
 
 //----------------------------------------------------------------------
@@ -642,6 +741,8 @@ inline void FVTerm::setNormal()
   next_attribute.attr.bit.no_changes = false;
   next_attribute.fg_color = FColor::Default;
   next_attribute.bg_color = FColor::Default;
+  next_attribute.fg_rgb = 0;
+  next_attribute.bg_rgb = 0;
 }
 
 //----------------------------------------------------------------------
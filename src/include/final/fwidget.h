@@ -96,10 +96,13 @@
 
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "final/fcallback.h"
+#include "final/fdamageregion.h"
+#include "final/fhittestindex.h"
 #include "final/fobject.h"
 #include "final/fpoint.h"
 #include "final/frect.h"
@@ -175,6 +178,7 @@ class FWidget : public FVTerm, public FObject
 
     // Accessors
     FString                  getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     FWidget*                 getRootWidget();
     FWidget*                 getParentWidget() const;
     static FWidget*&         getMainWidget();
@@ -187,9 +191,11 @@ class FWidget : public FVTerm, public FObject
     static FMenuBar*         getMenuBar();
     static FStatusBar*       getStatusBar();
     static auto              getColorTheme() -> std::shared_ptr<FWidgetColors>&;
+    static std::size_t       getPaintCount();
     virtual FWidget*         getFirstFocusableWidget (FObjectList);
     virtual FWidget*         getLastFocusableWidget (FObjectList);
     const FAcceleratorList&  getAcceleratorList() const;
+    FWidget*                 getAcceleratorTarget (FKey) const;
     FString                  getStatusbarMessage() const;
     FColor                   getForegroundColor() const;  // get the primary
     FColor                   getBackgroundColor() const;  // widget colors
@@ -297,6 +303,7 @@ class FWidget : public FVTerm, public FObject
     bool                     hasFocus() const;
     bool                     acceptFocus() const;  // is focusable
     bool                     isPaddingIgnored() const;
+    bool                     isKindOf (FTypeId) const override;
 
     // Methods
     FWidget*                 childWidgetAt (const FPoint&);
@@ -313,6 +320,8 @@ class FWidget : public FVTerm, public FObject
     void                     delAccelerator ();
     virtual void             delAccelerator (FWidget*);
     virtual void             redraw();
+    void                     invalidate();
+    void                     invalidate (const FRect&);
     virtual void             resize();
     virtual void             show();
     virtual void             hide();
@@ -331,6 +340,8 @@ class FWidget : public FVTerm, public FObject
     static FWidgetList*&     getDialogList();
     static FWidgetList*&     getAlwaysOnTopList();
     static FWidgetList*&     getWidgetCloseList();
+    FRect                    getClipRect();
+    FRect                    getVisibleRect();
     void                     addPreprocessingHandler ( const FVTerm*
                                                      , FPreprocessingFunction&& ) override;
     void                     delPreprocessingHandler (const FVTerm*) override;
@@ -355,12 +366,15 @@ class FWidget : public FVTerm, public FObject
     void                     hideArea (const FSize&);
     virtual bool             focusNextChild();  // Change child...
     virtual bool             focusPrevChild();  // ...focus
+    static void              processDamage();
+    virtual void             invalidateHitTest();
 
     // Event handlers
     bool                     event (FEvent*) override;
     virtual void             onKeyPress (FKeyEvent*);
     virtual void             onKeyUp (FKeyEvent*);
     virtual void             onKeyDown (FKeyEvent*);
+    virtual void             onPaste (FPasteEvent*);
     virtual void             onMouseDown (FMouseEvent*);
     virtual void             onMouseUp (FMouseEvent*);
     virtual void             onMouseDoubleClick (FMouseEvent*);
@@ -422,7 +436,12 @@ class FWidget : public FVTerm, public FObject
       int right{0};
     };
 
+    // Using-declaration
+    using FAcceleratorMap = std::unordered_map<FKey, FWidget*, FKeyHash>;
+    using FWindowGeometries = std::vector<std::pair<const FWidget*, FRect>>;
+
     // Methods
+    void                     updateAcceleratorMap() const;
     void                     determineDesktopSize();
     void                     initRootWidget();
     void                     initWidgetLayout();
@@ -436,11 +455,20 @@ class FWidget : public FVTerm, public FObject
     void                     processDestroy() const;
     virtual void             draw();
     void                     drawWindows() const;
+    static void              redrawWindow (FWidget*);
     void                     drawChildren();
+    FWindowGeometries        getWindowGeometries() const;
+    void                     redrawResizedWindows (const FWindowGeometries&);
+    FWidget*                 getChildAreaOwner();
+    void                     paintDesktop (const FRect&);
+    void                     paintWindow (const FRect&);
+    void                     paintClipped (const FRect&);
+    void                     paintClippedChildren (const FRect&);
     static bool              isDefaultTheme();
     static void              initColorTheme();
     void                     removeQueuedEvent() const;
     void                     setStatusbarText (bool = true) const;
+    uInt64                   getHitTestGeneration();
 
     // Data members
     struct FWidgetFlags      flags{};
@@ -468,7 +496,13 @@ class FWidget : public FVTerm, public FObject
     FColor                   background_color{FColor::Default};
     FString                  statusbar_message{};
     FAcceleratorList         accelerator_list{};
+    // key to accelerator target (first entry of accelerator_list wins)
+    mutable FAcceleratorMap  accelerator_map{};
+    mutable bool             accelerator_map_valid{true};
     FCallback                callback_impl{};
+    FHitTestIndex            child_index{};
+    // changes of the hit-test indexes inside a window (or the desktop)
+    uInt64                   hit_test_generation{0};
 
     static FStatusBar*       statusbar;
     static FMenuBar*         menubar;
@@ -484,6 +518,10 @@ class FWidget : public FVTerm, public FObject
     static FWidgetList*      dialog_list;
     static FWidgetList*      always_on_top_list;
     static FWidgetList*      close_widget;
+    static FDamageRegion     damage_region;
+    static FRect             damage_clip;
+    static std::size_t       paint_count;
+    static std::size_t       last_paint_count;
     static uInt              modal_dialog_counter;
     static bool              init_terminal;
     static bool              init_desktop;
@@ -509,6 +547,7 @@ class FWidget : public FVTerm, public FObject
 void          detectTermSize();
 bool          isFocusNextKey (const FKey);
 bool          isFocusPrevKey (const FKey);
+bool          isVisibleLine (const FRect&, int);
 FKey          getHotkey (const FString&);
 std::size_t   getHotkeyPos (const FString& src, FString& dest);
 void          setHotkeyViaString (FWidget*, const FString&);
@@ -531,6 +570,10 @@ void          drawNewFontListBox (FWidget*, const FRect&);
 inline FString FWidget::getClassName() const
 { return "FWidget"; }
 
+//----------------------------------------------------------------------
+constexpr auto FWidget::getClassTypeId() -> FTypeId
+{ return makeTypeId("FWidget"); }
+
 //----------------------------------------------------------------------
 inline FWidget*& FWidget::getMainWidget()
 { return main_widget; }
@@ -574,13 +617,20 @@ inline auto FWidget::getColorTheme() -> std::shared_ptr<FWidgetColors>&
   return *color_theme;
 }
 
+//----------------------------------------------------------------------
+inline std::size_t FWidget::getPaintCount()
+{ return last_paint_count; }
+
 //----------------------------------------------------------------------
 inline const FWidget::FAcceleratorList& FWidget::getAcceleratorList() const
 { return accelerator_list; }
 
 //----------------------------------------------------------------------
 inline FWidget::FAcceleratorList& FWidget::setAcceleratorList()
-{ return accelerator_list; }
+{
+  accelerator_map_valid = false;  // The list can be changed directly
+  return accelerator_list;
+}
 
 //----------------------------------------------------------------------
 inline FString FWidget::getStatusbarMessage() const
@@ -947,6 +997,10 @@ inline bool FWidget::acceptFocus() const  // is focusable
 inline bool FWidget::isPaddingIgnored() const
 { return ignore_padding; }
 
+//----------------------------------------------------------------------
+inline bool FWidget::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FObject::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline void FWidget::clearStatusbarMessage()
 { statusbar_message.clear(); }
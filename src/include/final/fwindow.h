@@ -84,6 +84,7 @@ class FWindow : public FWidget
 
     // Accessors
     FString             getClassName() const override;
+    static constexpr auto getClassTypeId() -> FTypeId;
     static FWindow*     getWindowWidget (FWidget*);
     static int          getWindowLayer (FWidget*);
     FWidget*            getWindowFocusWidget() const;
@@ -113,6 +114,7 @@ class FWindow : public FWidget
     bool                isAlwaysOnTop() const;
     bool                hasTransparentShadow() const;
     bool                hasShadow() const;
+    bool                isKindOf (FTypeId) const override;
 
     // Methods
     void                drawBorder() override;
@@ -142,8 +144,9 @@ class FWindow : public FWidget
     void                setShadowSize (const FSize&) override;
 
   protected:
-    // Method
+    // Methods
     void                adjustSize() override;
+    void                invalidateHitTest() override;
 
     // Mutator
     static void         setPreviousWindow (FWindow*);
@@ -159,11 +162,15 @@ class FWindow : public FWidget
     // Methods
     static void         deleteFromAlwaysOnTopList (const FWidget*);
     static void         processAlwaysOnTop();
+    static void         invalidateWindowIndex();
+    static void         updateWindowIndex();
 
     // Data members
     FWidget*            win_focus_widget{nullptr};
     FRect               normalGeometry{};
     static FWindow*     previous_window;
+    static FHitTestIndex window_index;
+    static std::vector<FWindow*> moved_windows;
     bool                window_active{false};
     bool                zoomed{false};
 };
@@ -178,6 +185,10 @@ void closeDropDown (const FWidget*, const FPoint&);
 inline FString FWindow::getClassName() const
 { return "FWindow"; }
 
+//----------------------------------------------------------------------
+constexpr auto FWindow::getClassTypeId() -> FTypeId
+{ return makeTypeId("FWindow"); }
+
 //----------------------------------------------------------------------
 inline bool FWindow::unsetWindowWidget()
 { return setWindowWidget(false); }
@@ -226,6 +237,10 @@ inline bool FWindow::hasTransparentShadow() const
 inline bool FWindow::hasShadow() const
 { return getFlags().shadow; }
 
+//----------------------------------------------------------------------
+inline bool FWindow::isKindOf (FTypeId id) const
+{ return id == getClassTypeId() || FWidget::isKindOf(id); }
+
 //----------------------------------------------------------------------
 inline FWindow* FWindow::getWindowWidgetAt (const FPoint& pos)
 { return getWindowWidgetAt (pos.getX(), pos.getY()); }
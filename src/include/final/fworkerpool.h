@@ -0,0 +1,116 @@
+/***********************************************************************
+* fworkerpool.h - Runs indexed tasks on a pool of threads              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FWorkerPool ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/* A fork-join pool of persistent worker threads. run() hands out the
+ * task indices 0 … count - 1 to the workers and to the calling thread
+ * and returns when all tasks are done. Each index is processed exactly
+ * once, in no particular order. A pool with one thread runs all tasks
+ * in the calling thread.
+ */
+
+#ifndef FWORKERPOOL_H
+#define FWORKERPOOL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWorkerPool
+//----------------------------------------------------------------------
+
+class FWorkerPool final
+{
+  public:
+    // Using-declaration
+    using Task = std::function<void(std::size_t)>;
+
+    // Constructor
+    explicit FWorkerPool (std::size_t = 0);
+
+    // Disable copy constructor
+    FWorkerPool (const FWorkerPool&) = delete;
+
+    // Destructor
+    ~FWorkerPool() noexcept;
+
+    // Disable copy assignment operator (=)
+    FWorkerPool& operator = (const FWorkerPool&) = delete;
+
+    // Accessors
+    FString             getClassName() const;
+    std::size_t         getThreadCount() const;
+
+    // Methods
+    void                run (std::size_t, const Task&);
+
+  private:
+    // Methods
+    void                workerLoop();
+    void                runTasks();
+
+    // Data members
+    std::vector<std::thread> workers{};
+    const Task*              task{nullptr};
+    std::size_t              task_count{0};
+    std::atomic<std::size_t> next_task{0};
+    std::size_t              busy_workers{0};
+    uInt64                   generation{0};
+    bool                     stop_workers{false};
+    std::mutex               pool_mutex{};
+    std::condition_variable  start_cond{};
+    std::condition_variable  done_cond{};
+};
+
+// FWorkerPool inline functions
+//----------------------------------------------------------------------
+inline FString FWorkerPool::getClassName() const
+{ return "FWorkerPool"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FWorkerPool::getThreadCount() const
+{ return workers.size() + 1; }
+
+}  // namespace finalcut
+
+#endif  // FWORKERPOOL_H
@@ -787,7 +787,7 @@ inline const char* ConEmu::getSEC_DA (console con)
   static const char* SEC_DA[] =
   {
     0,                            // Ansi,
-    C_STR("\033[>19;312;0c"),     // XTerm
+    C_STR("\033[>41;312;0c"),     // XTerm
     C_STR("\033[>82;20710;0c"),   // Rxvt
     C_STR("\033[>85;95;0c"),      // Urxvt
     C_STR("\033[>0;115;0c"),      // KDE Konsole
@@ -899,7 +899,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( DECID )
         write (fd_master, DECID, std::strlen(DECID));
 
-      i += 2;
+      i += 1;
     }
     else if ( i < length - 3  // Device status report (DSR)
            && buffer[i] == '\033'
@@ -912,7 +912,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( DSR )
         write (fd_master, DSR, std::strlen(DSR));
 
-      i += 4;
+      i += 3;
     }
     else if ( i < length - 3  // Report cursor position (CPR)
            && buffer[i] == '\033'
@@ -921,7 +921,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
            && buffer[i + 3] == 'n' )
     {
       write (fd_master, "\033[25;80R", 8);  // row 25 ; column 80
-      i += 4;
+      i += 3;
     }
     else if ( i < length - 2  // Device attributes (DA)
            && buffer[i] == '\033'
@@ -933,7 +933,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( DA )
         write (fd_master, DA, std::strlen(DA));
 
-      i += 3;
+      i += 2;
     }
     else if ( i < length - 3  // Device attributes (DA1)
            && buffer[i] == '\033'
@@ -945,7 +945,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
 
       if ( DA1 )
         write (fd_master, DA1, std::strlen(DA1));
-      i += 4;
+      i += 3;
     }
     else if ( i < length - 3  // Secondary device attributes (SEC_DA)
            && buffer[i] == '\033'
@@ -958,7 +958,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( SEC_DA )
         write (fd_master, SEC_DA, std::strlen(SEC_DA));
 
-      i += 4;
+      i += 3;
     }
     else if ( i < length - 4  // Report xterm window's title
            && buffer[i] == '\033'
@@ -989,7 +989,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
              && con != mlterm )
         write (fd_master, "\033]lTITLE\033\\", 10);
 
-      i += 5;
+      i += 4;
     }
     else if ( i < length - 7  // Get xterm color name 0-9
            && buffer[i] == '\033'
@@ -1024,7 +1024,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
         write (fd_master, "\a", 1);
       }
 
-      i += 8;
+      i += 7;
     }
     else if ( i < length - 8  // Get xterm color name 0-9
            && buffer[i] == '\033'
@@ -1062,7 +1062,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
         write (fd_master, "\a", 1);
       }
 
-      i += 9;
+      i += 8;
     }
     else if ( i < length - 9  // Get xterm color name 0-9
            && buffer[i] == '\033'
@@ -1107,7 +1107,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
         }
       }
 
-      i += 10;
+      i += 9;
     }
     else
     {
@@ -0,0 +1,210 @@
+/***********************************************************************
+* fapplication-test.cpp - FApplication unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 agent                                                 *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <array>
+#include <csignal>
+#include <functional>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class CountingDialog
+//----------------------------------------------------------------------
+
+class CountingDialog final : public finalcut::FDialog
+{
+  public:
+    // Using-declaration
+    using finalcut::FDialog::FDialog;
+
+    // Data member
+    int draw_count{0};
+
+  private:
+    // Method
+    void draw() override
+    {
+      draw_count++;
+      finalcut::FDialog::draw();
+    }
+};
+
+
+//----------------------------------------------------------------------
+// class ScenarioApplication
+//----------------------------------------------------------------------
+
+class ScenarioApplication final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Data members
+    std::function<void(int)> scenario{};
+    int resize_count{0};
+
+  private:
+    // Methods
+    void processExternalUserEvent() override
+    {
+      // Called once per pass of the event loop
+      finalcut::FHeadlessTerminal::advanceClock (20000);  // 20 ms
+      step++;
+
+      if ( scenario )
+        scenario(step);
+    }
+
+    void onResize (finalcut::FResizeEvent* ev) override
+    {
+      resize_count++;
+      finalcut::FApplication::onResize(ev);
+    }
+
+    // Data member
+    int step{0};
+};
+
+
+//----------------------------------------------------------------------
+// class FApplicationTest
+//----------------------------------------------------------------------
+
+class FApplicationTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FApplicationTest() = default;
+
+  protected:
+    void resizeTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FApplicationTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (resizeTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FApplicationTest::resizeTest()
+{
+  using finalcut::FPoint;
+  using finalcut::FSize;
+  auto& terminal = finalcut::FHeadlessTerminal::install \
+      (finalcut::FHeadlessTerminal::Profile::Xterm256color, FSize{50, 16});
+  finalcut::FHeadlessTerminal::setClock();
+  char arg0[] = "fapplication-test";
+  char* argv[] = { arg0, nullptr };
+  std::array<int, 3> resizes{};
+  std::array<int, 3> draws{};
+  std::array<bool, 3> equal{};
+  FSize desktop_size{};
+
+  {
+    ScenarioApplication app{1, argv};
+    finalcut::FWidget main_widget{&app};
+    CountingDialog dialog{"Resize", &main_widget};
+    dialog.setGeometry (FPoint{5, 3}, FSize{30, 8});
+    finalcut::FWidget::setMainWidget (&main_widget);
+    main_widget.show();
+
+    const auto check = [&] (std::size_t n)
+    {
+      resizes[n] = app.resize_count;
+      draws[n] = dialog.draw_count;
+      equal[n] = terminal.isVTermEqual();
+      app.resize_count = 0;
+      dialog.draw_count = 0;
+    };
+
+    app.scenario = [&] (int step)
+    {
+      if ( step == 10 )
+      {
+        check(0);
+
+        // Three size changes within one frame
+        terminal.setSize (FSize{60, 20});
+        terminal.setSize (FSize{70, 22});
+        terminal.setSize (FSize{64, 18});
+      }
+      else if ( step == 20 )
+      {
+        check(1);
+        desktop_size = FSize{ main_widget.getDesktopWidth()
+                            , main_widget.getDesktopHeight() };
+
+        // Resize signals without a size change
+        std::raise (SIGWINCH);
+        std::raise (SIGWINCH);
+        std::raise (SIGWINCH);
+      }
+      else if ( step == 50 )
+      {
+        // The flush interval grows after the screen was cleared,
+        // so the repaint is checked after the 400 ms reset
+        check(2);
+        app.quit();
+      }
+    };
+
+    app.exec();
+  }
+
+  finalcut::FObject::unsetFixedTime();
+
+  // No resize before the first check
+  CPPUNIT_ASSERT ( resizes[0] == 0 );
+  CPPUNIT_ASSERT ( equal[0] );
+
+  // The size changes of one frame lead to one relayout
+  CPPUNIT_ASSERT ( resizes[1] == 1 );
+  CPPUNIT_ASSERT ( desktop_size == FSize(64, 18) );
+  CPPUNIT_ASSERT ( equal[1] );
+
+  // The unchanged dialog is not repainted for a new size
+  CPPUNIT_ASSERT ( draws[1] == 0 );
+
+  // An unchanged size repaints everything once
+  CPPUNIT_ASSERT ( resizes[2] == 1 );
+  CPPUNIT_ASSERT ( draws[2] == 1 );
+  CPPUNIT_ASSERT ( equal[2] );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FApplicationTest);
+
+// The general unit test main part
+#include <main-test.inc>
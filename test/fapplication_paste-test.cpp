@@ -0,0 +1,203 @@
+/***********************************************************************
+* fapplication_paste-test.cpp - FApplication paste unit tests          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 agent                                                 *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <cwctype>
+#include <functional>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class KeyWidget
+//----------------------------------------------------------------------
+
+class KeyWidget final : public finalcut::FWidget
+{
+  public:
+    // Constructor
+    explicit KeyWidget (finalcut::FWidget* parent = nullptr)
+      : finalcut::FWidget{parent}
+    {
+      setFocusable();
+    }
+
+    // Event handlers
+    void onKeyDown (finalcut::FKeyEvent*) override
+    {
+      key_down_count++;
+    }
+
+    void onKeyPress (finalcut::FKeyEvent* ev) override
+    {
+      // Accepts only letters
+      const auto ch = wchar_t(ev->key());
+
+      if ( std::iswalpha(wint_t(ch)) )
+      {
+        keys += ch;
+        ev->accept();
+      }
+    }
+
+    void onAccel (finalcut::FAccelEvent* ev) override
+    {
+      accel_count++;
+      ev->accept();
+    }
+
+    // Data members
+    finalcut::FString keys{};
+    int key_down_count{0};
+    int accel_count{0};
+};
+
+
+//----------------------------------------------------------------------
+// class ScenarioApplication
+//----------------------------------------------------------------------
+
+class ScenarioApplication final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Data member
+    std::function<void(int)> scenario{};
+
+  private:
+    // Method
+    void processExternalUserEvent() override
+    {
+      // Called once per pass of the event loop
+      finalcut::FHeadlessTerminal::advanceClock (20000);  // 20 ms
+      step++;
+
+      if ( scenario )
+        scenario(step);
+    }
+
+    // Data member
+    int step{0};
+};
+
+
+//----------------------------------------------------------------------
+// class FApplicationPasteTest
+//----------------------------------------------------------------------
+
+class FApplicationPasteTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FApplicationPasteTest() = default;
+
+  protected:
+    void pasteTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FApplicationPasteTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (pasteTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FApplicationPasteTest::pasteTest()
+{
+  // Pasted text for a widget without a paste handler
+
+  using finalcut::FPoint;
+  using finalcut::FSize;
+  auto& terminal = finalcut::FHeadlessTerminal::install \
+      (finalcut::FHeadlessTerminal::Profile::Xterm256color, FSize{50, 16});
+  finalcut::FHeadlessTerminal::setClock();
+  char arg0[] = "fapplication_paste-test";
+  char* argv[] = { arg0, nullptr };
+  finalcut::FString first_keys{};
+  finalcut::FString second_keys{};
+  int first_key_downs{0};
+  int second_key_downs{0};
+  int accel_count{0};
+
+  {
+    ScenarioApplication app{1, argv};
+    finalcut::FWidget main_widget{&app};
+    finalcut::FDialog dialog{"Paste", &main_widget};
+    dialog.setGeometry (FPoint{5, 3}, FSize{30, 8});
+    KeyWidget first{&dialog};
+    first.setGeometry (FPoint{2, 1}, FSize{10, 1});
+    KeyWidget second{&dialog};
+    second.setGeometry (FPoint{2, 3}, FSize{10, 1});
+    dialog.addAccelerator (finalcut::FKey('!'), &second);
+    finalcut::FWidget::setMainWidget (&main_widget);
+    main_widget.show();
+    first.setFocus();
+
+    app.scenario = [&] (int step)
+    {
+      if ( step == 10 )
+      {
+        terminal.sendInput ("\033[200~ab\tcd!\033[201~");
+      }
+      else if ( step == 20 )
+      {
+        first_keys = first.keys;
+        second_keys = second.keys;
+        first_key_downs = first.key_down_count;
+        second_key_downs = second.key_down_count;
+        accel_count = second.accel_count;
+        app.quit();
+      }
+    };
+
+    app.exec();
+  }
+
+  finalcut::FObject::unsetFixedTime();
+
+  // Each character is handled like a typed key,
+  // the tab moves the focus to the second widget
+  CPPUNIT_ASSERT ( first_keys == "ab" );
+  CPPUNIT_ASSERT ( second_keys == "cd" );
+  CPPUNIT_ASSERT ( first_key_downs == 3 );
+  CPPUNIT_ASSERT ( second_key_downs == 3 );
+
+  // The unprocessed character triggers the keyboard accelerator
+  CPPUNIT_ASSERT ( accel_count == 1 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FApplicationPasteTest);
+
+// The general unit test main part
+#include <main-test.inc>
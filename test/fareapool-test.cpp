@@ -0,0 +1,167 @@
+/***********************************************************************
+* fareapool-test.cpp - FAreaPool unit tests                            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstring>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FAreaPoolTest
+//----------------------------------------------------------------------
+
+class FAreaPoolTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FAreaPoolTest() = default;
+
+  protected:
+    void classNameTest();
+    void blockSizeTest();
+    void recycleTest();
+    void limitTest();
+    void hugeBlockTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FAreaPoolTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (blockSizeTest);
+    CPPUNIT_TEST (recycleTest);
+    CPPUNIT_TEST (limitTest);
+    CPPUNIT_TEST (hugeBlockTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FAreaPoolTest::classNameTest()
+{
+  const finalcut::FAreaPool pool;
+  const finalcut::FString& classname = pool.getClassName();
+  CPPUNIT_ASSERT ( classname == "FAreaPool" );
+  CPPUNIT_ASSERT ( pool.getFreeBlockCount() == 0 );
+  CPPUNIT_ASSERT ( pool.getFreeBytes() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FAreaPoolTest::blockSizeTest()
+{
+  using finalcut::FAreaPool;
+  CPPUNIT_ASSERT ( FAreaPool::getBlockSize(0) == 256 );
+  CPPUNIT_ASSERT ( FAreaPool::getBlockSize(1) == 256 );
+  CPPUNIT_ASSERT ( FAreaPool::getBlockSize(256) == 256 );
+  CPPUNIT_ASSERT ( FAreaPool::getBlockSize(257) == 512 );
+  CPPUNIT_ASSERT ( FAreaPool::getBlockSize(5000) == 8192 );
+  CPPUNIT_ASSERT ( FAreaPool::getBlockSize(65536) == 65536 );
+}
+
+//----------------------------------------------------------------------
+void FAreaPoolTest::recycleTest()
+{
+  finalcut::FAreaPool pool;
+  std::size_t block_size{0};
+  void* block = pool.allocate(1000, block_size);
+  CPPUNIT_ASSERT ( block != nullptr );
+  CPPUNIT_ASSERT ( block_size == 1024 );
+  std::memset (block, 0x55, block_size);  // The whole block is usable
+
+  pool.deallocate (block, block_size);
+  CPPUNIT_ASSERT ( pool.getFreeBlockCount() == 1 );
+  CPPUNIT_ASSERT ( pool.getFreeBytes() == 1024 );
+
+  // A request of the same size class gets the released block
+  std::size_t second_size{0};
+  void* second = pool.allocate(600, second_size);
+  CPPUNIT_ASSERT ( second == block );
+  CPPUNIT_ASSERT ( second_size == 1024 );
+  CPPUNIT_ASSERT ( pool.getFreeBlockCount() == 0 );
+
+  // Other size classes get a new block
+  std::size_t third_size{0};
+  void* third = pool.allocate(3000, third_size);
+  CPPUNIT_ASSERT ( third != second );
+  CPPUNIT_ASSERT ( third_size == 4096 );
+
+  pool.deallocate (second, second_size);
+  pool.deallocate (third, third_size);
+  pool.deallocate (nullptr, 0);
+  CPPUNIT_ASSERT ( pool.getFreeBlockCount() == 2 );
+  CPPUNIT_ASSERT ( pool.getFreeBytes() == 5120 );
+
+  pool.clear();
+  CPPUNIT_ASSERT ( pool.getFreeBlockCount() == 0 );
+  CPPUNIT_ASSERT ( pool.getFreeBytes() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FAreaPoolTest::limitTest()
+{
+  finalcut::FAreaPool pool;
+  std::vector<void*> blocks{};
+  std::size_t block_size{0};
+
+  for (int i{0}; i < 10; i++)
+    blocks.push_back (pool.allocate(300, block_size));
+
+  for (auto&& block : blocks)
+    pool.deallocate (block, block_size);
+
+  // Only a few blocks per size class are kept
+  CPPUNIT_ASSERT ( pool.getFreeBlockCount() == 4 );
+  CPPUNIT_ASSERT ( pool.getFreeBytes() == 4 * 512 );
+}
+
+//----------------------------------------------------------------------
+void FAreaPoolTest::hugeBlockTest()
+{
+  finalcut::FAreaPool pool;
+  std::size_t block_size{0};
+  void* block = pool.allocate(3 * 1024 * 1024, block_size);
+  CPPUNIT_ASSERT ( block != nullptr );
+  CPPUNIT_ASSERT ( block_size == 4 * 1024 * 1024 );
+  // Huge page alignment
+  CPPUNIT_ASSERT ( reinterpret_cast<uintptr_t>(block) % (2 * 1024 * 1024) == 0 );
+  std::memset (block, 0, block_size);
+  pool.deallocate (block, block_size);
+  CPPUNIT_ASSERT ( pool.getFreeBlockCount() == 1 );
+
+  std::size_t second_size{0};
+  CPPUNIT_ASSERT ( pool.allocate(4 * 1024 * 1024, second_size) == block );
+  pool.deallocate (block, second_size);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FAreaPoolTest);
+
+// The general unit test main part
+#include <main-test.inc>
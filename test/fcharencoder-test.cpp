@@ -0,0 +1,244 @@
+/***********************************************************************
+* fcharencoder-test.cpp - FCharEncoder unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+wchar_t charEncode (wchar_t c, finalcut::Encoding enc)
+{
+  // Reference implementation with a linear search
+
+  wchar_t ch_enc = c;
+
+  for (auto&& entry : finalcut::fc::character)
+  {
+    if ( entry.unicode == c )
+    {
+      ch_enc = finalcut::fc::getCharacter(entry, enc);
+      break;
+    }
+  }
+
+  if ( enc == finalcut::Encoding::PC && ch_enc == c )
+    ch_enc = finalcut::unicode_to_cp437(c);
+
+  return ch_enc;
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FCharEncoderTest
+//----------------------------------------------------------------------
+
+class FCharEncoderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FCharEncoderTest() = default;
+
+  protected:
+    void classNameTest();
+    void encodeTest();
+    void outputCharTest();
+    void substitutionTest();
+    void invalidateTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FCharEncoderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (encodeTest);
+    CPPUNIT_TEST (outputCharTest);
+    CPPUNIT_TEST (substitutionTest);
+    CPPUNIT_TEST (invalidateTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FCharEncoderTest::classNameTest()
+{
+  const finalcut::FCharEncoder encoder;
+  const finalcut::FString& classname = encoder.getClassName();
+  CPPUNIT_ASSERT ( classname == "FCharEncoder" );
+}
+
+//----------------------------------------------------------------------
+void FCharEncoderTest::encodeTest()
+{
+  // Compare the tables with the linear search
+  finalcut::FCharEncoder encoder;
+  const std::vector<finalcut::Encoding> encodings
+  {
+    finalcut::Encoding::UTF8,
+    finalcut::Encoding::VT100,
+    finalcut::Encoding::PC,
+    finalcut::Encoding::ASCII
+  };
+  std::vector<wchar_t> chars{};
+
+  for (wchar_t ch{0}; ch < 0x3000; ch++)
+    chars.push_back(ch);
+
+  for (auto&& entry : finalcut::fc::character)
+    chars.push_back(entry.unicode);
+
+  chars.push_back(L'ｱ');  // Halfwidth katakana
+  chars.push_back(L'🙂');  // Outside the BMP
+
+  for (auto&& enc : encodings)
+    for (auto&& ch : chars)
+      CPPUNIT_ASSERT ( encoder.encode(ch, enc) == test::charEncode(ch, enc) );
+
+  // Unknown encodings leave the character unchanged
+  CPPUNIT_ASSERT ( encoder.encode(L'┌', finalcut::Encoding::Unknown) == L'┌' );
+}
+
+//----------------------------------------------------------------------
+void FCharEncoderTest::outputCharTest()
+{
+  finalcut::FCharEncoder encoder;
+
+  // UTF-8
+  auto out = encoder.getOutputChar(L'┌', finalcut::Encoding::UTF8);
+  CPPUNIT_ASSERT ( out.encoded == L'┌' );
+  CPPUNIT_ASSERT ( out.output == L'┌' );
+  CPPUNIT_ASSERT ( ! out.alt_charset );
+  CPPUNIT_ASSERT ( ! out.pc_charset );
+
+  // VT100 line drawing
+  out = encoder.getOutputChar(L'┌', finalcut::Encoding::VT100);
+  CPPUNIT_ASSERT ( out.encoded == L'l' );
+  CPPUNIT_ASSERT ( out.output == L'l' );
+  CPPUNIT_ASSERT ( out.alt_charset );
+  CPPUNIT_ASSERT ( ! out.pc_charset );
+
+  // Plain ASCII characters remain unchanged
+  out = encoder.getOutputChar(L'A', finalcut::Encoding::VT100);
+  CPPUNIT_ASSERT ( out.encoded == L'A' );
+  CPPUNIT_ASSERT ( ! out.alt_charset );
+
+  // VT100 without a character uses the ASCII fallback
+  out = encoder.getOutputChar(L'▌', finalcut::Encoding::VT100);
+  CPPUNIT_ASSERT ( out.encoded == L' ' );
+  CPPUNIT_ASSERT ( ! out.alt_charset );
+
+  // PC charset
+  out = encoder.getOutputChar(L'┌', finalcut::Encoding::PC);
+  CPPUNIT_ASSERT ( out.encoded == 0xda );
+  CPPUNIT_ASSERT ( out.output == 0xda );
+  CPPUNIT_ASSERT ( ! out.alt_charset );
+  CPPUNIT_ASSERT ( out.pc_charset );
+
+  out = encoder.getOutputChar(L'ｱ', finalcut::Encoding::PC);
+  CPPUNIT_ASSERT ( out.encoded == L'?' );
+  CPPUNIT_ASSERT ( out.pc_charset );
+
+  // ASCII
+  out = encoder.getOutputChar(L'┌', finalcut::Encoding::ASCII);
+  CPPUNIT_ASSERT ( out.encoded == L'.' );
+  CPPUNIT_ASSERT ( ! out.alt_charset );
+  CPPUNIT_ASSERT ( ! out.pc_charset );
+
+  // Characters outside the table
+  out = encoder.getOutputChar(L'🙂', finalcut::Encoding::ASCII);
+  CPPUNIT_ASSERT ( out.encoded == L'🙂' );
+  CPPUNIT_ASSERT ( out.output == L'🙂' );
+}
+
+//----------------------------------------------------------------------
+void FCharEncoderTest::substitutionTest()
+{
+  finalcut::FCharEncoder encoder;
+  const auto& data = finalcut::FTerm::getFTermData();
+  auto& sub_map = data->getCharSubstitutionMap();
+  const auto saved_map = sub_map;
+  sub_map[L'l'] = L'+';
+  sub_map[L'🙂'] = L':';
+  encoder.invalidate();
+
+  // The substitution uses the encoded character
+  auto out = encoder.getOutputChar(L'┌', finalcut::Encoding::VT100);
+  CPPUNIT_ASSERT ( out.encoded == L'l' );
+  CPPUNIT_ASSERT ( out.output == L'+' );
+  CPPUNIT_ASSERT ( out.alt_charset );
+
+  out = encoder.getOutputChar(L'l', finalcut::Encoding::UTF8);
+  CPPUNIT_ASSERT ( out.encoded == L'l' );
+  CPPUNIT_ASSERT ( out.output == L'+' );
+
+  out = encoder.getOutputChar(L'🙂', finalcut::Encoding::UTF8);
+  CPPUNIT_ASSERT ( out.encoded == L'🙂' );
+  CPPUNIT_ASSERT ( out.output == L':' );
+
+  sub_map = saved_map;
+  encoder.invalidate();
+  out = encoder.getOutputChar(L'┌', finalcut::Encoding::VT100);
+  CPPUNIT_ASSERT ( out.output == L'l' );
+}
+
+//----------------------------------------------------------------------
+void FCharEncoderTest::invalidateTest()
+{
+  finalcut::FCharEncoder encoder;
+  auto iter = finalcut::fc::character.begin();
+
+  while ( iter->unicode != L'┌' )
+    ++iter;
+
+  const auto saved_entry = *iter;
+  CPPUNIT_ASSERT ( encoder.encode(L'┌', finalcut::Encoding::PC) == 0xda );
+  CPPUNIT_ASSERT ( encoder.getOutputChar(L'┌', finalcut::Encoding::PC).encoded == 0xda );
+
+  // The tables keep the old value until they are invalidated
+  iter->pc = L'+';
+  CPPUNIT_ASSERT ( encoder.encode(L'┌', finalcut::Encoding::PC) == 0xda );
+  encoder.invalidate();
+  CPPUNIT_ASSERT ( encoder.encode(L'┌', finalcut::Encoding::PC) == L'+' );
+  CPPUNIT_ASSERT ( encoder.getOutputChar(L'┌', finalcut::Encoding::PC).encoded == L'+' );
+
+  *iter = saved_entry;
+  encoder.invalidate();
+  CPPUNIT_ASSERT ( encoder.encode(L'┌', finalcut::Encoding::PC) == 0xda );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FCharEncoderTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,239 @@
+/***********************************************************************
+* fcolorquantizer-test.cpp - FColorQuantizer unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FColorQuantizerTest
+//----------------------------------------------------------------------
+
+class FColorQuantizerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FColorQuantizerTest() = default;
+
+  protected:
+    void classNameTest();
+    void paletteTest();
+    void findPaletteColorTest();
+    void quantizeTest();
+    void grayTest();
+    void colorCountTest();
+    void ditherTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FColorQuantizerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (paletteTest);
+    CPPUNIT_TEST (findPaletteColorTest);
+    CPPUNIT_TEST (quantizeTest);
+    CPPUNIT_TEST (grayTest);
+    CPPUNIT_TEST (colorCountTest);
+    CPPUNIT_TEST (ditherTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::classNameTest()
+{
+  const finalcut::FColorQuantizer quantizer;
+  const finalcut::FString& classname = quantizer.getClassName();
+  CPPUNIT_ASSERT ( classname == "FColorQuantizer" );
+  CPPUNIT_ASSERT ( quantizer.getColorCount() == 256 );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::paletteTest()
+{
+  using finalcut::FColor;
+  using finalcut::FColorQuantizer;
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::Black) == 0x000000 );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::Blue) == 0x0000aa );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::Brown) == 0xaa5500 );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::White) == 0xffffff );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::Grey0) == 0x000000 );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::SteelBlue) == 0x5f87af );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::Grey93) == 0xeeeeee );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor(232)) == 0x080808 );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor(231)) == 0xffffff );
+  CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(FColor::Default) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::findPaletteColorTest()
+{
+  using finalcut::FColor;
+  using finalcut::FColorQuantizer;
+  FColor color{FColor::Undefined};
+
+  // Every color of the 256-color palette is found again
+  for (uInt16 index{16}; index < 256; index++)
+  {
+    const auto rgb = FColorQuantizer::getPaletteRGB(FColor(index));
+    CPPUNIT_ASSERT ( FColorQuantizer::findPaletteColor(rgb, color) );
+    CPPUNIT_ASSERT ( FColorQuantizer::getPaletteRGB(color) == rgb );
+  }
+
+  CPPUNIT_ASSERT ( FColorQuantizer::findPaletteColor(0x5f87af, color) );
+  CPPUNIT_ASSERT ( color == FColor(67) );
+  CPPUNIT_ASSERT ( FColorQuantizer::findPaletteColor(0x121212, color) );
+  CPPUNIT_ASSERT ( color == FColor(233) );
+  color = FColor::Undefined;
+  CPPUNIT_ASSERT ( ! FColorQuantizer::findPaletteColor(0x123456, color) );
+  CPPUNIT_ASSERT ( ! FColorQuantizer::findPaletteColor(0x5f87ae, color) );
+  CPPUNIT_ASSERT ( ! FColorQuantizer::findPaletteColor(0x131313, color) );
+  CPPUNIT_ASSERT ( color == FColor::Undefined );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::quantizeTest()
+{
+  using finalcut::FColor;
+  finalcut::FColorQuantizer quantizer;
+  CPPUNIT_ASSERT ( quantizer.quantize(0x000000) == FColor(16) );
+  CPPUNIT_ASSERT ( quantizer.quantize(0xffffff) == FColor(231) );
+  CPPUNIT_ASSERT ( quantizer.quantize(0xff0000) == FColor(196) );
+  CPPUNIT_ASSERT ( quantizer.quantize(0x123456) == FColor(237) );
+  CPPUNIT_ASSERT ( quantizer.quantize(0x80, 0x80, 0x80) == FColor(102) );
+
+  // Colors of the same cube cell share the result
+  CPPUNIT_ASSERT ( quantizer.quantize(0x101010) == quantizer.quantize(0x171717) );
+  CPPUNIT_ASSERT ( quantizer.quantize(0x6080a8) == quantizer.quantize(0x6787af) );
+
+  // A quantized palette color is never far from the original
+  for (uInt16 index{16}; index < 256; index++)
+  {
+    const auto rgb = finalcut::FColorQuantizer::getPaletteRGB(FColor(index));
+    const auto color = quantizer.quantize(rgb);
+    const auto result = finalcut::FColorQuantizer::getPaletteRGB(color);
+    CPPUNIT_ASSERT ( color >= FColor(16) && color <= FColor(255) );
+
+    for (int shift{0}; shift < 24; shift += 8)
+    {
+      const int diff = int((rgb >> shift) & 0xff)
+                     - int((result >> shift) & 0xff);
+      CPPUNIT_ASSERT ( diff >= -8 && diff <= 8 );
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::grayTest()
+{
+  // FVTerm::rgb2ColorIndex() takes an exact palette color first and
+  // the quantized color otherwise, so that grays are mapped to the
+  // grayscale ramp (232...255) and not only to the color cube
+
+  using finalcut::FColor;
+  finalcut::FColorQuantizer quantizer;
+  FColor color{FColor::Undefined};
+
+  for (uInt32 i{0}; i < 24; i++)
+  {
+    const uInt32 level = 8 + i * 10;
+    const uInt32 gray = (level << 16) | (level << 8) | level;
+    CPPUNIT_ASSERT ( finalcut::FColorQuantizer::findPaletteColor(gray, color) );
+    CPPUNIT_ASSERT ( color == FColor(232 + i) );
+  }
+
+  // Grays between two ramp entries
+  CPPUNIT_ASSERT ( quantizer.quantize(0x9a9a9a) == FColor(247) );
+  CPPUNIT_ASSERT ( quantizer.quantize(0x2a2a2a) == FColor(236) );
+
+  // The cube gray 0x878787 is nearer to the cell of 0x808080
+  CPPUNIT_ASSERT ( quantizer.quantize(0x808080) == FColor(102) );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::colorCountTest()
+{
+  using finalcut::FColor;
+  finalcut::FColorQuantizer quantizer{16};
+  CPPUNIT_ASSERT ( quantizer.getColorCount() == 16 );
+  CPPUNIT_ASSERT ( quantizer.quantize(0x000000) == FColor::Black );
+  CPPUNIT_ASSERT ( quantizer.quantize(0xffffff) == FColor::White );
+  CPPUNIT_ASSERT ( quantizer.quantize(0xff0000) == FColor::Red );
+  CPPUNIT_ASSERT ( quantizer.quantize(0xff6060) == FColor::LightRed );
+  CPPUNIT_ASSERT ( quantizer.quantize(0x0000a0) == FColor::Blue );
+
+  // Changing the color count discards the cached results
+  quantizer.setColorCount(8);
+  CPPUNIT_ASSERT ( quantizer.getColorCount() == 8 );
+  CPPUNIT_ASSERT ( quantizer.quantize(0xffffff) == FColor::LightGray );
+  CPPUNIT_ASSERT ( quantizer.quantize(0xff2020) == FColor::Red );
+
+  quantizer.setColorCount(256);
+  CPPUNIT_ASSERT ( quantizer.quantize(0xffffff) == FColor(231) );
+}
+
+//----------------------------------------------------------------------
+void FColorQuantizerTest::ditherTest()
+{
+  using finalcut::FColor;
+  finalcut::FColorQuantizer quantizer{16};
+  CPPUNIT_ASSERT ( quantizer.dither({0x000000}, 0).empty() );
+
+  // A palette color remains unchanged
+  const std::vector<uInt32> blue_block(40, 0x0000aa);
+  const auto blue = quantizer.dither(blue_block, 8);
+  CPPUNIT_ASSERT ( blue.size() == 40 );
+  CPPUNIT_ASSERT ( std::count(blue.begin(), blue.end(), FColor::Blue) == 40 );
+
+  // A medium gray between black and dark gray is mixed from both
+  const std::vector<uInt32> gray_block(100, 0x2a2a2a);
+  const auto gray = quantizer.dither(gray_block, 10);
+  CPPUNIT_ASSERT ( gray.size() == 100 );
+  const auto black_count = std::count(gray.begin(), gray.end(), FColor::Black);
+  const auto dark_count = std::count(gray.begin(), gray.end(), FColor::DarkGray);
+  CPPUNIT_ASSERT ( black_count + dark_count == 100 );
+  CPPUNIT_ASSERT ( black_count >= 40 && black_count <= 60 );
+
+  // Without dithering, the whole block gets one color
+  const auto plain = quantizer.quantize(0x2a2a2a);
+  CPPUNIT_ASSERT ( plain == FColor::Black || plain == FColor::DarkGray );
+
+  // An incomplete last row is also dithered
+  const std::vector<uInt32> row_block(15, 0x2a2a2a);
+  CPPUNIT_ASSERT ( quantizer.dither(row_block, 10).size() == 15 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FColorQuantizerTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,296 @@
+/***********************************************************************
+* fdamageregion-test.cpp - FDamageRegion unit tests                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <array>
+#include <functional>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class CountingWidget
+//----------------------------------------------------------------------
+
+class CountingWidget final : public finalcut::FWidget
+{
+  public:
+    // Using-declaration
+    using finalcut::FWidget::FWidget;
+
+    // Data member
+    int draw_count{0};
+
+  private:
+    // Method
+    void draw() override
+    {
+      draw_count++;
+    }
+};
+
+
+//----------------------------------------------------------------------
+// class DamageApplication
+//----------------------------------------------------------------------
+
+class DamageApplication final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Data member
+    std::function<void(int)> scenario{};
+
+  private:
+    // Method
+    void processExternalUserEvent() override
+    {
+      // Called once per pass of the event loop
+      finalcut::FHeadlessTerminal::advanceClock (20000);  // 20 ms
+      step++;
+
+      if ( scenario )
+        scenario(step);
+    }
+
+    // Data member
+    int step{0};
+};
+
+
+//----------------------------------------------------------------------
+// class FDamageRegionTest
+//----------------------------------------------------------------------
+
+class FDamageRegionTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FDamageRegionTest() = default;
+
+  protected:
+    void classNameTest();
+    void addTest();
+    void mergeTest();
+    void clearTest();
+    void paintTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FDamageRegionTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (addTest);
+    CPPUNIT_TEST (mergeTest);
+    CPPUNIT_TEST (clearTest);
+    CPPUNIT_TEST (paintTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FDamageRegionTest::classNameTest()
+{
+  const finalcut::FDamageRegion damage;
+  const finalcut::FString& classname = damage.getClassName();
+  CPPUNIT_ASSERT ( classname == "FDamageRegion" );
+  CPPUNIT_ASSERT ( damage.isEmpty() );
+  CPPUNIT_ASSERT ( damage.getCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FDamageRegionTest::addTest()
+{
+  using finalcut::FRect;
+  finalcut::FDamageRegion damage;
+
+  // Empty rectangles are ignored
+  damage.add (FRect{});
+  damage.add (FRect{5, 5, 0, 3});
+  damage.add (FRect{1, 1, 4, 4}.intersect(FRect{10, 10, 2, 2}));
+  CPPUNIT_ASSERT ( damage.isEmpty() );
+
+  damage.add (FRect{1, 1, 10, 5});
+  CPPUNIT_ASSERT ( damage.getCount() == 1 );
+
+  // A rectangle inside an existing one adds nothing
+  damage.add (FRect{2, 2, 3, 3});
+  CPPUNIT_ASSERT ( damage.getCount() == 1 );
+
+  damage.add (FRect{20, 20, 2, 2});
+  CPPUNIT_ASSERT ( damage.getCount() == 2 );
+
+  // A covering rectangle replaces the covered ones
+  damage.add (FRect{1, 1, 30, 30});
+  CPPUNIT_ASSERT ( damage.getCount() == 1 );
+  CPPUNIT_ASSERT ( damage.getRects()[0] == FRect(1, 1, 30, 30) );
+}
+
+//----------------------------------------------------------------------
+void FDamageRegionTest::mergeTest()
+{
+  using finalcut::FRect;
+  finalcut::FDamageRegion damage;
+
+  // Overlapping rectangles
+  damage.add (FRect{1, 1, 10, 2});
+  damage.add (FRect{5, 2, 10, 2});
+  damage.merge();
+  CPPUNIT_ASSERT ( damage.getCount() == 1 );
+  CPPUNIT_ASSERT ( damage.getRects()[0] == FRect(1, 1, 14, 3) );
+  damage.clear();
+
+  // Adjacent rows of the same width
+  damage.add (FRect{3, 4, 20, 1});
+  damage.add (FRect{3, 5, 20, 1});
+  damage.add (FRect{3, 6, 20, 1});
+  damage.merge();
+  CPPUNIT_ASSERT ( damage.getCount() == 1 );
+  CPPUNIT_ASSERT ( damage.getRects()[0] == FRect(3, 4, 20, 3) );
+  damage.clear();
+
+  // Distant rectangles stay separate
+  damage.add (FRect{1, 1, 2, 2});
+  damage.add (FRect{70, 20, 2, 2});
+  damage.merge();
+  CPPUNIT_ASSERT ( damage.getCount() == 2 );
+  CPPUNIT_ASSERT ( damage.getRects()[0] == FRect(1, 1, 2, 2) );
+  CPPUNIT_ASSERT ( damage.getRects()[1] == FRect(70, 20, 2, 2) );
+
+  // A bridging rectangle joins everything together
+  damage.add (FRect{2, 2, 69, 19});
+  damage.merge();
+  CPPUNIT_ASSERT ( damage.getCount() == 1 );
+  CPPUNIT_ASSERT ( damage.getRects()[0] == FRect(1, 1, 71, 21) );
+}
+
+//----------------------------------------------------------------------
+void FDamageRegionTest::clearTest()
+{
+  finalcut::FDamageRegion damage;
+  damage.add (finalcut::FRect{1, 1, 5, 5});
+  CPPUNIT_ASSERT ( ! damage.isEmpty() );
+  damage.clear();
+  CPPUNIT_ASSERT ( damage.isEmpty() );
+  CPPUNIT_ASSERT ( damage.getCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FDamageRegionTest::paintTest()
+{
+  using finalcut::FPoint;
+  using finalcut::FSize;
+  using finalcut::FWidget;
+  using Counts = std::array<int, 4>;
+  finalcut::FHeadlessTerminal::install ( finalcut::FHeadlessTerminal::Profile::Xterm256color
+                                       , FSize{60, 20} );
+  finalcut::FHeadlessTerminal::setClock();
+  char arg0[] = "fdamageregion-test";
+  char* argv[] = { arg0, nullptr };
+  std::array<Counts, 3> counts{};
+  std::array<std::size_t, 3> paint_counts{};
+
+  {
+    DamageApplication app{1, argv};
+    CountingWidget desktop_child{&app};  // A non-window desktop widget
+    desktop_child.setGeometry (FPoint{3, 15}, FSize{20, 2});
+    finalcut::FDialog dialog{&desktop_child};
+    dialog.setGeometry (FPoint{3, 2}, FSize{30, 8});
+    CountingWidget child1{&dialog};
+    child1.setGeometry (FPoint{2, 2}, FSize{10, 1});
+    CountingWidget child2{&dialog};
+    child2.setGeometry (FPoint{2, 5}, FSize{10, 1});
+    finalcut::FDialog other_dialog{&desktop_child};
+    other_dialog.setGeometry (FPoint{40, 2}, FSize{15, 8});
+    CountingWidget child3{&other_dialog};
+    child3.setGeometry (FPoint{2, 2}, FSize{10, 1});
+    FWidget::setMainWidget (&desktop_child);
+    desktop_child.show();
+
+    const auto getCounts = [&] ()
+    {
+      return Counts{{ child1.draw_count, child2.draw_count
+                    , child3.draw_count, desktop_child.draw_count }};
+    };
+
+    app.scenario = [&] (int step)
+    {
+      if ( step == 10 )
+      {
+        counts[0] = getCounts();
+        child1.invalidate();
+      }
+      else if ( step == 11 )
+      {
+        paint_counts[0] = FWidget::getPaintCount();
+        counts[1] = getCounts();
+        desktop_child.invalidate();
+      }
+      else if ( step == 12 )
+      {
+        paint_counts[1] = FWidget::getPaintCount();
+        counts[2] = getCounts();
+      }
+      else if ( step == 13 )
+      {
+        paint_counts[2] = FWidget::getPaintCount();  // Nothing painted
+        app.quit();
+      }
+    };
+
+    app.exec();
+  }
+
+  finalcut::FObject::unsetFixedTime();
+
+  // Only the invalidated child is redrawn
+  CPPUNIT_ASSERT ( counts[1][0] == counts[0][0] + 1 );
+  CPPUNIT_ASSERT ( counts[1][1] == counts[0][1] );
+  CPPUNIT_ASSERT ( counts[1][2] == counts[0][2] );
+  CPPUNIT_ASSERT ( counts[1][3] == counts[0][3] );
+  CPPUNIT_ASSERT ( paint_counts[0] == 3 );  // Desktop, dialog and child1
+
+  // A child of the desktop is repainted with the desktop
+  CPPUNIT_ASSERT ( counts[2][0] == counts[1][0] );
+  CPPUNIT_ASSERT ( counts[2][1] == counts[1][1] );
+  CPPUNIT_ASSERT ( counts[2][2] == counts[1][2] );
+  CPPUNIT_ASSERT ( counts[2][3] == counts[1][3] + 1 );
+  CPPUNIT_ASSERT ( paint_counts[1] == 2 );  // Desktop and desktop_child
+
+  // The paint count is reset in frames without painting
+  CPPUNIT_ASSERT ( paint_counts[2] == 0 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FDamageRegionTest);
+
+// The general unit test main part
+#include <main-test.inc>
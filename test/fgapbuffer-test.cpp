@@ -0,0 +1,280 @@
+/***********************************************************************
+* fgapbuffer-test.cpp - FGapBuffer unit tests                          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <clocale>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FGapBufferTest
+//----------------------------------------------------------------------
+
+class FGapBufferTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FGapBufferTest()
+    {
+      if ( ! std::setlocale (LC_CTYPE, "en_US.UTF-8") )
+        std::setlocale (LC_CTYPE, "C.UTF-8");
+    }
+
+  protected:
+    void classNameTest();
+    void insertTest();
+    void removeTest();
+    void moveGapTest();
+    void subStringTest();
+    void columnWidthTest();
+    void combinedCharacterTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FGapBufferTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (insertTest);
+    CPPUNIT_TEST (removeTest);
+    CPPUNIT_TEST (moveGapTest);
+    CPPUNIT_TEST (subStringTest);
+    CPPUNIT_TEST (columnWidthTest);
+    CPPUNIT_TEST (combinedCharacterTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FGapBufferTest::classNameTest()
+{
+  const finalcut::FGapBuffer buffer;
+  const finalcut::FString& classname = buffer.getClassName();
+  CPPUNIT_ASSERT ( classname == "FGapBuffer" );
+  CPPUNIT_ASSERT ( buffer.isEmpty() );
+  CPPUNIT_ASSERT ( buffer.getLength() == 0 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 0 );
+  CPPUNIT_ASSERT ( buffer.getString().isEmpty() );
+  CPPUNIT_ASSERT ( buffer[0] == L'\0' );
+}
+
+//----------------------------------------------------------------------
+void FGapBufferTest::insertTest()
+{
+  finalcut::FGapBuffer buffer{"world"};
+  CPPUNIT_ASSERT ( buffer.getLength() == 5 );
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 5 );
+
+  buffer.insert (0, "Hello");
+  CPPUNIT_ASSERT ( buffer.getString() == "Helloworld" );
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 5 );
+
+  buffer.insert (5, L' ');
+  buffer.insert (buffer.getLength(), L'!');
+  CPPUNIT_ASSERT ( buffer.getString() == "Hello world!" );
+  CPPUNIT_ASSERT ( buffer.getLength() == 12 );
+  CPPUNIT_ASSERT ( buffer[0] == L'H' );
+  CPPUNIT_ASSERT ( buffer[6] == L'w' );
+  CPPUNIT_ASSERT ( buffer[11] == L'!' );
+  CPPUNIT_ASSERT ( buffer[12] == L'\0' );
+
+  // Insert positions behind the end append the text
+  buffer.insert (100, "?");
+  CPPUNIT_ASSERT ( buffer.getString() == "Hello world!?" );
+
+  buffer.overwrite (6, "there");
+  CPPUNIT_ASSERT ( buffer.getString() == "Hello there!?" );
+  buffer.overwrite (12, "...");
+  CPPUNIT_ASSERT ( buffer.getString() == "Hello there!..." );
+
+  // A large text grows the buffer several times
+  finalcut::FGapBuffer large{};
+
+  for (std::size_t i{0}; i < 1000; i++)
+    large.insert (i / 2, wchar_t(L'a' + i % 26));
+
+  CPPUNIT_ASSERT ( large.getLength() == 1000 );
+  CPPUNIT_ASSERT ( large.getColumnWidth() == 1000 );
+  CPPUNIT_ASSERT ( large.getString().getLength() == 1000 );
+
+  buffer.setString("new text");
+  CPPUNIT_ASSERT ( buffer.getString() == "new text" );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 8 );
+}
+
+//----------------------------------------------------------------------
+void FGapBufferTest::removeTest()
+{
+  finalcut::FGapBuffer buffer{"0123456789"};
+  buffer.remove (3, 2);
+  CPPUNIT_ASSERT ( buffer.getString() == "01256789" );
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 3 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 8 );
+
+  buffer.remove (0, 1);
+  CPPUNIT_ASSERT ( buffer.getString() == "1256789" );
+
+  // The length is limited to the end of the text
+  buffer.remove (5, 10);
+  CPPUNIT_ASSERT ( buffer.getString() == "12567" );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 5 );
+
+  // Nothing happens behind the end or with zero length
+  buffer.remove (5, 1);
+  buffer.remove (2, 0);
+  CPPUNIT_ASSERT ( buffer.getString() == "12567" );
+
+  buffer.clear();
+  CPPUNIT_ASSERT ( buffer.isEmpty() );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 0 );
+  buffer.insert (0, "abc");
+  CPPUNIT_ASSERT ( buffer.getString() == "abc" );
+}
+
+//----------------------------------------------------------------------
+void FGapBufferTest::moveGapTest()
+{
+  finalcut::FGapBuffer buffer{"abcdefgh"};
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 8 );
+
+  buffer.moveGap (2);
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 2 );
+  CPPUNIT_ASSERT ( buffer.getString() == "abcdefgh" );
+  CPPUNIT_ASSERT ( buffer[2] == L'c' );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(2) == 2 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(6) == 6 );
+
+  buffer.moveGap (6);
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 6 );
+  CPPUNIT_ASSERT ( buffer.getString() == "abcdefgh" );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(1) == 1 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(8) == 8 );
+
+  buffer.moveGap (0);
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 0 );
+  CPPUNIT_ASSERT ( buffer[0] == L'a' );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(4) == 4 );
+
+  // The gap cannot be moved behind the end of the text
+  buffer.moveGap (100);
+  CPPUNIT_ASSERT ( buffer.getGapPosition() == 8 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(100) == 8 );
+}
+
+//----------------------------------------------------------------------
+void FGapBufferTest::subStringTest()
+{
+  finalcut::FGapBuffer buffer{"The quick brown fox"};
+  buffer.moveGap (7);
+  CPPUNIT_ASSERT ( buffer.getSubString(0, 3) == "The" );
+  CPPUNIT_ASSERT ( buffer.getSubString(4, 5) == "quick" );  // Over the gap
+  CPPUNIT_ASSERT ( buffer.getSubString(10, 5) == "brown" );
+  CPPUNIT_ASSERT ( buffer.getSubString(16, 10) == "fox" );
+  CPPUNIT_ASSERT ( buffer.getSubString(19, 1).isEmpty() );
+  CPPUNIT_ASSERT ( buffer.getSubString(0, 0).isEmpty() );
+  CPPUNIT_ASSERT ( buffer.getString() == "The quick brown fox" );
+}
+
+//----------------------------------------------------------------------
+void FGapBufferTest::columnWidthTest()
+{
+  const auto& data = finalcut::FTerm::getFTermData();
+  data->setTermEncoding (finalcut::Encoding::UTF8);
+
+  // Full-width characters occupy two columns
+  finalcut::FGapBuffer buffer{L"a\U00003042b\U00003044"};
+  CPPUNIT_ASSERT ( buffer.getLength() == 4 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 6 );
+  CPPUNIT_ASSERT ( buffer.getCharWidth(0) == 1 );
+  CPPUNIT_ASSERT ( buffer.getCharWidth(1) == 2 );
+  CPPUNIT_ASSERT ( buffer.getCharWidth(3) == 2 );
+  CPPUNIT_ASSERT ( buffer.getCharWidth(4) == 0 );
+
+  for (std::size_t gap{0}; gap <= 4; gap++)
+  {
+    buffer.moveGap(gap);
+    CPPUNIT_ASSERT ( buffer.getColumnWidth(0) == 0 );
+    CPPUNIT_ASSERT ( buffer.getColumnWidth(1) == 1 );
+    CPPUNIT_ASSERT ( buffer.getColumnWidth(2) == 3 );
+    CPPUNIT_ASSERT ( buffer.getColumnWidth(3) == 4 );
+    CPPUNIT_ASSERT ( buffer.getColumnWidth(4) == 6 );
+  }
+
+  buffer.remove (1, 1);
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 4 );
+  buffer.insert (0, L'\U00003046');
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 6 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(1) == 2 );
+  buffer.updateColumnWidths();
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 6 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth(1) == 2 );
+}
+
+//----------------------------------------------------------------------
+void FGapBufferTest::combinedCharacterTest()
+{
+  const auto& data = finalcut::FTerm::getFTermData();
+  data->setTermEncoding (finalcut::Encoding::UTF8);
+
+  // "e" + combining acute accent, "x", "a" + combining ring above
+  finalcut::FGapBuffer buffer{L"e\U00000301xa\U0000030a"};
+  CPPUNIT_ASSERT ( buffer.getLength() == 5 );
+  CPPUNIT_ASSERT ( buffer.getColumnWidth() == 3 );
+
+  CPPUNIT_ASSERT ( buffer.getCharLength(0) == 2 );
+  CPPUNIT_ASSERT ( buffer.getCharLength(1) == -1 );
+  CPPUNIT_ASSERT ( buffer.getCharLength(2) == 1 );
+  CPPUNIT_ASSERT ( buffer.getCharLength(3) == 2 );
+  CPPUNIT_ASSERT ( buffer.getCharLength(5) == -1 );
+
+  CPPUNIT_ASSERT ( buffer.getPrevCharLength(0) == -1 );
+  CPPUNIT_ASSERT ( buffer.getPrevCharLength(2) == 2 );
+  CPPUNIT_ASSERT ( buffer.getPrevCharLength(3) == 1 );
+  CPPUNIT_ASSERT ( buffer.getPrevCharLength(4) == -1 );
+
+  CPPUNIT_ASSERT ( buffer.searchLeftCharBegin(0) == finalcut::FGapBuffer::NOT_FOUND );
+  CPPUNIT_ASSERT ( buffer.searchLeftCharBegin(2) == 0 );
+  CPPUNIT_ASSERT ( buffer.searchLeftCharBegin(4) == 3 );
+  CPPUNIT_ASSERT ( buffer.searchRightCharBegin(0) == 2 );
+  CPPUNIT_ASSERT ( buffer.searchRightCharBegin(1) == 2 );
+  CPPUNIT_ASSERT ( buffer.searchRightCharBegin(4) == finalcut::FGapBuffer::NOT_FOUND );
+  CPPUNIT_ASSERT ( buffer.searchRightCharBegin(5) == finalcut::FGapBuffer::NOT_FOUND );
+
+  // The results do not depend on the gap position
+  buffer.moveGap(1);
+  CPPUNIT_ASSERT ( buffer.getCharLength(0) == 2 );
+  CPPUNIT_ASSERT ( buffer.getPrevCharLength(2) == 2 );
+  CPPUNIT_ASSERT ( buffer.searchRightCharBegin(1) == 2 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FGapBufferTest);
+
+// The general unit test main part
+#include <main-test.inc>
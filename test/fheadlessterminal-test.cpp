@@ -0,0 +1,222 @@
+/***********************************************************************
+* fheadlessterminal-test.cpp - FHeadlessTerminal unit tests            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <array>
+#include <functional>
+#include <string>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class ScenarioApplication
+//----------------------------------------------------------------------
+
+class ScenarioApplication final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Data member
+    std::function<void(int)> scenario{};
+
+  private:
+    // Method
+    void processExternalUserEvent() override
+    {
+      // Called once per pass of the event loop
+      finalcut::FHeadlessTerminal::advanceClock (20000);  // 20 ms
+      step++;
+
+      if ( scenario )
+        scenario(step);
+    }
+
+    // Data member
+    int step{0};
+};
+
+
+//----------------------------------------------------------------------
+// class FHeadlessTerminalTest
+//----------------------------------------------------------------------
+
+class FHeadlessTerminalTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FHeadlessTerminalTest() = default;
+
+  protected:
+    void classNameTest();
+    void terminalDetectionTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FHeadlessTerminalTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (terminalDetectionTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FHeadlessTerminalTest::classNameTest()
+{
+  using finalcut::FHeadlessTerminal;
+  using Profile = FHeadlessTerminal::Profile;
+  const FHeadlessTerminal terminal{Profile::Linux};
+  const finalcut::FString& classname = terminal.getClassName();
+  CPPUNIT_ASSERT ( classname == "FHeadlessTerminal" );
+  CPPUNIT_ASSERT ( terminal.getProfile() == Profile::Linux );
+  CPPUNIT_ASSERT ( terminal.isOpen() );
+  CPPUNIT_ASSERT ( terminal.getScreen().getWidth() == 80 );
+  CPPUNIT_ASSERT ( terminal.getScreen().getHeight() == 24 );
+  CPPUNIT_ASSERT ( std::string{FHeadlessTerminal::getTermType(Profile::Xterm256color)} == "xterm-256color" );
+  CPPUNIT_ASSERT ( std::string{FHeadlessTerminal::getTermType(Profile::Linux)} == "linux" );
+  CPPUNIT_ASSERT ( std::string{FHeadlessTerminal::getTermType(Profile::Vt100)} == "vt100" );
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminalTest::terminalDetectionTest()
+{
+  auto& start_options = finalcut::FStartOptions::getFStartOptions();
+  CPPUNIT_ASSERT ( start_options.terminal_detection );
+
+  {
+    // Nobody answers the queries of the terminal detection
+    const finalcut::FHeadlessTerminal terminal{};
+    CPPUNIT_ASSERT ( ! start_options.terminal_detection );
+  }
+
+  // The destructor restores the option
+  CPPUNIT_ASSERT ( start_options.terminal_detection );
+
+  start_options.terminal_detection = false;
+
+  {
+    const finalcut::FHeadlessTerminal terminal{};
+    CPPUNIT_ASSERT ( ! start_options.terminal_detection );
+  }
+
+  CPPUNIT_ASSERT ( ! start_options.terminal_detection );
+  start_options.terminal_detection = true;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessTerminalTest::applicationTest()
+{
+  using finalcut::FPoint;
+  using finalcut::FSize;
+  auto& terminal = finalcut::FHeadlessTerminal::install \
+      (finalcut::FHeadlessTerminal::Profile::Xterm256color, FSize{50, 16});
+  finalcut::FHeadlessTerminal::setClock();
+  const auto& screen = terminal.getScreen();
+  char arg0[] = "fheadlessterminal-test";
+  char* argv[] = { arg0, nullptr };
+  std::array<bool, 3> equal{};
+  std::array<finalcut::FString, 3> lines{};
+  finalcut::FString input_text{};
+  FPoint dialog_pos{};
+  FPoint difference{};
+
+  {
+    ScenarioApplication app{1, argv};
+    finalcut::FWidget main_widget{&app};
+    finalcut::FDialog dialog{"Headless", &main_widget};
+    dialog.setGeometry (FPoint{5, 3}, FSize{30, 8});
+    finalcut::FLabel label{"Hello terminal", &dialog};
+    label.setGeometry (FPoint{2, 1}, FSize{14, 1});
+    finalcut::FLineEdit input{&dialog};
+    input.setGeometry (FPoint{2, 3}, FSize{20, 1});
+    finalcut::FWidget::setMainWidget (&main_widget);
+    main_widget.show();
+    input.setFocus();
+
+    app.scenario = [&] (int step)
+    {
+      if ( step == 10 )
+      {
+        equal[0] = terminal.isVTermEqual();
+        lines[0] = screen.getLine(5);
+        terminal.sendInput ("Input");
+      }
+      else if ( step == 20 )
+      {
+        equal[1] = terminal.isVTermEqual();
+        lines[1] = screen.getLine(7);
+        input_text = input.getText();
+        dialog.move (FPoint{10, 4});
+      }
+      else if ( step == 30 )
+      {
+        equal[2] = terminal.isVTermEqual();
+        lines[2] = screen.getLine(9);
+        dialog_pos = dialog.getPos();
+        terminal.getScreen().write ("\033[1;1HX");  // Not in the vterm
+        difference = terminal.findVTermDifference();
+        app.quit();
+      }
+    };
+
+    app.exec();
+  }
+
+  finalcut::FObject::unsetFixedTime();
+
+  // The screen shows the widgets of the application
+  CPPUNIT_ASSERT ( equal[0] );
+  CPPUNIT_ASSERT ( lines[0].includes("Hello terminal") );
+  CPPUNIT_ASSERT ( lines[0].mid(7, 14) == "Hello terminal" );
+
+  // The keyboard input reaches the focused line edit
+  CPPUNIT_ASSERT ( equal[1] );
+  CPPUNIT_ASSERT ( input_text == "Input" );
+  CPPUNIT_ASSERT ( lines[1].includes("Input") );
+
+  // The screen follows the moved dialog
+  CPPUNIT_ASSERT ( equal[2] );
+  CPPUNIT_ASSERT ( dialog_pos == FPoint(15, 7) );
+  CPPUNIT_ASSERT ( lines[2].includes("Hello terminal") );
+  CPPUNIT_ASSERT ( lines[2].mid(17, 14) == "Hello terminal" );
+
+  // The first differing cell
+  CPPUNIT_ASSERT ( difference == FPoint(1, 1) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FHeadlessTerminalTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,308 @@
+/***********************************************************************
+* fhittestindex-test.cpp - FHitTestIndex unit tests                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FHitTestIndexTest
+//----------------------------------------------------------------------
+
+class FHitTestIndexTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FHitTestIndexTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void findTest();
+    void priorityTest();
+    void outOfRangeTest();
+    void invalidateTest();
+    void updateTest();
+    void randomTest();
+
+  private:
+    // The index never dereferences the widget pointers
+    finalcut::FWidget* widget (std::size_t);
+
+    // Data member
+    std::array<char, 64> storage{};
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FHitTestIndexTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (findTest);
+    CPPUNIT_TEST (priorityTest);
+    CPPUNIT_TEST (outOfRangeTest);
+    CPPUNIT_TEST (invalidateTest);
+    CPPUNIT_TEST (updateTest);
+    CPPUNIT_TEST (randomTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::classNameTest()
+{
+  const finalcut::FHitTestIndex index;
+  const finalcut::FString& classname = index.getClassName();
+  CPPUNIT_ASSERT ( classname == "FHitTestIndex" );
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::noArgumentTest()
+{
+  finalcut::FHitTestIndex index;
+  CPPUNIT_ASSERT ( ! index.isValid() );
+  CPPUNIT_ASSERT ( index.getCount() == 0 );
+  CPPUNIT_ASSERT ( index.find({1, 1}) == nullptr );
+
+  index.build();
+  CPPUNIT_ASSERT ( index.isValid() );
+  CPPUNIT_ASSERT ( index.find({1, 1}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({80, 25}) == nullptr );
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::findTest()
+{
+  finalcut::FHitTestIndex index;
+  index.insert (finalcut::FRect{2, 2, 10, 3}, widget(0));
+  index.insert (finalcut::FRect{20, 2, 5, 10}, widget(1));
+  index.insert (finalcut::FRect{1, 20, 80, 1}, widget(2));
+  index.insert (finalcut::FRect{5, 5, 0, 0}, widget(3));  // Empty
+  CPPUNIT_ASSERT ( index.getCount() == 3 );
+  index.build();
+
+  CPPUNIT_ASSERT ( index.find({2, 2}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({11, 4}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({12, 4}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({11, 5}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({1, 2}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({20, 11}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({24, 2}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({25, 2}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({1, 20}) == widget(2) );
+  CPPUNIT_ASSERT ( index.find({80, 20}) == widget(2) );
+  CPPUNIT_ASSERT ( index.find({81, 20}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({5, 5}) == nullptr );
+
+  index.clear();
+  CPPUNIT_ASSERT ( ! index.isValid() );
+  CPPUNIT_ASSERT ( index.getCount() == 0 );
+  CPPUNIT_ASSERT ( index.find({2, 2}) == nullptr );
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::priorityTest()
+{
+  // The first inserted rectangle wins
+  finalcut::FHitTestIndex index;
+  index.insert (finalcut::FRect{10, 1, 5, 5}, widget(0));
+  index.insert (finalcut::FRect{1, 1, 40, 10}, widget(1));
+  index.insert (finalcut::FRect{12, 3, 2, 2}, widget(2));
+  index.build();
+
+  CPPUNIT_ASSERT ( index.find({10, 1}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({12, 3}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({9, 1}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({15, 5}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({40, 10}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({41, 10}) == nullptr );
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::outOfRangeTest()
+{
+  // There is no row limit
+  finalcut::FHitTestIndex index;
+  index.insert (finalcut::FRect{-5, -5, 10, 10}, widget(0));
+  index.insert (finalcut::FRect{1, 8, 10, 10}, widget(1));
+  index.build();
+
+  CPPUNIT_ASSERT ( index.find({-5, -5}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({0, 0}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({4, 4}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({5, 4}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({1, 10}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({10, 17}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({10, 18}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({1, -6}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({1, 100000}) == nullptr );
+
+  index.clear();
+  index.insert (finalcut::FRect{1, 100000, 5, 2}, widget(0));
+  index.build();
+  CPPUNIT_ASSERT ( index.find({1, 100000}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({5, 100001}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({5, 100002}) == nullptr );
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::invalidateTest()
+{
+  finalcut::FHitTestIndex index1;
+  finalcut::FHitTestIndex index2;
+  index1.build();
+  index2.build();
+  CPPUNIT_ASSERT ( index1.isValid() );
+  CPPUNIT_ASSERT ( index2.isValid() );
+
+  // All indexes share the same generation
+  finalcut::FHitTestIndex::invalidate();
+  CPPUNIT_ASSERT ( ! index1.isValid() );
+  CPPUNIT_ASSERT ( ! index2.isValid() );
+
+  index1.build();
+  CPPUNIT_ASSERT ( index1.isValid() );
+  CPPUNIT_ASSERT ( ! index2.isValid() );
+
+  // A local generation outdates only one index
+  index1.build(7);
+  index2.build(3);
+  CPPUNIT_ASSERT ( index1.isValid(7) );
+  CPPUNIT_ASSERT ( ! index1.isValid(8) );
+  CPPUNIT_ASSERT ( index2.isValid(3) );
+  finalcut::FHitTestIndex::invalidate();
+  CPPUNIT_ASSERT ( ! index1.isValid(7) );
+  CPPUNIT_ASSERT ( ! index2.isValid(3) );
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::updateTest()
+{
+  finalcut::FHitTestIndex index;
+  index.insert (finalcut::FRect{1, 1, 10, 5}, widget(0));
+  index.insert (finalcut::FRect{5, 3, 10, 5}, widget(1));
+
+  // Not possible before the index is built
+  CPPUNIT_ASSERT ( ! index.update(finalcut::FRect{1, 1, 2, 2}, widget(0)) );
+  index.build();
+  CPPUNIT_ASSERT ( index.find({6, 4}) == widget(0) );
+
+  // Move the first rectangle away; its priority is kept
+  CPPUNIT_ASSERT ( index.update(finalcut::FRect{30, 10, 10, 5}, widget(0)) );
+  CPPUNIT_ASSERT ( index.isValid() );
+  CPPUNIT_ASSERT ( index.getCount() == 2 );
+  CPPUNIT_ASSERT ( index.find({1, 1}) == nullptr );
+  CPPUNIT_ASSERT ( index.find({6, 4}) == widget(1) );
+  CPPUNIT_ASSERT ( index.find({30, 10}) == widget(0) );
+  CPPUNIT_ASSERT ( index.update(finalcut::FRect{5, 3, 2, 2}, widget(0)) );
+  CPPUNIT_ASSERT ( index.find({6, 4}) == widget(0) );
+  CPPUNIT_ASSERT ( index.find({7, 4}) == widget(1) );
+
+  // Unknown widgets and empty rectangles require a new build
+  CPPUNIT_ASSERT ( ! index.update(finalcut::FRect{1, 1, 2, 2}, widget(2)) );
+  CPPUNIT_ASSERT ( ! index.update(finalcut::FRect{1, 1, 0, 0}, widget(0)) );
+  finalcut::FHitTestIndex::invalidate();
+  CPPUNIT_ASSERT ( ! index.update(finalcut::FRect{1, 1, 2, 2}, widget(0)) );
+}
+
+//----------------------------------------------------------------------
+void FHitTestIndexTest::randomTest()
+{
+  // Compare the index with a linear search
+  std::mt19937 gen(4711);
+  std::uniform_int_distribution<int> pos(-3, 40);
+  std::uniform_int_distribution<int> len(0, 15);
+
+  for (int round{0}; round < 20; round++)
+  {
+    finalcut::FHitTestIndex index;
+    std::vector<finalcut::FRect> rects{};
+
+    for (std::size_t i{0}; i < storage.size(); i++)
+    {
+      const finalcut::FRect r { pos(gen), pos(gen)
+                              , std::size_t(len(gen))
+                              , std::size_t(len(gen)) };
+      rects.push_back(r);
+      index.insert (r, widget(i));
+    }
+
+    index.build();
+
+    if ( round % 2 == 1 )
+    {
+      // Move some rectangles
+      std::uniform_int_distribution<int> nonempty(1, 15);
+
+      for (std::size_t i{0}; i < storage.size(); i += 3)
+      {
+        const finalcut::FRect r { pos(gen), pos(gen)
+                                , std::size_t(nonempty(gen))
+                                , std::size_t(nonempty(gen)) };
+
+        if ( index.update(r, widget(i)) )
+          rects[i] = r;
+      }
+    }
+
+    for (int y{-5}; y <= 60; y++)
+    {
+      for (int x{-5}; x <= 60; x++)
+      {
+        finalcut::FWidget* expected{nullptr};
+
+        for (std::size_t i{0}; i < rects.size(); i++)
+        {
+          if ( rects[i].contains(x, y) )
+          {
+            expected = widget(i);
+            break;
+          }
+        }
+
+        CPPUNIT_ASSERT ( index.find({x, y}) == expected );
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+finalcut::FWidget* FHitTestIndexTest::widget (std::size_t n)
+{
+  return reinterpret_cast<finalcut::FWidget*>(&storage[n]);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FHitTestIndexTest);
+
+// The general unit test main part
+#include <main-test.inc>
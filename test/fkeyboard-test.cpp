@@ -300,6 +300,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void sequencesTest();
     void mouseTest();
     void utf8Test();
+    void pasteTest();
+    void keyboardProtocolTest();
     void unknownKeyTest();
 
   private:
@@ -317,6 +319,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (sequencesTest);
     CPPUNIT_TEST (mouseTest);
     CPPUNIT_TEST (utf8Test);
+    CPPUNIT_TEST (pasteTest);
+    CPPUNIT_TEST (keyboardProtocolTest);
     CPPUNIT_TEST (unknownKeyTest);
 
     // End of test suite definition
@@ -329,11 +333,14 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void keyReleased();
     void escapeKeyPressed();
     void mouseTracking();
+    void textPasted();
 
     // Data members
     finalcut::FKey key_pressed{finalcut::FKey::None};
     finalcut::FKey key_released{finalcut::FKey::None};
+    finalcut::FString pasted_text{};
     int  number_of_keys{0};
+    int  number_of_pastes{0};
     finalcut::FKeyboard* keyboard{nullptr};
 };
 
@@ -2957,6 +2964,126 @@ void FKeyboardTest::utf8Test()
   clear();
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::pasteTest()
+{
+  // Bracketed paste delivers the text as a whole
+  input("\033[200~Hello \342\202\254 \033[B\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( pasted_text == L"Hello \x20ac \033[B" );
+  CPPUNIT_ASSERT ( keyboard->getPasteText().isEmpty() );
+  CPPUNIT_ASSERT ( ! keyboard->isPasting() );
+  clear();
+
+  // Keys before and after the pasted text
+  input("A\033[200~x\ny\033[201~\033[B");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 2 );
+  CPPUNIT_ASSERT ( pasted_text == L"x\ny" );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Down );
+  clear();
+
+  // The end marker arrives later
+  input("\033[200~abc");
+  processInput();
+  CPPUNIT_ASSERT ( keyboard->isPasting() );
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  input("def\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( ! keyboard->isPasting() );
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text == L"abcdef" );
+  clear();
+
+  // An empty paste generates no event
+  input("\033[200~\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  clear();
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::keyboardProtocolTest()
+{
+  std::cout << std::endl;
+
+  // Kitty keyboard protocol escape (without timeout)
+  input("\033[27u");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Escape );
+  clear();
+
+  // Kitty keyboard protocol ctrl-a
+  input("\033[97;5u");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_a );
+  clear();
+
+  // Kitty keyboard protocol meta-a
+  input("\033[97;3u");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Meta_a );
+  clear();
+
+  // Kitty keyboard protocol meta-A with shifted key sub-parameter
+  input("\033[97:65;4u");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Meta_A );
+  clear();
+
+  // Kitty keyboard protocol shift-tab
+  input("\033[9;2u");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Back_tab );
+  clear();
+
+  // Kitty keyboard protocol meta-enter
+  input("\033[13;3u");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Meta_enter );
+  clear();
+
+  // Kitty keyboard protocol ctrl-space (num lock is ignored)
+  input("\033[32;133u");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_space );
+  clear();
+
+  // xterm modifyOtherKeys ctrl-a
+  input("\033[27;5;97~");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_a );
+  clear();
+
+  // xterm modifyOtherKeys meta-escape followed by a cursor key
+  input("\033[27;3;27~\033[B");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( number_of_keys == 2 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Down );
+  clear();
+
+  // Legacy keys with '~' are not affected
+  input("\033[2;3~");
+  processInput();
+  std::cout << " - Key: " << keyboard->getKeyName(key_pressed) << std::endl;
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Meta_insert );
+  clear();
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::unknownKeyTest()
 {
@@ -2982,14 +3109,17 @@ void FKeyboardTest::init()
   auto cmd2 = std::bind(&FKeyboardTest::keyReleased, this);
   auto cmd3 = std::bind(&FKeyboardTest::escapeKeyPressed, this);
   auto cmd4 = std::bind(&FKeyboardTest::mouseTracking, this);
+  auto cmd5 = std::bind(&FKeyboardTest::textPasted, this);
   finalcut::FKeyboardCommand key_cmd1 (cmd1);
   finalcut::FKeyboardCommand key_cmd2 (cmd2);
   finalcut::FKeyboardCommand key_cmd3 (cmd3);
   finalcut::FKeyboardCommand key_cmd4 (cmd4);
+  finalcut::FKeyboardCommand key_cmd5 (cmd5);
   keyboard->setPressCommand (key_cmd1);
   keyboard->setReleaseCommand (key_cmd2);
   keyboard->setEscPressedCommand (key_cmd3);
   keyboard->setMouseTrackingCommand (key_cmd4);
+  keyboard->setPasteCommand (key_cmd5);
   keyboard->setKeypressTimeout (100000);  // 100 ms
   processInput();
   CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::None );
@@ -3045,6 +3175,8 @@ void FKeyboardTest::clear()
 {
   keyboard->clearKeyBuffer();
   number_of_keys = 0;
+  number_of_pastes = 0;
+  pasted_text.clear();
   key_pressed = finalcut::FKey::None;
   key_released = finalcut::FKey::None;
 }
@@ -3076,6 +3208,13 @@ void FKeyboardTest::mouseTracking()
   key_pressed = keyboard->getKey();
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::textPasted()
+{
+  pasted_text = keyboard->getPasteText();
+  number_of_pastes++;
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FKeyboardTest);
 
@@ -0,0 +1,323 @@
+/***********************************************************************
+* flineanalyzer-test.cpp - FLineAnalyzer unit tests                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <random>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------
+std::vector<finalcut::FChar> createLine (const std::wstring& text)
+{
+  std::vector<finalcut::FChar> line(text.length());
+
+  for (std::size_t i{0}; i < text.length(); i++)
+  {
+    line[i].ch[0] = text[i];
+    line[i].fg_color = finalcut::FColor::Black;
+    line[i].bg_color = finalcut::FColor::LightGray;
+    line[i].attr.bit.char_width = 1;
+  }
+
+  return line;
+}
+
+}  // anonymous namespace
+
+//----------------------------------------------------------------------
+// class FLineAnalyzerTest
+//----------------------------------------------------------------------
+
+class FLineAnalyzerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FLineAnalyzerTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void equalTest();
+    void randomEqualTest();
+    void equalRunTest();
+    void unchangedRunTest();
+    void firstColumnTest();
+    void lastColumnTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FLineAnalyzerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (equalTest);
+    CPPUNIT_TEST (randomEqualTest);
+    CPPUNIT_TEST (equalRunTest);
+    CPPUNIT_TEST (unchangedRunTest);
+    CPPUNIT_TEST (firstColumnTest);
+    CPPUNIT_TEST (lastColumnTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::classNameTest()
+{
+  const finalcut::FLineAnalyzer analyzer;
+  const finalcut::FString& classname = analyzer.getClassName();
+  CPPUNIT_ASSERT ( classname == "FLineAnalyzer" );
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::noArgumentTest()
+{
+  finalcut::FLineAnalyzer analyzer;
+  CPPUNIT_ASSERT ( analyzer.getWidth() == 0 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(0) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getUnchangedRun(0) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 0 );
+
+  analyzer.analyze (nullptr, 0);
+  analyzer.analyzeTrailingRun (nullptr, 0);
+  CPPUNIT_ASSERT ( analyzer.getWidth() == 0 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::equalTest()
+{
+  using finalcut::FLineAnalyzer;
+  const auto line = createLine(L"aa");
+  const auto& a = line[0];
+  auto b = line[1];
+  CPPUNIT_ASSERT ( FLineAnalyzer::isEqual(a, b) );
+
+  // Not compared: encoded character, print state and character width
+  b.encoded_char[0] = L'x';
+  b.encoded_char[4] = L'y';
+  b.attr.bit.no_changes = true;
+  b.attr.bit.printed = true;
+  b.attr.bit.char_width = 2;
+  b.attr.byte[3] = 0xff;
+  CPPUNIT_ASSERT ( a == b );
+  CPPUNIT_ASSERT ( FLineAnalyzer::isEqual(a, b) );
+
+  // Compared: character, colors, attributes and padding state
+  b = a;
+  b.ch[4] = L'z';
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+  b = a;
+  b.fg_color = finalcut::FColor::Red;
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+  b = a;
+  b.bg_color = finalcut::FColor::Blue;
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+  b = a;
+  b.fg_rgb = 0x010203;
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+  b = a;
+  b.bg_rgb = 0x040506;
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+  b = a;
+  b.attr.bit.bold = true;
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+  b = a;
+  b.attr.bit.inherit_background = true;
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+  b = a;
+  b.attr.bit.fullwidth_padding = true;
+  CPPUNIT_ASSERT ( ! FLineAnalyzer::isEqual(a, b) );
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::randomEqualTest()
+{
+  // isEqual() gives the same result as operator ==
+
+  std::mt19937 random{4711};
+  const auto base = createLine(L"x");
+
+  for (int i{0}; i < 20000; i++)
+  {
+    auto lhs = base[0];
+    auto rhs = base[0];
+    auto bytes = reinterpret_cast<uInt8*>(&rhs);
+
+    // Change up to three random bits
+    for (auto n = random() % 4; n > 0; n--)
+    {
+      const auto bit = random() % (sizeof(finalcut::FChar) * 8);
+      bytes[bit / 8] ^= uInt8(1 << (bit % 8));
+    }
+
+    CPPUNIT_ASSERT ( finalcut::FLineAnalyzer::isEqual(lhs, rhs) == (lhs == rhs) );
+    CPPUNIT_ASSERT ( finalcut::FLineAnalyzer::isEqual(rhs, lhs) == (lhs == rhs) );
+  }
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::equalRunTest()
+{
+  finalcut::FLineAnalyzer analyzer;
+  auto line = createLine(L"aaab  c   ");
+  analyzer.analyze (line.data(), uInt(line.size()));
+  CPPUNIT_ASSERT ( analyzer.getWidth() == 10 );
+  const uInt runs[] = { 3, 2, 1, 1, 2, 1, 1, 3, 2, 1 };
+
+  for (uInt x{0}; x < 10; x++)
+    CPPUNIT_ASSERT ( analyzer.getEqualRun(x) == runs[x] );
+
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(10) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 0 );
+  analyzer.analyzeTrailingRun (line.data(), uInt(line.size()));
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 3 );
+
+  // A different color ends a run
+  line[8].bg_color = finalcut::FColor::Blue;
+  analyzer.analyze (line.data(), uInt(line.size()));
+  analyzer.analyzeTrailingRun (line.data(), uInt(line.size()));
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(7) == 1 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(8) == 1 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 1 );
+
+  // A line of equal characters
+  const auto blank_line = createLine(std::wstring(200, L' '));
+  analyzer.analyze (blank_line.data(), uInt(blank_line.size()));
+  analyzer.analyzeTrailingRun (blank_line.data(), uInt(blank_line.size()));
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(0) == 200 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(150) == 50 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 200 );
+
+  // A shorter line reuses the buffers
+  analyzer.analyze (line.data(), 4);
+  analyzer.analyzeTrailingRun (line.data(), 4);
+  CPPUNIT_ASSERT ( analyzer.getWidth() == 4 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(0) == 3 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(4) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 1 );
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::unchangedRunTest()
+{
+  finalcut::FLineAnalyzer analyzer;
+  auto line = createLine(L"abcdefgh");
+
+  for (auto x : {1, 2, 3, 5, 7})
+    line[std::size_t(x)].attr.bit.no_changes = true;
+
+  analyzer.analyze (line.data(), uInt(line.size()));
+  const uInt runs[] = { 0, 3, 2, 1, 0, 1, 0, 1 };
+
+  for (uInt x{0}; x < 8; x++)
+    CPPUNIT_ASSERT ( analyzer.getUnchangedRun(x) == runs[x] );
+
+  // The change state is not part of the equal runs
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(1) == 1 );
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::firstColumnTest()
+{
+  finalcut::FLineAnalyzer analyzer;
+  const auto line = createLine(L"ab      cd      ");
+  analyzer.analyze (line.data(), uInt(line.size()), 9);
+  analyzer.analyzeTrailingRun (line.data(), uInt(line.size()));
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(8) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(9) == 1 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(10) == 6 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 6 );
+
+  // The trailing run reaches beyond the first column
+  analyzer.analyze (line.data(), uInt(line.size()), 13);
+  analyzer.analyzeTrailingRun (line.data(), uInt(line.size()));
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(12) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(13) == 3 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 6 );
+
+  const auto blank_line = createLine(std::wstring(10, L' '));
+  analyzer.analyze (blank_line.data(), uInt(blank_line.size()), 9);
+  analyzer.analyzeTrailingRun (blank_line.data(), uInt(blank_line.size()));
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(9) == 1 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 10 );
+
+  // First column behind the line end
+  analyzer.analyze (line.data(), uInt(line.size()), 20);
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(15) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FLineAnalyzerTest::lastColumnTest()
+{
+  finalcut::FLineAnalyzer analyzer;
+  const auto line = createLine(L"ab      cd      ");
+
+  // The runs end at the last column
+  analyzer.analyze (line.data(), uInt(line.size()), 1, 5);
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(0) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(1) == 1 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(2) == 4 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(5) == 1 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(6) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getUnchangedRun(6) == 0 );
+
+  // The trailing run is not part of the analysis
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 0 );
+  analyzer.analyzeTrailingRun (line.data(), uInt(line.size()));
+  CPPUNIT_ASSERT ( analyzer.getTrailingRun() == 6 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(2) == 4 );
+
+  // A single column
+  analyzer.analyze (line.data(), uInt(line.size()), 3, 3);
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(2) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(3) == 1 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(4) == 0 );
+
+  // Last column behind the line end
+  analyzer.analyze (line.data(), uInt(line.size()), 12, 40);
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(12) == 4 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(15) == 1 );
+
+  // Last column in front of the first column
+  analyzer.analyze (line.data(), uInt(line.size()), 6, 5);
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(5) == 0 );
+  CPPUNIT_ASSERT ( analyzer.getEqualRun(6) == 0 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FLineAnalyzerTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,348 @@
+/***********************************************************************
+* flistview-test.cpp - FListView unit tests                            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <array>
+#include <functional>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class BigModel
+//----------------------------------------------------------------------
+
+class BigModel final : public finalcut::FListViewModel
+{
+  public:
+    // Constructor
+    explicit BigModel (std::size_t count)
+      : rows{count}
+    { }
+
+    // Accessors
+    std::size_t getRowCount() const override
+    {
+      return rows;
+    }
+
+    finalcut::FString getText (std::size_t row, int column) const override
+    {
+      if ( row >= rows )
+        out_of_range = true;
+
+      text_requests++;
+
+      if ( column == 1 )
+        return getRowText(row);
+
+      return finalcut::FString{}.setNumber(2 * row);
+    }
+
+    std::size_t getMaxColumnWidth (int column) const override
+    {
+      return ( column == 1 ) ? 11 : 7;
+    }
+
+    static finalcut::FString getRowText (std::size_t row)
+    {
+      return finalcut::FString{"Row "} + finalcut::FString{}.setNumber(row);
+    }
+
+    // Method
+    bool sort (int column, finalcut::SortOrder order) override
+    {
+      // Only the first column is sortable
+      if ( column != 1 )
+        return false;
+
+      descending = ( order == finalcut::SortOrder::Descending );
+      return true;
+    }
+
+    // Data members
+    std::size_t rows{0};
+    mutable std::size_t text_requests{0};
+    mutable bool out_of_range{false};
+    bool descending{false};
+};
+
+
+//----------------------------------------------------------------------
+// class ScenarioApplication
+//----------------------------------------------------------------------
+
+class ScenarioApplication final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Data member
+    std::function<void(int)> scenario{};
+
+  private:
+    // Method
+    void processExternalUserEvent() override
+    {
+      // Called once per pass of the event loop
+      finalcut::FHeadlessTerminal::advanceClock (20000);  // 20 ms
+      step++;
+
+      if ( scenario )
+        scenario(step);
+    }
+
+    // Data member
+    int step{0};
+};
+
+
+//----------------------------------------------------------------------
+// class FListViewTest
+//----------------------------------------------------------------------
+
+class FListViewTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FListViewTest() = default;
+
+  protected:
+    void classNameTest();
+    void modelTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FListViewTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (modelTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FListViewTest::classNameTest()
+{
+  const BigModel model{1};
+  const finalcut::FString& classname = model.getClassName();
+  CPPUNIT_ASSERT ( classname == "FListViewModel" );
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::modelTest()
+{
+  // A list view with five million rows of a data model
+
+  using finalcut::FKey;
+  using finalcut::FPoint;
+  using finalcut::FSize;
+  static constexpr std::size_t row_count = 5000000;
+  auto& terminal = finalcut::FHeadlessTerminal::install \
+      (finalcut::FHeadlessTerminal::Profile::Xterm256color, FSize{50, 16});
+  finalcut::FHeadlessTerminal::setClock();
+  const auto& screen = terminal.getScreen();
+  char arg0[] = "flistview-test";
+  char* argv[] = { arg0, nullptr };
+  BigModel model{row_count};
+  std::array<std::size_t, 8> current{};
+  std::array<finalcut::FString, 8> first_line{};
+  std::array<finalcut::FString, 8> last_line{};
+  std::size_t requests_per_page{0};
+  bool has_model_after_clear{true};
+  int sort_column_1{0};
+  int sort_column_2{0};
+  finalcut::SortOrder sort_order_2{finalcut::SortOrder::Ascending};
+
+  {
+    ScenarioApplication app{1, argv};
+    finalcut::FWidget main_widget{&app};
+    finalcut::FDialog dialog{"List", &main_widget};
+    dialog.setGeometry (FPoint{1, 1}, FSize{44, 15});
+    finalcut::FListView list{&dialog};
+    list.setGeometry (FPoint{1, 1}, FSize{40, 12});  // 10 visible rows
+    list.addColumn ("Name");
+    list.addColumn ("Value");
+    list.setModel (&model);
+    finalcut::FWidget::setMainWidget (&main_widget);
+    main_widget.show();
+    list.setFocus();
+
+    const auto press = [&list] (FKey key)
+    {
+      finalcut::FKeyEvent ev{finalcut::Event::KeyPress, key};
+      list.onKeyPress(&ev);
+    };
+
+    const auto check = [&] (std::size_t n)
+    {
+      current[n] = list.getCurrentRow();
+      first_line[n] = screen.getLine(4);
+      last_line[n] = screen.getLine(13);
+    };
+
+    app.scenario = [&] (int step)
+    {
+      if ( step == 10 )
+      {
+        check(0);
+        requests_per_page = model.text_requests;
+        press (FKey::End);
+      }
+      else if ( step == 20 )
+      {
+        check(1);
+        press (FKey::Home);
+      }
+      else if ( step == 30 )
+      {
+        check(2);
+        press (FKey::Page_down);
+        press (FKey::Page_down);
+      }
+      else if ( step == 40 )
+      {
+        check(3);
+        finalcut::FWheelEvent ev { finalcut::Event::MouseWheel
+                                 , FPoint{5, 5}
+                                 , finalcut::MouseWheel::Down };
+        list.onWheel(&ev);
+      }
+      else if ( step == 50 )
+      {
+        check(4);
+
+        // Middle click in the middle of the vertical scrollbar
+        for (auto&& child : list.getChildren())
+        {
+          auto widget = static_cast<finalcut::FWidget*>(child);
+
+          if ( widget->getClassName() != "FScrollbar"
+            || widget->getHeight() < 2 )
+            continue;
+
+          finalcut::FMouseEvent ev { finalcut::Event::MouseDown
+                                   , FPoint{1, int(widget->getHeight() / 2)}
+                                   , finalcut::MouseButton::Middle };
+          finalcut::FApplication::sendEvent(widget, &ev);
+        }
+      }
+      else if ( step == 60 )
+      {
+        check(5);
+        press (FKey::End);
+      }
+      else if ( step == 70 )
+      {
+        // The model shrinks before reloadModel() is called
+        model.rows = 100;
+        list.redraw();
+        press (FKey::Down);
+        list.reloadModel();
+        list.redraw();
+      }
+      else if ( step == 80 )
+      {
+        check(6);
+
+        // The model cannot sort the second column
+        list.setColumnSort (1, finalcut::SortOrder::Descending);
+        list.sort();
+        sort_column_1 = list.getSortColumn();
+        list.setColumnSort (2, finalcut::SortOrder::Ascending);
+        list.sort();
+        sort_column_2 = list.getSortColumn();
+        sort_order_2 = list.getSortOrder();
+        list.clear();
+        has_model_after_clear = list.hasModel();
+        app.quit();
+      }
+    };
+
+    app.exec();
+  }
+
+  finalcut::FObject::unsetFixedTime();
+  const auto row = [] (std::size_t n)
+  {
+    return BigModel::getRowText(n) + " ";
+  };
+
+  // Only the visible rows are requested from the model
+  CPPUNIT_ASSERT ( requests_per_page > 0 );
+  CPPUNIT_ASSERT ( requests_per_page < 1000 );
+  CPPUNIT_ASSERT ( current[0] == 0 );
+  CPPUNIT_ASSERT ( first_line[0].includes(row(0)) );
+  CPPUNIT_ASSERT ( last_line[0].includes(row(9)) );
+
+  // End
+  CPPUNIT_ASSERT ( current[1] == row_count - 1 );
+  CPPUNIT_ASSERT ( first_line[1].includes(row(row_count - 10)) );
+  CPPUNIT_ASSERT ( last_line[1].includes(row(row_count - 1)) );
+
+  // Home
+  CPPUNIT_ASSERT ( current[2] == 0 );
+  CPPUNIT_ASSERT ( first_line[2].includes(row(0)) );
+
+  // Two times page down
+  CPPUNIT_ASSERT ( current[3] == 18 );
+  CPPUNIT_ASSERT ( first_line[3].includes(row(9)) );
+  CPPUNIT_ASSERT ( last_line[3].includes(row(18)) );
+
+  // Mouse wheel down
+  CPPUNIT_ASSERT ( current[4] == 22 );
+  CPPUNIT_ASSERT ( first_line[4].includes(row(13)) );
+
+  // Scrollbar jump to the middle of the list
+  CPPUNIT_ASSERT ( current[5] > row_count / 4 );
+  CPPUNIT_ASSERT ( current[5] < row_count / 4 * 3 );
+  CPPUNIT_ASSERT ( last_line[5].includes(row(current[5])) );
+
+  // The shrunken model is never asked for rows that no longer exist
+  CPPUNIT_ASSERT ( ! model.out_of_range );
+  CPPUNIT_ASSERT ( current[6] == 99 );
+  CPPUNIT_ASSERT ( first_line[6].includes(row(90)) );
+  CPPUNIT_ASSERT ( last_line[6].includes(row(99)) );
+
+  // Sorting falls back to unsorted if the model cannot sort
+  CPPUNIT_ASSERT ( sort_column_1 == 1 );
+  CPPUNIT_ASSERT ( model.descending );
+  CPPUNIT_ASSERT ( sort_column_2 == -1 );
+  CPPUNIT_ASSERT ( sort_order_2 == finalcut::SortOrder::Unsorted );
+
+  // clear() detaches the model
+  CPPUNIT_ASSERT ( ! has_model_after_clear );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FListViewTest);
+
+// The general unit test main part
+#include <main-test.inc>
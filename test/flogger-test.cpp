@@ -20,9 +20,15 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
@@ -34,6 +40,53 @@
 
 #include <final/final.h>
 
+//----------------------------------------------------------------------
+// class GateBuffer
+//----------------------------------------------------------------------
+
+// A string buffer that blocks all writes until it is opened
+class GateBuffer : public std::stringbuf
+{
+  public:
+    void open()
+    {
+      std::lock_guard<std::mutex> lock_guard(mut);
+      opened = true;
+      cond.notify_all();
+    }
+
+    std::size_t countLines() const
+    {
+      const std::string& s = str();
+      return std::size_t(std::count(s.begin(), s.end(), '\n'));
+    }
+
+  protected:
+    std::streamsize xsputn (const char* s, std::streamsize n) override
+    {
+      wait();
+      return std::stringbuf::xsputn(s, n);
+    }
+
+    int_type overflow (int_type c) override
+    {
+      wait();
+      return std::stringbuf::overflow(c);
+    }
+
+  private:
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      cond.wait (lock, [this] () { return opened; });
+    }
+
+    // Data members
+    std::mutex mut{};
+    std::condition_variable cond{};
+    bool opened{false};
+};
+
 //----------------------------------------------------------------------
 // class FLoggerTest
 //----------------------------------------------------------------------
@@ -69,9 +122,11 @@ class myLogger : public finalcut::FLog
     void setOutputStream (const std::ostream& os) override
     { output.rdbuf(os.rdbuf()); }
 
-    void setLineEnding (LineEnding) override
+    void setLineEnding (LineEnding eol) override
     {
-      // An implementation is not required in this context
+      // The mutex of FLog protects the state of derived classes
+      std::lock_guard<std::mutex> lock_guard(getMutex());
+      setEnding() = eol;
     }
 
     void enableTimestamp() override
@@ -105,6 +160,8 @@ class FLoggerTest : public CPPUNIT_NS::TestFixture
     void lineEndingTest();
     void timestampTest();
     void fileTest();
+    void asyncTest();
+    void overflowTest();
     void applicationObjectTest();
 
   private:
@@ -117,6 +174,8 @@ class FLoggerTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (lineEndingTest);
     CPPUNIT_TEST (timestampTest);
     CPPUNIT_TEST (fileTest);
+    CPPUNIT_TEST (asyncTest);
+    CPPUNIT_TEST (overflowTest);
     CPPUNIT_TEST (applicationObjectTest);
 
     // End of test suite definition
@@ -313,6 +372,168 @@ void FLoggerTest::fileTest()
   }
 }
 
+//----------------------------------------------------------------------
+void FLoggerTest::asyncTest()
+{
+  constexpr std::size_t num_threads = 4;
+  constexpr std::size_t num_lines = 2000;
+  std::ostringstream buf{};
+  finalcut::FLogger log{};
+  log.setLineEnding (finalcut::FLog::LineEnding::LF);
+  log.setOutputStream(buf);
+  CPPUNIT_ASSERT ( ! log.isAsync() );
+  CPPUNIT_ASSERT ( log.getOverflowPolicy()
+                   == finalcut::FLogger::OverflowPolicy::Drop );
+
+  log.enableAsync(100);
+  CPPUNIT_ASSERT ( log.isAsync() );
+  log.setOverflowPolicy (finalcut::FLogger::OverflowPolicy::Block);
+  std::vector<std::thread> threads{};
+
+  for (std::size_t t{0}; t < num_threads; t++)
+  {
+    threads.emplace_back ( [&log, t] ()
+                           {
+                             for (std::size_t n{0}; n < num_lines; n++)
+                               log.info ( "thread " + std::to_string(t)
+                                        + " line " + std::to_string(n) );
+                           } );
+  }
+
+  for (auto&& thread : threads)
+    thread.join();
+
+  log.flush();
+  log.disableAsync();  // Writes all queued lines
+  CPPUNIT_ASSERT ( ! log.isAsync() );
+  CPPUNIT_ASSERT ( log.getDroppedCount() == 0 );
+
+  // Each thread writes its lines in order
+  std::vector<std::size_t> next(num_threads, 0);
+  std::istringstream input{buf.str()};
+  std::string line{};
+  std::size_t count{0};
+
+  while ( std::getline(input, line) )
+  {
+    std::istringstream fields{line};
+    std::string level{}, word1{}, word2{};
+    std::size_t t{}, n{};
+    fields >> level >> word1 >> t >> word2 >> n;
+    CPPUNIT_ASSERT ( level == "[INFO]" );
+    CPPUNIT_ASSERT ( t < num_threads );
+    CPPUNIT_ASSERT ( next[t] == n );
+    next[t]++;
+    count++;
+  }
+
+  CPPUNIT_ASSERT ( count == num_threads * num_lines );
+
+  // Switching to synchronous logging while other threads log
+  buf.str("");
+  log.enableAsync(16);
+  threads.clear();
+
+  for (std::size_t t{0}; t < num_threads; t++)
+  {
+    threads.emplace_back ( [&log, t] ()
+                           {
+                             for (std::size_t n{0}; n < num_lines; n++)
+                               log.info ( "thread " + std::to_string(t)
+                                        + " line " + std::to_string(n) );
+                           } );
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  log.disableAsync();
+
+  for (auto&& thread : threads)
+    thread.join();
+
+  // The direct output does not overtake the queued lines
+  std::fill (next.begin(), next.end(), 0);
+  input.clear();
+  input.str(buf.str());
+  count = 0;
+
+  while ( std::getline(input, line) )
+  {
+    std::istringstream fields{line};
+    std::string level{}, word1{}, word2{};
+    std::size_t t{}, n{};
+    fields >> level >> word1 >> t >> word2 >> n;
+    CPPUNIT_ASSERT ( t < num_threads );
+    CPPUNIT_ASSERT ( next[t] == n );
+    next[t]++;
+    count++;
+  }
+
+  CPPUNIT_ASSERT ( count == num_threads * num_lines );
+
+  // Synchronous logging after the async mode
+  buf.str("");
+  log.warn("sync");
+  CPPUNIT_ASSERT ( buf.str() == "[WARNING] sync\n" );
+
+  // Streaming into an async logger
+  buf.str("");
+  log.enableAsync();
+  log << finalcut::FLog::LogLevel::Error << "streaming" << std::flush;
+  log.disableAsync();
+  CPPUNIT_ASSERT ( buf.str() == "[ERROR] streaming\n" );
+}
+
+//----------------------------------------------------------------------
+void FLoggerTest::overflowTest()
+{
+  constexpr std::size_t num_lines = 1000;
+  const std::string text(1000, '-');
+
+  {
+    // Drop log lines while the output stream blocks
+    GateBuffer gate{};
+    std::ostream os{&gate};
+    finalcut::FLogger log{};
+    log.setLineEnding (finalcut::FLog::LineEnding::LF);
+    log.setOutputStream(os);
+    log.enableAsync(4);
+
+    for (std::size_t n{0}; n < num_lines; n++)
+      log.debug(text);
+
+    gate.open();
+    log.disableAsync();
+    const std::size_t dropped = log.getDroppedCount();
+    CPPUNIT_ASSERT ( dropped > 0 );
+    CPPUNIT_ASSERT ( gate.countLines() == num_lines - dropped );
+  }
+
+  {
+    // Wait for free queue slots
+    GateBuffer gate{};
+    std::ostream os{&gate};
+    finalcut::FLogger log{};
+    log.setLineEnding (finalcut::FLog::LineEnding::LF);
+    log.setOutputStream(os);
+    log.setOverflowPolicy (finalcut::FLogger::OverflowPolicy::Block);
+    log.enableAsync(4);
+    std::thread opener { [&gate] ()
+                         {
+                           std::this_thread::sleep_for
+                             (std::chrono::milliseconds(100));
+                           gate.open();
+                         } };
+
+    for (std::size_t n{0}; n < num_lines; n++)
+      log.debug(text);
+
+    opener.join();
+    log.disableAsync();
+    CPPUNIT_ASSERT ( log.getDroppedCount() == 0 );
+    CPPUNIT_ASSERT ( gate.countLines() == num_lines );
+  }
+}
+
 //----------------------------------------------------------------------
 void FLoggerTest::applicationObjectTest()
 {
@@ -135,6 +135,31 @@ class FObject_userEvent : public finalcut::FObject
     int value{0};
 };
 
+//----------------------------------------------------------------------
+
+class FObject_typeId : public finalcut::FObject
+{
+  public:
+    explicit FObject_typeId (finalcut::FObject* parent = nullptr)
+      : finalcut::FObject{parent}
+    { }
+
+    finalcut::FString getClassName() const override
+    {
+      return "FObject_typeId";
+    }
+
+    static constexpr auto getClassTypeId() -> finalcut::FTypeId
+    {
+      return finalcut::makeTypeId("FObject_typeId");
+    }
+
+    bool isKindOf (finalcut::FTypeId id) const override
+    {
+      return id == getClassTypeId() || finalcut::FObject::isKindOf(id);
+    }
+};
+
 }  // namespace test
 
 
@@ -163,6 +188,7 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
     void timerTest();
     void performTimerActionTest();
     void userEventTest();
+    void typeIdTest();
 
   private:
     // Adds code needed to register the test suite
@@ -183,6 +209,7 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (timerTest);
     CPPUNIT_TEST (performTimerActionTest);
     CPPUNIT_TEST (userEventTest);
+    CPPUNIT_TEST (typeIdTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -715,6 +742,43 @@ void FObjectTest::userEventTest()
   CPPUNIT_ASSERT ( n == 10 );
 }
 
+//----------------------------------------------------------------------
+void FObjectTest::typeIdTest()
+{
+  // The type identifiers are compile-time constants
+  static_assert ( finalcut::FObject::getClassTypeId()
+                  == finalcut::makeTypeId("FObject"), "" );
+  static_assert ( finalcut::FListView::getClassTypeId()
+                  != finalcut::FListViewItem::getClassTypeId(), "" );
+  static_assert ( finalcut::FMenu::getClassTypeId()
+                  != finalcut::FDialogListMenu::getClassTypeId(), "" );
+  static_assert ( finalcut::FWidget::getClassTypeId()
+                  != finalcut::FObject::getClassTypeId(), "" );
+  static_assert ( finalcut::FWindow::getClassTypeId()
+                  != finalcut::FWidget::getClassTypeId(), "" );
+  static_assert ( finalcut::FDialog::getClassTypeId()
+                  != finalcut::FWindow::getClassTypeId(), "" );
+
+  finalcut::FObject obj;
+  test::FObject_typeId t1{&obj};
+  CPPUNIT_ASSERT ( obj.isA<finalcut::FObject>() );
+  CPPUNIT_ASSERT ( ! obj.isA<test::FObject_typeId>() );
+  CPPUNIT_ASSERT ( ! obj.isA<finalcut::FListViewItem>() );
+  CPPUNIT_ASSERT ( t1.isA<finalcut::FObject>() );
+  CPPUNIT_ASSERT ( t1.isA<test::FObject_typeId>() );
+  CPPUNIT_ASSERT ( t1.isInstanceOf("FObject_typeId") );
+
+  finalcut::FObject* ptr1 = &t1;
+  finalcut::FObject* ptr2 = &obj;
+  const finalcut::FObject* ptr3 = &t1;
+  CPPUNIT_ASSERT ( finalcut::dyn_cast<test::FObject_typeId>(ptr1) == &t1 );
+  CPPUNIT_ASSERT ( finalcut::dyn_cast<test::FObject_typeId>(ptr2) == nullptr );
+  CPPUNIT_ASSERT ( finalcut::dyn_cast<test::FObject_typeId>(ptr3) == &t1 );
+  CPPUNIT_ASSERT ( finalcut::dyn_cast<finalcut::FObject>(ptr1) == &t1 );
+  CPPUNIT_ASSERT ( finalcut::dyn_cast<test::FObject_typeId>
+                     (static_cast<finalcut::FObject*>(nullptr)) == nullptr );
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FObjectTest);
 
@@ -20,8 +20,11 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <array>
+#include <cstring>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
@@ -80,8 +83,12 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     void teratermTest();
     void ibmColorTest();
     void wyse50Test();
+    void directSGRTest();
+    void rgbColorTest();
 
   private:
+    void compareWithSGRoptimizer (const finalcut::FOptiAttr::TermEnv&);
+    static void setAttributes (finalcut::FChar&, uInt);
     std::string printSequence (const std::string&);
 
     // Adds code needed to register the test suite
@@ -103,6 +110,8 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (teratermTest);
     CPPUNIT_TEST (ibmColorTest);
     CPPUNIT_TEST (wyse50Test);
+    CPPUNIT_TEST (directSGRTest);
+    CPPUNIT_TEST (rgbColorTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -4603,6 +4612,277 @@ void FOptiAttrTest::wyse50Test()
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
 }
 
+//----------------------------------------------------------------------
+void FOptiAttrTest::directSGRTest()
+{
+  // The directly combined SGR sequences must be identical
+  // to the output of the SGRoptimizer
+
+  const char* xterm_setaf = CSI "%?%p1%{8}%<"
+                                "%t3%p1%d"
+                                "%e%p1%{16}%<"
+                                "%t9%p1%{8}%-%d"
+                                "%e38;5;%p1%d%;m";
+  const char* xterm_setab = CSI "%?%p1%{8}%<"
+                                "%t4%p1%d"
+                                "%e%p1%{16}%<"
+                                "%t10%p1%{8}%-%d"
+                                "%e48;5;%p1%d%;m";
+
+  const std::vector<finalcut::FOptiAttr::TermEnv> term_env_list =
+  {
+    {  // xterm-256color
+      CSI "1m", CSI "22m", CSI "2m", CSI "22m", CSI "3m", CSI "23m",
+      CSI "4m", CSI "24m", CSI "5m", CSI "25m", CSI "7m", CSI "27m",
+      CSI "7m", CSI "27m", CSI "8m", CSI "28m", 0, CSI "0m",
+      CSI "9m", CSI "29m", CSI "21m", CSI "24m",
+      "%?%p9%t" ESC "(0%e" ESC "(B%;" CSI "0%?%p6%t;1%;%?%p5%t;2%;"
+      "%?%p2%t;4%;%?%p1%p3%|%t;7%;%?%p4%t;5%;%?%p7%t;8%;m",
+      CSI "0m", ESC "(0", ESC "(B", 0, 0,
+      xterm_setaf, xterm_setab, 0, 0, 0, CSI "39;49m", 0,
+      256, 0, true
+    },
+    {  // linux
+      CSI "1m", CSI "22m", 0, 0, 0, 0,
+      0, 0, CSI "5m", CSI "25m", CSI "7m", CSI "27m",
+      CSI "7m", CSI "27m", 0, 0, 0, 0,
+      0, 0, 0, 0,
+      CSI "0%?%p6%|%t;1%;%?%p1%p3%|%t;7%;%?%p4%t;5%;m%?%p9%t\016%e\017%;",
+      CSI "0m\017", "\016", "\017", CSI "11m", CSI "10m",
+      CSI "3%p1%{8}%m%d%?%p1%{7}%>%t;1%e;22%;m",
+      CSI "4%p1%{8}%m%d%?%p1%{7}%>%t;5%e;25%;m",
+      0, 0, 0, CSI "39;49;25m", OSC "R",
+      16, 18, true
+    },
+    {  // putty-256color
+      CSI "1m", CSI "22m", CSI "2m", CSI "22m", 0, 0,
+      CSI "4m", CSI "24m", CSI "5m", CSI "25m", CSI "7m", CSI "27m",
+      CSI "7m", CSI "27m", 0, CSI "28m", 0, CSI "0m",
+      CSI "9m", CSI "29m", CSI "21m", CSI "24m",
+      CSI "0%?%p1%p6%|%t;1%;%?%p5%t;2%;%?%p2%t;4%;%?%p1%p3%|%t;7%;"
+      "%?%p4%t;5%;m%?%p9%t\016%e\017%;",
+      CSI "0m", "\016", "\017", CSI "11m", CSI "10m",
+      xterm_setaf, xterm_setab, 0, 0, 0, CSI "39;49m", OSC "R",
+      256, 0, false
+    },
+    {  // rxvt with fake reverse
+      CSI "1m", CSI "22m", 0, CSI "22m", 0, 0,
+      CSI "4m", CSI "24m", CSI "5m", CSI "25m", CSI "7m", CSI "27m",
+      CSI "7m", CSI "27m", 0, CSI "28m", 0, CSI "0m",
+      CSI "9m", CSI "29m", CSI "21m", CSI "24m",
+      CSI "0%?%p6%t;1%;%?%p2%t;4%;%?%p1%p3%|%t;7%;%?%p4%t;5%;m"
+      "%?%p9%t\016%e\017%;",
+      CSI "0m", "\016", "\017", 0, 0,
+      CSI "3%p1%dm", CSI "4%p1%dm", 0, 0, 0, CSI "39;49m", 0,
+      8, 7, true
+    },
+    {  // Separate attribute sequences with set_foreground/set_background
+      CSI "1m", CSI "22m", CSI "2m", CSI "22m", CSI "3m", CSI "23m",
+      CSI "4m", CSI "24m", CSI "5m", CSI "25m", CSI "7m", CSI "27m",
+      CSI "7m", CSI "27m", CSI "8m", CSI "28m", 0, 0,
+      CSI "9m", CSI "29m", CSI "21m", CSI "24m",
+      0, CSI "m", "\016", "\017", CSI "11m", CSI "10m",
+      0, 0, CSI "3%p1%dm", CSI "4%p1%dm", 0, 0, 0,
+      8, 0, false
+    }
+  };
+
+  for (auto&& term_env : term_env_list)
+    compareWithSGRoptimizer (term_env);
+
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+}
+
+//----------------------------------------------------------------------
+void FOptiAttrTest::rgbColorTest()
+{
+  const char* xterm_setaf = CSI "%?%p1%{8}%<"
+                                "%t3%p1%d"
+                                "%e%p1%{16}%<"
+                                "%t9%p1%{8}%-%d"
+                                "%e38;5;%p1%d%;m";
+  const char* xterm_setab = CSI "%?%p1%{8}%<"
+                                "%t4%p1%d"
+                                "%e%p1%{16}%<"
+                                "%t10%p1%{8}%-%d"
+                                "%e48;5;%p1%d%;m";
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (256);
+  oa.setNoColorVideo (0);
+  oa.set_exit_attribute_mode (CSI "0m");
+  oa.set_a_foreground_color (xterm_setaf);
+  oa.set_a_background_color (xterm_setab);
+  oa.set_orig_pair (CSI "39;49m");
+  oa.initialize();
+
+  // Without truecolor support, the nearest palette color is used
+  finalcut::FChar from{};
+  finalcut::FChar to{};
+  to.fg_color = finalcut::FColor::RGB;
+  to.fg_rgb = 0x123456;
+  to.bg_color = finalcut::FColor::RGB;
+  to.bg_rgb = 0x5f87af;  // Exact palette color 67
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "38;5;237m" CSI "48;5;67m" );
+  CPPUNIT_ASSERT ( from.fg_color == finalcut::FColor(237) );
+  CPPUNIT_ASSERT ( from.bg_color == finalcut::FColor(67) );
+  CPPUNIT_ASSERT ( from.fg_rgb == 0 );
+  CPPUNIT_ASSERT ( to.fg_color == finalcut::FColor::RGB );
+  CPPUNIT_ASSERT ( to.fg_rgb == 0x123456 );
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+
+  // The same palette color as an index needs no change
+  to.fg_color = finalcut::FColor(237);
+  to.fg_rgb = 0;
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+
+  // Direct colors with truecolor support
+  oa.setTrueColorSupport();
+  from = finalcut::FChar{};
+  to.fg_color = finalcut::FColor::RGB;
+  to.fg_rgb = 0x123456;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "38;2;18;52;86m" CSI "48;5;67m" );
+  CPPUNIT_ASSERT ( from.fg_color == finalcut::FColor::RGB );
+  CPPUNIT_ASSERT ( from.fg_rgb == 0x123456 );
+  CPPUNIT_ASSERT ( from.bg_color == finalcut::FColor(67) );
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+
+  // Only the changed color is sent
+  to.bg_rgb = 0xfedcba;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "48;2;254;220;186m" );
+  CPPUNIT_ASSERT ( from.bg_rgb == 0xfedcba );
+
+  // Back to the default colors
+  to.fg_color = finalcut::FColor::Default;
+  to.bg_color = finalcut::FColor::Default;
+  to.fg_rgb = 0;
+  to.bg_rgb = 0;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), CSI "39;49m" );
+  CPPUNIT_ASSERT ( from.fg_rgb == 0 );
+  CPPUNIT_ASSERT ( from.bg_rgb == 0 );
+
+  // Combined SGR sequence
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = true;
+  to.fg_color = finalcut::FColor::RGB;
+  to.fg_rgb = 0x010203;
+  to.bg_color = finalcut::FColor::RGB;
+  to.bg_rgb = 0xffffff;  // Exact palette color 231
+  to.attr.bit.bold = true;
+  oa.set_enter_bold_mode (CSI "1m");
+  oa.set_exit_bold_mode (CSI "22m");
+  oa.initialize();
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , CSI "38;2;1;2;3;48;5;231;1m" );
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+
+  // A 16-color terminal uses the base colors
+  oa.unsetTrueColorSupport();
+  oa.setMaxColor (16);
+  oa.initialize();
+  from = finalcut::FChar{};
+  to = finalcut::FChar{};
+  to.fg_color = finalcut::FColor::RGB;
+  to.fg_rgb = 0xff0000;
+  to.bg_color = finalcut::FColor::RGB;
+  to.bg_rgb = 0x0000a0;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), CSI "31m" CSI "44m" );
+  CPPUNIT_ASSERT ( from.fg_color == finalcut::FColor::Red );
+  CPPUNIT_ASSERT ( from.bg_color == finalcut::FColor::Blue );
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FOptiAttrTest::compareWithSGRoptimizer (const finalcut::FOptiAttr::TermEnv& term_env)
+{
+  auto& start_options = finalcut::FStartOptions::getFStartOptions();
+  finalcut::FOptiAttr separate_oa;
+  finalcut::FOptiAttr combined_oa;
+  separate_oa.setTermEnvironment(term_env);
+  combined_oa.setTermEnvironment(term_env);
+
+  const std::array<finalcut::FColor, 10> colors =
+  {{
+    finalcut::FColor::Default, finalcut::FColor(0),
+    finalcut::FColor(1), finalcut::FColor(7), finalcut::FColor(8),
+    finalcut::FColor(12), finalcut::FColor(15), finalcut::FColor(16),
+    finalcut::FColor(100), finalcut::FColor(255)
+  }};
+
+  finalcut::SGRoptimizer::AttributeBuffer buffer{};
+  finalcut::SGRoptimizer sgr_optimizer(buffer);
+
+  // Changes from all 8192 attribute combinations to no attributes,
+  // to the inverted attributes and to a mixed attribute combination
+  for (uInt mask{0}; mask < 0x2000; mask++)
+  {
+    const std::array<uInt, 3> next_masks =
+    {{
+      0, ~mask & 0x1fff, (mask * 2654435761U) >> 19
+    }};
+
+    for (std::size_t n{0}; n < next_masks.size(); n++)
+    {
+      finalcut::FChar term{};
+      finalcut::FChar next{};
+      setAttributes (term, mask);
+      setAttributes (next, next_masks[n]);
+      term.fg_color = colors[mask % colors.size()];
+      term.bg_color = colors[(mask / 3) % colors.size()];
+      next.fg_color = colors[(mask * 7 + n) % colors.size()];
+      next.bg_color = colors[(mask * 3 + n) % colors.size()];
+
+      finalcut::FChar term1{term};
+      finalcut::FChar next1{next};
+      finalcut::FChar term2{term};
+      finalcut::FChar next2{next};
+
+      // Separate sequences + SGRoptimizer
+      start_options.sgr_optimizer = false;
+      const char* separate = separate_oa.changeAttribute(term1, next1);
+
+      if ( separate )
+      {
+        std::strncpy (buffer.data(), separate, buffer.size() - 1);
+        sgr_optimizer.optimize();
+      }
+
+      // Directly combined sequences
+      start_options.sgr_optimizer = true;
+      const char* combined = combined_oa.changeAttribute(term2, next2);
+
+      if ( separate )
+        CPPUNIT_ASSERT_CSTRING ( combined, buffer.data() );
+      else
+        CPPUNIT_ASSERT ( combined == nullptr );
+
+      CPPUNIT_ASSERT ( term1 == term2 );
+      CPPUNIT_ASSERT ( next1 == next2 );
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiAttrTest::setAttributes (finalcut::FChar& ch, uInt mask)
+{
+  ch.attr.bit.bold          = (mask & 0x0001) != 0;
+  ch.attr.bit.dim           = (mask & 0x0002) != 0;
+  ch.attr.bit.italic        = (mask & 0x0004) != 0;
+  ch.attr.bit.underline     = (mask & 0x0008) != 0;
+  ch.attr.bit.blink         = (mask & 0x0010) != 0;
+  ch.attr.bit.reverse       = (mask & 0x0020) != 0;
+  ch.attr.bit.standout      = (mask & 0x0040) != 0;
+  ch.attr.bit.invisible     = (mask & 0x0080) != 0;
+  ch.attr.bit.protect       = (mask & 0x0100) != 0;
+  ch.attr.bit.crossed_out   = (mask & 0x0200) != 0;
+  ch.attr.bit.dbl_underline = (mask & 0x0400) != 0;
+  ch.attr.bit.alt_charset   = (mask & 0x0800) != 0;
+  ch.attr.bit.pc_charset    = (mask & 0x1000) != 0;
+}
+
 //----------------------------------------------------------------------
 std::string FOptiAttrTest::printSequence (const std::string& s)
 {
@@ -20,8 +20,10 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <array>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
@@ -77,8 +79,12 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     void puttyTest();
     void teratermTest();
     void wyse50Test();
+    void parameterFormTest();
+    void cacheTest();
+    void leftMarginAfterReturnTest();
 
   private:
+    void setXTermCapabilities (finalcut::FOptiMove&);
     std::string printSequence (const std::string&);
 
     // Adds code needed to register the test suite
@@ -98,6 +104,9 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (puttyTest);
     CPPUNIT_TEST (teratermTest);
     CPPUNIT_TEST (wyse50Test);
+    CPPUNIT_TEST (parameterFormTest);
+    CPPUNIT_TEST (cacheTest);
+    CPPUNIT_TEST (leftMarginAfterReturnTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -734,6 +743,148 @@ void FOptiMoveTest::wyse50Test()
   CPPUNIT_ASSERT_CSTRING (om.moveCursor (53, 2, 53, -3), "\v\v");
 }
 
+//----------------------------------------------------------------------
+void FOptiMoveTest::parameterFormTest()
+{
+  // Known ANSI forms are written without tparm(). The "%{0}%+" forms
+  // produce the same output, but are not recognized.
+  finalcut::FOptiMove om1;
+  finalcut::FOptiMove om2;
+  om1.setTermSize (200, 60);
+  om2.setTermSize (200, 60);
+  om1.set_cursor_address (CSI "%i%p1%d;%p2%dH");
+  om2.set_cursor_address (CSI "%i%p1%{0}%+%d;%p2%dH");
+  om1.set_column_address (CSI "%i%p1%dG");
+  om2.set_column_address (CSI "%i%p1%{0}%+%dG");
+  om1.set_row_address (CSI "%i%p1%dd");
+  om2.set_row_address (CSI "%i%p1%{0}%+%dd");
+  om1.set_parm_up_cursor (CSI "%p1%dA");
+  om2.set_parm_up_cursor (CSI "%p1%{0}%+%dA");
+  om1.set_parm_down_cursor (CSI "%p1%dB");
+  om2.set_parm_down_cursor (CSI "%p1%{0}%+%dB");
+  om1.set_parm_right_cursor (CSI "%p1%dC");
+  om2.set_parm_right_cursor (CSI "%p1%{0}%+%dC");
+  om1.set_parm_left_cursor (CSI "%p1%dD");
+  om2.set_parm_left_cursor (CSI "%p1%{0}%+%dD");
+
+  // The durations are different, so only one method is tested at a time
+  const std::vector<std::array<int, 4>> moves =
+  {
+    {{ -1, -1,   0,  0 }}, {{ -1, -1, 199, 59 }}, {{ 3, 3, 120, 45 }},
+    {{ 10,  5,  10, 50 }}, {{ 10, 50,  10,  5 }}, {{ 10, 5, 150,  5 }},
+    {{ 150, 5,  10,  5 }}, {{ 99, 40,   9,  9 }}, {{ 0,  0,   8, 30 }}
+  };
+
+  for (const auto& m : moves)
+  {
+    const char* seq1 = om1.moveCursor (m[0], m[1], m[2], m[3]);
+    const std::string s1 = seq1 ? seq1 : "";
+    const char* seq2 = om2.moveCursor (m[0], m[1], m[2], m[3]);
+    const std::string s2 = seq2 ? seq2 : "";
+    CPPUNIT_ASSERT ( ! s1.empty() );
+    CPPUNIT_ASSERT_EQUAL ( s2, s1 );
+  }
+
+  for (int y{0}; y < 60; y++)
+  {
+    for (int x{0}; x < 200; x += 7)
+    {
+      const std::string s1 = om1.moveCursor (-1, -1, x, y);
+      const std::string s2 = om2.moveCursor (-1, -1, x, y);
+      CPPUNIT_ASSERT_EQUAL ( s2, s1 );
+    }
+  }
+
+  om1.set_parm_right_cursor (CSI "%p1%dC$<5>");  // Not an ANSI form
+  om1.set_column_address (nullptr);
+  om1.set_cursor_address (nullptr);
+  CPPUNIT_ASSERT_CSTRING (om1.moveCursor (10, 5, 150, 5), CSI "140C$<5>");
+}
+
+//----------------------------------------------------------------------
+void FOptiMoveTest::cacheTest()
+{
+  finalcut::FOptiMove om;
+  setXTermCapabilities(om);
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 11, 4), CSI "12G");
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 11, 4), CSI "12G");
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (11, 4, 9, 4), "\b\b");
+
+  // Positions outside the screen share the entry of the clipped move
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (53, 22, 100, 22), CSI "80G");
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (53, 22, 79, 22), CSI "80G");
+
+  // Evict the first entries
+  for (int x{0}; x < 80; x++)
+    CPPUNIT_ASSERT ( om.moveCursor (-1, -1, x, 7) != nullptr );
+
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 11, 4), CSI "12G");
+
+  // Every mutator invalidates the cached moves
+  om.set_column_address (nullptr);
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 11, 4), CSI "2C");
+  om.set_parm_right_cursor (nullptr);
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 11, 4), CSI "C" CSI "C");
+  om.set_cursor_right (nullptr);
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 11, 4), CSI "5;12H");
+  om.setTermSize (10, 25);
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 11, 4), "");
+  om.set_cursor_address (nullptr);
+  om.set_parm_left_cursor (nullptr);
+  om.set_cursor_left (nullptr);
+  om.set_carriage_return (nullptr);
+  om.set_cursor_home (nullptr);
+  CPPUNIT_ASSERT ( om.moveCursor (9, 4, 2, 4) == nullptr );
+  CPPUNIT_ASSERT ( om.moveCursor (9, 4, 2, 4) == nullptr );
+  om.set_carriage_return ("\r");
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 4, 0, 4), "\r");
+}
+
+//----------------------------------------------------------------------
+void FOptiMoveTest::leftMarginAfterReturnTest()
+{
+  // A carriage return move must not change the terminal settings
+  finalcut::FOptiMove om;
+  setXTermCapabilities(om);
+  om.set_auto_left_margin (true);
+  om.set_eat_newline_glitch (false);
+
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (4, 1, 6, 0), "\r\b" CSI "7G");
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (9, 0, 1, 0), "\r" CSI "C");
+  CPPUNIT_ASSERT_CSTRING (om.moveCursor (4, 2, 6, 1), "\r\b" CSI "7G");
+
+  // Padding in the prefix capability
+  finalcut::FOptiMove om2;
+  om2.set_cursor_address (nullptr);
+  om2.set_carriage_return (nullptr);
+  om2.set_cursor_home (CSI "H$<5>");
+  om2.set_cursor_right (CSI "C");
+  CPPUNIT_ASSERT_CSTRING (om2.moveCursor (70, 20, 1, 0), CSI "H$<5>" CSI "C");
+}
+
+//----------------------------------------------------------------------
+void FOptiMoveTest::setXTermCapabilities (finalcut::FOptiMove& om)
+{
+  om.setTermSize (80, 25);
+  om.setBaudRate (38400);
+  om.setTabStop (8);
+  om.set_tabular ("\t");
+  om.set_back_tab (CSI "Z");
+  om.set_cursor_home (CSI "H");
+  om.set_carriage_return ("\r");
+  om.set_cursor_up (CSI "A");
+  om.set_cursor_down ("\n");
+  om.set_cursor_right (CSI "C");
+  om.set_cursor_left ("\b");
+  om.set_cursor_address (CSI "%i%p1%d;%p2%dH");
+  om.set_column_address (CSI "%i%p1%dG");
+  om.set_row_address (CSI "%i%p1%dd");
+  om.set_parm_up_cursor (CSI "%p1%dA");
+  om.set_parm_down_cursor (CSI "%p1%dB");
+  om.set_parm_right_cursor (CSI "%p1%dC");
+  om.set_parm_left_cursor (CSI "%p1%dD");
+}
+
 //----------------------------------------------------------------------
 std::string FOptiMoveTest::printSequence (const std::string& s)
 {
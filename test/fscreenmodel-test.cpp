@@ -0,0 +1,389 @@
+/***********************************************************************
+* fscreenmodel-test.cpp - FScreenModel unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FScreenModelTest
+//----------------------------------------------------------------------
+
+class FScreenModelTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FScreenModelTest() = default;
+
+  protected:
+    void classNameTest();
+    void textTest();
+    void cursorTest();
+    void wrapTest();
+    void colorTest();
+    void eraseTest();
+    void scrollTest();
+    void rectangleTest();
+    void characterSetTest();
+    void alternateScreenTest();
+    void resizeTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FScreenModelTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (textTest);
+    CPPUNIT_TEST (cursorTest);
+    CPPUNIT_TEST (wrapTest);
+    CPPUNIT_TEST (colorTest);
+    CPPUNIT_TEST (eraseTest);
+    CPPUNIT_TEST (scrollTest);
+    CPPUNIT_TEST (rectangleTest);
+    CPPUNIT_TEST (characterSetTest);
+    CPPUNIT_TEST (alternateScreenTest);
+    CPPUNIT_TEST (resizeTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FScreenModelTest::classNameTest()
+{
+  const finalcut::FScreenModel screen;
+  const finalcut::FString& classname = screen.getClassName();
+  CPPUNIT_ASSERT ( classname == "FScreenModel" );
+  CPPUNIT_ASSERT ( screen.getWidth() == 80 );
+  CPPUNIT_ASSERT ( screen.getHeight() == 24 );
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(1, 1) );
+  CPPUNIT_ASSERT ( screen.isCursorVisible() );
+  CPPUNIT_ASSERT ( ! screen.isInAlternateScreen() );
+  CPPUNIT_ASSERT ( screen.getLine(1) == finalcut::FString(80, L' ') );
+  CPPUNIT_ASSERT ( screen.getLine(0).isEmpty() );
+  CPPUNIT_ASSERT ( screen.getLine(25).isEmpty() );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::textTest()
+{
+  finalcut::FScreenModel screen{finalcut::FSize{10, 3}};
+  screen.write ("Hello\r\nWorld");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "Hello     " );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "World     " );
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(6, 2) );
+  CPPUNIT_ASSERT ( screen.getByteCount() == 12 );
+
+  // UTF-8 input and an invalid byte
+  screen.write ("\r\n\xc3\xa4\xe2\x94\x80\xff");
+  CPPUNIT_ASSERT ( screen.getCharacter({1, 3}).ch[0] == L'ä' );
+  CPPUNIT_ASSERT ( screen.getCharacter({2, 3}).ch[0] == L'─' );
+  CPPUNIT_ASSERT ( screen.getCharacter({3, 3}).ch[0] == L'�' );
+
+  // Unknown sequences are skipped
+  screen.write ("\r\033]0;Title\007\033[?2004h\033[>1u\033P+q544e\033\\x");
+  CPPUNIT_ASSERT ( screen.getLine(3) == L"x─�       " );
+
+  // Linux console palette sequences have no terminator
+  screen.write ("\r\033]P40f3a9d\033]Ry");
+  CPPUNIT_ASSERT ( screen.getLine(3) == L"y─�       " );
+
+  // Repeat the preceding character
+  screen.write ("\rx\033[3b");
+  CPPUNIT_ASSERT ( screen.getLine(3) == L"xxxx      " );
+
+  // Insert and delete characters
+  screen.write ("\r\033[2@");
+  CPPUNIT_ASSERT ( screen.getLine(3) == L"  xxxx    " );
+  screen.write ("\033[3P");
+  CPPUNIT_ASSERT ( screen.getLine(3) == L"xxx       " );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::cursorTest()
+{
+  finalcut::FScreenModel screen{finalcut::FSize{20, 10}};
+  screen.write ("\033[5;8H");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(8, 5) );
+  screen.write ("\033[2A\033[3C");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(11, 3) );
+  screen.write ("\033[B\033[4D");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(7, 4) );
+  screen.write ("\033[15G\033[9d");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(15, 9) );
+  screen.write ("\033[H");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(1, 1) );
+
+  // The cursor stays inside the screen
+  screen.write ("\033[99;99H");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(20, 10) );
+  screen.write ("\033[99A\033[99D");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(1, 1) );
+
+  // Tabs, backspace and save/restore
+  screen.write ("\tab\b");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(10, 1) );
+  screen.write ("\0337\033[5;5H\0338");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(10, 1) );
+  screen.write ("\033[Z");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(9, 1) );
+  screen.write ("\033[2I");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(20, 1) );
+  screen.write ("\033[2Z");
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(9, 1) );
+
+  // Cursor visibility
+  screen.write ("\033[?25l");
+  CPPUNIT_ASSERT ( ! screen.isCursorVisible() );
+  screen.write ("\033[?25h");
+  CPPUNIT_ASSERT ( screen.isCursorVisible() );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::wrapTest()
+{
+  finalcut::FScreenModel screen{finalcut::FSize{5, 3}};
+  screen.write ("abcde");
+  // The cursor waits at the right margin
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(5, 1) );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "     " );
+  screen.write ("f");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "abcde" );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "f    " );
+
+  // Writing into the last cell does not scroll
+  screen.write ("\033[3;1Hvwxyz");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "abcde" );
+  CPPUNIT_ASSERT ( screen.getLine(3) == "vwxyz" );
+
+  // The next character scrolls the screen up
+  screen.write ("!");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "f    " );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "vwxyz" );
+  CPPUNIT_ASSERT ( screen.getLine(3) == "!    " );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::colorTest()
+{
+  using finalcut::FColor;
+  finalcut::FScreenModel screen{finalcut::FSize{10, 2}};
+  screen.write ("\033[1;4;31;42mA\033[22;93;104mB\033[38;5;196;48;5;21mC"
+                "\033[38;2;18;52;86mD\033[0mE\033[7;9;3mF\033[m");
+
+  const auto& a = screen.getCharacter({1, 1});
+  CPPUNIT_ASSERT ( a.ch[0] == L'A' );
+  CPPUNIT_ASSERT ( a.fg_color == FColor::Red );
+  CPPUNIT_ASSERT ( a.bg_color == FColor::Green );
+  CPPUNIT_ASSERT ( a.attr.bit.bold );
+  CPPUNIT_ASSERT ( a.attr.bit.underline );
+
+  const auto& b = screen.getCharacter({2, 1});
+  CPPUNIT_ASSERT ( b.fg_color == FColor::Yellow );
+  CPPUNIT_ASSERT ( b.bg_color == FColor::LightBlue );
+  CPPUNIT_ASSERT ( ! b.attr.bit.bold );
+  CPPUNIT_ASSERT ( b.attr.bit.underline );
+
+  const auto& c = screen.getCharacter({3, 1});
+  CPPUNIT_ASSERT ( c.fg_color == FColor(196) );
+  CPPUNIT_ASSERT ( c.bg_color == FColor(21) );
+
+  const auto& d = screen.getCharacter({4, 1});
+  CPPUNIT_ASSERT ( d.fg_color == FColor::RGB );
+  CPPUNIT_ASSERT ( d.fg_rgb == 0x123456 );
+  CPPUNIT_ASSERT ( d.bg_color == FColor(21) );
+
+  const auto& e = screen.getCharacter({5, 1});
+  CPPUNIT_ASSERT ( e.fg_color == FColor::Default );
+  CPPUNIT_ASSERT ( e.bg_color == FColor::Default );
+  CPPUNIT_ASSERT ( e.attr.byte[0] == 0 );
+  CPPUNIT_ASSERT ( e.attr.byte[1] == 0 );
+
+  const auto& f = screen.getCharacter({6, 1});
+  CPPUNIT_ASSERT ( f.attr.bit.reverse );
+  CPPUNIT_ASSERT ( f.attr.bit.crossed_out );
+  CPPUNIT_ASSERT ( f.attr.bit.italic );
+  CPPUNIT_ASSERT ( ! f.attr.bit.underline );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::eraseTest()
+{
+  using finalcut::FColor;
+  finalcut::FScreenModel screen{finalcut::FSize{6, 3}};
+  screen.write ("abcdef\r\nghijkl\r\nmnopqr");
+  screen.write ("\033[2;3H\033[K");
+  CPPUNIT_ASSERT ( screen.getLine(2) == "gh    " );
+  screen.write ("\033[1;4H\033[1K");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "    ef" );
+  screen.write ("\033[3;2H\033[2X");
+  CPPUNIT_ASSERT ( screen.getLine(3) == "m  pqr" );
+
+  // Erased cells get the background color
+  screen.write ("\033[44m\033[3;5H\033[J");
+  CPPUNIT_ASSERT ( screen.getLine(3) == "m  p  " );
+  CPPUNIT_ASSERT ( screen.getCharacter({6, 3}).bg_color == FColor::Blue );
+  CPPUNIT_ASSERT ( screen.getCharacter({4, 3}).bg_color == FColor::Default );
+
+  screen.write ("\033[2J");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "      " );
+  CPPUNIT_ASSERT ( screen.getLine(3) == "      " );
+  CPPUNIT_ASSERT ( screen.getCharacter({1, 1}).bg_color == FColor::Blue );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::scrollTest()
+{
+  finalcut::FScreenModel screen{finalcut::FSize{3, 5}};
+  screen.write ("111\r\n222\r\n333\r\n444\r\n555");
+
+  // Scroll region 2...4
+  screen.write ("\033[2;4r\033[4;1H\n");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "111" );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "333" );
+  CPPUNIT_ASSERT ( screen.getLine(3) == "444" );
+  CPPUNIT_ASSERT ( screen.getLine(4) == "   " );
+  CPPUNIT_ASSERT ( screen.getLine(5) == "555" );
+
+  // Reverse index at the top margin
+  screen.write ("\033[2;1H\033M");
+  CPPUNIT_ASSERT ( screen.getLine(2) == "   " );
+  CPPUNIT_ASSERT ( screen.getLine(3) == "333" );
+  CPPUNIT_ASSERT ( screen.getLine(4) == "444" );
+
+  // Insert and delete lines
+  screen.write ("\033[r\033[1;1H\033[M");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "   " );
+  CPPUNIT_ASSERT ( screen.getLine(4) == "555" );
+  CPPUNIT_ASSERT ( screen.getLine(5) == "   " );
+  screen.write ("\033[2L");
+  CPPUNIT_ASSERT ( screen.getLine(3) == "   " );
+  CPPUNIT_ASSERT ( screen.getLine(4) == "333" );
+  CPPUNIT_ASSERT ( screen.getLine(5) == "444" );
+
+  // Scroll up and down
+  screen.write ("\033[3S");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "333" );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "444" );
+  screen.write ("\033[T");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "   " );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "333" );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::rectangleTest()
+{
+  using finalcut::FColor;
+  finalcut::FScreenModel screen{finalcut::FSize{6, 4}};
+  screen.write ("abc\r\ndef");
+
+  // DECCRA - copies lines 1...2, columns 1...3 to (3, 4)
+  screen.write ("\033[1;1;2;3;1;3;4;1$v");
+  CPPUNIT_ASSERT ( screen.getLine(3) == "   abc" );
+  CPPUNIT_ASSERT ( screen.getLine(4) == "   def" );
+
+  // Overlapping copy
+  screen.write ("\033[1;1;2;3;1;1;2;1$v");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "aabc  " );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "ddef  " );
+
+  // DECFRA - fills with '#'
+  screen.write ("\033[41m\033[35;2;5;3;6$x");
+  CPPUNIT_ASSERT ( screen.getLine(2) == "ddef##" );
+  CPPUNIT_ASSERT ( screen.getLine(3) == "   a##" );
+  CPPUNIT_ASSERT ( screen.getCharacter({5, 2}).bg_color == FColor::Red );
+
+  // DECERA - erases with the current background color
+  screen.write ("\033[44m\033[1;1;4;2$z");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "  bc  " );
+  CPPUNIT_ASSERT ( screen.getLine(4) == "   def" );
+  CPPUNIT_ASSERT ( screen.getCharacter({2, 4}).bg_color == FColor::Blue );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::characterSetTest()
+{
+  finalcut::FScreenModel screen{finalcut::FSize{8, 1}};
+  // G0 = DEC special graphics
+  screen.write ("\033(0lqk\033(Bq");
+  CPPUNIT_ASSERT ( screen.getLine(1) == L"┌─┐q    " );
+
+  // G1 = DEC special graphics with shift out/in
+  screen.write ("\033)0\x0exa\x0fx");
+  CPPUNIT_ASSERT ( screen.getLine(1) == L"┌─┐q│▒x " );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::alternateScreenTest()
+{
+  finalcut::FScreenModel screen{finalcut::FSize{5, 2}};
+  screen.write ("shell\033[2;3H");
+  screen.write ("\033[?1049h");
+  CPPUNIT_ASSERT ( screen.isInAlternateScreen() );
+  CPPUNIT_ASSERT ( screen.getLine(1) == "     " );
+  screen.write ("\033[Happ");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "app  " );
+
+  // Back to the primary screen with the saved cursor
+  screen.write ("\033[?1049l");
+  CPPUNIT_ASSERT ( ! screen.isInAlternateScreen() );
+  CPPUNIT_ASSERT ( screen.getLine(1) == "shell" );
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(3, 2) );
+
+  // Full reset
+  screen.write ("\033[31m\033c");
+  CPPUNIT_ASSERT ( screen.getLine(1) == "     " );
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(1, 1) );
+  screen.write ("x");
+  CPPUNIT_ASSERT ( screen.getCharacter({1, 1}).fg_color == finalcut::FColor::Default );
+}
+
+//----------------------------------------------------------------------
+void FScreenModelTest::resizeTest()
+{
+  finalcut::FScreenModel screen{finalcut::FSize{4, 2}};
+  screen.write ("abcd\r\nefgh");
+  screen.setSize ({6, 3});
+  CPPUNIT_ASSERT ( screen.getWidth() == 6 );
+  CPPUNIT_ASSERT ( screen.getHeight() == 3 );
+  CPPUNIT_ASSERT ( screen.getLine(1) == "abcd  " );
+  CPPUNIT_ASSERT ( screen.getLine(2) == "efgh  " );
+  CPPUNIT_ASSERT ( screen.getLine(3) == "      " );
+
+  screen.setSize ({2, 1});
+  CPPUNIT_ASSERT ( screen.getLine(1) == "ab" );
+  CPPUNIT_ASSERT ( screen.getCursorPos() == finalcut::FPoint(2, 1) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FScreenModelTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,273 @@
+/***********************************************************************
+* fsessionrecorder-test.cpp - FSessionRecorder unit tests              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FSessionRecorderTest
+//----------------------------------------------------------------------
+
+class FSessionRecorderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FSessionRecorderTest() = default;
+
+  protected:
+    void classNameTest();
+    void jsonTest();
+    void outputTest();
+    void recordTest();
+    void replayLoadTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FSessionRecorderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (jsonTest);
+    CPPUNIT_TEST (outputTest);
+    CPPUNIT_TEST (recordTest);
+    CPPUNIT_TEST (replayLoadTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FSessionRecorderTest::classNameTest()
+{
+  const finalcut::FSessionRecorder recorder;
+  const finalcut::FString& classname = recorder.getClassName();
+  CPPUNIT_ASSERT ( classname == "FSessionRecorder" );
+  CPPUNIT_ASSERT ( ! recorder.isRecording() );
+  CPPUNIT_ASSERT ( recorder.getEventCount() == 0 );
+
+  const finalcut::FSessionReplay replay;
+  CPPUNIT_ASSERT ( replay.getClassName() == "FSessionReplay" );
+  CPPUNIT_ASSERT ( replay.getSize() == finalcut::FSize(80, 24) );
+  CPPUNIT_ASSERT ( replay.getEventCount() == 0 );
+  CPPUNIT_ASSERT ( ! replay.isFinished() );
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorderTest::jsonTest()
+{
+  using Event = finalcut::FSessionRecorder::Event;
+  using finalcut::FSessionRecorder;
+  Event event{};
+  event.time = 1500000;
+  event.type = 'o';
+  event.data = "\033[1;1Hab\"c\\\r\n\t";
+  CPPUNIT_ASSERT ( FSessionRecorder::toJSON(event)
+                   == "[1.500000, \"o\", \"\\u001b[1;1Hab\\\"c\\\\\\r\\n\\t\"]" );
+
+  // Valid UTF-8 is kept, other bytes become U+DC80...U+DCFF
+  event.time = 42;
+  event.type = 'i';
+  event.data = "\xc3\xa4\xe2\x94\x80\xff\x7f";
+  CPPUNIT_ASSERT ( FSessionRecorder::toJSON(event)
+                   == "[0.000042, \"i\", \"\xc3\xa4\xe2\x94\x80\\udcff\\u007f\"]" );
+
+  // Round trip
+  Event result{};
+  CPPUNIT_ASSERT ( FSessionRecorder::fromJSON(FSessionRecorder::toJSON(event), result) );
+  CPPUNIT_ASSERT ( result.time == 42 );
+  CPPUNIT_ASSERT ( result.type == 'i' );
+  CPPUNIT_ASSERT ( result.data == event.data );
+
+  // Lines of other asciicast writers
+  CPPUNIT_ASSERT ( FSessionRecorder::fromJSON("[12.5,\"o\",\"\\u00e4\\ud83d\\ude00\\/\"]", result) );
+  CPPUNIT_ASSERT ( result.time == 12500000 );
+  CPPUNIT_ASSERT ( result.type == 'o' );
+  CPPUNIT_ASSERT ( result.data == "\xc3\xa4\xf0\x9f\x98\x80/" );
+  CPPUNIT_ASSERT ( FSessionRecorder::fromJSON("[0.1234567, \"r\", \"100x40\"]", result) );
+  CPPUNIT_ASSERT ( result.time == 123456 );
+  CPPUNIT_ASSERT ( result.data == "100x40" );
+
+  // Invalid lines
+  CPPUNIT_ASSERT ( ! FSessionRecorder::fromJSON("", result) );
+  CPPUNIT_ASSERT ( ! FSessionRecorder::fromJSON("[\"o\", \"x\"]", result) );
+  CPPUNIT_ASSERT ( ! FSessionRecorder::fromJSON("[1.0, \"o\", \"x]", result) );
+  CPPUNIT_ASSERT ( ! FSessionRecorder::fromJSON("[1.0, \"out\", \"x\"]", result) );
+  CPPUNIT_ASSERT ( ! FSessionRecorder::fromJSON("[1.0, \"o\", \"\\u12\"]", result) );
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorderTest::outputTest()
+{
+  // The bytes written by FTerm are recorded as they are
+
+  using finalcut::FTerm;
+  const std::string filename{"session-output-test.cast"};
+  finalcut::FHeadlessTerminal::install \
+      (finalcut::FHeadlessTerminal::Profile::Xterm256color, finalcut::FSize{80, 24});
+  const auto& recorder = FTerm::getFSessionRecorder();
+  timeval time{100, 0};
+  finalcut::FObject::setFixedTime (time);
+  FTerm::putstring ("\033[?1049h");  // Not recorded
+  CPPUNIT_ASSERT ( recorder->start(filename, finalcut::FSize{80, 24}) );
+
+  FTerm::putstring ("\033[?1049h");
+  FTerm::putchar_UTF8 (L'\u2500');
+  recorder->flushOutput();
+  recorder->flushOutput();  // No new output
+  CPPUNIT_ASSERT ( recorder->getEventCount() == 1 );
+
+  // The stop writes the remaining output
+  time.tv_sec = 102;
+  finalcut::FObject::setFixedTime (time);
+  FTerm::putchar_ASCII ('x');
+  FTerm::putstring ("\033[?1049l");
+  recorder->stop();
+  finalcut::FObject::unsetFixedTime();
+  CPPUNIT_ASSERT ( recorder->getEventCount() == 2 );
+
+  std::ifstream file_stream{filename};
+  std::vector<std::string> lines{};
+  std::string line{};
+
+  while ( std::getline(file_stream, line) )
+    lines.push_back(line);
+
+  file_stream.close();
+  std::remove(filename.c_str());
+  CPPUNIT_ASSERT ( lines.size() == 3 );
+  CPPUNIT_ASSERT ( lines[1] == "[0.000000, \"o\", \"\\u001b[?1049h\xe2\x94\x80\"]" );
+  CPPUNIT_ASSERT ( lines[2] == "[2.000000, \"o\", \"x\\u001b[?1049l\"]" );
+
+  // Restores the standard output of the headless terminal
+  std::unique_ptr<finalcut::FSystem> fsys{new finalcut::FSystemImpl};
+  FTerm::setFSystem(fsys);
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorderTest::recordTest()
+{
+  const std::string filename{"session-test.cast"};
+  finalcut::FSessionRecorder recorder{};
+  timeval time{100, 0};
+  finalcut::FObject::setFixedTime (time);
+  CPPUNIT_ASSERT ( recorder.start(filename, finalcut::FSize{100, 30}) );
+  CPPUNIT_ASSERT ( recorder.isRecording() );
+
+  time.tv_usec = 250000;
+  finalcut::FObject::setFixedTime (time);
+  recorder.recordOutput ("\033[Hhello");
+  recorder.recordOutput ("");  // Ignored
+  time.tv_sec = 101;
+  finalcut::FObject::setFixedTime (time);
+  recorder.recordInput ("\033[A");
+  recorder.recordResize (finalcut::FSize{90, 25});
+  CPPUNIT_ASSERT ( recorder.getEventCount() == 3 );
+  recorder.stop();
+  finalcut::FObject::unsetFixedTime();
+  CPPUNIT_ASSERT ( ! recorder.isRecording() );
+
+  // Events after the end of the recording are ignored
+  recorder.recordOutput ("lost");
+  CPPUNIT_ASSERT ( recorder.getEventCount() == 3 );
+
+  std::ifstream file_stream{filename};
+  std::vector<std::string> lines{};
+  std::string line{};
+
+  while ( std::getline(file_stream, line) )
+    lines.push_back(line);
+
+  file_stream.close();
+  std::remove(filename.c_str());
+  CPPUNIT_ASSERT ( lines.size() == 4 );
+  CPPUNIT_ASSERT ( lines[0].find("{\"version\": 2, \"width\": 100, "
+                                 "\"height\": 30, \"timestamp\": 100") == 0 );
+  CPPUNIT_ASSERT ( lines[1] == "[0.250000, \"o\", \"\\u001b[Hhello\"]" );
+  CPPUNIT_ASSERT ( lines[2] == "[1.250000, \"i\", \"\\u001b[A\"]" );
+  CPPUNIT_ASSERT ( lines[3] == "[1.250000, \"r\", \"90x25\"]" );
+
+  // A file that cannot be created
+  CPPUNIT_ASSERT ( ! recorder.start("/nonexistent/dir/x.cast", finalcut::FSize{80, 24}) );
+  CPPUNIT_ASSERT ( ! recorder.isRecording() );
+}
+
+//----------------------------------------------------------------------
+void FSessionRecorderTest::replayLoadTest()
+{
+  std::istringstream cast
+  {
+    "{\"version\": 2, \"width\": 120, \"height\": 40}\n"
+    "[0.100000, \"o\", \"start\"]\n"
+    "[1.000000, \"i\", \"a\"]\n"
+    "[1.004000, \"o\", \"a\"]\n"
+    "[2.000000, \"i\", \"b\"]\n"
+    "\n"
+    "[2.500000, \"r\", \"80x24\"]\n"
+    "[3.000000, \"i\", \"c\"]\n"
+    "[3.000000, \"r\", \"90x24\"]\n"
+    "[3.020000, \"o\", \"c\"]\n"
+  };
+
+  finalcut::FSessionReplay replay{};
+  CPPUNIT_ASSERT ( replay.load(cast) );
+  CPPUNIT_ASSERT ( replay.getSize() == finalcut::FSize(120, 40) );
+  CPPUNIT_ASSERT ( replay.getEventCount() == 8 );
+
+  const auto& timings = replay.getFrameTimings();
+  CPPUNIT_ASSERT ( timings.size() == 3 );
+  CPPUNIT_ASSERT ( timings[0].input_time == 1000000 );
+  CPPUNIT_ASSERT ( timings[0].recorded_frame );
+  CPPUNIT_ASSERT ( timings[0].recorded_latency == 4000 );
+  CPPUNIT_ASSERT ( ! timings[0].replayed_frame );
+  // No output before the next input
+  CPPUNIT_ASSERT ( timings[1].input_time == 2000000 );
+  CPPUNIT_ASSERT ( ! timings[1].recorded_frame );
+  // Resize events are skipped
+  CPPUNIT_ASSERT ( timings[2].recorded_frame );
+  CPPUNIT_ASSERT ( timings[2].recorded_latency == 20000 );
+
+  // Wrong version and broken event lines
+  std::istringstream version_1{"{\"version\": 1, \"width\": 80}\n"};
+  CPPUNIT_ASSERT ( ! replay.load(version_1) );
+  std::istringstream broken{"{\"version\": 2}\n[0.1, \"o\"]\n"};
+  CPPUNIT_ASSERT ( ! replay.load(broken) );
+  CPPUNIT_ASSERT ( ! replay.load(finalcut::FString("/nonexistent.cast")) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FSessionRecorderTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -54,6 +54,7 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture, test::ConEmu
     void FullWidthHalfWidthTest();
     void combiningCharacterTest();
     void readCursorPosTest();
+    void queryTerminalTest();
 
   private:
     // Constant
@@ -69,6 +70,7 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture, test::ConEmu
     CPPUNIT_TEST (FullWidthHalfWidthTest);
     CPPUNIT_TEST (combiningCharacterTest);
     CPPUNIT_TEST (readCursorPosTest);
+    CPPUNIT_TEST (queryTerminalTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -2568,6 +2570,73 @@ void FTermFunctionsTest::readCursorPosTest()
   }
 }
 
+//----------------------------------------------------------------------
+void FTermFunctionsTest::queryTerminalTest()
+{
+  finalcut::FTermData& data = *finalcut::FTerm::getFTermData();
+  finalcut::FTermDetection detect;
+  data.setTermType("xterm");
+  detect.setTerminalDetection(true);
+
+  pid_t pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    // Several queries with a single round trip
+    CPPUNIT_ASSERT ( data.isTermResponsive() );
+    const auto& answer = finalcut::queryTerminal ( "\033[6n\033[>c"
+                                                 , 600000, 2 );
+    CPPUNIT_ASSERT ( answer == "\033[25;80R\033[>41;312;0c" );
+    CPPUNIT_ASSERT ( data.isTermResponsive() );
+
+    // The cursor position report within other answers
+    CPPUNIT_ASSERT ( finalcut::parseCursorPos(answer) == finalcut::FPoint(80, 25) );
+    CPPUNIT_ASSERT ( finalcut::parseCursorPos("\033[>41;312;0c") == finalcut::FPoint(-1, -1) );
+    CPPUNIT_ASSERT ( finalcut::parseCursorPos("\033[1;5P\033[3;7R") == finalcut::FPoint(7, 3) );
+
+    // Without a query only the sentinel is answered
+    CPPUNIT_ASSERT ( finalcut::queryTerminal ("", 600000).empty() );
+    CPPUNIT_ASSERT ( data.isTermResponsive() );
+
+    closeConEmuStdStreams();
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::xterm);
+
+    if ( waitpid(pid, 0, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+  }
+
+  pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    // The ansi terminal does not answer the device attributes
+    CPPUNIT_ASSERT ( finalcut::queryTerminal ("\033[>c", 100000).empty() );
+    CPPUNIT_ASSERT ( ! data.isTermResponsive() );
+
+    // No further queries to an unresponsive terminal
+    const finalcut::FPoint cursor_pos = finalcut::readCursorPos();
+    CPPUNIT_ASSERT ( cursor_pos.getX() == -1 );
+    CPPUNIT_ASSERT ( cursor_pos.getY() == -1 );
+    data.setTermResponsive();
+
+    closeConEmuStdStreams();
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::ansi);
+
+    if ( waitpid(pid, 0, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+  }
+}
+
 
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FTermFunctionsTest);
@@ -0,0 +1,292 @@
+/***********************************************************************
+* ftermcapcache-test.cpp - FTermcapCache unit tests                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FTermcapCacheTest
+//----------------------------------------------------------------------
+
+class FTermcapCacheTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FTermcapCacheTest();
+    ~FTermcapCacheTest();
+
+  protected:
+    void classNameTest();
+    void disabledTest();
+    void saveLoadTest();
+    void keyTest();
+    void refreshTest();
+    void termcapTest();
+
+  private:
+    void removeCacheFile (const finalcut::FTermcapCache&);
+
+    // Data member
+    char cache_dir[32]{"/tmp/fcache-test-XXXXXX"};
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermcapCacheTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (disabledTest);
+    CPPUNIT_TEST (saveLoadTest);
+    CPPUNIT_TEST (keyTest);
+    CPPUNIT_TEST (refreshTest);
+    CPPUNIT_TEST (termcapTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+FTermcapCacheTest::FTermcapCacheTest()
+{
+  // Use a private cache directory
+  if ( mkdtemp(cache_dir) )
+    setenv ("XDG_CACHE_HOME", cache_dir, 1);
+}
+
+//----------------------------------------------------------------------
+FTermcapCacheTest::~FTermcapCacheTest()
+{
+  const std::string dir{cache_dir};
+  rmdir ((dir + "/finalcut").c_str());
+  rmdir (cache_dir);
+}
+
+//----------------------------------------------------------------------
+void FTermcapCacheTest::classNameTest()
+{
+  const finalcut::FTermcapCache cache;
+  const finalcut::FString& classname = cache.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTermcapCache" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapCacheTest::disabledTest()
+{
+  finalcut::FTermcapCache cache;
+  CPPUNIT_ASSERT ( ! cache.isEnabled() );
+  CPPUNIT_ASSERT ( ! cache.isLoaded() );
+  CPPUNIT_ASSERT ( ! cache.isRestored() );
+
+  // A disabled cache neither reads nor writes files
+  CPPUNIT_ASSERT ( ! cache.load ("xterm", "", "\033[>0;115;0c") );
+  CPPUNIT_ASSERT ( cache.getKey().empty() );
+  CPPUNIT_ASSERT ( cache.getFileName().empty() );
+  cache.setValue ("color.256color", "1");
+  CPPUNIT_ASSERT ( cache.hasValue("color.256color") );
+  CPPUNIT_ASSERT ( ! cache.save() );
+  CPPUNIT_ASSERT ( ! cache.restoreTermcap() );
+}
+
+//----------------------------------------------------------------------
+void FTermcapCacheTest::saveLoadTest()
+{
+  finalcut::FTermcapCache cache;
+  cache.setEnabled();
+  CPPUNIT_ASSERT ( cache.isEnabled() );
+  CPPUNIT_ASSERT ( ! cache.load ("xterm", "PuTTY", "\033[>0;136;0c") );
+  CPPUNIT_ASSERT ( ! cache.isLoaded() );
+  CPPUNIT_ASSERT ( ! cache.getKey().empty() );
+  CPPUNIT_ASSERT ( cache.getKey().find(' ') != std::string::npos );
+
+  const auto& filename = cache.getFileName();
+  CPPUNIT_ASSERT ( filename.find(cache_dir) == 0 );
+  CPPUNIT_ASSERT ( filename.find("/finalcut/termcap-") != std::string::npos );
+
+  // Values with control characters, spaces and escapes
+  cache.setValue ("color.termtype", "putty-256color");
+  cache.setValue ("empty", "");
+  cache.setValue ("sequence", "\033[%i%p1%d;%p2%dH\r\n\t\\ =\177\200");
+  CPPUNIT_ASSERT ( cache.save() );
+  CPPUNIT_ASSERT ( access(filename.c_str(), R_OK) == 0 );
+
+  finalcut::FTermcapCache cache2;
+  cache2.setEnabled();
+  CPPUNIT_ASSERT ( cache2.load ("xterm", "PuTTY", "\033[>0;136;0c") );
+  CPPUNIT_ASSERT ( cache2.isLoaded() );
+  CPPUNIT_ASSERT ( cache2.getKey() == cache.getKey() );
+  CPPUNIT_ASSERT ( cache2.getValue("color.termtype") == "putty-256color" );
+  CPPUNIT_ASSERT ( cache2.hasValue("empty") );
+  CPPUNIT_ASSERT ( cache2.getValue("empty").empty() );
+  CPPUNIT_ASSERT ( cache2.getValue("sequence")
+                   == "\033[%i%p1%d;%p2%dH\r\n\t\\ =\177\200" );
+  CPPUNIT_ASSERT ( ! cache2.hasValue("unknown") );
+  CPPUNIT_ASSERT ( cache2.getValue("unknown").empty() );
+
+  // No termcap values in the cache
+  CPPUNIT_ASSERT ( ! cache2.restoreTermcap() );
+  CPPUNIT_ASSERT ( ! cache2.isRestored() );
+
+  cache2.clear();
+  CPPUNIT_ASSERT ( ! cache2.isLoaded() );
+  CPPUNIT_ASSERT ( cache2.getKey().empty() );
+  CPPUNIT_ASSERT ( ! cache2.hasValue("color.termtype") );
+  removeCacheFile (cache);
+}
+
+//----------------------------------------------------------------------
+void FTermcapCacheTest::keyTest()
+{
+  finalcut::FTermcapCache cache;
+  cache.setEnabled();
+  cache.load ("xterm", "", "\033[>0;115;0c");
+  cache.setValue ("color.256color", "1");
+  CPPUNIT_ASSERT ( cache.save() );
+
+  // Every part of the key selects a different cache entry
+  finalcut::FTermcapCache cache2;
+  cache2.setEnabled();
+  CPPUNIT_ASSERT ( ! cache2.load ("rxvt", "", "\033[>0;115;0c") );
+  CPPUNIT_ASSERT ( cache2.getKey() != cache.getKey() );
+  CPPUNIT_ASSERT ( ! cache2.load ("xterm", "xterm", "\033[>0;115;0c") );
+  CPPUNIT_ASSERT ( cache2.getKey() != cache.getKey() );
+  CPPUNIT_ASSERT ( ! cache2.load ("xterm", "", "\033[>1;5202;0c") );
+  CPPUNIT_ASSERT ( cache2.getKey() != cache.getKey() );
+  CPPUNIT_ASSERT ( cache2.getFileName() != cache.getFileName() );
+  CPPUNIT_ASSERT ( cache2.load ("xterm", "", "\033[>0;115;0c") );
+  CPPUNIT_ASSERT ( cache2.getValue("color.256color") == "1" );
+  removeCacheFile (cache);
+}
+
+//----------------------------------------------------------------------
+void FTermcapCacheTest::refreshTest()
+{
+  finalcut::FTermcapCache cache;
+  cache.setEnabled();
+  cache.load ("screen", "", "\033[>83;40003;0c");
+  cache.setValue ("color.termtype", "screen-256color");
+  CPPUNIT_ASSERT ( cache.save() );
+
+  // The refresh mode ignores the stored values, but writes new ones
+  finalcut::FTermcapCache cache2;
+  cache2.setEnabled();
+  cache2.setRefresh();
+  CPPUNIT_ASSERT ( ! cache2.load ("screen", "", "\033[>83;40003;0c") );
+  CPPUNIT_ASSERT ( ! cache2.hasValue("color.termtype") );
+  cache2.setValue ("color.termtype", "screen-16color");
+  CPPUNIT_ASSERT ( cache2.save() );
+
+  cache2.setRefresh(false);
+  CPPUNIT_ASSERT ( cache2.load ("screen", "", "\033[>83;40003;0c") );
+  CPPUNIT_ASSERT ( cache2.getValue("color.termtype") == "screen-16color" );
+  removeCacheFile (cache);
+}
+
+//----------------------------------------------------------------------
+void FTermcapCacheTest::termcapTest()
+{
+  auto& caps = finalcut::FTermcap::strings;
+  const auto& data = finalcut::FTerm::getFTermData();
+  const auto& term_detection = finalcut::FTerm::getFTermDetection();
+  term_detection->setXTerminal (true);
+  data->setTermType (term_detection->getTermType());
+
+  for (auto&& cap : caps)
+    cap.string = nullptr;
+
+  caps[int(finalcut::Termcap::t_cursor_address)].string = CSI "%i%p1%d;%p2%dH";
+  caps[int(finalcut::Termcap::t_pad_char)].string = "\001";
+  caps[int(finalcut::Termcap::t_exit_attribute_mode)].string = CSI "0m";
+  finalcut::fc::fkey_cap_table[0].string = CSI "Z";
+  finalcut::FTermcap::max_color = 256;
+  finalcut::FTermcap::tabstop = 8;
+  finalcut::FTermcap::osc_support = true;
+  finalcut::FTermcap::eat_nl_glitch = false;
+
+  finalcut::FTermcapCache cache;
+  cache.setEnabled();
+  cache.load ("xterm-256color", "", "\033[>0;115;0c");
+  cache.storeTermcap();
+  CPPUNIT_ASSERT ( cache.save() );
+
+  // Change the termcap values
+  for (auto&& cap : caps)
+    cap.string = "-";
+
+  finalcut::fc::fkey_cap_table[0].string = nullptr;
+  finalcut::FTermcap::max_color = 8;
+  finalcut::FTermcap::tabstop = 0;
+  finalcut::FTermcap::osc_support = false;
+  finalcut::FTermcap::eat_nl_glitch = true;
+
+  finalcut::FTermcapCache cache2;
+  cache2.setEnabled();
+  CPPUNIT_ASSERT ( cache2.load ("xterm-256color", "", "\033[>0;115;0c") );
+  CPPUNIT_ASSERT ( cache2.restoreTermcap() );
+  CPPUNIT_ASSERT ( cache2.isRestored() );
+  CPPUNIT_ASSERT ( finalcut::FTermcap::isInitialized() );
+  CPPUNIT_ASSERT ( finalcut::FTermcap::max_color == 256 );
+  CPPUNIT_ASSERT ( finalcut::FTermcap::tabstop == 8 );
+  CPPUNIT_ASSERT ( finalcut::FTermcap::osc_support );
+  CPPUNIT_ASSERT ( ! finalcut::FTermcap::eat_nl_glitch );
+  CPPUNIT_ASSERT ( ! data->isMonochron() );
+  CPPUNIT_ASSERT ( std::strcmp ( caps[int(finalcut::Termcap::t_cursor_address)].string
+                               , CSI "%i%p1%d;%p2%dH" ) == 0 );
+  CPPUNIT_ASSERT ( std::strcmp ( caps[int(finalcut::Termcap::t_pad_char)].string
+                               , "\001" ) == 0 );
+  CPPUNIT_ASSERT ( std::strcmp ( caps[int(finalcut::Termcap::t_exit_attribute_mode)].string
+                               , CSI "0m" ) == 0 );
+  CPPUNIT_ASSERT ( caps[int(finalcut::Termcap::t_bell)].string == nullptr );
+  CPPUNIT_ASSERT ( std::strcmp (finalcut::fc::fkey_cap_table[0].string, CSI "Z") == 0 );
+
+  // A different detection result invalidates the cached termcap values
+  term_detection->setXTerminal (false);
+  CPPUNIT_ASSERT ( ! cache2.restoreTermcap() );
+  CPPUNIT_ASSERT ( ! cache2.isRestored() );
+  term_detection->setXTerminal (true);
+  data->setTermType ("vt100");
+  CPPUNIT_ASSERT ( ! cache2.restoreTermcap() );
+  removeCacheFile (cache);
+}
+
+//----------------------------------------------------------------------
+void FTermcapCacheTest::removeCacheFile (const finalcut::FTermcapCache& cache)
+{
+  const auto& filename = cache.getFileName();
+  CPPUNIT_ASSERT ( unlink(filename.c_str()) == 0 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermcapCacheTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -86,6 +86,7 @@ class FTermDetectionTest : public CPPUNIT_NS::TestFixture, test::ConEmu
     void ktermTest();
     void mltermTest();
     void ttytypeTest();
+    void keyboardProtocolTest();
 
   private:
     // Adds code needed to register the test suite
@@ -115,6 +116,7 @@ class FTermDetectionTest : public CPPUNIT_NS::TestFixture, test::ConEmu
     CPPUNIT_TEST (ktermTest);
     CPPUNIT_TEST (mltermTest);
     CPPUNIT_TEST (ttytypeTest);
+    CPPUNIT_TEST (keyboardProtocolTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -122,7 +124,15 @@ class FTermDetectionTest : public CPPUNIT_NS::TestFixture, test::ConEmu
 
 //----------------------------------------------------------------------
 FTermDetectionTest::FTermDetectionTest()
-{ }
+{
+  // Keep the capability cache away from the user's cache directory
+  finalcut::FTerm::getFTermcapCache()->setEnabled(false);
+
+  // The xterm font and title query of the detection uses the
+  // FTermDetection object of FTerm. Its constructor must not reset
+  // the static data of a running detection.
+  finalcut::FTerm::getFTermDetection();
+}
 
 //----------------------------------------------------------------------
 FTermDetectionTest::~FTermDetectionTest()
@@ -183,6 +193,7 @@ void FTermDetectionTest::ansiTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( ! detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
     CPPUNIT_ASSERT_CSTRING ( detect.getTermType(), "ansi" );
 
     // Test fallback to vt100 without TERM environment variable
@@ -253,6 +264,18 @@ void FTermDetectionTest::xtermTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( detect.hasRectangleSupport() );
+
+    // The title and the cursor position come with the detection query
+    CPPUNIT_ASSERT ( finalcut::FTerm::getFTermXTerminal()->getTitle() == "TITLE" );
+    CPPUNIT_ASSERT ( detect.getCursorPos() == finalcut::FPoint(80, 25) );
+
+    // Other terminals with the xterm id get no rectangle operations
+    unsetenv("XTERM_VERSION");
+    detect.detect();
+    CPPUNIT_ASSERT ( detect.isXTerminal() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
+    setenv ("XTERM_VERSION", "XTerm(312)", 1);
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -315,6 +338,7 @@ void FTermDetectionTest::rxvtTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
     CPPUNIT_ASSERT_CSTRING ( detect.getTermType(), "rxvt-16color" );
 
     printConEmuDebug();
@@ -378,6 +402,7 @@ void FTermDetectionTest::urxvtTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -440,6 +465,7 @@ void FTermDetectionTest::kdeKonsoleTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -503,6 +529,7 @@ void FTermDetectionTest::gnomeTerminalTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -566,6 +593,7 @@ void FTermDetectionTest::newerVteTerminalTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -628,6 +656,7 @@ void FTermDetectionTest::puttyTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     enableConEmuDebug(true);
     printConEmuDebug();
@@ -693,6 +722,7 @@ void FTermDetectionTest::windowsTerminalTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -756,6 +786,7 @@ void FTermDetectionTest::teraTermTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -819,6 +850,7 @@ void FTermDetectionTest::cygwinTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -882,6 +914,7 @@ void FTermDetectionTest::minttyTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     printConEmuDebug();
     closeConEmuStdStreams();
@@ -945,6 +978,7 @@ void FTermDetectionTest::linuxTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     // Test fallback to vt100 without TERM environment variable
     unsetenv("TERM");
@@ -1016,6 +1050,7 @@ void FTermDetectionTest::freebsdTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     // Test fallback to vt100 without TERM environment variable
     unsetenv("TERM");
@@ -1089,6 +1124,7 @@ void FTermDetectionTest::netbsdTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     // Test fallback to vt100 without TERM environment variable
     unsetenv("TERM");
@@ -1160,6 +1196,7 @@ void FTermDetectionTest::openbsdTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     // Test fallback to vt100 without TERM environment variable
     unsetenv("TERM");
@@ -1229,6 +1266,7 @@ void FTermDetectionTest::sunTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( ! detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     // Test fallback to vt100 without TERM environment variable
     unsetenv("TERM");
@@ -1299,6 +1337,7 @@ void FTermDetectionTest::screenTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
     CPPUNIT_ASSERT_CSTRING ( detect.getTermType(), "screen" );
 
     setenv ("XTERM_VERSION", "XTerm(312)", 1);
@@ -1369,6 +1408,7 @@ void FTermDetectionTest::tmuxTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
     CPPUNIT_ASSERT_CSTRING ( detect.getTermType(), "screen" );
 
     setenv ("VTE_VERSION", "3801", 1);
@@ -1438,6 +1478,7 @@ void FTermDetectionTest::ktermTest()
     CPPUNIT_ASSERT ( ! detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( ! detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
 
     // Test fallback to vt100 without TERM environment variable
     unsetenv("TERM");
@@ -1508,6 +1549,7 @@ void FTermDetectionTest::mltermTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasRectangleSupport() );
     CPPUNIT_ASSERT_CSTRING ( detect.getTermType(), "mlterm-256color" );
 
     setenv ("TERM", "mlterm", 1);
@@ -1621,6 +1663,58 @@ void FTermDetectionTest::ttytypeTest()
   rmdir("new-root-dir");
 }
 
+//----------------------------------------------------------------------
+void FTermDetectionTest::keyboardProtocolTest()
+{
+  using finalcut::FTermDetection;
+
+  // xterm secondary device attributes without keyboard protocol reports
+  FTermDetection::parseKeyboardProtocols ("\033[>41;377;0c\033[?62;22c");
+  CPPUNIT_ASSERT ( ! FTermDetection::hasKittyKeyboardSupport() );
+  CPPUNIT_ASSERT ( ! FTermDetection::hasModifyOtherKeysSupport() );
+
+  // Kitty keyboard flags report
+  FTermDetection::parseKeyboardProtocols ("\033[>1;4000;29c\033[?0u\033[?62;c");
+  CPPUNIT_ASSERT ( FTermDetection::hasKittyKeyboardSupport() );
+  CPPUNIT_ASSERT ( ! FTermDetection::hasModifyOtherKeysSupport() );
+
+  FTermDetection::parseKeyboardProtocols ("\033[?15u");
+  CPPUNIT_ASSERT ( FTermDetection::hasKittyKeyboardSupport() );
+
+  // xterm modifyOtherKeys report (XTQMODKEYS)
+  FTermDetection::parseKeyboardProtocols ("\033[>41;377;0c\033[>4;2m");
+  CPPUNIT_ASSERT ( ! FTermDetection::hasKittyKeyboardSupport() );
+  CPPUNIT_ASSERT ( FTermDetection::hasModifyOtherKeysSupport() );
+
+  FTermDetection::parseKeyboardProtocols ("\033[>4m");
+  CPPUNIT_ASSERT ( FTermDetection::hasModifyOtherKeysSupport() );
+
+  // Incomplete or different reports
+  FTermDetection::parseKeyboardProtocols ("\033[?1\033[>4;2");
+  CPPUNIT_ASSERT ( ! FTermDetection::hasKittyKeyboardSupport() );
+  CPPUNIT_ASSERT ( ! FTermDetection::hasModifyOtherKeysSupport() );
+
+  FTermDetection::parseKeyboardProtocols ("\033[?u\033[>45;1m\033[?1;2c");
+  CPPUNIT_ASSERT ( ! FTermDetection::hasKittyKeyboardSupport() );
+  CPPUNIT_ASSERT ( ! FTermDetection::hasModifyOtherKeysSupport() );
+
+  // Bracketed paste mode report (DECRQM)
+  CPPUNIT_ASSERT ( ! FTermDetection::hasBracketedPasteSupport() );
+  FTermDetection::parseKeyboardProtocols ("\033[>1;10;0c\033[?2004;2$y");
+  CPPUNIT_ASSERT ( FTermDetection::hasBracketedPasteSupport() );
+  CPPUNIT_ASSERT ( ! FTermDetection::hasKittyKeyboardSupport() );
+
+  FTermDetection::parseKeyboardProtocols ("\033[?2004;1$y\033[?0u");
+  CPPUNIT_ASSERT ( FTermDetection::hasBracketedPasteSupport() );
+  CPPUNIT_ASSERT ( FTermDetection::hasKittyKeyboardSupport() );
+
+  // Unknown or permanently reset mode
+  FTermDetection::parseKeyboardProtocols ("\033[?2004;0$y");
+  CPPUNIT_ASSERT ( ! FTermDetection::hasBracketedPasteSupport() );
+  FTermDetection::parseKeyboardProtocols ("\033[?2004;4$y");
+  CPPUNIT_ASSERT ( ! FTermDetection::hasBracketedPasteSupport() );
+}
+
 
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FTermDetectionTest);
@@ -0,0 +1,225 @@
+/***********************************************************************
+* fvterm-test.cpp - FVTerm unit tests                                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <array>
+#include <functional>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FillWindow
+//----------------------------------------------------------------------
+
+class FillWindow final : public finalcut::FWindow
+{
+  public:
+    // Using-declaration
+    using finalcut::FWindow::FWindow;
+
+    // Data members
+    wchar_t fill_char{L'#'};
+    finalcut::FColorPair colors{};
+
+  private:
+    // Method
+    void draw() override
+    {
+      setColor (colors.getForegroundColor(), colors.getBackgroundColor());
+      clearArea (fill_char);
+    }
+};
+
+
+//----------------------------------------------------------------------
+// class ScenarioApplication
+//----------------------------------------------------------------------
+
+class ScenarioApplication final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Data member
+    std::function<void(int)> scenario{};
+
+  private:
+    // Method
+    void processExternalUserEvent() override
+    {
+      // Called once per pass of the event loop
+      finalcut::FHeadlessTerminal::advanceClock (20000);  // 20 ms
+      step++;
+
+      if ( scenario )
+        scenario(step);
+    }
+
+    // Data member
+    int step{0};
+};
+
+
+//----------------------------------------------------------------------
+// class FVTermTest
+//----------------------------------------------------------------------
+
+class FVTermTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FVTermTest() = default;
+
+  protected:
+    void rectangleTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FVTermTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (rectangleTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FVTermTest::rectangleTest()
+{
+  // Replays the DECCRA, DECFRA and DECERA output of FVTerm in the
+  // screen model of a headless terminal
+
+  using finalcut::FColor;
+  using finalcut::FPoint;
+  using finalcut::FSize;
+  auto& terminal = finalcut::FHeadlessTerminal::install \
+      (finalcut::FHeadlessTerminal::Profile::Xterm256color, FSize{80, 40});
+  finalcut::FHeadlessTerminal::setClock();
+  finalcut::FTerm::getFTermDetection()->setRectangleSupport();
+  const auto& screen = terminal.getScreen();
+  char arg0[] = "fvterm-test";
+  char* argv[] = { arg0, nullptr };
+  std::array<bool, 6> equal{};
+  std::array<std::size_t, 5> bytes{};
+  std::size_t byte_count{0};
+
+  {
+    ScenarioApplication app{1, argv};
+    finalcut::FWidget main_widget{&app};
+    FillWindow window{&main_widget};
+    window.setGeometry (FPoint{54, 26}, FSize{24, 12});
+    finalcut::FDialog dialog{"Rectangle", &main_widget};
+    dialog.setGeometry (FPoint{6, 4}, FSize{40, 14});
+    finalcut::FLabel label{"Text that is copied", &dialog};
+    label.setGeometry (FPoint{2, 2}, FSize{19, 1});
+    finalcut::FWidget::setMainWidget (&main_widget);
+    main_widget.show();
+
+    const auto check = [&] (std::size_t n)
+    {
+      equal[n] = terminal.isVTermEqual();
+
+      if ( n > 0 )
+        bytes[n - 1] = screen.getByteCount() - byte_count;
+
+      byte_count = screen.getByteCount();
+    };
+
+    app.scenario = [&] (int step)
+    {
+      if ( step == 10 )
+      {
+        check(0);
+        window.fill_char = L'#';  // Filled with DECFRA
+        window.colors = finalcut::FColorPair{FColor::Yellow, FColor::Red};
+        window.redraw();
+      }
+      else if ( step == 20 )
+      {
+        check(1);
+        window.fill_char = L' ';  // Erased with DECERA
+        window.colors = finalcut::FColorPair{FColor::Default, FColor::Default};
+        window.redraw();
+      }
+      else if ( step == 30 )
+      {
+        check(2);
+        dialog.move (FPoint{0, 3});  // Puts the dialog by position
+      }
+      else if ( step == 40 )
+      {
+        check(3);
+        dialog.move (FPoint{-4, -1});  // Copied with DECCRA
+      }
+      else if ( step == 50 )
+      {
+        check(4);
+        dialog.move (FPoint{6, 0});
+      }
+      else if ( step == 60 )
+      {
+        check(5);
+        app.quit();
+      }
+    };
+
+    app.exec();
+  }
+
+  finalcut::FObject::unsetFixedTime();
+  finalcut::FTerm::getFTermDetection()->setRectangleSupport(false);
+
+  // The terminal shows the same as the virtual terminal
+  CPPUNIT_ASSERT ( equal[0] );
+  CPPUNIT_ASSERT ( equal[1] );
+  CPPUNIT_ASSERT ( equal[2] );
+  CPPUNIT_ASSERT ( equal[3] );
+  CPPUNIT_ASSERT ( equal[4] );
+  CPPUNIT_ASSERT ( equal[5] );
+
+  // One sequence instead of printing the window
+  CPPUNIT_ASSERT ( bytes[0] > 0 );
+  CPPUNIT_ASSERT ( bytes[0] < 2 * 24 );
+  CPPUNIT_ASSERT ( bytes[1] > 0 );
+  CPPUNIT_ASSERT ( bytes[1] < 2 * 24 );
+
+  // The moved dialog is copied with a single sequence, so that
+  // fewer bytes than dialog cells are needed
+  CPPUNIT_ASSERT ( bytes[3] > 0 );
+  CPPUNIT_ASSERT ( bytes[3] < 40 * 14 );
+  CPPUNIT_ASSERT ( bytes[4] > 0 );
+  CPPUNIT_ASSERT ( bytes[4] < 40 * 14 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FVTermTest);
+
+// The general unit test main part
+#include <main-test.inc>
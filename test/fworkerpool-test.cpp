@@ -0,0 +1,352 @@
+/***********************************************************************
+* fworkerpool-test.cpp - FWorkerPool unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FillWindow
+//----------------------------------------------------------------------
+
+class FillWindow final : public finalcut::FWindow
+{
+  public:
+    // Using-declaration
+    using finalcut::FWindow::FWindow;
+
+    // Accessor
+    const FTermArea* getVTerm() const
+    {
+      return getVirtualTerminal();
+    }
+
+    // Data members
+    wchar_t fill_char{L'#'};
+    finalcut::FColorPair colors{};
+
+  private:
+    // Method
+    void draw() override
+    {
+      setColor (colors.getForegroundColor(), colors.getBackgroundColor());
+      clearArea (fill_char);
+    }
+};
+
+
+//----------------------------------------------------------------------
+// class ScenarioApplication
+//----------------------------------------------------------------------
+
+class ScenarioApplication final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Data member
+    std::function<void(int)> scenario{};
+
+  private:
+    // Method
+    void processExternalUserEvent() override
+    {
+      // Called once per pass of the event loop
+      finalcut::FHeadlessTerminal::advanceClock (20000);  // 20 ms
+      step++;
+
+      if ( scenario )
+        scenario(step);
+    }
+
+    // Data member
+    int step{0};
+};
+
+
+//----------------------------------------------------------------------
+// class FWorkerPoolTest
+//----------------------------------------------------------------------
+
+class FWorkerPoolTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FWorkerPoolTest() = default;
+
+  protected:
+    void classNameTest();
+    void threadCountTest();
+    void taskTest();
+    void repeatTest();
+    void resultTest();
+    void compositorTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FWorkerPoolTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (threadCountTest);
+    CPPUNIT_TEST (taskTest);
+    CPPUNIT_TEST (repeatTest);
+    CPPUNIT_TEST (resultTest);
+    CPPUNIT_TEST (compositorTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::classNameTest()
+{
+  const finalcut::FWorkerPool pool{1};
+  const finalcut::FString& classname = pool.getClassName();
+  CPPUNIT_ASSERT ( classname == "FWorkerPool" );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::threadCountTest()
+{
+  const finalcut::FWorkerPool pool1{1};
+  CPPUNIT_ASSERT ( pool1.getThreadCount() == 1 );
+  const finalcut::FWorkerPool pool4{4};
+  CPPUNIT_ASSERT ( pool4.getThreadCount() == 4 );
+  const finalcut::FWorkerPool pool_auto{};
+  CPPUNIT_ASSERT ( pool_auto.getThreadCount() >= 1 );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::taskTest()
+{
+  finalcut::FWorkerPool pool{4};
+  std::vector<int> calls(1000, 0);
+
+  // Every task index is processed exactly once
+  pool.run (calls.size(), [&calls] (std::size_t i) { calls[i]++; });
+  CPPUNIT_ASSERT ( std::all_of ( calls.begin(), calls.end()
+                               , [] (int n) { return n == 1; } ) );
+
+  // No tasks
+  std::atomic<int> count{0};
+  pool.run (0, [&count] (std::size_t) { count++; });
+  CPPUNIT_ASSERT ( count == 0 );
+
+  // One task runs in the calling thread
+  const auto caller = std::this_thread::get_id();
+  std::thread::id task_thread{};
+  pool.run (1, [&task_thread] (std::size_t) { task_thread = std::this_thread::get_id(); });
+  CPPUNIT_ASSERT ( task_thread == caller );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::repeatTest()
+{
+  // The pool is reusable without new threads
+
+  finalcut::FWorkerPool pool{3};
+  std::atomic<std::size_t> sum{0};
+
+  for (std::size_t n{1}; n <= 200; n++)
+    pool.run (n, [&sum] (std::size_t i) { sum += i + 1; });
+
+  // sum of (n * (n + 1) / 2) for n = 1 … 200
+  CPPUNIT_ASSERT ( sum == 1353400 );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::resultTest()
+{
+  // Disjoint bands give the same result with any thread count
+
+  const std::size_t size{10000};
+  std::vector<uInt64> expected(size);
+  std::iota (expected.begin(), expected.end(), 0);
+
+  for (auto&& value : expected)
+    value = value * value + 7;
+
+  for (std::size_t threads{1}; threads <= 8; threads++)
+  {
+    finalcut::FWorkerPool pool{threads};
+    std::vector<uInt64> result(size, 0);
+    const std::size_t bands{37};
+    pool.run ( bands, [&result, size, bands] (std::size_t band)
+                      {
+                        for (auto i = band * size / bands; i < (band + 1) * size / bands; i++)
+                          result[i] = i * i + 7;
+                      } );
+    CPPUNIT_ASSERT ( result == expected );
+  }
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::compositorTest()
+{
+  // Composes overlapping windows with shadows serially and with
+  // 2, 4 and 8 threads into the virtual terminal
+
+  using finalcut::FColor;
+  using finalcut::FPoint;
+  using finalcut::FSize;
+  using FLineChanges = finalcut::FVTerm::FLineChanges;
+  finalcut::FHeadlessTerminal::install \
+      (finalcut::FHeadlessTerminal::Profile::Xterm256color, FSize{128, 64});
+  finalcut::FHeadlessTerminal::setClock();
+  char arg0[] = "fvterm-test";
+  char* argv[] = { arg0, nullptr };
+  const std::array<std::size_t, 4> thread_counts{{1, 2, 4, 8}};
+  std::array<std::size_t, 4> used_threads{};
+  std::array<std::vector<finalcut::FChar>, 4> data{};
+  std::array<std::vector<FLineChanges>, 4> changes{};
+
+  {
+    ScenarioApplication app{1, argv};
+    finalcut::FWidget main_widget{&app};
+    std::vector<std::unique_ptr<FillWindow>> windows{};
+    std::vector<std::unique_ptr<finalcut::FDialog>> dialogs{};
+
+    for (int i{0}; i < 6; i++)
+    {
+      // Windows with a shadow
+      windows.emplace_back (new FillWindow{&main_widget});
+      auto& window = windows.back();
+      window->setGeometry (FPoint{2 + 17 * i, 3 + 7 * i}, FSize{30, 16});
+      window->setShadow();
+      window->colors = finalcut::FColorPair{FColor::Blue, FColor::Cyan};
+
+      // Dialogs with a transparent shadow
+      dialogs.emplace_back (new finalcut::FDialog{"Dialog", &main_widget});
+      auto& dialog = dialogs.back();
+      dialog->setGeometry (FPoint{12 + 18 * i, 1 + 8 * i}, FSize{26, 12});
+    }
+
+    finalcut::FWidget::setMainWidget (&main_widget);
+    main_widget.show();
+    const auto vterm = windows.front()->getVTerm();
+
+    const auto change_windows = [&windows, &dialogs] (bool alternate)
+    {
+      for (auto&& window : windows)
+      {
+        window->fill_char = alternate ? L'x' : L'#';
+        window->colors = alternate
+            ? finalcut::FColorPair{FColor::Yellow, FColor::Red}
+            : finalcut::FColorPair{FColor::Blue, FColor::Cyan};
+        window->redraw();
+      }
+
+      for (auto&& dialog : dialogs)
+      {
+        dialog->setText (alternate ? "Changed" : "Dialog");
+        dialog->redraw();
+      }
+    };
+
+    app.scenario = [&] (int step)
+    {
+      if ( step < 10 || step % 10 != 0 )
+        return;
+
+      const auto run = std::size_t(step / 20);
+
+      if ( step % 20 == 10 )
+      {
+        if ( run == thread_counts.size() )
+        {
+          finalcut::FVTerm::setCompositorThreads(1);
+          app.quit();
+          return;
+        }
+
+        // Keeps the composed changes in the virtual terminal
+        finalcut::FVTerm::setCompositorThreads(thread_counts[run]);
+        used_threads[run] = finalcut::FVTerm::getCompositorThreads();
+        main_widget.setTerminalUpdates (finalcut::FVTerm::TerminalUpdate::Stop);
+        change_windows(true);
+      }
+      else
+      {
+        const auto size = std::size_t(vterm->width * vterm->height);
+        data[run - 1].assign(vterm->data, vterm->data + size);
+        changes[run - 1].assign(vterm->changes, vterm->changes + vterm->height);
+        change_windows(false);
+        main_widget.setTerminalUpdates (finalcut::FVTerm::TerminalUpdate::Continue);
+      }
+    };
+
+    app.exec();
+  }
+
+  finalcut::FObject::unsetFixedTime();
+
+  // The same result as the serial composition
+  CPPUNIT_ASSERT ( data[0].size() == 128 * 64 );
+  CPPUNIT_ASSERT ( changes[0].size() == 64 );
+
+  for (std::size_t run{0}; run < thread_counts.size(); run++)
+  {
+    CPPUNIT_ASSERT ( used_threads[run] == thread_counts[run] );
+    CPPUNIT_ASSERT ( data[run] == data[0] );
+    CPPUNIT_ASSERT ( changes[run].size() == changes[0].size() );
+
+    for (std::size_t y{0}; y < changes[0].size(); y++)
+    {
+      CPPUNIT_ASSERT ( changes[run][y].xmin == changes[0][y].xmin );
+      CPPUNIT_ASSERT ( changes[run][y].xmax == changes[0][y].xmax );
+      CPPUNIT_ASSERT ( changes[run][y].trans_count == changes[0][y].trans_count );
+    }
+  }
+
+  // The changed windows are in the composed lines
+  const auto& serial = data[0];
+  std::size_t x_count{0};
+
+  for (auto&& fchar : serial)
+    if ( fchar.ch[0] == L'x' )
+      x_count++;
+
+  CPPUNIT_ASSERT ( x_count > 0 );
+  CPPUNIT_ASSERT ( changes[0][20].xmin <= changes[0][20].xmax );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FWorkerPoolTest);
+
+// The general unit test main part
+#include <main-test.inc>